@@ -10,6 +10,16 @@
 
 #include "GLGEData.h"
 #include "glgePrivDefines.hpp"
+#include <algorithm>
+
+//use SSE2 for the varint arrays if the compiler supports it, define GLGE_DATA_NO_SIMD to use only the scalar code
+#if !defined(GLGE_DATA_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#include <emmintrin.h>
+#define GLGE_DATA_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 /**
  * @brief amount of bits in a segment
@@ -20,6 +30,221 @@
  */
 #define CONTINUE_BITS 0x80
 
+/**
+ * @brief get the index of the lowest set bit
+ * 
+ * @param v the bits, must not be 0
+ * @return int the index of the lowest set bit
+ */
+static inline int glgeLowestBit(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    //use the builtin, it compiles to a single instruction
+    return __builtin_ctz(v);
+#elif defined(_MSC_VER)
+    //use the intrinsic
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return (int)index;
+#else
+    //search the bit
+    int i = 0;
+    while (!(v & 1)) { v >>= 1; i++; }
+    return i;
+#endif
+}
+
+/**
+ * @brief encode integers as varints
+ * 
+ * @param values the integers to encode
+ * @param count the amount of integers
+ * @param out the bytes to write to, must have space for count*5 bytes
+ * @return size_t the amount of written bytes
+ */
+static size_t glgeEncodeVarInts(const uint32_t* values, size_t count, uint8_t* out)
+{
+    //store the write position
+    size_t p = 0;
+    //store the read position
+    size_t i = 0;
+    //encode blocks of 16 integers
+    while (i < count)
+    {
+#ifdef GLGE_DATA_SSE2
+        //encode 16 integers at once while all of them fit into a single byte
+        const __m128i high = _mm_set1_epi32(~SEGMENT_BITS);
+        while (i + 16 <= count)
+        {
+            //load 16 integers
+            __m128i a = _mm_loadu_si128((const __m128i*)(values + i));
+            __m128i b = _mm_loadu_si128((const __m128i*)(values + i + 4));
+            __m128i c = _mm_loadu_si128((const __m128i*)(values + i + 8));
+            __m128i d = _mm_loadu_si128((const __m128i*)(values + i + 12));
+            //check if an integer needs more than 7 bits
+            __m128i any = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), high);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(any, _mm_setzero_si128())) != 0xFFFF) { break; }
+            //pack the integers to bytes, they are small enough to not saturate
+            __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+            _mm_storeu_si128((__m128i*)(out + p), bytes);
+            p += 16;
+            i += 16;
+        }
+#endif
+        //encode the next block one by one
+        size_t stop = std::min(count, i + 16);
+        for (; i < stop; i++)
+        {
+            uint32_t value = values[i];
+            //write 7 bits per byte while more bits follow
+            while (value & ~(uint32_t)SEGMENT_BITS)
+            {
+                out[p++] = (uint8_t)((value & SEGMENT_BITS) | CONTINUE_BITS);
+                value >>= 7;
+            }
+            //write the last byte
+            out[p++] = (uint8_t)value;
+        }
+    }
+    //return the amount of written bytes
+    return p;
+}
+
+/**
+ * @brief decode varints
+ * 
+ * @param in the bytes to decode
+ * @param size the amount of bytes
+ * @param values the integers to write to
+ * @param count the amount of integers to decode
+ * @return size_t the amount of read bytes, 0 if the data is invalid or to short
+ */
+static size_t glgeDecodeVarInts(const uint8_t* in, size_t size, uint32_t* values, size_t count)
+{
+    //store the read position
+    size_t p = 0;
+    //store the write position
+    size_t i = 0;
+#ifdef GLGE_DATA_SSE2
+    //decode blocks of 16 bytes while they are fully readable
+    const __m128i zero = _mm_setzero_si128();
+    while ((i + 16 <= count) && (p + 16 <= size))
+    {
+        //load 16 bytes and get the bits that say if a varint continues
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(in + p));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(bytes);
+        //check if the block contains 16 single byte varints
+        if (mask == 0)
+        {
+            //widen the bytes to integers
+            __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+            __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+            _mm_storeu_si128((__m128i*)(values + i), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(values + i + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(values + i + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i*)(values + i + 12), _mm_unpackhi_epi16(hi, zero));
+            p += 16;
+            i += 16;
+            continue;
+        }
+        //check if the first half contains 8 single byte varints
+        if ((mask & 0xFF) == 0)
+        {
+            //widen the bytes to integers
+            __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+            _mm_storeu_si128((__m128i*)(values + i), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(values + i + 4), _mm_unpackhi_epi16(lo, zero));
+            p += 8;
+            i += 8;
+            continue;
+        }
+        //check if the block contains 8 varints with 2 bytes
+        if ((mask == 0x5555) && (i + 8 <= count))
+        {
+            //combine the low 7 bits of both bytes of every 16 bit lane
+            __m128i low = _mm_and_si128(bytes, _mm_set1_epi16(0x007F));
+            __m128i high = _mm_slli_epi16(_mm_srli_epi16(bytes, 8), 7);
+            __m128i v = _mm_or_si128(low, high);
+            //widen the values to integers
+            _mm_storeu_si128((__m128i*)(values + i), _mm_unpacklo_epi16(v, zero));
+            _mm_storeu_si128((__m128i*)(values + i + 4), _mm_unpackhi_epi16(v, zero));
+            p += 16;
+            i += 8;
+            continue;
+        }
+        //check if the block only contains varints with 1 or 2 bytes, then no byte with a continue bit follows another one
+        if ((mask & (mask << 1)) == 0)
+        {
+            //calculate the value of a varint starting at every byte, the next byte is only added if the byte continues
+            __m128i low = _mm_and_si128(bytes, _mm_set1_epi8(0x7F));
+            __m128i high = _mm_and_si128(_mm_srli_si128(low, 1), _mm_cmplt_epi8(bytes, zero));
+            uint16_t candidates[16];
+            _mm_storeu_si128((__m128i*)candidates, _mm_or_si128(_mm_unpacklo_epi8(low, zero), _mm_slli_epi16(_mm_unpacklo_epi8(high, zero), 7)));
+            _mm_storeu_si128((__m128i*)(candidates + 8), _mm_or_si128(_mm_unpackhi_epi8(low, zero), _mm_slli_epi16(_mm_unpackhi_epi8(high, zero), 7)));
+            //the varints start at the first byte and after every byte without a continue bit, a varint at the last byte with a continue bit ends in the next block
+            uint32_t starts = ((~mask << 1) | 1) & 0xFFFF & ~(mask & 0x8000);
+            int start = 0;
+            while (starts && (i < count))
+            {
+                //copy the value of the next varint
+                start = glgeLowestBit(starts);
+                values[i++] = candidates[start];
+                starts &= starts - 1;
+            }
+            //continue after the last decoded varint
+            p += start + 1 + ((mask >> start) & 1);
+            continue;
+        }
+        //decode every varint that ends inside of the block, the ends are the bytes without the continue bit
+        uint32_t ends = ~mask & 0xFFFF;
+        int start = 0;
+        while (ends && (i < count))
+        {
+            //get the length of the varint from the next end
+            int end = glgeLowestBit(ends);
+            int len = end - start + 1;
+            //a varint of an integer has at most 5 bytes
+            if (len > 5) { return 0; }
+            //load the bytes of the varint at once, SSE2 hosts are little endian
+            uint64_t x = 0;
+            if (p + start + 8 <= size) { std::memcpy(&x, in + p + start, 8); }
+            else { std::memcpy(&x, in + p + start, len); }
+            //remove the bytes after the varint
+            x &= (~0ull) >> (64 - 8*len);
+            //combine the 7 bit groups without branching on the length
+            values[i++] = (uint32_t)((x & 0x7Full) | ((x >> 1) & (0x7Full << 7)) | ((x >> 2) & (0x7Full << 14)) |
+                                     ((x >> 3) & (0x7Full << 21)) | ((x >> 4) & (0xFull << 28)));
+            //continue after the end
+            start = end + 1;
+            ends &= ends - 1;
+        }
+        //16 bytes without an end can't be valid
+        if (start == 0) { return 0; }
+        p += start;
+    }
+#endif
+    //decode the remaining varints one by one
+    for (; i < count; i++)
+    {
+        uint32_t value = 0;
+        int position = 0;
+        while (true)
+        {
+            //stop if no data is left
+            if (p >= size) { return 0; }
+            uint8_t currentByte = in[p++];
+            value |= (uint32_t)(currentByte & SEGMENT_BITS) << position;
+            if ((currentByte & CONTINUE_BITS) == 0) { break; }
+            position += 7;
+            //a varint of an integer has at most 5 bytes
+            if (position >= 32) { return 0; }
+        }
+        values[i] = value;
+    }
+    //return the amount of read bytes
+    return p;
+}
+
 Data::Data()
 {
     //clear the data
@@ -32,194 +257,258 @@ Data::~Data()
     this->data.clear();
 }
 
+Data::Data(const Data& other) : DataView()
+{
+    //copy the data and the read position
+    this->data = other.data;
+    this->readPos = other.readPos;
+    //view the own copy
+    this->sync();
+}
+
+Data& Data::operator=(const Data& other)
+{
+    //check for self assignment
+    if (this == &other) { return *this; }
+    //copy the data and the read position
+    this->data = other.data;
+    this->readPos = other.readPos;
+    //view the own copy
+    this->sync();
+    return *this;
+}
+
+void Data::sync()
+{
+    //view the bytes of the vector
+    this->view = (const uint8_t*)this->data.data();
+    this->viewSize = this->data.size();
+}
+
+uint8_t* Data::grow(size_t size)
+{
+    //store the old size
+    size_t old = this->data.size();
+    //make space for the new bytes, the vector grows geometrically
+    this->data.resize(old + size);
+    //the vector may have moved
+    this->sync();
+    //return the new bytes
+    return (uint8_t*)this->data.data() + old;
+}
+
+const uint8_t* DataView::consume(size_t size)
+{
+    //safty check
+    if (size > (this->viewSize - this->readPos))
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Cant read " + std::to_string(size) + " bytes from array of size " + std::to_string(this->viewSize - this->readPos))
+        //stop the function
+        return NULL;
+    }
+    //get the bytes
+    const uint8_t* bytes = this->view + this->readPos;
+    //move the read position behind the bytes
+    this->readPos += size;
+    //return the bytes
+    return bytes;
+}
+
+bool DataView::readBytes(void* out, size_t size)
+{
+    //get the bytes, this checks the size
+    const uint8_t* bytes = this->consume(size);
+    if (!bytes) { return false; }
+    //copy the bytes
+    if (size) { std::memcpy(out, bytes, size); }
+    return true;
+}
+
+bool DataView::skip(size_t size)
+{
+    //move over the bytes, this checks the size
+    return this->consume(size) != NULL;
+}
+
+void Data::reserve(size_t size)
+{
+    //reserve the space after the existing data
+    this->data.reserve(this->data.size() + size);
+    //the vector may have moved
+    this->sync();
+}
+
 void Data::writeBool(bool a)
 {
     //write a boolean to the message
-    this->data.push_back((int8_t)a);
+    *this->grow(1) = (uint8_t)a;
 }
 void Data::writeByte(int8_t a)
 {
     //write a byte to the message
-    this->data.push_back(a);
+    *this->grow(1) = (uint8_t)a;
 }
 void Data::writeUByte(uint8_t a)
 {
-    //write a unsigned byte (use some pointer magic to handle the sign byte)
-    this->data.push_back(*((int8_t*)&a));
+    //write a unsigned byte
+    *this->grow(1) = a;
 }
 void Data::writeShort(short a)
 {
-    //reverse the bit order
-    a = (a & 0x00FF) << 8 | (a & 0xFF00) >> 8;
-    //create a short to store the number
-    short* s = new short(a);
-    //write the array to the message
-    this->data.insert(this->data.end(), (int8_t*)s, (int8_t*)&s[1]);
+    //write the short as big endian
+    int16_t v = (int16_t)a;
+    glgeStoreBigEndian(this->grow(2), &v, 1);
 }
 void Data::writeUShort(unsigned short a)
 {
-    //reverse the bit order
-    a = (a & 0x00FF) << 8 | (a & 0xFF00) >> 8;
-    //create a short to store the number
-    unsigned short* s = new unsigned short(a);
-    //write the array to the message
-    this->data.insert(this->data.end(), (int8_t*)s, (int8_t*)&s[1]);
+    //write the unsigned short as big endian
+    uint16_t v = (uint16_t)a;
+    glgeStoreBigEndian(this->grow(2), &v, 1);
 }
 void Data::writeInt(int a)
 {
-    //store the reversed long
-    long i = 0;
-    //reverse the bit order
-    i = (a & 0x000000FF) << (4 - 1)*8 | 
-        (a & 0x0000FF00) << (4 - 3)*8 | 
-        (a & 0x00FF0000) >> (4 - 3)*8 |
-        (a & 0xFF000000) >> (4 - 1)*8;
-    //create a short to store the number
-    int* p = new int(i);
-    //write the array to the message
-    this->data.insert(this->data.end(), (int8_t*)p, (int8_t*)(p+1));
+    //write the integer as big endian
+    int32_t v = (int32_t)a;
+    glgeStoreBigEndian(this->grow(4), &v, 1);
 }
 void Data::writeUInt(unsigned int a)
 {
-    //store the reversed long
-    long i = 0;
-    //reverse the bit order
-    i = (a & 0x000000FF) << (4 - 1)*8 | 
-        (a & 0x0000FF00) << (4 - 3)*8 | 
-        (a & 0x00FF0000) >> (4 - 3)*8 |
-        (a & 0xFF000000) >> (4 - 1)*8;
-    //create a short to store the number
-    int* p = new int(i);
-    //write the array to the message
-    this->data.insert(this->data.end(), (int8_t*)p, (int8_t*)(p+1));
+    //write the unsigned integer as big endian
+    uint32_t v = (uint32_t)a;
+    glgeStoreBigEndian(this->grow(4), &v, 1);
 }
 void Data::writeLong(long a)
 {
-    //store the reversed long
-    long l = 0;
-    //reverse the bit order
-    l = (a & 0x00000000000000FF) << (8 - 1)*8 | 
-        (a & 0x000000000000FF00) << (8 - 3)*8 | 
-        (a & 0x0000000000FF0000) << (8 - 5)*8 | 
-        (a & 0x00000000FF000000) << (8 - 7)*8 | 
-        (a & 0x000000FF00000000) >> (8 - 7)*8 |
-        (a & 0x0000FF0000000000) >> (8 - 5)*8 |
-        (a & 0x00FF000000000000) >> (8 - 3)*8 |
-        (a & 0xFF00000000000000) >> (8 - 1)*8;
-    //create a short to store the number
-    long* p = new long(l);
-    //write the array to the message
-    this->data.insert(this->data.end(), (int8_t*)p, (int8_t*)(p+1));
+    //write the long as 8 big endian bytes on every platform
+    int64_t v = (int64_t)a;
+    glgeStoreBigEndian(this->grow(8), &v, 1);
 }
 void Data::writeULong(unsigned long a)
 {
-    //store the reversed long
-    long l = 0;
-    //reverse the bit order
-    l = (a & 0x00000000000000FF) << (8 - 1)*8 | 
-        (a & 0x000000000000FF00) << (8 - 3)*8 | 
-        (a & 0x0000000000FF0000) << (8 - 5)*8 | 
-        (a & 0x00000000FF000000) << (8 - 7)*8 | 
-        (a & 0x000000FF00000000) >> (8 - 7)*8 |
-        (a & 0x0000FF0000000000) >> (8 - 5)*8 |
-        (a & 0x00FF000000000000) >> (8 - 3)*8 |
-        (a & 0xFF00000000000000) >> (8 - 1)*8;
-    //create a short to store the number
-    long* p = new long(l);
-    //write the array to the message
-    this->data.insert(this->data.end(), (int8_t*)p, (int8_t*)(p+1));
+    //write the unsigned long as 8 big endian bytes on every platform
+    uint64_t v = (uint64_t)a;
+    glgeStoreBigEndian(this->grow(8), &v, 1);
 }
 void Data::writeFloat(float a)
 {
-    //pretend the float is an integer
-    this->writeInt(*((int*)&a));
+    //write the bits of the float as big endian
+    glgeStoreBigEndian(this->grow(4), &a, 1);
 }
 void Data::writeDouble(double a)
 {
-    //represent double as long
-    this->writeLong(*((long*)&a));
+    //write the bits of the double as big endian
+    glgeStoreBigEndian(this->grow(8), &a, 1);
 }
 void Data::writeString(std::string a)
 {
     //write the length as an varint
     this->writeVarInt(a.length());
-    //loop over every element in the string
-    for (int i = 0; i < (int)a.length(); i++)
-    {
-        //write the current element to the message
-        data.push_back(a[i]);
-    }
+    //write all characters at once
+    if (!a.empty()) { std::memcpy(this->grow(a.length()), a.data(), a.length()); }
 }
 // https://wiki.vg/Data_types#VarInt_and_VarLong
 void Data::writeVarInt(int a)
 {
-    int value = a;
-    //make sure to not get stuck in the loop
-    for (int i = 0; i < 8; i++)
+    //encode the bits of the integer without a sign
+    uint32_t value = (uint32_t)a;
+    //store the encoded bytes, an integer takes at most 5 bytes
+    uint8_t bytes[5];
+    int count = 0;
+    //write 7 bits per byte while more bits follow
+    while (value & ~(uint32_t)SEGMENT_BITS)
     {
-        if ((value & (~SEGMENT_BITS)) == 0) {
-            this->writeByte((int8_t)(value & 0xFF));
-            return;
-        }
-        this->writeByte((value & SEGMENT_BITS) | CONTINUE_BITS);
-
-        value = value >> 7;
-        //set the new byte to 0
-        ((int8_t*)&value)[3] = 0x00;
+        bytes[count++] = (uint8_t)((value & SEGMENT_BITS) | CONTINUE_BITS);
+        value >>= 7;
     }
-    //throw an error : the varint was too long
-    std::__throw_runtime_error("VarInt was too long");
-    return;
+    //write the last byte
+    bytes[count++] = (uint8_t)value;
+    //append all bytes at once
+    std::memcpy(this->grow(count), bytes, count);
 }
 void Data::writeVarLong(long a)
 {
-    long value = a;
-    //make sure to not get stuck in the loop
-    for (int i = 0; i < 16; i++)
+    //encode the bits of the long without a sign
+    uint64_t value = (uint64_t)(int64_t)a;
+    //store the encoded bytes, a long takes at most 10 bytes
+    uint8_t bytes[10];
+    int count = 0;
+    //write 7 bits per byte while more bits follow
+    while (value & ~(uint64_t)SEGMENT_BITS)
     {
-        if ((value & (~((long)SEGMENT_BITS))) == 0) {
-            this->writeByte((int8_t)(value & 0xFF));
-            return;
+        bytes[count++] = (uint8_t)((value & SEGMENT_BITS) | CONTINUE_BITS);
+        value >>= 7;
+    }
+    //write the last byte
+    bytes[count++] = (uint8_t)value;
+    //append all bytes at once
+    std::memcpy(this->grow(count), bytes, count);
+}
+void Data::writeVarInts(const unsigned int* values, size_t count, bool delta)
+{
+    //stop if nothing is written
+    if (count == 0) { return; }
+    //get space for the longest possible encoding
+    size_t old = this->data.size();
+    uint8_t* out = this->grow(count*5);
+    size_t written = 0;
+    //check if the differences should be written
+    if (delta)
+    {
+        //store the zigzag encoded differences, small positive and negative differences become small integers
+        std::vector<uint32_t> diffs(count);
+        uint32_t prev = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            int32_t d = (int32_t)(values[i] - prev);
+            diffs[i] = ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+            prev = values[i];
         }
-        this->writeByte((value & SEGMENT_BITS) | CONTINUE_BITS);
-
-        value = value >> 7;
-        //set the new byte to 0
-        ((int8_t*)&value)[7] = 0x00;
+        written = glgeEncodeVarInts(diffs.data(), count, out);
     }
-    //throw an error : the varlong was too long
-    std::__throw_runtime_error("VarLong was too long");
-    return;
+    else
+    {
+        //write the integers directly
+        written = glgeEncodeVarInts((const uint32_t*)values, count, out);
+    }
+    //remove the unused space
+    this->data.resize(old + written);
+    this->sync();
+}
+void Data::writeVarIntArray(const unsigned int* values, size_t count, bool delta)
+{
+    //write the amount of integers
+    this->writeVarLong((long)count);
+    //write the integers
+    this->writeVarInts(values, count, delta);
+}
+void Data::writeVarIntArray(const std::vector<unsigned int>& values, bool delta)
+{
+    //write the vector
+    this->writeVarIntArray(values.data(), values.size(), delta);
 }
 void Data::writeVec2(vec2 a)
 {
-    //write a float for the x component
-    this->writeFloat(a.y);
-    //write a float for the y-component
-    this->writeFloat(a.x);
+    //the components are stored from the last to the first
+    float v[2] = {a.y, a.x};
+    glgeStoreBigEndian(this->grow(sizeof(v)), v, 2);
 }
 void Data::writeVec3(vec3 a)
 {
-    //write a float for the x component
-    this->writeFloat(a.z);
-    //write a float for the y-component
-    this->writeFloat(a.y);
-    //write a float for the z-component
-    this->writeFloat(a.x);
+    //the components are stored from the last to the first
+    float v[3] = {a.z, a.y, a.x};
+    glgeStoreBigEndian(this->grow(sizeof(v)), v, 3);
 }
 void Data::writeVec4(vec4 a)
 {
-    //write a float for the x component
-    this->writeFloat(a.w);
-    //write a float for the y-component
-    this->writeFloat(a.z);
-    //write a float for the z-component
-    this->writeFloat(a.y);
-    //write a float for the w-component
-    this->writeFloat(a.x);
+    //the components are stored from the last to the first
+    float v[4] = {a.w, a.z, a.y, a.x};
+    glgeStoreBigEndian(this->grow(sizeof(v)), v, 4);
 }
 void Data::writeMat2(mat2 a)
 {
+    //store the elements from the last to the first
+    float v[4];
     //loop over the rows
     for (int x = 0; x < 2; x++)
     {
@@ -227,12 +516,16 @@ void Data::writeMat2(mat2 a)
         for (int y = 0; y < 2; y++)
         {
             //add a floa for the element
-            this->writeFloat(a.m[(1-x)][(1-y)]);
+            v[x*2 + y] = a.m[(1-x)][(1-y)];
         }
     }
+    //write all elements at once
+    glgeStoreBigEndian(this->grow(sizeof(v)), v, 4);
 }
 void Data::writeMat3(mat3 a)
 {
+    //store the elements from the last to the first
+    float v[9];
     //loop over the rows
     for (int x = 0; x < 3; x++)
     {
@@ -240,12 +533,16 @@ void Data::writeMat3(mat3 a)
         for (int y = 0; y < 3; y++)
         {
             //add a floa for the element
-            this->writeFloat(a.m[(2-x)][(2-y)]);
+            v[x*3 + y] = a.m[(2-x)][(2-y)];
         }
     }
+    //write all elements at once
+    glgeStoreBigEndian(this->grow(sizeof(v)), v, 9);
 }
 void Data::writeMat4(mat4 a)
 {
+    //store the elements from the last to the first
+    float v[16];
     //loop over the rows
     for (int x = 0; x < 4; x++)
     {
@@ -253,9 +550,11 @@ void Data::writeMat4(mat4 a)
         for (int y = 0; y < 4; y++)
         {
             //add a floa for the element
-            this->writeFloat(a.m[(3-x)][(3-y)]);
+            v[x*4 + y] = a.m[(3-x)][(3-y)];
         }
     }
+    //write all elements at once
+    glgeStoreBigEndian(this->grow(sizeof(v)), v, 16);
 }
 void Data::writeQuaternion(Quaternion a)
 {
@@ -265,223 +564,245 @@ void Data::writeQuaternion(Quaternion a)
 void Data::writeBytes(uint8_t* data, size_t size)
 {
     //add the data to the own data
-    this->data.insert(this->data.end(), data, data+size);
+    if (size) { std::memcpy(this->grow(size), data, size); }
 }
 
 int8_t* Data::getData()
 {
-    return this->data.data();
-}
-size_t Data::getLen()
-{
-    return this->data.size();
+    //return the data that was not read yet
+    return this->data.data() + this->readPos;
 }
 
 void Data::setData(std::vector<int8_t> data)
 {
-    this->data.clear();
-    this->data = data;
+    //take the data without copying it again
+    this->data = std::move(data);
+    //start reading at the beginning
+    this->readPos = 0;
+    this->sync();
 }
 void Data::setData(int8_t* data, size_t len)
 {
-    this->data.clear();
-    this->data.insert(this->data.end(), data, data+len);
+    //copy the data
+    this->data.assign(data, data+len);
+    //start reading at the beginning
+    this->readPos = 0;
+    this->sync();
 }
 
-bool Data::readBool()
+bool DataView::readBool()
 {
     //get the first byte of the message
-    int8_t byte = this->data[0];
-    //delete the first byte of the message
-    this->data.erase(data.begin(), data.begin()+1);
+    const uint8_t* byte = this->consume(1);
     //return the byte interpreted as an bool
-    return (bool)byte;
+    return byte ? (bool)*byte : false;
 }
-int8_t Data::readByte()
+int8_t DataView::readByte()
 {
     //get the first byte of the message
-    int8_t byte = this->data[0];
-    //delete the first byte of the message
-    this->data.erase(data.begin(), data.begin()+1);
+    const uint8_t* byte = this->consume(1);
     //return the byte
-    return byte;
+    return byte ? (int8_t)*byte : 0;
 }
-uint8_t Data::readUByte()
+uint8_t DataView::readUByte()
 {
     //get the first byte of the message
-    int8_t byte = this->data[0];
-    //delete the first byte of the message
-    this->data.erase(data.begin(), data.begin()+1);
-    //return the byte interpreted as an unsigned int8_t
-    return (unsigned int8_t)byte;
-}
-short Data::readShort()
-{
-    //construct a short from the first two element of the message
-    short data = (this->data[0] << 4) | this->data[1];
-    //delete the first two elements of the message
-    this->data.erase(this->data.begin(), this->data.begin()+2);
-    //return the short
-    return data;
-}
-unsigned short Data::readUShort()
-{
-    //construct an unsigned short from the first two element of the message
-    unsigned short data = (this->data[0] << 4) | this->data[1];
-    //delete the first two elements of the message
-    this->data.erase(this->data.begin(), this->data.begin()+2);
-    //return the unsigned short
-    return data;
-}
-int Data::readInt()
-{
-    //construct an integer from the first four element of the message
-    int data = (this->data[0] << 12) | (this->data[1] << 8) | (this->data[2] << 4) | this->data[3];
-    //delete the first four elements of the message
-    this->data.erase(this->data.begin(), this->data.begin()+4);
-    //return the integer
-    return data;
-}
-unsigned int Data::readUInt()
-{
-    //construct an unsigned integer from the first four element of the message
-    unsigned int data = (this->data[0] << 12) | (this->data[1] << 8) | (this->data[2] << 4) | this->data[3];
-    //delete the first four elements of the message
-    this->data.erase(this->data.begin(), this->data.begin()+4);
-    //return the unsigned integer
-    return data;
-}
-long Data::readLong()
-{
-    //construct a long from the first eigt element of the message
-    int data = (this->data[0] << 28) | (this->data[1] << 24) | (this->data[2] << 20) | (this->data[3] << 16) | 
-              (this->data[4] << 12) | (this->data[5] << 8)  | (this->data[6] << 4) | this->data[7];
-    //delete the first eight elements of the message
-    this->data.erase(this->data.begin(), this->data.begin()+8);
-    //return the long
-    return data;
-}
-unsigned long Data::readULong()
-{
-    //construct a long from the first eigt element of the message
-    unsigned int data = (this->data[0] << 28) | (this->data[1] << 24) | (this->data[2] << 20) | (this->data[3] << 16) | 
-                       (this->data[4] << 12) | (this->data[5] << 8)  | (this->data[6] << 4) | this->data[7];
-    //delete the first eight elements of the message
-    this->data.erase(this->data.begin(), this->data.begin()+8);
-    //return the unsigned long
-    return data;
-}
-float Data::readFloat()
-{
-    //store an integer
-    int a = 0;
-    //loop over the vector and read the float
-    for (int i = 0; i < 4; i++)
-    {
-        //store the current element
-        ((int8_t*)&a)[(3-i)] = this->data[i];
-    }
-    //delete the content
-    this->data.erase(this->data.begin(), this->data.begin()+4);
-    //return a float
-    return *((float*)&a);
+    const uint8_t* byte = this->consume(1);
+    //return the byte interpreted as an unsigned byte
+    return byte ? *byte : 0;
 }
-double Data::readDouble()
+short DataView::readShort()
 {
-    //store a long
-    long a = 0;
-    //loop over the vector and read the float
-    for (int i = 0; i < 8; i++)
-    {
-        //store the current element
-        ((int8_t*)&a)[(7-i)] = this->data[i];
-    }
-    //delete the content
-    this->data.erase(this->data.begin(), this->data.begin()+8);
-    //return a float
-    return *((double*)&a);
+    //read a big endian short
+    int16_t v = 0;
+    this->readArray(&v, 1);
+    return (short)v;
+}
+unsigned short DataView::readUShort()
+{
+    //read a big endian unsigned short
+    uint16_t v = 0;
+    this->readArray(&v, 1);
+    return (unsigned short)v;
+}
+int DataView::readInt()
+{
+    //read a big endian integer
+    int32_t v = 0;
+    this->readArray(&v, 1);
+    return (int)v;
+}
+unsigned int DataView::readUInt()
+{
+    //read a big endian unsigned integer
+    uint32_t v = 0;
+    this->readArray(&v, 1);
+    return (unsigned int)v;
+}
+long DataView::readLong()
+{
+    //read 8 big endian bytes
+    int64_t v = 0;
+    this->readArray(&v, 1);
+    return (long)v;
+}
+unsigned long DataView::readULong()
+{
+    //read 8 big endian bytes
+    uint64_t v = 0;
+    this->readArray(&v, 1);
+    return (unsigned long)v;
+}
+float DataView::readFloat()
+{
+    //read the bits of a big endian float
+    float v = 0;
+    this->readArray(&v, 1);
+    return v;
+}
+double DataView::readDouble()
+{
+    //read the bits of a big endian double
+    double v = 0;
+    this->readArray(&v, 1);
+    return v;
 }
 
-std::string Data::readString()
+std::string DataView::readString()
 {
-    //store the string to return
-    std::string str;
     //get the number of elements in the string
     int len = this->readVarInt();
-    //get as many elements as they are in the string
-    for (int i = 0; i < len; i++)
-    {
-        //write the element to tthe string
-        str += this->readByte();
-    }
+    //an invalid length results in an empty string
+    if (len <= 0) { return std::string(); }
+    //get all characters at once
+    const uint8_t* chars = this->consume((size_t)len);
+    if (!chars) { return std::string(); }
     //return the finished string
-    return str;
+    return std::string((const char*)chars, (size_t)len);
 }
 // https://wiki.vg/Data_types#VarInt_and_VarLong
-int Data::readVarInt()
+int DataView::readVarInt()
 {
-    int value = 0;
+    uint32_t value = 0;
     int position = 0;
-    int8_t currentByte;
 
-    for (int i = 0; i < 8; i++)
+    while (true)
     {
-        currentByte = this->readByte();
-        value |= (currentByte & SEGMENT_BITS) << position;
+        //stop if no data is left
+        if (this->readPos >= this->viewSize)
+        {
+            //throw an error
+            GLGE_THROW_ERROR("The VarInt is cut off")
+            return 0;
+        }
+        uint8_t currentByte = this->view[this->readPos++];
+        value |= (uint32_t)(currentByte & SEGMENT_BITS) << position;
 
-        if ((currentByte & CONTINUE_BITS) == 0) return value;
+        if ((currentByte & CONTINUE_BITS) == 0) return (int)value;
 
         position += 7;
 
         if (position >= 32)
         {
-            std::__throw_runtime_error("VarInt is too big");
+            //throw an error, the data is invalid
+            GLGE_THROW_ERROR("The VarInt is too big")
+            return 0;
         }
     }
-
-    return value;
-
 }
-long Data::readVarLong()
+long DataView::readVarLong()
 {
-    long value = 0;
+    uint64_t value = 0;
     int position = 0;
-    int8_t currentByte;
 
-    for (int i = 0; i < 16; i++)
+    while (true)
     {
-        currentByte = this->readByte();
-        value |= (long) (currentByte & SEGMENT_BITS) << position;
+        //stop if no data is left
+        if (this->readPos >= this->viewSize)
+        {
+            //throw an error
+            GLGE_THROW_ERROR("The VarLong is cut off")
+            return 0;
+        }
+        uint8_t currentByte = this->view[this->readPos++];
+        value |= (uint64_t)(currentByte & SEGMENT_BITS) << position;
 
-        if ((currentByte & CONTINUE_BITS) == 0) return value;
+        if ((currentByte & CONTINUE_BITS) == 0) return (long)(int64_t)value;
 
         position += 7;
 
         if (position >= 64)
         {
-            std::__throw_runtime_error("VarLong is too big");
+            //throw an error, the data is invalid
+            GLGE_THROW_ERROR("The VarLong is too big")
+            return 0;
         }
     }
-
-    return value;
 }
-vec2 Data::readVec2()
+bool DataView::readVarInts(unsigned int* values, size_t count, bool delta)
 {
-    //read a float for the x value and one for the y value
-    return vec2(this->readFloat(), this->readFloat());
+    //decode the integers
+    size_t read = glgeDecodeVarInts(this->view + this->readPos, this->viewSize - this->readPos, (uint32_t*)values, count);
+    //check if the data was valid
+    if ((read == 0) && (count != 0))
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Failed to read " + std::to_string(count) + " varints, the data is invalid or to short")
+        return false;
+    }
+    //move the read position behind the integers
+    this->readPos += read;
+    //check if the differences were written
+    if (delta)
+    {
+        //undo the zigzag encoding and sum up the differences
+        uint32_t prev = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t z = values[i];
+            prev += (z >> 1) ^ (0u - (z & 1));
+            values[i] = prev;
+        }
+    }
+    return true;
+}
+std::vector<unsigned int> DataView::readVarIntArray(bool delta)
+{
+    //read the amount of integers
+    long count = this->readVarLong();
+    //every integer takes at least one byte, so the count can't be larger than the data
+    if ((count <= 0) || ((unsigned long)count > this->getLen())) { return std::vector<unsigned int>(); }
+    //read the integers
+    std::vector<unsigned int> values((size_t)count);
+    if (!this->readVarInts(values.data(), values.size(), delta)) { return std::vector<unsigned int>(); }
+    return values;
+}
+vec2 DataView::readVec2()
+{
+    //the components are stored from the last to the first
+    float v[2] = {0,0};
+    this->readArray(v, 2);
+    return vec2(v[1], v[0]);
 }
-vec3 Data::readVec3()
+vec3 DataView::readVec3()
 {
-    //read a float for the x value, one for the y value and one for the z value
-    return vec3(this->readFloat(), this->readFloat(), this->readFloat());
+    //the components are stored from the last to the first
+    float v[3] = {0,0,0};
+    this->readArray(v, 3);
+    return vec3(v[2], v[1], v[0]);
 }
-vec4 Data::readVec4()
+vec4 DataView::readVec4()
 {
-    //read a float for the x value, one for the y value, one for the z value and one for the w value
-    return vec4(this->readFloat(), this->readFloat(), this->readFloat(), this->readFloat());
+    //the components are stored from the last to the first
+    float v[4] = {0,0,0,0};
+    this->readArray(v, 4);
+    return vec4(v[3], v[2], v[1], v[0]);
 }
-mat2 Data::readMat2()
+mat2 DataView::readMat2()
 {
+    //read all elements at once
+    float v[4] = {0};
+    this->readArray(v, 4);
     //create a matrix
     mat2 a;
     //loop over the rows
@@ -490,15 +811,18 @@ mat2 Data::readMat2()
         //loop over every column
         for (int y = 0; y < 2; y++)
         {
-            //add a floa for the element
-            a.m[x][y] = this->readFloat();
+            //the elements are stored from the last to the first
+            a.m[(1-x)][(1-y)] = v[x*2 + y];
         }
     }
     //return the matrix
     return a;
 }
-mat3 Data::readMat3()
+mat3 DataView::readMat3()
 {
+    //read all elements at once
+    float v[9] = {0};
+    this->readArray(v, 9);
     //create a matrix
     mat3 a;
     //loop over the rows
@@ -507,15 +831,18 @@ mat3 Data::readMat3()
         //loop over every column
         for (int y = 0; y < 3; y++)
         {
-            //add a floa for the element
-            a.m[x][y] = this->readFloat();
+            //the elements are stored from the last to the first
+            a.m[(2-x)][(2-y)] = v[x*3 + y];
         }
     }
     //return the matrix
     return a;
 }
-mat4 Data::readMat4()
+mat4 DataView::readMat4()
 {
+    //read all elements at once
+    float v[16] = {0};
+    this->readArray(v, 16);
     //create a matrix
     mat4 a;
     //loop over the rows
@@ -524,34 +851,29 @@ mat4 Data::readMat4()
         //loop over every column
         for (int y = 0; y < 4; y++)
         {
-            //add a floa for the element
-            a.m[x][y] = this->readFloat();
+            //the elements are stored from the last to the first
+            a.m[(3-x)][(3-y)] = v[x*4 + y];
         }
     }
     //return the matrix
     return a;
 }
-Quaternion Data::readQuaternion()
+Quaternion DataView::readQuaternion()
 {
-    //read a float for the angle and a vector 3 for the position
-    return Quaternion(this->readFloat(), this->readVec3());
+    //the quaternion is stored as a vector 4 of w, x, y and z
+    vec4 v = this->readVec4();
+    return Quaternion(v.x, v.y, v.z, v.w);
 }
-uint8_t* Data::readBytes(size_t size)
+uint8_t* DataView::readBytes(size_t size)
 {
-    //safty check
-    if (size > this->data.size())
-    {
-        //throw an error
-        GLGE_THROW_ERROR("Cant read " + std::to_string(size) + " bytes from array of size " + std::to_string(this->data.size()))
-        //stop the function
-        return NULL;
-    }
+    //get the bytes, this checks the size
+    const uint8_t* bytes = this->consume(size);
+    //stop the function if the data is to short
+    if (!bytes) { return NULL; }
     //make an byte array with enough size
     uint8_t* dat = new uint8_t[size];
     //copy the data over
-    memcpy(dat, this->data.data(), size);
-    //delete the data from the own data
-    this->data.erase(this->data.begin(), this->data.begin()+size);
+    memcpy(dat, bytes, size);
     //return the data
     return dat;
 }
\ No newline at end of file
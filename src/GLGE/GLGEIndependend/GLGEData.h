@@ -17,23 +17,529 @@
 #include <string>
 #include "../CML/CML.h"
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+//check if the bytes of the host must be swapped to get big endian data
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+/**
+ * @brief say that the host stores numbers as big endian, the data can be copied without swapping
+ */
+#define GLGE_DATA_BIG_ENDIAN
+#endif
+
+/**
+ * @brief swap the byte order of an unsigned integer
+ * 
+ * @param v the integer to swap
+ * @return uint16_t the swapped integer
+ */
+inline uint16_t glgeByteSwap(uint16_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    //use the builtin, it compiles to a single instruction
+    return __builtin_bswap16(v);
+#else
+    //swap the bytes manualy
+    return (uint16_t)((v << 8) | (v >> 8));
+#endif
+}
+
+/**
+ * @brief swap the byte order of an unsigned integer
+ * 
+ * @param v the integer to swap
+ * @return uint32_t the swapped integer
+ */
+inline uint32_t glgeByteSwap(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    //use the builtin, it compiles to a single instruction
+    return __builtin_bswap32(v);
+#else
+    //swap the bytes manualy
+    return (v << 24) | ((v << 8) & 0x00FF0000u) | ((v >> 8) & 0x0000FF00u) | (v >> 24);
+#endif
+}
+
+/**
+ * @brief swap the byte order of an unsigned integer
+ * 
+ * @param v the integer to swap
+ * @return uint64_t the swapped integer
+ */
+inline uint64_t glgeByteSwap(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    //use the builtin, it compiles to a single instruction
+    return __builtin_bswap64(v);
+#else
+    //swap both halfs and exchange them
+    return ((uint64_t)glgeByteSwap((uint32_t)v) << 32) | glgeByteSwap((uint32_t)(v >> 32));
+#endif
+}
+
+/**
+ * @brief store numbers as big endian bytes
+ * 
+ * @tparam T the type of the numbers, must be an arithmetic type
+ * @param out the bytes to write to, must have space for count*sizeof(T) bytes
+ * @param values the numbers to store
+ * @param count the amount of numbers
+ */
+template<typename T> inline void glgeStoreBigEndian(void* out, const T* values, size_t count)
+{
+    //only numbers have a defined byte order
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be stored as big endian");
+#ifndef GLGE_DATA_BIG_ENDIAN
+    //check if the bytes must be swapped
+    if constexpr (sizeof(T) > 1)
+    {
+        //get the unsigned integer with the size of the type
+        typedef typename std::conditional<sizeof(T) == 2, uint16_t, typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type U;
+        static_assert(sizeof(U) == sizeof(T), "unsupported size of an arithmetic type");
+        //swap every number, the compiler vectorizes this loop
+        uint8_t* dst = (uint8_t*)out;
+        for (size_t i = 0; i < count; i++)
+        {
+            U v;
+            std::memcpy(&v, values + i, sizeof(U));
+            v = glgeByteSwap(v);
+            std::memcpy(dst + i*sizeof(U), &v, sizeof(U));
+        }
+        return;
+    }
+#endif
+    //the byte order already matches
+    if (count) { std::memcpy(out, values, count*sizeof(T)); }
+}
+
+/**
+ * @brief load numbers from big endian bytes
+ * 
+ * @tparam T the type of the numbers, must be an arithmetic type
+ * @param values the numbers to load to
+ * @param in the bytes to read, must contain count*sizeof(T) bytes
+ * @param count the amount of numbers
+ */
+template<typename T> inline void glgeLoadBigEndian(T* values, const void* in, size_t count)
+{
+    //only numbers have a defined byte order
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be loaded from big endian");
+#ifndef GLGE_DATA_BIG_ENDIAN
+    //check if the bytes must be swapped
+    if constexpr (sizeof(T) > 1)
+    {
+        //get the unsigned integer with the size of the type
+        typedef typename std::conditional<sizeof(T) == 2, uint16_t, typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type U;
+        static_assert(sizeof(U) == sizeof(T), "unsupported size of an arithmetic type");
+        //swap every number, the compiler vectorizes this loop
+        const uint8_t* src = (const uint8_t*)in;
+        for (size_t i = 0; i < count; i++)
+        {
+            U v;
+            std::memcpy(&v, src + i*sizeof(U), sizeof(U));
+            v = glgeByteSwap(v);
+            std::memcpy(values + i, &v, sizeof(U));
+        }
+        return;
+    }
+#endif
+    //the byte order already matches
+    if (count) { std::memcpy(values, in, count*sizeof(T)); }
+}
+
+/**
+ * @brief store numbers as little endian bytes, this is a plain copy on most hosts
+ * 
+ * @tparam T the type of the numbers, must be an arithmetic type
+ * @param out the bytes to write to, must have space for count*sizeof(T) bytes
+ * @param values the numbers to store
+ * @param count the amount of numbers
+ */
+template<typename T> inline void glgeStoreLittleEndian(void* out, const T* values, size_t count)
+{
+    //only numbers have a defined byte order
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be stored as little endian");
+#ifdef GLGE_DATA_BIG_ENDIAN
+    //check if the bytes must be swapped
+    if constexpr (sizeof(T) > 1)
+    {
+        //get the unsigned integer with the size of the type
+        typedef typename std::conditional<sizeof(T) == 2, uint16_t, typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type U;
+        static_assert(sizeof(U) == sizeof(T), "unsupported size of an arithmetic type");
+        //swap every number
+        uint8_t* dst = (uint8_t*)out;
+        for (size_t i = 0; i < count; i++)
+        {
+            U v;
+            std::memcpy(&v, values + i, sizeof(U));
+            v = glgeByteSwap(v);
+            std::memcpy(dst + i*sizeof(U), &v, sizeof(U));
+        }
+        return;
+    }
+#endif
+    //the byte order already matches
+    if (count) { std::memcpy(out, values, count*sizeof(T)); }
+}
+
+/**
+ * @brief load numbers from little endian bytes, this is a plain copy on most hosts
+ * 
+ * @tparam T the type of the numbers, must be an arithmetic type
+ * @param values the numbers to load to
+ * @param in the bytes to read, must contain count*sizeof(T) bytes
+ * @param count the amount of numbers
+ */
+template<typename T> inline void glgeLoadLittleEndian(T* values, const void* in, size_t count)
+{
+    //only numbers have a defined byte order
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be loaded from little endian");
+#ifdef GLGE_DATA_BIG_ENDIAN
+    //check if the bytes must be swapped
+    if constexpr (sizeof(T) > 1)
+    {
+        //get the unsigned integer with the size of the type
+        typedef typename std::conditional<sizeof(T) == 2, uint16_t, typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type U;
+        static_assert(sizeof(U) == sizeof(T), "unsupported size of an arithmetic type");
+        //swap every number
+        const uint8_t* src = (const uint8_t*)in;
+        for (size_t i = 0; i < count; i++)
+        {
+            U v;
+            std::memcpy(&v, src + i*sizeof(U), sizeof(U));
+            v = glgeByteSwap(v);
+            std::memcpy(values + i, &v, sizeof(U));
+        }
+        return;
+    }
+#endif
+    //the byte order already matches
+    if (count) { std::memcpy(values, in, count*sizeof(T)); }
+}
+
+/**
+ * @brief read data encoded by the Data class from memory that is not owned by the view, like a memory mapped file
+ */
+class DataView
+{
+protected:
+    /**
+     * @brief store a pointer to the viewed bytes
+     */
+    const uint8_t* view = NULL;
+    /**
+     * @brief store the amount of viewed bytes
+     */
+    size_t viewSize = 0;
+    /**
+     * @brief store the position of the first byte that was not read yet
+     */
+    size_t readPos = 0;
+
+    /**
+     * @brief read bytes from the view
+     * 
+     * @param size the amount of bytes to read
+     * @return const uint8_t* a pointer to the read bytes, NULL if not enough data is left
+     */
+    const uint8_t* consume(size_t size);
+public:
+    /**
+     * @brief Construct an empty view
+     */
+    DataView() {}
+    /**
+     * @brief Construct a view over some memory
+     * @warning the memory must stay valid while the view is used
+     * 
+     * @param data a pointer to the bytes to read
+     * @param size the amount of bytes
+     */
+    DataView(const void* data, size_t size) : view((const uint8_t*)data), viewSize(data ? size : 0) {}
+
+    /**
+     * @brief read a bool from the viewed data
+     * 
+     * @return bool the read bool
+     */
+    bool readBool();
+    /**
+     * @brief read a byte from the viewed data
+     * 
+     * @return int8_t the read byte
+     */
+    int8_t readByte();
+    /**
+     * @brief read an unsigned byte from the viewed data
+     * 
+     * @return unsigned int8_t the read unsigned byte
+     */
+    uint8_t readUByte();
+    /**
+     * @brief read a short integer from the viewed data
+     * 
+     * @return short the read short integer
+     */
+    short readShort();
+    /**
+     * @brief read an unsigned short integer from the viewed data
+     * 
+     * @return unsigned short the read unsigned short integer
+     */
+    unsigned short readUShort();
+    /**
+     * @brief read an integer from the viewed data
+     * 
+     * @return int the read integer
+     */
+    int readInt();
+    /**
+     * @brief read an unsigned integer from the viewed data
+     * 
+     * @return unsigned int the read unsigned integer
+     */
+    unsigned int readUInt();
+    /**
+     * @brief read a long integer from the viewed data
+     * 
+     * @return long the read long integer
+     */
+    long readLong();
+    /**
+     * @brief read an unsigned long integer from the viewed data
+     * 
+     * @return unsigned long the read unsigned long integer
+     */
+    unsigned long readULong();
+    /**
+     * @brief read a float from the viewed data
+     * 
+     * @return float the read float
+     */
+    float readFloat();
+    /**
+     * @brief read a double from the viewed data
+     * 
+     * @return double the read double
+     */
+    double readDouble();
+    /**
+     * @brief read a string from the viewed data
+     * 
+     * @return std::string the read string
+     */
+    std::string readString();
+    /**
+     * @brief read an integer where some storage space was saved from the data
+     * 
+     * @return int the read integer
+     */
+    int readVarInt();
+    /**
+     * @brief read a long integer where some storage space was saved from the data
+     * 
+     * @return long the read long integer
+     */
+    long readVarLong();
+    /**
+     * @brief read a vector 2 from the viewed data
+     * 
+     * @return vec2 the read vector 2
+     */
+    vec2 readVec2();
+    /**
+     * @brief read a vector 3 from the viewed data
+     * 
+     * @return vec3 the read vector 3
+     */
+    vec3 readVec3();
+    /**
+     * @brief read a vector 4 from the viewed data
+     * 
+     * @return vec4 the read vector 4
+     */
+    vec4 readVec4();
+    /**
+     * @brief read a 2 by 2 matrix from the viewed data
+     * 
+     * @return mat2 the read 2 by 2 matrix
+     */
+    mat2 readMat2();
+    /**
+     * @brief read a 3 by 3 matrix from the viewed data
+     * 
+     * @return mat3 the read 3 by 3 matrix
+     */
+    mat3 readMat3();
+    /**
+     * @brief read a 4 by 4 matrix from the viewed data
+     * 
+     * @return mat4 the read 4 by 4 matrix
+     */
+    mat4 readMat4();
+    /**
+     * @brief read a quaternion from the viewed data
+     * 
+     * @return Quaternion the read quaternion
+     */
+    Quaternion readQuaternion();
+    /**
+     * @brief read an abituary amount of data
+     * 
+     * @param size the size of the data to read
+     * @return uint8_t* the read data
+     */
+    uint8_t* readBytes(size_t size);
+    /**
+     * @brief read an array of numbers in one pass
+     * 
+     * @tparam T the type of the numbers, must be an arithmetic type
+     * @param values the array to fill
+     * @param count the amount of numbers to read
+     * @return true : the numbers were read | false : not enough data is left, nothing was read
+     */
+    template<typename T> bool readArray(T* values, size_t count)
+    {
+        //check that the size dosn't overflow
+        if (count > (SIZE_MAX / sizeof(T))) { return false; }
+        //an empty array is always read, even from an empty view
+        if (count == 0) { return true; }
+        //get the bytes of all numbers
+        const uint8_t* in = this->consume(count*sizeof(T));
+        if (!in) { return false; }
+        //convert the numbers
+        glgeLoadBigEndian(values, in, count);
+        return true;
+    }
+    /**
+     * @brief read an array of numbers written by Data::writeLittleEndianArray
+     * 
+     * @tparam T the type of the numbers, must be an arithmetic type
+     * @param values the array to fill
+     * @param count the amount of numbers to read
+     * @return true : the numbers were read | false : not enough data is left, nothing was read
+     */
+    template<typename T> bool readLittleEndianArray(T* values, size_t count)
+    {
+        //check that the size dosn't overflow
+        if (count > (SIZE_MAX / sizeof(T))) { return false; }
+        //an empty array is always read, even from an empty view
+        if (count == 0) { return true; }
+        //get the bytes of all numbers
+        const uint8_t* in = this->consume(count*sizeof(T));
+        if (!in) { return false; }
+        //copy the numbers
+        glgeLoadLittleEndian(values, in, count);
+        return true;
+    }
+    /**
+     * @brief read a vector written by writeArray(const std::vector<T>&)
+     * 
+     * @tparam T the type of the numbers, must be an arithmetic type
+     * @return std::vector<T> the read vector, empty if the data is invalid
+     */
+    template<typename T> std::vector<T> readArray()
+    {
+        //read the amount of elements
+        unsigned long count = this->readULong();
+        //check that enough data is left before allocating the vector
+        if (count > (this->getLen() / sizeof(T))) { return std::vector<T>(); }
+        //read all elements
+        std::vector<T> values(count);
+        this->readArray(values.data(), values.size());
+        return values;
+    }
+
+    /**
+     * @brief read an array of integers written by Data::writeVarIntArray
+     * 
+     * @param delta true : the array was written as zigzag encoded differences | false : every integer was written on its own
+     * @return std::vector<unsigned int> the read integers, empty if the data is invalid
+     */
+    std::vector<unsigned int> readVarIntArray(bool delta = false);
+    /**
+     * @brief read integers written by Data::writeVarInts into existing memory
+     * 
+     * @param values the array to fill
+     * @param count the amount of integers to read
+     * @param delta true : the integers were written as zigzag encoded differences | false : every integer was written on its own
+     * @return true : all integers were read | false : the data is invalid or to short
+     */
+    bool readVarInts(unsigned int* values, size_t count, bool delta = false);
+
+    /**
+     * @brief read an abituary amount of data into existing memory
+     * 
+     * @param out the memory to copy the data to
+     * @param size the size of the data to read
+     * @return true : the data was read | false : not enough data is left, nothing was read
+     */
+    bool readBytes(void* out, size_t size);
+    /**
+     * @brief skip some bytes
+     * 
+     * @param size the amount of bytes to skip
+     * @return true : the bytes were skipped | false : not enough data is left
+     */
+    bool skip(size_t size);
+
+    /**
+     * @brief Get a pointer to the first byte that was not read yet
+     * 
+     * @return const uint8_t* a pointer into the viewed memory
+     */
+    const uint8_t* getReadPointer() const { return this->view + this->readPos; }
+    /**
+     * @brief Get the amount of bytes that were not read yet
+     * 
+     * @return size_t the amount of remaining bytes
+     */
+    size_t getLen() const { return this->viewSize - this->readPos; }
+};
 
 /**
  * @brief store a lot of data in an single vector
- * @warning using a read function will delete it in the stored data
+ * @warning read functions only advance the read position, the read bytes stay in the vector, but getData and getLen only cover the bytes that were not read yet
  */
-class Data
+class Data : public DataView
 {
 private:
     /**
      * @brief store the encoded data in an vector
      */
     std::vector<int8_t> data;
+
+    /**
+     * @brief append bytes to the data
+     * 
+     * @param size the amount of bytes to append
+     * @return uint8_t* a pointer to the appended bytes, valid until the next write
+     */
+    uint8_t* grow(size_t size);
+    /**
+     * @brief point the view of the base class to the own data, must be called after the vector changed
+     */
+    void sync();
 public:
     /**
      * @brief Construct a new class to the data
      */
     Data();
+    /**
+     * @brief Copy the data and the read position of another instance
+     * 
+     * @param other the data to copy
+     */
+    Data(const Data& other);
+    /**
+     * @brief Copy the data and the read position of another instance
+     * 
+     * @param other the data to copy
+     * @return Data& a reference to this instance
+     */
+    Data& operator=(const Data& other);
     /**
      * @brief Destroy the class instance
      */
@@ -172,153 +678,79 @@ public:
      * @param size the size of the data
      */
     void writeBytes(uint8_t* data, size_t size);
-
-    /**
-     * @brief read a bool from the stored data
-     * 
-     * @return bool the read bool
-     */
-    bool readBool();
     /**
-     * @brief read a byte from the stored data
+     * @brief write an array of numbers in one pass, every number is stored like the single write functions store it
      * 
-     * @return int8_t the read byte
+     * @tparam T the type of the numbers, must be an arithmetic type
+     * @param values the numbers to write
+     * @param count the amount of numbers
      */
-    int8_t readByte();
+    template<typename T> void writeArray(const T* values, size_t count)
+    {
+        //convert all numbers directly into the data
+        glgeStoreBigEndian(this->grow(count*sizeof(T)), values, count);
+    }
     /**
-     * @brief read an unsigned byte from the stored data
+     * @brief write an array of numbers as little endian bytes without a length, on little endian hosts this is a single copy
      * 
-     * @return unsigned int8_t the read unsigned byte
+     * @tparam T the type of the numbers, must be an arithmetic type
+     * @param values the numbers to write
+     * @param count the amount of numbers
      */
-    uint8_t readUByte();
+    template<typename T> void writeLittleEndianArray(const T* values, size_t count)
+    {
+        //copy all numbers directly into the data
+        glgeStoreLittleEndian(this->grow(count*sizeof(T)), values, count);
+    }
     /**
-     * @brief read a short integer from the stored data
+     * @brief write the length of a vector and all of its elements
      * 
-     * @return short the read short integer
+     * @tparam T the type of the numbers, must be an arithmetic type
+     * @param values the vector to write
      */
-    short readShort();
+    template<typename T> void writeArray(const std::vector<T>& values)
+    {
+        //write the amount of elements
+        this->writeULong(values.size());
+        //write all elements
+        this->writeArray(values.data(), values.size());
+    }
     /**
-     * @brief read an unsigned short integer from the stored data
+     * @brief write integers like writeVarInt without a length, small values are encoded 16 at a time
      * 
-     * @return unsigned short the read unsigned short integer
+     * @param values the integers to write
+     * @param count the amount of integers
+     * @param delta true : write the zigzag encoded difference to the previous integer, this keeps sorted or local data small | false : write every integer on its own
      */
-    unsigned short readUShort();
+    void writeVarInts(const unsigned int* values, size_t count, bool delta = false);
     /**
-     * @brief read an integer from the stored data
+     * @brief write the length of an array and all of its integers like writeVarInt
      * 
-     * @return int the read integer
+     * @param values the integers to write
+     * @param count the amount of integers
+     * @param delta true : write the zigzag encoded difference to the previous integer, this keeps sorted or local data small | false : write every integer on its own
      */
-    int readInt();
+    void writeVarIntArray(const unsigned int* values, size_t count, bool delta = false);
     /**
-     * @brief read an unsigned integer from the stored data
+     * @brief write the length of a vector and all of its integers like writeVarInt
      * 
-     * @return unsigned int the read unsigned integer
+     * @param values the integers to write
+     * @param delta true : write the zigzag encoded difference to the previous integer, this keeps sorted or local data small | false : write every integer on its own
      */
-    unsigned int readUInt();
+    void writeVarIntArray(const std::vector<unsigned int>& values, bool delta = false);
     /**
-     * @brief read a long integer from the stored data
+     * @brief reserve space for data that will be written, so the data is not reallocated
      * 
-     * @return long the read long integer
+     * @param size the amount of bytes that will be written
      */
-    long readLong();
-    /**
-     * @brief read an unsigned long integer from the stored data
-     * 
-     * @return unsigned long the read unsigned long integer
-     */
-    unsigned long readULong();
-    /**
-     * @brief read a float from the stored data
-     * 
-     * @return float the read float
-     */
-    float readFloat();
-    /**
-     * @brief read a double from the store data
-     * 
-     * @return double the read double
-     */
-    double readDouble();
-    /**
-     * @brief read a string from the stored data
-     * 
-     * @return std::string the read string
-     */
-    std::string readString();
-    /**
-     * @brief read an integer where some storage space was saved from the data
-     * 
-     * @return int the read integer
-     */
-    int readVarInt();
-    /**
-     * @brief read a long integer where some storage space was saved from the data
-     * 
-     * @return long the read long integer
-     */
-    long readVarLong();
-    /**
-     * @brief read a vector 2 from the stored data
-     * 
-     * @return vec2 the read vector 2
-     */
-    vec2 readVec2();
-    /**
-     * @brief read a vector 3 from the stored data
-     * 
-     * @return vec3 the read vector 3
-     */
-    vec3 readVec3();
-    /**
-     * @brief read a vector 4 from the stored data
-     * 
-     * @return vec4 the read vector 4
-     */
-    vec4 readVec4();
-    /**
-     * @brief read a 2 by 2 matrix from the stored data
-     * 
-     * @return mat2 the read 2 by 2 matrix
-     */
-    mat2 readMat2();
-    /**
-     * @brief read a 3 by 3 matrix from the stored data
-     * 
-     * @return mat3 the read 3 by 3 matrix
-     */
-    mat3 readMat3();
-    /**
-     * @brief read a 4 by 4 matrix from the stored data
-     * 
-     * @return mat4 the read 4 by 4 matrix
-     */
-    mat4 readMat4();
-    /**
-     * @brief read a quaternion from the stored data
-     * 
-     * @return Quaternion the read quaternion
-     */
-    Quaternion readQuaternion();
-    /**
-     * @brief read an abituary amount of data
-     * 
-     * @param size the size of the data to read
-     * @return uint8_t* the read data
-     */
-    uint8_t* readBytes(size_t size);
+    void reserve(size_t size);
 
     /**
-     * @brief Get the raw data
+     * @brief Get the raw data that was not read yet
      * 
      * @return int8_t* a pointer to the raw data
      */
     int8_t* getData();
-    /**
-     * @brief Get the amount of stored data in bytes
-     * 
-     * @return size_t the amount of stored data in bytes
-     */
-    size_t getLen();
     /**
      * @brief Set the raw data for this object
      * 
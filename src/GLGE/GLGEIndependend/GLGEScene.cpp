@@ -12,6 +12,276 @@
 #include "GLGEScene.hpp"
 #include "glgePrivDefines.hpp"
 #include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <functional>
+//include the memory mapping
+#if defined(_WIN32)
+#define GLGE_SCENE_NO_MMAP
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//the magic bytes at the start of every scene file
+static const char glgeSceneMagic[9] = {'G','L','G','E','S','c','e','n','e'};
+
+/**
+ * @brief the size of the header of a scene file of version 2: the magic bytes, the version, a reserved integer, the amount of records and the offset of the name block
+ */
+#define GLGE_SCENE_HEADER_SIZE 32
+
+struct SceneFile
+{
+    //store the mapped file
+    const uint8_t* mapping = NULL;
+    //store the size of the file
+    size_t size = 0;
+    //say if the file was read into the heap
+    bool heap = false;
+
+    ~SceneFile()
+    {
+        //check if a file is mapped
+        if (!this->mapping) { return; }
+#ifndef GLGE_SCENE_NO_MMAP
+        //unmap the file
+        if (!this->heap) { munmap((void*)this->mapping, this->size); return; }
+#endif
+        //free the heap copy
+        delete[] this->mapping;
+    }
+};
+
+/**
+ * @brief map a scene file
+ * 
+ * @param path the path to the file
+ * @return std::shared_ptr<SceneFile> the mapped file, empty if the file can't be opened
+ */
+static std::shared_ptr<SceneFile> glgeMapSceneFile(const std::string& path)
+{
+    //create the file
+    std::shared_ptr<SceneFile> file = std::make_shared<SceneFile>();
+#ifdef GLGE_SCENE_NO_MMAP
+    //read the whole file into the heap
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) { return NULL; }
+    std::streamsize fileSize = in.tellg();
+    if (fileSize <= 0) { return NULL; }
+    uint8_t* buffer = new uint8_t[(size_t)fileSize];
+    in.seekg(0);
+    in.read((char*)buffer, fileSize);
+    if (!in) { delete[] buffer; return NULL; }
+    file->mapping = buffer;
+    file->size = (size_t)fileSize;
+    file->heap = true;
+#else
+    //open the file
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return NULL; }
+    //get the size of the file
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0)) { close(fd); return NULL; }
+    //map the file, the file descriptor is not needed after mapping
+    void* mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) { return NULL; }
+    file->mapping = (const uint8_t*)mapping;
+    file->size = (size_t)fileStat.st_size;
+#endif
+    //return the mapped file
+    return file;
+}
+
+/**
+ * @brief hash the name of an object with FNV-1a
+ * 
+ * @param name the name to hash
+ * @return uint64_t the hash
+ */
+static uint64_t glgeHashSceneName(const std::string& name)
+{
+    //combine all characters
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : name) { hash = (hash ^ (uint8_t)c) * 1099511628211ull; }
+    return hash;
+}
+
+/**
+ * @brief hash the data of an object to detect changes
+ * 
+ * @param data the data to hash
+ * @param size the size of the data in bytes
+ * @return uint64_t the hash
+ */
+static uint64_t glgeHashSceneData(const uint8_t* data, size_t size)
+{
+    //start with the size, so data that only differs in trailing zeros has a different hash
+    uint64_t hash = 14695981039346656037ull ^ (uint64_t)size;
+    //mix in 8 bytes at once
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    //mix in the remaining bytes
+    for (; i < size; i++) { hash = (hash ^ data[i]) * 1099511628211ull; }
+    return hash;
+}
+
+/**
+ * @brief compress the data of an object if it is large enough and gets smaller
+ * 
+ * @param data the data of the object
+ * @param size the size of the data in bytes
+ * @param mode the compression mode
+ * @param threshold the minimum size to compress
+ * @param packed the uncompressed size followed by the compressed data, empty if the data is not compressed
+ * @return uint8_t the flags of the record, 0 if the data is not compressed
+ */
+static uint8_t glgePackSceneData(const uint8_t* data, uint64_t size, uint8_t mode, uint64_t threshold, std::vector<uint8_t>& packed)
+{
+    //check if the data should be compressed
+    packed.clear();
+    if ((mode == GLGE_COMPRESSION_NONE) || (size < threshold)) { return 0; }
+    //compress the data behind the uncompressed size
+    packed.resize(sizeof(uint64_t) + glgeCompressBound(size));
+    std::memcpy(packed.data(), &size, sizeof(size));
+    size_t packedSize = sizeof(uint64_t) + glgeCompress(data, size, packed.data() + sizeof(uint64_t), mode);
+    //only use the compressed data if it is smaller
+    if (packedSize >= size) { std::vector<uint8_t>().swap(packed); return 0; }
+    packed.resize(packedSize);
+    return GLGE_SCENE_FLAG_COMPRESSED | ((mode == GLGE_COMPRESSION_HIGH) ? GLGE_SCENE_FLAG_COMPRESSED_HIGH : 0);
+}
+
+/**
+ * @brief check that compressed object data starts with a plausible uncompressed size
+ * 
+ * @param data the compressed data
+ * @param length the size of the compressed data
+ * @return true : the size is valid | false : the data is invalid
+ */
+static bool glgeCheckPackedSceneData(const uint8_t* data, uint64_t length)
+{
+    //the data starts with the uncompressed size
+    if (length < sizeof(uint64_t)) { return false; }
+    uint64_t rawSize = 0;
+    std::memcpy(&rawSize, data, sizeof(rawSize));
+    //the data can't grow by more than 255 times
+    return rawSize <= (length - sizeof(uint64_t)) * 255;
+}
+
+//the magic bytes at the start of every change log
+static const char glgeSceneChangesMagic[12] = {'G','L','G','E','C','h','a','n','g','e','0','1'};
+
+/**
+ * @brief the change log entry sets an object
+ */
+#define GLGE_SCENE_CHANGE_SET 1
+/**
+ * @brief the change log entry removes an object
+ */
+#define GLGE_SCENE_CHANGE_REMOVE 2
+/**
+ * @brief the size of the header of a change log entry: the type, the flags, the length of the name, a reserved integer and the length of the data
+ */
+#define GLGE_SCENE_CHANGE_HEADER_SIZE 16
+
+struct SceneLoad
+{
+    //store the thread that loads the scene
+    std::thread thread;
+    //store the scene the file is loaded into, it is only accessed by the thread until the load is done
+    Scene* scene = NULL;
+    //say if the load is done
+    std::atomic<bool> done{false};
+    //say if the file couldn't be loaded, the scene is then not applied
+    std::atomic<bool> failed{false};
+    //store an error that was thrown while loading, it is raised again on the thread that finishes the load
+    std::exception_ptr error;
+    //store the amount of objects that are created
+    std::atomic<uint64_t> created{0};
+    //store the amount of objects to create
+    std::atomic<uint64_t> total{0};
+
+    ~SceneLoad()
+    {
+        //wait for the thread
+        if (this->thread.joinable()) { this->thread.join(); }
+        //delete the scene that was not applied
+        delete this->scene;
+    }
+};
+
+/**
+ * @brief the minimum amount of bytes a thread should process when objects are compressed or decompressed in parallel
+ */
+#define GLGE_SCENE_BYTES_PER_THREAD (256*1024)
+
+/**
+ * @brief run a function for a range of indices on all available cores
+ * 
+ * @param count the amount of indices
+ * @param bytes the amount of bytes that are processed, small jobs are run on the calling thread
+ * @param func the function to run for every index, it is called from multiple threads at once, the first exception it throws is rethrown after all threads are joined
+ */
+static void glgeSceneParallelFor(size_t count, uint64_t bytes, const std::function<void(size_t)>& func)
+{
+    //calculate how many threads are worth starting
+    size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), count);
+    threadCount = std::min<size_t>(threadCount, std::max<uint64_t>(1, bytes / GLGE_SCENE_BYTES_PER_THREAD));
+    if (threadCount <= 1)
+    {
+        //run everything on the calling thread
+        for (size_t i = 0; i < count; i++) { func(i); }
+        return;
+    }
+    //the threads take the next index when they are done, so large objects don't stall the other threads
+    std::atomic<size_t> next(0);
+    //store the first error, it can't leave a thread and is raised after all threads are joined
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]()
+    {
+        try { for (size_t i = next++; i < count; i = next++) { func(i); } }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) { error = std::current_exception(); }
+            //stop the other threads
+            next = count;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < threadCount; t++) { threads.emplace_back(worker); }
+    //the calling thread works too
+    worker();
+    for (std::thread& t : threads) { t.join(); }
+    //raise the error on the calling thread
+    if (error) { std::rethrow_exception(error); }
+}
+
+/**
+ * @brief round a size up to the alignment of the object data
+ * 
+ * @param size the size to round up
+ * @return uint64_t the aligned size
+ */
+static inline uint64_t glgeAlignScene(uint64_t size)
+{
+    //round up to the next multiple
+    return (size + GLGE_SCENE_ALIGNMENT - 1) / GLGE_SCENE_ALIGNMENT * GLGE_SCENE_ALIGNMENT;
+}
 
 NamedObject::NamedObject()
 {
@@ -24,6 +294,16 @@ NamedObject::NamedObject(std::string name)
     this->name = name;
 }
 
+NamedObject::NamedObject(std::string name, std::shared_ptr<SceneFile> file, const uint8_t* data, size_t size)
+{
+    //store the name
+    this->name = name;
+    //view the data inside of the file
+    this->file = file;
+    this->view = data;
+    this->viewSize = size;
+}
+
 NamedObject::~NamedObject()
 {
     //clear the data
@@ -33,27 +313,86 @@ NamedObject::~NamedObject()
 
 std::vector<uint8_t>* NamedObject::getData()
 {
+    //check if the data is viewed in a scene file
+    if (this->view)
+    {
+        //copy the data, it may be changed through the vector
+        this->objData.assign(this->view, this->view + this->viewSize);
+        //stop viewing the file
+        this->detachView();
+    }
     //return the object's data
     return &this->objData;
 }
 
+void NamedObject::detachView()
+{
+    //check if the data is viewed in a scene file
+    if (!this->view) { return; }
+    //the viewed data is the data that is stored in the file
+    this->savedHash = glgeHashSceneData(this->view, this->viewSize);
+    this->saved = true;
+    //stop viewing the file
+    this->view = NULL;
+    this->viewSize = 0;
+    this->file.reset();
+}
+
+uint64_t NamedObject::getHash()
+{
+    //hash the current data
+    size_t size = 0;
+    const uint8_t* bytes = this->getBytes(&size);
+    return glgeHashSceneData(bytes, size);
+}
+
+bool NamedObject::isDirty()
+{
+    //viewed data can't be changed
+    if (this->view) { return false; }
+    //compare the data to the stored data
+    return !this->saved || (this->getHash() != this->savedHash);
+}
+
+void NamedObject::markSaved()
+{
+    //viewed data is always stored
+    if (this->view) { return; }
+    //remember the hash of the current data
+    this->savedHash = this->getHash();
+    this->saved = true;
+}
+
+const uint8_t* NamedObject::getBytes(size_t* size)
+{
+    //check if the data is viewed in a scene file
+    if (this->view)
+    {
+        //return the viewed data
+        *size = this->viewSize;
+        return this->view;
+    }
+    //return the own data
+    *size = this->objData.size();
+    return this->objData.data();
+}
+
 std::string NamedObject::getTypeName()
 {
+    //get the data
+    size_t size = 0;
+    const uint8_t* bytes = this->getBytes(&size);
     //read the name of the data type
     std::string t = "";
     //store the current read position, begin after the size
-    int i = sizeof(uint64_t)/sizeof(char);
-    //store the current char
-    char curr = this->objData[i];
-    //loop unitll a 0-byte is hit
-    while (curr != 0x00)
+    size_t i = sizeof(uint64_t)/sizeof(char);
+    //loop unitll a 0-byte or the end of the data is hit
+    while ((i < size) && (bytes[i] != 0x00))
     {
         //store the current element
-        t += curr;
+        t += (char)bytes[i];
         //increase the read position
         i++;
-        //read the new character
-        curr = this->objData[i];
     }
     //return the type name
     return t;
@@ -61,6 +400,8 @@ std::string NamedObject::getTypeName()
 
 void NamedObject::handleInputData(Data* data, std::string type)
 {
+    //the new data replaces data viewed in a scene file
+    this->detachView();
     //get the size of the data to store
     uint64_t size = data->getLen() + type.length() + sizeof(uint64_t);
     //malloc enough size to the own data pointer
@@ -77,57 +418,46 @@ void NamedObject::handleInputData(Data* data, std::string type)
     std::memcpy(((uint8_t*)(((uint64_t*)this->objData.data())+1)) + type.length() + 1, data->getData(), data->getLen());
 }
 
-Data NamedObject::getOutputData(std::string type)
+DataView NamedObject::getOutputData(std::string type)
 {
-    //read the size of the data
-    uint64_t size = *((uint64_t*)this->objData.data());
-    //read the name of the data type
-    std::string t = "";
-    //store the current read position, begin after the size
-    int i = sizeof(uint64_t)/sizeof(char);
-    //store the current char
-    char curr = this->objData[i];
-    //loop unitll a 0-byte is hit
-    while (curr != 0x00)
+    //get the data
+    size_t bytesSize = 0;
+    const uint8_t* bytes = this->getBytes(&bytesSize);
+    //check that the size can be read
+    if (bytesSize < sizeof(uint64_t))
     {
-        //store the current element
-        t += curr;
-        //increase the read position
-        i++;
-        //read the new character
-        curr = this->objData[i];
+        //throw an error
+        GLGE_THROW_ERROR("The object " + this->name + " contains no data")
+        return DataView();
     }
+    //read the size of the data
+    uint64_t size = 0;
+    std::memcpy(&size, bytes, sizeof(size));
+    //read the name of the data type
+    std::string t = this->getTypeName();
+    //store the read position after the name
+    size_t i = sizeof(uint64_t)/sizeof(char) + t.length();
     //check if the inputed type is not the stored type
     if (type != t)
     {
         //throw an error
         GLGE_THROW_ERROR("Trying to decode object of type \'" + t + "\' as type \'" + type + "\'");
-        return Data();
+        return DataView();
     }
-    //calculate the size of the remaining data
-    long remain = size - i;
-    //check if data remains
-    if (remain < 1)
+    //check if data remains, the stored size is not trusted and compared without a sign
+    if (size <= i)
     {
-        //if not, return a new object instance
-        return Data();
+        //if not, return an empty view
+        return DataView();
     }
-    //create a void* to store the data
-    void* data = malloc(remain);
-    //test if malloc was successfull
-    if (!data)
-    {
-        //throw an error
-        GLGE_THROW_ERROR("malloc failed, is enough ram free?")
-    }
-    //copy the data into the new pointer
-    std::memcpy(data, (int8_t*)((uint64_t*)this->objData.data() + 1) + type.length() + 1, remain);
-    //create a data structure
-    Data dat;
-    //fill the data
-    dat.setData((int8_t*)data, remain);
-    //return the data
-    return dat;
+    //calculate the size of the remaining data
+    uint64_t remain = size - i;
+    //the data starts after the 0-byte of the name and can't be larger than the stored data
+    size_t start = i + 1;
+    if (start > bytesSize) { return DataView(); }
+    size_t length = (size_t)std::min<uint64_t>(remain, bytesSize - start);
+    //view the data directly inside of the object, decoding never copies the payload
+    return DataView(bytes + start, length);
 }
 
 Scene::Scene()
@@ -149,6 +479,8 @@ Scene::Scene(const char* sceneFile)
 
 Scene::~Scene()
 {
+    //wait for a load in the background
+    this->loading.reset();
     //clear the objects
     this->objs.clear();
 }
@@ -162,80 +494,381 @@ void Scene::storeObjects(std::vector<NamedObject*> objs)
         std::string name = obj->name;
         //store the object in a new position in the map
         this->objs[name] = obj;
+        //the object may view data of another scene, so it is stored with the next changes
+        this->pendingSets.insert(name);
     }
 }
 
 void Scene::safeFile()
 {
-    //create a new file
-    std::fstream file;
-    //open a file
-    file.open((this->name + ".glges").c_str(), std::fstream::binary | std::fstream::out);
-    //check if the file is open
-    if (!file.is_open())
+    //store the data of an object that is written to the file
+    struct Entry { std::string name; const uint8_t* data; uint64_t size; uint8_t flags; std::vector<uint8_t> packed; };
+    std::vector<Entry> entries;
+    //collect the objects that are stored in the scene
+    std::unordered_map<std::string, NamedObject*>::iterator it;
+    for (it = this->objs.begin(); it != this->objs.end(); ++it)
+    {
+        //skip missing objects
+        if (!it->second) { continue; }
+        //check if the name is short enough
+        if (it->first.size() > UINT16_MAX)
+        {
+            //throw an error
+            GLGE_THROW_ERROR("The name " + it->first + " is too long to be stored in an scene file")
+            continue;
+        }
+        //get the data without copying it
+        size_t size = 0;
+        const uint8_t* data = it->second->getBytes(&size);
+        entries.push_back(Entry{it->first, data, (uint64_t)size, 0, {}});
+    }
+    //store the entries that should be compressed
+    std::vector<size_t> pack;
+    uint64_t packBytes = 0;
+    if (this->compression != GLGE_COMPRESSION_NONE)
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].size < this->compressionThreshold) { continue; }
+            pack.push_back(i);
+            packBytes += entries[i].size;
+        }
+    }
+    //compress the objects in parallel, every entry is only accessed by one thread
+    uint8_t mode = this->compression;
+    uint64_t threshold = this->compressionThreshold;
+    glgeSceneParallelFor(pack.size(), packBytes, [&](size_t i)
+    {
+        //compress the data
+        Entry& entry = entries[pack[i]];
+        entry.flags = glgePackSceneData(entry.data, entry.size, mode, threshold, entry.packed);
+        if (!entry.flags) { return; }
+        //use the compressed data
+        entry.data = entry.packed.data();
+        entry.size = entry.packed.size();
+    });
+    //collect the objects of the mapped file that were never accessed
+    for (const SceneRecord& record : this->records)
+    {
+        //get the name of the object
+        std::string name = this->getRecordName(record);
+        //skip objects that were accessed, replaced or removed
+        if (this->objs.count(name) || this->removed.count(name)) { continue; }
+        //the data is copied as it is stored, compressed data is not compressed again
+        entries.push_back(Entry{name, this->file->mapping + record.offset, record.length, record.flags, {}});
+    }
+
+    //create the table of contents, sorted by the name hash
+    std::vector<SceneRecord> toc(entries.size());
+    std::vector<size_t> order(entries.size());
+    uint64_t namesSize = 0;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        //fill the entry, the offset is set after sorting
+        toc[i].nameHash = glgeHashSceneName(entries[i].name);
+        toc[i].length = entries[i].size;
+        toc[i].nameOffset = (uint32_t)namesSize;
+        toc[i].nameLength = (uint16_t)entries[i].name.size();
+        toc[i].type = 0;
+        toc[i].flags = entries[i].flags;
+        namesSize += entries[i].name.size();
+        order[i] = i;
+    }
+    //sort the entries by the hash and then by the name, so the order is the same on every save
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+    {
+        if (toc[a].nameHash != toc[b].nameHash) { return toc[a].nameHash < toc[b].nameHash; }
+        return entries[a].name < entries[b].name;
+    });
+    //calculate the offsets of the object data, they follow the name block
+    uint64_t namesOffset = GLGE_SCENE_HEADER_SIZE + entries.size()*sizeof(SceneRecord);
+    uint64_t offset = glgeAlignScene(namesOffset + namesSize);
+    std::vector<SceneRecord> sorted(entries.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        //store the entry at its sorted position
+        sorted[i] = toc[order[i]];
+        sorted[i].offset = offset;
+        offset = glgeAlignScene(offset + sorted[i].length);
+    }
+
+    //write to a temporary file first, the old file may still be mapped
+    std::string path = this->name + ".glges";
+    std::string tmpPath = path + ".tmp";
+    {
+        //create a new file
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        //check if the file is open
+        if (!file.is_open())
+        {
+            //throw an error
+            GLGE_THROW_ERROR("Cound't create scene file")
+            //stop the function
+            return;
+        }
+        //write the header
+        uint8_t header[GLGE_SCENE_HEADER_SIZE] = {0};
+        std::memcpy(header, glgeSceneMagic, 9);
+        std::memcpy(header + 9, "002", 3);
+        uint64_t count = entries.size();
+        std::memcpy(header + 16, &count, sizeof(count));
+        std::memcpy(header + 24, &namesOffset, sizeof(namesOffset));
+        file.write((const char*)header, sizeof(header));
+        //write the table of contents
+        file.write((const char*)sorted.data(), sorted.size()*sizeof(SceneRecord));
+        //write the names in the order of the unsorted table, which stores the name offsets
+        for (const Entry& entry : entries) { file.write(entry.name.data(), entry.name.size()); }
+        //write the object data
+        static const char padding[GLGE_SCENE_ALIGNMENT] = {0};
+        uint64_t pos = namesOffset + namesSize;
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            //pad to the aligned start
+            file.write(padding, sorted[i].offset - pos);
+            //write the data
+            file.write((const char*)entries[order[i]].data, entries[order[i]].size);
+            pos = sorted[i].offset + sorted[i].length;
+        }
+        //check if everything was written
+        if (!file)
+        {
+            //throw an error
+            GLGE_THROW_ERROR("Failed to write the scene file " + path)
+            file.close();
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+    //replace the old file, mapped views of the old file stay valid
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
     {
         //throw an error
-        GLGE_THROW_ERROR("Cound't create scene file")
-        //stop the function
+        GLGE_THROW_ERROR("Failed to replace the scene file " + path)
+        std::remove(tmpPath.c_str());
         return;
     }
-    //clear the file
-    file.clear();
+    //the new file contains all changes, so the change log isn't needed anymore
+    std::remove((path + GLGE_SCENE_CHANGES_ENDING).c_str());
+    this->changesSize = 0;
+    this->compactChanges = false;
+    this->removed.clear();
+    this->pendingRemovals.clear();
+    this->pendingSets.clear();
+    //all objects are now stored
+    for (it = this->objs.begin(); it != this->objs.end(); ++it)
+    {
+        if (it->second) { it->second->markSaved(); }
+    }
+    //map the new file, objects that were never accessed are read from it
+    std::shared_ptr<SceneFile> written = glgeMapSceneFile(path);
+    if (written && this->readTableOfContents(written))
+    {
+        this->onDisk = true;
+        this->fileSize = written->size;
+    }
+}
 
-    //specify that this is a GLGE file
-    file << "GLGE";
-    //specify that this is a scene file
-    file << "Scene";
-    //specify the version id 1
-    file << "001";
+void Scene::safeChanges()
+{
+    //without a file or with a damaged change log all objects have to be written
+    if (!this->onDisk || this->compactChanges) { this->safeFile(); return; }
 
-    //store an iterator for the own object vector
+    //store an object that changed with its data for the change log
+    struct Change { std::string name; NamedObject* obj; const uint8_t* data; uint64_t size; uint8_t flags; std::vector<uint8_t> packed; };
+    //collect the objects that changed, they are packed first so the size of the change log is known
+    std::vector<Change> changed;
+    uint64_t bytes = 0;
     std::unordered_map<std::string, NamedObject*>::iterator it;
-    //loop over all objects
     for (it = this->objs.begin(); it != this->objs.end(); ++it)
     {
-        //get the object name
-        std::string name = it->first;
+        //skip missing and unchanged objects
+        if (!it->second || !(it->second->isDirty() || this->pendingSets.count(it->first))) { continue; }
         //check if the name is short enough
-        if (name.size() > UINT8_MAX)
+        if (it->first.size() > UINT16_MAX)
         {
             //throw an error
-            GLGE_THROW_ERROR("The name " + name + " is too long to be stored in an scene file")
+            GLGE_THROW_ERROR("The name " + it->first + " is too long to be stored in an scene file")
+            continue;
+        }
+        changed.push_back(Change());
+        Change& change = changed.back();
+        change.name = it->first;
+        change.obj = it->second;
+        size_t size = 0;
+        change.data = it->second->getBytes(&size);
+        change.size = size;
+        change.flags = glgePackSceneData(change.data, change.size, this->compression, this->compressionThreshold, change.packed);
+        bytes += GLGE_SCENE_CHANGE_HEADER_SIZE + change.name.size() + (change.flags ? change.packed.size() : change.size);
+    }
+    for (const std::string& name : this->pendingRemovals) { bytes += GLGE_SCENE_CHANGE_HEADER_SIZE + name.size(); }
+    //check if anything changed
+    if (changed.empty() && this->pendingRemovals.empty()) { return; }
+    //write the whole file if the change log would grow too large, this also removes the change log
+    if ((double)(this->changesSize + bytes) > (double)this->fileSize * GLGE_SCENE_COMPACTION_RATIO) { this->safeFile(); return; }
+
+    //open the change log for appending
+    std::string path = this->name + ".glges" + GLGE_SCENE_CHANGES_ENDING;
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    //check if the file is open
+    if (!file.is_open())
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Cound't open the change log " + path)
+        return;
+    }
+    uint64_t written = 0;
+    //a new change log starts with the magic bytes
+    if (this->changesSize == 0)
+    {
+        file.write(glgeSceneChangesMagic, sizeof(glgeSceneChangesMagic));
+        written += sizeof(glgeSceneChangesMagic);
+    }
+    //write an entry of the change log
+    auto writeEntry = [&](uint8_t type, uint8_t flags, const std::string& name, const uint8_t* data, uint64_t length)
+    {
+        uint8_t header[GLGE_SCENE_CHANGE_HEADER_SIZE] = {0};
+        header[0] = type;
+        header[1] = flags;
+        uint16_t nameLength = (uint16_t)name.size();
+        std::memcpy(header + 2, &nameLength, sizeof(nameLength));
+        std::memcpy(header + 8, &length, sizeof(length));
+        file.write((const char*)header, sizeof(header));
+        file.write(name.data(), name.size());
+        if (length) { file.write((const char*)data, length); }
+        written += sizeof(header) + name.size() + length;
+    };
+    //write the removed objects first, an object may be set again after it was removed
+    for (const std::string& name : this->pendingRemovals) { writeEntry(GLGE_SCENE_CHANGE_REMOVE, 0, name, NULL, 0); }
+    //write the changed objects
+    for (Change& change : changed)
+    {
+        if (change.flags) { writeEntry(GLGE_SCENE_CHANGE_SET, change.flags, change.name, change.packed.data(), change.packed.size()); }
+        else { writeEntry(GLGE_SCENE_CHANGE_SET, 0, change.name, change.data, change.size); }
+    }
+    //check if everything was written
+    file.flush();
+    if (!file)
+    {
+        //throw an error, the log may contain an incomplete entry now
+        GLGE_THROW_ERROR("Failed to write the change log " + path)
+        this->compactChanges = true;
+        return;
+    }
+    //all changes are stored now
+    this->changesSize += written;
+    for (Change& change : changed) { change.obj->markSaved(); }
+    this->pendingRemovals.clear();
+    this->pendingSets.clear();
+}
+
+void Scene::remove(std::string name)
+{
+    //remove the object from the scene
+    this->objs.erase(name);
+    this->pendingSets.erase(name);
+    //the removal has to be stored if the object may be in the scene file
+    if (this->onDisk)
+    {
+        this->removed.insert(name);
+        this->pendingRemovals.push_back(name);
+    }
+}
+
+void Scene::replayChanges()
+{
+    //reset the change log
+    this->changesSize = 0;
+    this->compactChanges = false;
+    //map the change log, it only exists if changes were stored
+    std::string path = this->name + ".glges" + GLGE_SCENE_CHANGES_ENDING;
+    std::shared_ptr<SceneFile> file = glgeMapSceneFile(path);
+    if (!file) { return; }
+    //check the magic bytes
+    if ((file->size < sizeof(glgeSceneChangesMagic)) || (std::memcmp(file->mapping, glgeSceneChangesMagic, sizeof(glgeSceneChangesMagic)) != 0))
+    {
+        //throw an error
+        GLGE_THROW_ERROR("The change log " + path + " is invalid")
+        this->compactChanges = true;
+        return;
+    }
+    //apply all entries
+    size_t pos = sizeof(glgeSceneChangesMagic);
+    while (file->size - pos >= GLGE_SCENE_CHANGE_HEADER_SIZE)
+    {
+        //read the header
+        const uint8_t* header = file->mapping + pos;
+        uint8_t type = header[0];
+        uint8_t flags = header[1];
+        uint16_t nameLength = 0;
+        uint64_t length = 0;
+        std::memcpy(&nameLength, header + 2, sizeof(nameLength));
+        std::memcpy(&length, header + 8, sizeof(length));
+        //check that the entry is inside of the file
+        size_t remain = file->size - pos - GLGE_SCENE_CHANGE_HEADER_SIZE;
+        if ((nameLength > remain) || (length > remain - nameLength)) { break; }
+        std::string name((const char*)header + GLGE_SCENE_CHANGE_HEADER_SIZE, nameLength);
+        const uint8_t* data = header + GLGE_SCENE_CHANGE_HEADER_SIZE + nameLength;
+        if (type == GLGE_SCENE_CHANGE_REMOVE)
+        {
+            //remove the object
+            this->objs.erase(name);
+            this->removed.insert(name);
         }
-        //store the length of the name
-        uint8_t nLen = (uint8_t)name.size();
-        //get the object data
-        std::vector<uint8_t>* data = it->second->getData();
-        //get the length of the data
-        uint32_t len = (uint32_t)(data->size() + (int)name.size() + sizeof(nLen));
-        //store the object size
-        file.write((char*)&len, sizeof(len));
-        //store the length of the name
-        file.write((char*)&nLen, sizeof(nLen));
-        //store the name
-        file << name;
-        //store the object data
-        file.write((char*)data->data(), len);
-    }
-
-    //close the file
-    file.close();
+        else if (type == GLGE_SCENE_CHANGE_SET)
+        {
+            //create the object
+            NamedObject* obj = NULL;
+            if (flags & GLGE_SCENE_FLAG_COMPRESSED)
+            {
+                //decompress the data
+                if (!glgeCheckPackedSceneData(data, length)) { break; }
+                uint64_t rawSize = 0;
+                std::memcpy(&rawSize, data, sizeof(rawSize));
+                obj = new NamedObject(name);
+                obj->getData()->resize((size_t)rawSize);
+                if (!glgeDecompress(data + sizeof(uint64_t), length - sizeof(uint64_t), obj->getData()->data(), (size_t)rawSize)) { delete obj; break; }
+                obj->markSaved();
+            }
+            else
+            {
+                //view the data inside of the change log
+                obj = new NamedObject(name, file, data, length);
+            }
+            this->objs[name] = obj;
+        }
+        else { break; }
+        //go to the next entry
+        pos += GLGE_SCENE_CHANGE_HEADER_SIZE + nameLength + length;
+    }
+    //check if the whole log was applied
+    if (pos != file->size)
+    {
+        //print a warning, the last entry was not written completely
+        if (glgeWarningOutput)
+        {
+            printf("[GLGE WARNING] The change log of the scene %s is damaged, the changes after byte %zu are ignored\n", this->name.c_str(), pos);
+        }
+        //the next save writes the whole file, appending after the damaged entry would make the new changes unreadable
+        this->compactChanges = true;
+    }
+    //store the size of the log
+    this->changesSize = file->size;
 }
 
 void Scene::set(NamedObject* obj)
 {
     //access the named object and store it
     this->objs[obj->name] = obj;
+    //the object may view data of another scene, so it is stored with the next changes
+    this->pendingSets.insert(obj->name);
 }
 
 void Scene::load()
 {
-    //store the corresponding file
-    std::fstream file;
-    //open the corresponding scene file
-    file.open((this->name + ".glges"));
+    //map the corresponding scene file
+    std::shared_ptr<SceneFile> file = glgeMapSceneFile(this->name + ".glges");
     //check if the file is open
-    if (!file.is_open())
+    if (!file)
     {
         //throw an error
         GLGE_THROW_ERROR("Cound't open scene file for scene " + this->name + ".glges")
@@ -243,14 +876,8 @@ void Scene::load()
         return;
     }
 
-    //store the header
-    char head[10];
-    //get the file header
-    file.read(head, sizeof(head)-1);
-    //add a 0-Byte to the end
-    head[9] = 0x00;
     //check if the file header is correct
-    if (std::string(head) != "GLGEScene")
+    if ((file->size < 12) || (std::memcmp(file->mapping, glgeSceneMagic, 9) != 0))
     {
         //throw an error
         GLGE_THROW_ERROR("The scene file for the scene " + this->name + " is not a valid scene file")
@@ -261,11 +888,12 @@ void Scene::load()
     //store the version number
     char vers[4];
     //get the version from the file
-    file.read(vers, sizeof(vers)-1);
+    std::memcpy(vers, file->mapping + 9, 3);
     //add a 0-Byte to the end
     vers[3] = 0x00;
     //check the version
-    if (atoi(vers) > 1)
+    int version = atoi(vers);
+    if (version > GLGE_SCENE_VERSION)
     {
         //throw an error
         GLGE_THROW_ERROR("The Scene was created in a newer version of GLGE. Can't load the scene file.")
@@ -273,66 +901,353 @@ void Scene::load()
         return;
     }
 
-    while (!(file.peek() == EOF))
-    {
-        //store the amount of data to read
-        uint32_t len = 0;
-        //get the length of the new data
-        file.read((char*)&len, sizeof(len));
-        //store the length of the name
-        uint8_t nLen = 0;
-        //read the length of the name
-        file.read((char*)&nLen, sizeof(nLen));
-        //create a string to store the name
-        std::string name;
-        //make enough space for the name
-        name.resize(nLen);
-        //read the name
-        file.read(name.data(), nLen);
-        //store the main data
-        std::vector<uint8_t> data;
-        //resize to enough size for everything
-        data.resize(len);
-        //get all the data
-        file.read((char*)data.data(), len);
-
-        //create a new NamedObject
-        NamedObject* obj = new NamedObject(name);
-        //make enough size for the data
-        obj->getData()->resize(len);
-        //set the data for the named object
-        memcpy(obj->getData()->data(), data.data(), len);
-        //store the named object
-        this->objs[name] = obj;
+    //check for the old format without a table of contents
+    if (version < 2)
+    {
+        //store the read position
+        size_t pos = 12;
+        while (pos < file->size)
+        {
+            //get the length of the new data
+            uint32_t len = 0;
+            if (pos + sizeof(len) + 1 > file->size) { break; }
+            std::memcpy(&len, file->mapping + pos, sizeof(len));
+            pos += sizeof(len);
+            //read the length of the name
+            uint8_t nLen = file->mapping[pos++];
+            //check that the record is inside of the file
+            if ((pos + nLen > file->size) || (len > file->size - pos - nLen))
+            {
+                //throw an error
+                GLGE_THROW_ERROR("The scene file for the scene " + this->name + " is cut off")
+                break;
+            }
+            //read the name
+            std::string name((const char*)file->mapping + pos, nLen);
+            pos += nLen;
+            //the old writer counted the name and its length in the length, so the last bytes of the record are not part of the object
+            size_t size = (len >= (uint32_t)nLen + 1) ? len - nLen - 1 : len;
+            //create a new NamedObject that views the data
+            this->objs[name] = new NamedObject(name, file, file->mapping + pos, size);
+            pos += len;
+        }
     }
+    //read the table of contents of version 2
+    else if (!this->readTableOfContents(file)) { return; }
 
-    //close the file
-    file.close();
+    //the scene now has a file, changes can be appended to it
+    this->onDisk = true;
+    this->fileSize = file->size;
+    this->removed.clear();
+    this->pendingRemovals.clear();
+    //apply the changes that were stored after the file was written
+    this->replayChanges();
+}
+
+bool Scene::readTableOfContents(std::shared_ptr<SceneFile> file)
+{
+    //read the header of version 2
+    if (file->size < GLGE_SCENE_HEADER_SIZE)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("The scene file for the scene " + this->name + " is cut off")
+        return false;
+    }
+    uint64_t count = 0, namesOffset = 0;
+    std::memcpy(&count, file->mapping + 16, sizeof(count));
+    std::memcpy(&namesOffset, file->mapping + 24, sizeof(namesOffset));
+    //check that the table of contents and the name block are inside of the file
+    if ((count > (file->size - GLGE_SCENE_HEADER_SIZE) / sizeof(SceneRecord)) || (namesOffset != GLGE_SCENE_HEADER_SIZE + count*sizeof(SceneRecord)))
+    {
+        //throw an error
+        GLGE_THROW_ERROR("The table of contents of the scene file for the scene " + this->name + " is invalid")
+        return false;
+    }
+    //read the table of contents
+    std::vector<SceneRecord> records(count);
+    if (count) { std::memcpy(records.data(), file->mapping + GLGE_SCENE_HEADER_SIZE, count*sizeof(SceneRecord)); }
+    //check that every entry is inside of the file
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const SceneRecord& record = records[i];
+        //the entries must be sorted by the name hash, else objects can't be found
+        if ((i > 0) && (records[i-1].nameHash > record.nameHash))
+        {
+            //throw an error
+            GLGE_THROW_ERROR("The table of contents of the scene file for the scene " + this->name + " is not sorted")
+            return false;
+        }
+        //compressed data starts with the uncompressed size, it is only checked if the record is inside of the file
+        if ((record.offset > file->size) || (record.length > file->size - record.offset) || 
+            (namesOffset + record.nameOffset + record.nameLength > file->size) ||
+            ((record.flags & GLGE_SCENE_FLAG_COMPRESSED) && !glgeCheckPackedSceneData(file->mapping + record.offset, record.length)))
+        {
+            //throw an error
+            GLGE_THROW_ERROR("The table of contents of the scene file for the scene " + this->name + " is invalid")
+            return false;
+        }
+    }
+    //store the file, objects are created when they are accessed
+    this->file = file;
+    this->records = std::move(records);
+    return true;
+}
+
+void Scene::loadAsync()
+{
+    //wait for a load that is still running
+    this->loading.reset();
+    //create the scene the file is loaded into, so this scene can be used while it loads
+    std::shared_ptr<SceneLoad> job = std::make_shared<SceneLoad>();
+    job->scene = new Scene(this->name.c_str());
+    job->scene->setCompression(this->compression, this->compressionThreshold);
+    //load the file in the background
+    SceneLoad* state = job.get();
+    job->thread = std::thread([state]()
+    {
+        //errors can't leave the thread, they are stored for finishLoad
+        try
+        {
+            //map the file and read the table of contents
+            Scene* scene = state->scene;
+            scene->load();
+            //the scene only has a file if it was loaded
+            if (!scene->onDisk) { state->failed = true; }
+            else
+            {
+                //count the objects that still need to be created
+                uint64_t total = 0;
+                for (const SceneRecord& record : scene->records)
+                {
+                    std::string name = scene->getRecordName(record);
+                    if (!scene->objs.count(name) && !scene->removed.count(name)) { total++; }
+                }
+                state->total = total;
+                //create all objects on the worker threads
+                scene->createMissingObjects(&state->created);
+            }
+        }
+        catch (...)
+        {
+            //store the error
+            state->error = std::current_exception();
+            state->failed = true;
+        }
+        //the scene can now be applied
+        state->done = true;
+    });
+    this->loading = job;
+}
+
+bool Scene::isLoading()
+{
+    //check if a load is stored
+    return (bool)this->loading;
+}
+
+float Scene::getLoadProgress()
+{
+    //without a load everything is loaded
+    if (!this->loading) { return 1.f; }
+    if (this->loading->done) { return this->loading->failed ? -1.f : 1.f; }
+    //use the amount of created objects, reading the file counts as nothing
+    uint64_t total = this->loading->total;
+    if (total == 0) { return 0.f; }
+    return (float)((double)this->loading->created / (double)total);
+}
+
+bool Scene::finishLoad(bool wait)
+{
+    //check if a load is running
+    if (!this->loading) { return true; }
+    //check if the load is done
+    if (!wait && !this->loading->done) { return false; }
+    this->loading->thread.join();
+    //a failed load doesn't change the scene
+    if (this->loading->failed)
+    {
+        //end the load before the error is raised, so no thread is left running
+        std::exception_ptr error = this->loading->error;
+        this->loading.reset();
+        if (error) { std::rethrow_exception(error); }
+        return false;
+    }
+    //move the loaded state into this scene
+    Scene* loaded = this->loading->scene;
+    this->objs = std::move(loaded->objs);
+    this->file = std::move(loaded->file);
+    this->records = std::move(loaded->records);
+    this->onDisk = loaded->onDisk;
+    this->fileSize = loaded->fileSize;
+    this->changesSize = loaded->changesSize;
+    this->compactChanges = loaded->compactChanges;
+    this->removed = std::move(loaded->removed);
+    this->pendingRemovals.clear();
+    this->pendingSets.clear();
+    //delete the loaded scene
+    this->loading.reset();
+    return true;
+}
+
+void Scene::setCompression(uint8_t mode, uint64_t threshold)
+{
+    //store the compression settings
+    this->compression = mode;
+    this->compressionThreshold = threshold;
+}
+
+std::string Scene::getRecordName(const SceneRecord& record)
+{
+    //get the offset of the name block
+    uint64_t namesOffset = GLGE_SCENE_HEADER_SIZE + this->records.size()*sizeof(SceneRecord);
+    //read the name from the mapped file
+    return std::string((const char*)this->file->mapping + namesOffset + record.nameOffset, record.nameLength);
+}
+
+const SceneRecord* Scene::findRecord(const std::string& name)
+{
+    //removed objects are ignored
+    if (this->removed.count(name)) { return NULL; }
+    //search the first entry with the hash of the name
+    uint64_t hash = glgeHashSceneName(name);
+    std::vector<SceneRecord>::iterator it = std::lower_bound(this->records.begin(), this->records.end(), hash, 
+                                                             [](const SceneRecord& r, uint64_t h) { return r.nameHash < h; });
+    //check all entries with the same hash
+    for (; (it != this->records.end()) && (it->nameHash == hash); ++it)
+    {
+        //compare the names
+        if (this->getRecordName(*it) == name) { return &(*it); }
+    }
+    //the object is not in the file
+    return NULL;
+}
+
+NamedObject* Scene::createObject(const SceneRecord& record, const std::string& name, std::string* error)
+{
+    //store the data of the record
+    const uint8_t* data = this->file->mapping + record.offset;
+    //check if the data is compressed
+    if (!(record.flags & GLGE_SCENE_FLAG_COMPRESSED))
+    {
+        //create the object, it views its data inside of the file
+        return new NamedObject(name, this->file, data, record.length);
+    }
+    //read the uncompressed size
+    uint64_t rawSize = 0;
+    std::memcpy(&rawSize, data, sizeof(rawSize));
+    //decompress the data into the object
+    NamedObject* obj = new NamedObject(name);
+    obj->getData()->resize((size_t)rawSize);
+    if (!glgeDecompress(data + sizeof(uint64_t), record.length - sizeof(uint64_t), obj->getData()->data(), (size_t)rawSize))
+    {
+        delete obj;
+        std::string msg = "The compressed data of the object " + name + " in the scene " + this->name + " is invalid";
+        //worker threads can't throw, so the error is returned to the calling thread
+        if (error) { *error = msg; return NULL; }
+        //throw an error
+        GLGE_THROW_ERROR(msg)
+        return NULL;
+    }
+    //the decompressed data equals the data in the file
+    obj->markSaved();
+    //return the object
+    return obj;
 }
 
 NamedObject* Scene::get(std::string name)
 {
+    //check if the object was already created
+    std::unordered_map<std::string, NamedObject*>::iterator it = this->objs.find(name);
+    if (it != this->objs.end()) { return it->second; }
+    //search the object in the mapped file
+    const SceneRecord* record = this->findRecord(name);
+    if (!record) { return NULL; }
+    //create the object
+    NamedObject* obj = this->createObject(*record, name);
+    if (!obj) { return NULL; }
+    this->objs[name] = obj;
     //return the named object
-    return this->objs[name];
+    return obj;
+}
+
+bool Scene::has(std::string name)
+{
+    //check the created objects and the mapped file
+    return (this->objs.count(name) != 0) || (this->findRecord(name) != NULL);
+}
+
+std::vector<std::string> Scene::getObjectNames()
+{
+    //store the names
+    std::vector<std::string> names;
+    names.reserve(this->objs.size() + this->records.size());
+    //add the created objects
+    for (std::unordered_map<std::string, NamedObject*>::iterator it = this->objs.begin(); it != this->objs.end(); ++it)
+    {
+        names.push_back(it->first);
+    }
+    //add the objects of the mapped file that were not created yet
+    for (const SceneRecord& record : this->records)
+    {
+        std::string name = this->getRecordName(record);
+        if (!this->objs.count(name) && !this->removed.count(name)) { names.push_back(name); }
+    }
+    //return the names
+    return names;
+}
+
+void Scene::createMissingObjects(std::atomic<uint64_t>* progress)
+{
+    //collect the objects of the mapped file that were not created yet
+    std::vector<const SceneRecord*> missing;
+    std::vector<std::string> names;
+    uint64_t bytes = 0;
+    for (const SceneRecord& record : this->records)
+    {
+        std::string name = this->getRecordName(record);
+        if (this->objs.count(name) || this->removed.count(name)) { continue; }
+        missing.push_back(&record);
+        names.push_back(name);
+        //only compressed objects need work, the others view the file
+        if (record.flags & GLGE_SCENE_FLAG_COMPRESSED) { bytes += record.length; }
+    }
+    //create the objects in parallel, the errors are collected for every object
+    std::vector<NamedObject*> created(missing.size(), NULL);
+    std::vector<std::string> errors(missing.size());
+    glgeSceneParallelFor(missing.size(), bytes, [&](size_t i)
+    {
+        created[i] = this->createObject(*missing[i], names[i], &errors[i]);
+        if (progress) { (*progress)++; }
+    });
+    //store the objects, the map is only changed by this thread
+    for (size_t i = 0; i < created.size(); i++)
+    {
+        if (created[i]) { this->objs[names[i]] = created[i]; }
+    }
+    //report the errors after all threads are done
+    for (const std::string& error : errors)
+    {
+        if (error.empty()) { continue; }
+        //throw an error
+        GLGE_THROW_ERROR(error)
+    }
 }
 
 std::vector<NamedObject*> Scene::getAllObjects()
 {
+    //create every object of the mapped file
+    this->createMissingObjects();
     //create a new vector
     std::vector<NamedObject*> ret;
     //make enough space in the vector
-    ret.resize(this->objs.size());
+    ret.reserve(this->objs.size());
     //store an iterator for the objects
     std::unordered_map<std::string, NamedObject*>::iterator it;
-    //store the current element id
-    int i = 0;
     //loop over the map
     for (it = this->objs.begin(); it != this->objs.end(); ++it)
     {
         //store the map element
-        ret[i] = it->second;
-        //increment i
-        i++;
+        ret.push_back(it->second);
     }
 
     //return all the elements
@@ -13,13 +13,94 @@
 
 //includes from default library
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string>
 #include <cstring>
 #include <typeinfo>
+#include <memory>
+#include <cstdint>
+#include <atomic>
 
 //includes from GLGE
 #include "GLGEData.h"
+#include "glgeCompression.h"
+
+/**
+ * @brief the newest version of the scene file format
+ */
+#define GLGE_SCENE_VERSION 2
+/**
+ * @brief the alignment of the object data in scene files of version 2
+ */
+#define GLGE_SCENE_ALIGNMENT 8
+
+/**
+ * @brief the flag of a record whose object data is compressed, the data starts with the uncompressed size as an uint64_t
+ */
+#define GLGE_SCENE_FLAG_COMPRESSED 0x01
+/**
+ * @brief the flag of a record that was compressed with GLGE_COMPRESSION_HIGH, it decompresses the same way
+ */
+#define GLGE_SCENE_FLAG_COMPRESSED_HIGH 0x02
+/**
+ * @brief the default size from which on object data is compressed
+ */
+#define GLGE_SCENE_COMPRESSION_THRESHOLD 4096
+
+/**
+ * @brief the ending that is added to the scene file for the log of changes that were stored after the file was written
+ */
+#define GLGE_SCENE_CHANGES_ENDING ".delta"
+/**
+ * @brief the scene file is written again when the change log grows larger than this part of the scene file
+ */
+#define GLGE_SCENE_COMPACTION_RATIO 0.5
+
+/**
+ * @brief a mapped scene file, it is shared by the scene and the objects that view its data
+ */
+struct SceneFile;
+
+/**
+ * @brief the state of a scene that is loaded in the background
+ */
+struct SceneLoad;
+
+/**
+ * @brief an entry in the table of contents of a scene file of version 2, all values are little endian
+ */
+struct SceneRecord
+{
+    /**
+     * @brief the FNV-1a hash of the object name, the table is sorted by it
+     */
+    uint64_t nameHash;
+    /**
+     * @brief the offset of the object data from the start of the file, a multiple of GLGE_SCENE_ALIGNMENT
+     */
+    uint64_t offset;
+    /**
+     * @brief the size of the object data in bytes
+     */
+    uint64_t length;
+    /**
+     * @brief the offset of the name in the name block
+     */
+    uint32_t nameOffset;
+    /**
+     * @brief the length of the name in bytes
+     */
+    uint16_t nameLength;
+    /**
+     * @brief the type of the record, 0 for an object
+     */
+    uint8_t type;
+    /**
+     * @brief flags for the encoding of the object data, 0 if the data is stored as it is, else a combination of GLGE_SCENE_FLAG_*
+     */
+    uint8_t flags;
+};
 
 ///////////
 //CLASSES//
@@ -43,6 +124,16 @@ public:
      */
     NamedObject(std::string name);
 
+    /**
+     * @brief Construct a named object that views its data inside of a scene file instead of copying it
+     * 
+     * @param name the name of the object
+     * @param file the scene file that contains the data, it stays mapped while the object exists
+     * @param data a pointer to the data of the object inside of the file
+     * @param size the size of the data in bytes
+     */
+    NamedObject(std::string name, std::shared_ptr<SceneFile> file, const uint8_t* data, size_t size);
+
     /**
      * @brief Destroy the Named Object
      */
@@ -64,6 +155,22 @@ public:
         return ret;
     }
 
+    /**
+     * @brief Get the object without creating its GPU resources, T::decodeData is used instead of T::decode so this can run on any thread
+     * 
+     * @tparam T the object to use
+     * @return T the interpreted object
+     */
+    template<typename T> T* getObjectData()
+    {
+        //create the object to return
+        T* ret = new T();
+        //read the data into the object
+        ret->decodeData(this->getOutputData(std::string(typeid(T).name())));
+        //return the object
+        return ret;
+    }
+
     /**
      * @brief Set the object to another object
      * 
@@ -103,10 +210,18 @@ public:
     std::string name;
 
     /**
-     * @brief get the object's data
+     * @brief get the object's data, data viewed in a scene file is copied first
      */
     std::vector<uint8_t>* getData();
 
+    /**
+     * @brief get the object's data without copying data that is viewed in a scene file
+     * 
+     * @param size the size of the data in bytes
+     * @return const uint8_t* a pointer to the data
+     */
+    const uint8_t* getBytes(size_t* size);
+
     /**
      * @brief Get the name of the encoded object
      * 
@@ -114,11 +229,54 @@ public:
      */
     std::string getTypeName();
 
+    /**
+     * @brief Get a hash of the object's data
+     * 
+     * @return uint64_t the hash of the data
+     */
+    uint64_t getHash();
+
+    /**
+     * @brief check if the object's data changed since it was loaded or stored in a scene file
+     * 
+     * @return true : the data differs from the stored data | false : the data is the same as in the scene file
+     */
+    bool isDirty();
+
+    /**
+     * @brief remember the current data as the data that is stored in a scene file
+     */
+    void markSaved();
+
 private:
     /**
      * @brief store the data of the object
      */
     std::vector<uint8_t> objData;
+    /**
+     * @brief store the scene file the viewed data belongs to
+     */
+    std::shared_ptr<SceneFile> file;
+    /**
+     * @brief store a pointer to the data inside of the scene file, NULL if the data is stored in objData
+     */
+    const uint8_t* view = NULL;
+    /**
+     * @brief store the size of the viewed data
+     */
+    size_t viewSize = 0;
+    /**
+     * @brief store the hash of the data that is stored in a scene file
+     */
+    uint64_t savedHash = 0;
+    /**
+     * @brief say if savedHash is valid
+     */
+    bool saved = false;
+    /**
+     * @brief stop viewing the scene file and remember the hash of the viewed data, the data has to be replaced or copied afterwards
+     */
+    void detachView();
     /**
      * @brief store the inputed data from an object encoding
      * 
@@ -131,9 +289,9 @@ private:
      * 
      * @param type the type name to decode to
      * 
-     * @return Data the data for object decoding
+     * @return DataView a view of the data for object decoding, valid while the object's data is not changed
      */
-    Data getOutputData(std::string type);
+    DataView getOutputData(std::string type);
 };
 
 //default includes
@@ -177,10 +335,32 @@ public:
     void storeObjects(std::vector<NamedObject*> objs);
 
     /**
-     * @brief store all named objects in a scene file
+     * @brief store all named objects in a scene file, the objects are compressed in parallel
      */
     void safeFile();
 
+    /**
+     * @brief set how the objects are compressed when the scene file is stored
+     * 
+     * @param mode the compression mode, GLGE_COMPRESSION_NONE (default), GLGE_COMPRESSION_FAST or GLGE_COMPRESSION_HIGH
+     * @param threshold objects with less bytes than this are stored uncompressed
+     */
+    void setCompression(uint8_t mode, uint64_t threshold = GLGE_SCENE_COMPRESSION_THRESHOLD);
+
+    /**
+     * @brief append the objects that changed since the scene file was loaded or stored to the change log of the scene file
+     * 
+     * The change log is replayed by load. If the scene has no file yet or the change log grows too large the whole scene file is written with safeFile instead.
+     */
+    void safeChanges();
+
+    /**
+     * @brief remove an object from the scene, the object itself is not deleted
+     * 
+     * @param name the name of the object to remove
+     */
+    void remove(std::string name);
+
     /**
      * @brief set an object instance into the scene
      * 
@@ -190,8 +370,10 @@ public:
      */
     template<typename T> void set(T* obj, std::string name)
     {
-        //create a new named object
-        NamedObject* o = new NamedObject();
+        //reuse the named object with the name, so it can compare the new data to the stored data
+        NamedObject* o = this->get(name);
+        //create a new named object if the scene has no object with the name
+        if (!o) { o = new NamedObject(); }
         //store the object
         o->set<T>(obj, name);
         //store the object in the own array
@@ -206,20 +388,69 @@ public:
     void set(NamedObject* obj);
 
     /**
-     * @brief load the corresponding scene file
+     * @brief load the corresponding scene file and its change log, version 2 files are mapped and only the table of contents is read
      */
     void load();
 
     /**
-     * @brief get an named object by its name
+     * @brief start to load the corresponding scene file on a background thread
+     * 
+     * The file is mapped and the objects are created and decompressed on worker threads. The scene can be used while it loads,
+     * the loaded objects replace the objects of the scene when finishLoad returns true. Objects that create GPU resources can then
+     * be decoded with glgeQueueSceneObjects, which decodes them on background threads and spreads the creation of the GPU resources over multiple frames.
+     */
+    void loadAsync();
+
+    /**
+     * @brief check if the scene is loading in the background
+     * 
+     * @return true : a load was started and finishLoad didn't apply it yet | false : no load is running
+     */
+    bool isLoading();
+
+    /**
+     * @brief Get the progress of a load in the background
+     * 
+     * @return float the progress from 0 to 1, 1 if no load is running, -1 if the load failed
+     */
+    float getLoadProgress();
+
+    /**
+     * @brief move the objects of a finished background load into the scene
+     * 
+     * A failed load leaves the scene unchanged and is ended, so isLoading returns false afterwards. An error that was thrown while
+     * loading is thrown again on the calling thread.
+     * 
+     * @param wait true : wait for the load to finish | false : return if the load is still running
+     * @return true : the load finished and was applied or no load was running | false : the load is still running or failed
+     */
+    bool finishLoad(bool wait = false);
+
+    /**
+     * @brief get an named object by its name, objects of a mapped scene file are created on the first access
      * 
      * @param name the name of the object to get
-     * @return NamedObject* a pointer to the named object
+     * @return NamedObject* a pointer to the named object, NULL if the scene has no object with the name
      */
     NamedObject* get(std::string name);
 
     /**
-     * @brief Get the all objects that are stored in the scene
+     * @brief check if the scene contains an object
+     * 
+     * @param name the name of the object
+     * @return true : the scene contains the object | false : the scene has no object with the name
+     */
+    bool has(std::string name);
+
+    /**
+     * @brief Get the names of all objects without creating the objects
+     * 
+     * @return std::vector<std::string> the names of all objects
+     */
+    std::vector<std::string> getObjectNames();
+
+    /**
+     * @brief Get the all objects that are stored in the scene, objects of a mapped scene file are created in parallel
      * 
      * @return std::vector<NamedObject*> a vector of pointer to the named objects
      */
@@ -232,6 +463,95 @@ private:
     std::unordered_map<std::string, NamedObject*> objs;
     //store the scene name
     std::string name;
+    /**
+     * @brief store the mapped scene file
+     */
+    std::shared_ptr<SceneFile> file;
+    /**
+     * @brief store the table of contents of the mapped file, sorted by the name hash
+     */
+    std::vector<SceneRecord> records;
+    /**
+     * @brief store the compression mode for new scene files
+     */
+    uint8_t compression = GLGE_COMPRESSION_NONE;
+    /**
+     * @brief store the size from which on objects are compressed
+     */
+    uint64_t compressionThreshold = GLGE_SCENE_COMPRESSION_THRESHOLD;
+    /**
+     * @brief say if the scene was loaded from or stored in a scene file
+     */
+    bool onDisk = false;
+    /**
+     * @brief store the size of the scene file
+     */
+    uint64_t fileSize = 0;
+    /**
+     * @brief store the size of the change log
+     */
+    uint64_t changesSize = 0;
+    /**
+     * @brief say if the change log is damaged and the scene file has to be written completely
+     */
+    bool compactChanges = false;
+    /**
+     * @brief store the names of the objects of the mapped file that were removed
+     */
+    std::unordered_set<std::string> removed;
+    /**
+     * @brief store the names of the objects that were removed since the last save
+     */
+    std::vector<std::string> pendingRemovals;
+    /**
+     * @brief store the names of the named objects that were set since the last save, they may view data of another scene
+     */
+    std::unordered_set<std::string> pendingSets;
+    /**
+     * @brief store the state of a load in the background, empty if no load is running
+     */
+    std::shared_ptr<SceneLoad> loading;
+
+    /**
+     * @brief find an object in the table of contents of the mapped file
+     * 
+     * @param name the name of the object
+     * @return const SceneRecord* the entry of the object, NULL if the file has no object with the name
+     */
+    const SceneRecord* findRecord(const std::string& name);
+    /**
+     * @brief create an object from an entry of the table of contents, it dosn't change the scene and can be called from multiple threads
+     * 
+     * @param record the entry of the object
+     * @param name the name of the object
+     * @param error stores the error if the data is invalid instead of throwing it, may be NULL
+     * @return NamedObject* the new object, NULL if the data is invalid
+     */
+    NamedObject* createObject(const SceneRecord& record, const std::string& name, std::string* error = NULL);
+    /**
+     * @brief read the table of contents of a scene file of version 2
+     * 
+     * @param file the mapped scene file
+     * @return true : the table of contents was read | false : the file is invalid
+     */
+    bool readTableOfContents(std::shared_ptr<SceneFile> file);
+    /**
+     * @brief apply the change log of the scene file
+     */
+    void replayChanges();
+    /**
+     * @brief create all objects of the mapped file that were not created yet, compressed objects are decompressed in parallel
+     * 
+     * @param progress a counter that is increased for every created object, may be NULL
+     */
+    void createMissingObjects(std::atomic<uint64_t>* progress = NULL);
+    /**
+     * @brief get the name of an entry of the table of contents
+     * 
+     * @param record the entry
+     * @return std::string the name of the object
+     */
+    std::string getRecordName(const SceneRecord& record);
 };
 
 #endif
\ No newline at end of file
@@ -249,3 +249,226 @@ Vertex::Vertex(float x, float y, float z, vec4 color, float nx, float ny, float
     //pass to another constructor
     *this = Vertex(x,y,z, color.x, color.y, color.z, color.w, nx,ny,nz);
 }
+
+/////////////////
+//MESH ENCODING//
+/////////////////
+
+/**
+ * @brief the maximum amount of vertex attributes in an encoded layout
+ */
+#define GLGE_OBJECT_MAX_ATTRIBUTES 16
+
+/**
+ * @brief the attributes of a vertex in the encoded layout
+ */
+enum GLGEVertexAttribute
+{
+    GLGE_VERTEX_ATTRIBUTE_POSITION = 0,
+    GLGE_VERTEX_ATTRIBUTE_COLOR = 1,
+    GLGE_VERTEX_ATTRIBUTE_TEX_COORD = 2,
+    GLGE_VERTEX_ATTRIBUTE_NORMAL = 3
+};
+
+/**
+ * @brief the description of one float attribute inside of an encoded vertex
+ */
+struct GLGEAttributeLayout
+{
+    //store the attribute
+    uint8_t attribute;
+    //store the amount of floats
+    uint8_t components;
+    //store the offset from the start of the vertex in bytes
+    uint16_t offset;
+};
+
+//the encoding copies whole vertices as floats
+static_assert(sizeof(Vertex) % sizeof(float) == 0, "a vertex must only consist of floats");
+
+/**
+ * @brief get the layout of the vertex struct in memory
+ * 
+ * @param layout the array to fill, must have space for 4 attributes
+ * @return uint8_t the amount of attributes
+ */
+static uint8_t glgeGetVertexLayout(GLGEAttributeLayout* layout)
+{
+    //get the offsets from an instance
+    Vertex v;
+    const uint8_t* base = (const uint8_t*)&v;
+    layout[0] = {GLGE_VERTEX_ATTRIBUTE_POSITION, 3, (uint16_t)((const uint8_t*)&v.pos - base)};
+    layout[1] = {GLGE_VERTEX_ATTRIBUTE_COLOR, 4, (uint16_t)((const uint8_t*)&v.color - base)};
+    layout[2] = {GLGE_VERTEX_ATTRIBUTE_TEX_COORD, 2, (uint16_t)((const uint8_t*)&v.texCoord - base)};
+    layout[3] = {GLGE_VERTEX_ATTRIBUTE_NORMAL, 3, (uint16_t)((const uint8_t*)&v.normal - base)};
+    return 4;
+}
+
+/**
+ * @brief read the vertices and indices of an object encoding of version 2
+ * 
+ * @param dat the data to read from, the version was already read
+ * @param vertices the vector to store the vertices in
+ * @param indices the vector to store the indices in
+ * @return true : the mesh was read | false : the data is invalid
+ */
+static bool glgeDecodeRawMesh(DataView& dat, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+    //read the layout of the vertices
+    uint8_t attributeCount = dat.readUByte();
+    if (attributeCount > GLGE_OBJECT_MAX_ATTRIBUTES) { return false; }
+    GLGEAttributeLayout layout[GLGE_OBJECT_MAX_ATTRIBUTES];
+    for (uint8_t i = 0; i < attributeCount; i++)
+    {
+        layout[i].attribute = dat.readUByte();
+        layout[i].components = dat.readUByte();
+        layout[i].offset = dat.readUShort();
+    }
+    unsigned int stride = dat.readUInt();
+    //check the layout, all attributes must lie inside of the vertex
+    if ((stride == 0) || (stride % sizeof(float) != 0)) { return false; }
+    for (uint8_t i = 0; i < attributeCount; i++)
+    {
+        if ((layout[i].components > 4) || (layout[i].offset % sizeof(float) != 0) || (layout[i].offset + layout[i].components*sizeof(float) > stride)) { return false; }
+    }
+
+    //read the amount of vertices, the size can't be larger than the data
+    int64_t vert = 0;
+    if (!dat.readArray(&vert, 1) || (vert < 0) || ((uint64_t)vert > dat.getLen() / stride)) { return false; }
+
+    //check if the layout matches the vertex struct
+    GLGEAttributeLayout native[4];
+    uint8_t nativeCount = glgeGetVertexLayout(native);
+    bool same = (stride == sizeof(Vertex)) && (attributeCount == nativeCount);
+    for (uint8_t i = 0; same && (i < attributeCount); i++)
+    {
+        same = (layout[i].attribute == native[i].attribute) && (layout[i].components == native[i].components) && (layout[i].offset == native[i].offset);
+    }
+    vertices.resize(vert);
+    if (same)
+    {
+        //copy all vertices at once
+        if (!dat.readLittleEndianArray((float*)vertices.data(), vertices.size()*sizeof(Vertex)/sizeof(float))) { return false; }
+    }
+    else
+    {
+        //read every known attribute on its own, missing attributes keep theyre default value
+        const uint8_t* data = dat.getReadPointer();
+        if (!dat.skip((size_t)vert * stride)) { return false; }
+        for (int64_t i = 0; i < vert; i++)
+        {
+            for (uint8_t a = 0; a < attributeCount; a++)
+            {
+                //load the floats of the attribute
+                float f[4] = {0,0,0,1};
+                glgeLoadLittleEndian(f, data + (size_t)i*stride + layout[a].offset, layout[a].components);
+                //store the attribute
+                switch (layout[a].attribute)
+                {
+                case GLGE_VERTEX_ATTRIBUTE_POSITION:
+                    vertices[i].pos = vec3(f[0], f[1], f[2]);
+                    break;
+                case GLGE_VERTEX_ATTRIBUTE_COLOR:
+                    vertices[i].color = vec4(f[0], f[1], f[2], f[3]);
+                    break;
+                case GLGE_VERTEX_ATTRIBUTE_TEX_COORD:
+                    vertices[i].texCoord = vec2(f[0], f[1]);
+                    break;
+                case GLGE_VERTEX_ATTRIBUTE_NORMAL:
+                    vertices[i].normal = vec3(f[0], f[1], f[2]);
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+
+    //read the amount of indices, an index takes 4 bytes, so the size can't be larger than the data
+    int64_t ind = 0;
+    if (!dat.readArray(&ind, 1) || (ind < 0) || ((uint64_t)ind > dat.getLen() / sizeof(unsigned int))) { return false; }
+    //copy all indices at once
+    indices.resize(ind);
+    return dat.readLittleEndianArray(indices.data(), indices.size());
+}
+
+void glgeEncodeMesh(Data* dat, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    //store the version of the encoding, older versions start with the amount of vertices, which is never negative
+    dat->writeLong(-GLGE_OBJECT_ENCODING_VERSION);
+    //store the layout of the vertices, so the decoder can read them if the vertex struct changes
+    GLGEAttributeLayout layout[4];
+    uint8_t attributeCount = glgeGetVertexLayout(layout);
+    dat->writeUByte(attributeCount);
+    for (uint8_t i = 0; i < attributeCount; i++)
+    {
+        dat->writeUByte(layout[i].attribute);
+        dat->writeUByte(layout[i].components);
+        dat->writeUShort(layout[i].offset);
+    }
+    dat->writeUInt(sizeof(Vertex));
+
+    //store the amount of vertives
+    dat->writeLong(vertices.size());
+    //store all vertices as one little endian array of floats
+    dat->writeLittleEndianArray((const float*)vertices.data(), vertices.size()*sizeof(Vertex)/sizeof(float));
+
+    //store the amount of indices
+    dat->writeLong(indices.size());
+    //store all indices as one little endian array
+    dat->writeLittleEndianArray(indices.data(), indices.size());
+}
+
+bool glgeDecodeMesh(DataView& dat, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+    //store the amount of vertives, a negative value is the version of the encoding
+    long vert = dat.readLong();
+    if (vert < 0)
+    {
+        //check if the encoding is known, the version is never negated because that overflows for the smallest long
+        if (vert < -GLGE_OBJECT_ENCODING_VERSION)
+        {
+            //throw an error
+            GLGE_THROW_ERROR("The object was encoded by a newer version of GLGE")
+            return false;
+        }
+        //read the arrays of vertices and indices
+        if (!glgeDecodeRawMesh(dat, vertices, indices))
+        {
+            //throw an error
+            GLGE_THROW_ERROR("The mesh data of the encoded object is invalid")
+            return false;
+        }
+        return true;
+    }
+
+    //a vertex takes 48 bytes, so the size can't be larger than the data
+    if ((unsigned long)vert > dat.getLen() / 48) { vert = 0; }
+    vertices.clear();
+    vertices.reserve(vert);
+    //loop over every vertex
+    for (long i = 0; i < vert; i++)
+    {
+        //create a new vertex
+        Vertex vert;
+        //store the vertex position
+        vert.pos = dat.readVec3();
+        //store the vertex color
+        vert.color = dat.readVec4();
+        //store the texture coordinate
+        vert.texCoord = dat.readVec2();
+        //store the normal
+        vert.normal = dat.readVec3();
+        //store the vertex
+        vertices.push_back(vert);
+    }
+
+    //store the amount of indices
+    long ind = dat.readLong();
+    //an index takes 4 bytes, so the size can't be larger than the data
+    if ((ind < 0) || ((unsigned long)ind > dat.getLen() / 4)) { ind = 0; }
+    //read all indices in one pass
+    indices.resize(ind);
+    dat.readArray(indices.data(), indices.size());
+    return true;
+}
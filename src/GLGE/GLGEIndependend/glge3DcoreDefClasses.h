@@ -22,8 +22,16 @@
 //matrices
 #include "../CML/CMLMat4.h"
 
+//include the data class for the mesh encoding
+#include "GLGEData.h"
+
 //public defines
 
+/**
+ * @brief the newest version of the object encoding, version 2 stores the vertices and indices as little endian arrays
+ */
+#define GLGE_OBJECT_ENCODING_VERSION 2
+
 /**
  * @brief say the type of an model file
  */
@@ -287,4 +295,23 @@ struct Vertex
     Vertex(float x, float y, float z, vec4 color, float nx, float ny, float nz);
 };
 
+/**
+ * @brief encode the vertices and indices of a mesh with the newest object encoding
+ * 
+ * @param dat the data to write to
+ * @param vertices the vertices of the mesh
+ * @param indices the indices of the mesh
+ */
+void glgeEncodeMesh(Data* dat, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+/**
+ * @brief decode the vertices and indices of a mesh, the mesh can be encoded by glgeEncodeMesh or by an older version of GLGE
+ * 
+ * @param dat the data to read from
+ * @param vertices the vector to store the vertices in
+ * @param indices the vector to store the indices in
+ * @return true : the mesh was decoded | false : the data is invalid or was encoded by a newer version of GLGE, an error was thrown
+ */
+bool glgeDecodeMesh(DataView& dat, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
 #endif
\ No newline at end of file
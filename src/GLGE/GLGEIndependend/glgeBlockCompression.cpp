@@ -0,0 +1,1185 @@
+/**
+ * @file glgeBlockCompression.cpp
+ * @author DM8AT
+ * @brief implement the CPU encoder and decoder for the BCn block compression formats and the compressed cache file
+ * @version 0.1
+ * @date 2024-03-02
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the header
+#include "glgeBlockCompression.h"
+//include the private defines for errors
+#include "glgePrivDefines.hpp"
+//include the needed standard librarys
+#include <thread>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+#include <sys/stat.h>
+
+//use SSE2 to search the palettes if the compiler supports it, define GLGE_BC_NO_SIMD to use only the scalar code
+#if !defined(GLGE_BC_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#include <emmintrin.h>
+#define GLGE_BC_SSE2
+#endif
+
+//the magic bytes at the start of every cache file, the last character is the version
+static const char glgeBCCacheMagic[8] = {'G','L','G','E','B','C','_','1'};
+//the weights BC7 uses to interpolate between the endpoints with 4 bit indices
+static const int glgeBC7Weights[16] = {0,4,9,13,17,21,26,30,34,38,43,47,51,55,60,64};
+
+/**
+ * @brief clamp a float to the range of a byte
+ *
+ * @param v the value to clamp
+ * @return float the clamped value
+ */
+static inline float glgeClampByte(float v)
+{
+    //clamp between 0 and 255
+    return (v < 0.f) ? 0.f : ((v > 255.f) ? 255.f : v);
+}
+
+/**
+ * @brief find the nearest palette entry for all pixels of a block
+ *
+ * @param px the pixels of the block
+ * @param chanels the amount of chanels to compare
+ * @param palette the palette to search in
+ * @param paletteSize the amount of entries in the palette
+ * @param ignore pixels that are set to true are skipped, may be NULL
+ * @param idx the indices to write to
+ * @return float the summed squared error of the block
+ */
+static float glgeFindIndices(const float px[16][4], int chanels, const float palette[][4], int paletteSize, const bool* ignore, uint8_t idx[16])
+{
+    //store the error of the whole block
+    float total = 0;
+#ifdef GLGE_BC_SSE2
+    //compare 4 pixels against one palette entry at a time
+    float errors[16];
+    uint32_t indices[16];
+    for (int i = 0; i < 16; i += 4)
+    {
+        //transpose the pixels, so every register stores one chanel of 4 pixels
+        __m128 chanel[4] = {_mm_loadu_ps(px[i]), _mm_loadu_ps(px[i+1]), _mm_loadu_ps(px[i+2]), _mm_loadu_ps(px[i+3])};
+        _MM_TRANSPOSE4_PS(chanel[0], chanel[1], chanel[2], chanel[3]);
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i bestIdx = _mm_setzero_si128();
+        for (int p = 0; p < paletteSize; p++)
+        {
+            //calculate the squared distance, the chanels are added in the same order as in the scalar code
+            __m128 d = _mm_setzero_ps();
+            for (int c = 0; c < chanels; c++)
+            {
+                __m128 diff = _mm_sub_ps(chanel[c], _mm_set1_ps(palette[p][c]));
+                d = _mm_add_ps(d, _mm_mul_ps(diff, diff));
+            }
+            //keep the first entry with the smallest distance
+            __m128 closer = _mm_cmplt_ps(d, best);
+            __m128i mask = _mm_castps_si128(closer);
+            best = _mm_or_ps(_mm_and_ps(closer, d), _mm_andnot_ps(closer, best));
+            bestIdx = _mm_or_si128(_mm_and_si128(mask, _mm_set1_epi32(p)), _mm_andnot_si128(mask, bestIdx));
+        }
+        _mm_storeu_ps(errors + i, best);
+        _mm_storeu_si128((__m128i*)(indices + i), bestIdx);
+    }
+    //store the indices and add the errors in pixel order
+    for (int i = 0; i < 16; i++)
+    {
+        //skip ignored pixels
+        if (ignore && ignore[i]) { continue; }
+        idx[i] = (uint8_t)indices[i];
+        total += errors[i];
+    }
+#else
+    //loop over all pixels
+    for (int i = 0; i < 16; i++)
+    {
+        //skip ignored pixels
+        if (ignore && ignore[i]) { continue; }
+        //store the best entry
+        float best = std::numeric_limits<float>::max();
+        uint8_t bestIdx = 0;
+        //loop over all palette entries
+        for (int p = 0; p < paletteSize; p++)
+        {
+            //calculate the squared distance
+            float d = 0;
+            for (int c = 0; c < chanels; c++)
+            {
+                float diff = px[i][c] - palette[p][c];
+                d += diff*diff;
+            }
+            //store the entry if it is closer
+            if (d < best) { best = d; bestIdx = (uint8_t)p; }
+        }
+        //store the index and add the error
+        idx[i] = bestIdx;
+        total += best;
+    }
+#endif
+    //return the error
+    return total;
+}
+
+/**
+ * @brief fit two endpoints to the pixels of a block
+ *
+ * @param px the pixels of the block
+ * @param chanels the amount of chanels to fit
+ * @param ignore pixels that are set to true are skipped, may be NULL
+ * @param pca true : the principal axis of the pixels is used | false : the inset bounding box is used
+ * @param e0 the first endpoint
+ * @param e1 the second endpoint
+ */
+static void glgeFitEndpoints(const float px[16][4], int chanels, const bool* ignore, bool pca, float e0[4], float e1[4])
+{
+    //calculate the bounding box and the mean
+    float mn[4] = {255,255,255,255}, mx[4] = {0,0,0,0}, mean[4] = {0,0,0,0};
+    int count = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        //skip ignored pixels
+        if (ignore && ignore[i]) { continue; }
+        for (int c = 0; c < chanels; c++)
+        {
+            mn[c] = std::min(mn[c], px[i][c]);
+            mx[c] = std::max(mx[c], px[i][c]);
+            mean[c] += px[i][c];
+        }
+        count++;
+    }
+    //if no pixel is used, the endpoints are black
+    if (count == 0)
+    {
+        for (int c = 0; c < 4; c++) { e0[c] = 0; e1[c] = 0; }
+        return;
+    }
+    //finish the mean
+    for (int c = 0; c < chanels; c++) { mean[c] /= (float)count; }
+
+    //the principal axis, starts at the diagonal of the bounding box
+    float axis[4] = {0,0,0,0};
+    float len = 0;
+    for (int c = 0; c < chanels; c++) { axis[c] = mx[c] - mn[c]; len += axis[c]*axis[c]; }
+    //check if the principal axis should be used
+    if (pca && len > 0.f)
+    {
+        //calculate the covariance matrix
+        float cov[4][4] = {};
+        for (int i = 0; i < 16; i++)
+        {
+            if (ignore && ignore[i]) { continue; }
+            for (int a = 0; a < chanels; a++)
+            {
+                for (int b = 0; b < chanels; b++)
+                {
+                    cov[a][b] += (px[i][a] - mean[a]) * (px[i][b] - mean[b]);
+                }
+            }
+        }
+        //use power iteration to find the largest eigen vector
+        for (int it = 0; it < 8; it++)
+        {
+            float next[4] = {0,0,0,0};
+            for (int a = 0; a < chanels; a++)
+            {
+                for (int b = 0; b < chanels; b++) { next[a] += cov[a][b] * axis[b]; }
+            }
+            //normalize the axis
+            float l = 0;
+            for (int c = 0; c < chanels; c++) { l += next[c]*next[c]; }
+            //stop if the axis collapsed
+            if (l <= 1e-12f) { break; }
+            l = 1.f / std::sqrt(l);
+            for (int c = 0; c < chanels; c++) { axis[c] = next[c] * l; }
+        }
+        //project all pixels onto the axis
+        float tmin = std::numeric_limits<float>::max(), tmax = -std::numeric_limits<float>::max();
+        //normalize the axis, in case the power iteration stopped early
+        float l = 0;
+        for (int c = 0; c < chanels; c++) { l += axis[c]*axis[c]; }
+        l = 1.f / std::sqrt(l);
+        for (int c = 0; c < chanels; c++) { axis[c] *= l; }
+        for (int i = 0; i < 16; i++)
+        {
+            if (ignore && ignore[i]) { continue; }
+            float t = 0;
+            for (int c = 0; c < chanels; c++) { t += (px[i][c] - mean[c]) * axis[c]; }
+            tmin = std::min(tmin, t);
+            tmax = std::max(tmax, t);
+        }
+        //the endpoints are the extremes along the axis
+        for (int c = 0; c < chanels; c++)
+        {
+            e0[c] = glgeClampByte(mean[c] + axis[c]*tmax);
+            e1[c] = glgeClampByte(mean[c] + axis[c]*tmin);
+        }
+    }
+    else
+    {
+        //use the bounding box, inset by a 16th to reduce the error of the interpolated values
+        for (int c = 0; c < chanels; c++)
+        {
+            float inset = (mx[c] - mn[c]) / 16.f;
+            e0[c] = mx[c] - inset;
+            e1[c] = mn[c] + inset;
+        }
+    }
+    //clear the unused chanels
+    for (int c = chanels; c < 4; c++) { e0[c] = 0; e1[c] = 0; }
+}
+
+/**
+ * @brief refine the endpoints of a block with a least squares fit for the current indices
+ *
+ * @param px the pixels of the block
+ * @param chanels the amount of chanels to fit
+ * @param ignore pixels that are set to true are skipped, may be NULL
+ * @param weights the weight of the second endpoint for every index
+ * @param idx the current indices of the pixels
+ * @param e0 the first endpoint
+ * @param e1 the second endpoint
+ * @return true : the endpoints where refined | false : the system was singular, the endpoints are unchanged
+ */
+static bool glgeRefineEndpoints(const float px[16][4], int chanels, const bool* ignore, const float* weights, const uint8_t idx[16], float e0[4], float e1[4])
+{
+    //accumulate the normal equations
+    float a2 = 0, b2 = 0, ab = 0;
+    float ax[4] = {0,0,0,0}, bx[4] = {0,0,0,0};
+    for (int i = 0; i < 16; i++)
+    {
+        if (ignore && ignore[i]) { continue; }
+        float b = weights[idx[i]];
+        float a = 1.f - b;
+        a2 += a*a;
+        b2 += b*b;
+        ab += a*b;
+        for (int c = 0; c < chanels; c++)
+        {
+            ax[c] += a * px[i][c];
+            bx[c] += b * px[i][c];
+        }
+    }
+    //check if the system can be solved
+    float det = a2*b2 - ab*ab;
+    if (std::fabs(det) < 1e-6f) { return false; }
+    det = 1.f / det;
+    //solve for both endpoints
+    for (int c = 0; c < chanels; c++)
+    {
+        e0[c] = glgeClampByte((ax[c]*b2 - bx[c]*ab) * det);
+        e1[c] = glgeClampByte((bx[c]*a2 - ax[c]*ab) * det);
+    }
+    //the endpoints where refined
+    return true;
+}
+
+/**
+ * @brief quantize a color to RGB565
+ *
+ * @param c the color to quantize
+ * @return uint16_t the quantized color
+ */
+static uint16_t glgeQuantize565(const float c[4])
+{
+    //round every chanel to its bit depth
+    int r = (int)(glgeClampByte(c[0]) * (31.f / 255.f) + .5f);
+    int g = (int)(glgeClampByte(c[1]) * (63.f / 255.f) + .5f);
+    int b = (int)(glgeClampByte(c[2]) * (31.f / 255.f) + .5f);
+    //pack the chanels
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+/**
+ * @brief expand an RGB565 color to 8 bit per chanel
+ *
+ * @param v the packed color
+ * @param c the color to write to
+ */
+static void glgeExpand565(uint16_t v, int c[3])
+{
+    //extract the chanels
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    //replicate the high bits into the low bits
+    c[0] = (r << 3) | (r >> 2);
+    c[1] = (g << 2) | (g >> 4);
+    c[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * @brief calculate the palette of a BC1 color block
+ *
+ * @param c0 the first endpoint
+ * @param c1 the second endpoint
+ * @param fourColor true : four colors are interpolated | false : three colors and transparent black are used
+ * @param palette the palette to write to, as RGBA
+ */
+static void glgeBC1Palette(uint16_t c0, uint16_t c1, bool fourColor, int palette[4][4])
+{
+    //expand the endpoints
+    glgeExpand565(c0, palette[0]);
+    glgeExpand565(c1, palette[1]);
+    //interpolate the other entries
+    for (int c = 0; c < 3; c++)
+    {
+        if (fourColor)
+        {
+            palette[2][c] = (2*palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2*palette[1][c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    //set the alpha values
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+    palette[2][3] = 255;
+    palette[3][3] = fourColor ? 255 : 0;
+}
+
+/**
+ * @brief encode a BC1 color block
+ *
+ * @param px the pixels of the block
+ * @param preset the quality preset
+ * @param allowAlpha true : pixels with an alpha below 128 are stored as transparent | false : the alpha is ignored
+ * @param out the 8 bytes to write the block to
+ */
+static void glgeEncodeBC1(const float px[16][4], unsigned int preset, bool allowAlpha, uint8_t* out)
+{
+    //the weights of the second endpoint for both modes
+    static const float w4[4] = {0.f, 1.f, 1.f/3.f, 2.f/3.f};
+    static const float w3[4] = {0.f, 1.f, .5f, 0.f};
+    //check which pixels are transparent
+    bool ignore[16];
+    bool transparent = false;
+    for (int i = 0; i < 16; i++)
+    {
+        ignore[i] = allowAlpha && (px[i][3] < 128.f);
+        transparent |= ignore[i];
+    }
+    //fit the initial endpoints
+    float e0[4], e1[4];
+    glgeFitEndpoints(px, 3, ignore, preset != GLGE_BC_PRESET_FAST, e0, e1);
+    //store the best result
+    uint16_t bestC0 = 0, bestC1 = 0;
+    uint8_t bestIdx[16] = {};
+    float bestErr = std::numeric_limits<float>::max();
+    //get the amount of refinement steps
+    int iterations = (preset == GLGE_BC_PRESET_FAST) ? 0 : ((preset == GLGE_BC_PRESET_NORMAL) ? 1 : 3);
+    for (int it = 0; it <= iterations; it++)
+    {
+        //quantize the endpoints
+        uint16_t c0 = glgeQuantize565(e0), c1 = glgeQuantize565(e1);
+        //four color mode needs c0 > c1, three color mode with transparency needs c0 <= c1
+        if ((!transparent && c0 < c1) || (transparent && c0 > c1)) { std::swap(c0, c1); }
+        bool fourColor = c0 > c1;
+        //build the palette
+        int ipal[4][4];
+        glgeBC1Palette(c0, c1, fourColor, ipal);
+        float palette[4][4];
+        for (int p = 0; p < 4; p++) { for (int c = 0; c < 4; c++) { palette[p][c] = (float)ipal[p][c]; } }
+        //find the indices, the transparent entry is never used for opaque pixels
+        uint8_t idx[16] = {};
+        float err = glgeFindIndices(px, 3, palette, fourColor ? 4 : 3, ignore, idx);
+        //store the result if it is better
+        if (err < bestErr)
+        {
+            bestErr = err;
+            bestC0 = c0;
+            bestC1 = c1;
+            std::memcpy(bestIdx, idx, 16);
+        }
+        //refine the endpoints for the next iteration
+        if ((it == iterations) || !glgeRefineEndpoints(px, 3, ignore, fourColor ? w4 : w3, idx, e0, e1)) { break; }
+    }
+    //write the endpoints
+    out[0] = (uint8_t)(bestC0 & 0xFF);
+    out[1] = (uint8_t)(bestC0 >> 8);
+    out[2] = (uint8_t)(bestC1 & 0xFF);
+    out[3] = (uint8_t)(bestC1 >> 8);
+    //write the indices, transparent pixels use index 3
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        bits |= (uint32_t)(ignore[i] ? 3 : bestIdx[i]) << (i*2);
+    }
+    out[4] = (uint8_t)(bits);
+    out[5] = (uint8_t)(bits >> 8);
+    out[6] = (uint8_t)(bits >> 16);
+    out[7] = (uint8_t)(bits >> 24);
+}
+
+/**
+ * @brief decode a BC1 color block
+ *
+ * @param in the 8 bytes of the block
+ * @param forceFourColor true : the block is always decoded with four colors, like in BC3 | false : the endpoint order selects the mode
+ * @param out the 16 RGBA pixels to write to
+ */
+static void glgeDecodeBC1(const uint8_t* in, bool forceFourColor, uint8_t out[16][4])
+{
+    //read the endpoints
+    uint16_t c0 = (uint16_t)(in[0] | (in[1] << 8));
+    uint16_t c1 = (uint16_t)(in[2] | (in[3] << 8));
+    //build the palette
+    int palette[4][4];
+    glgeBC1Palette(c0, c1, forceFourColor || (c0 > c1), palette);
+    //read the indices
+    uint32_t bits = (uint32_t)in[4] | ((uint32_t)in[5] << 8) | ((uint32_t)in[6] << 16) | ((uint32_t)in[7] << 24);
+    for (int i = 0; i < 16; i++)
+    {
+        int idx = (bits >> (i*2)) & 3;
+        for (int c = 0; c < 4; c++) { out[i][c] = (uint8_t)palette[idx][c]; }
+    }
+}
+
+/**
+ * @brief calculate the palette of a BC4 block
+ *
+ * If e0 is larger than e1, the palette is the two endpoints followed by 6 values interpolated between them. Else it is
+ * the two endpoints, 4 interpolated values and the constants 0 and 255. The index of a value in the palette is the index
+ * that is stored for a pixel.
+ *
+ * @param e0 the first endpoint
+ * @param e1 the second endpoint
+ * @param palette the 8 values to write to
+ */
+static void glgeBC4Palette(int e0, int e1, int palette[8])
+{
+    //store the endpoints
+    palette[0] = e0;
+    palette[1] = e1;
+    //check the mode
+    if (e0 > e1)
+    {
+        //6 interpolated values
+        for (int i = 1; i < 7; i++) { palette[i+1] = ((7-i)*e0 + i*e1) / 7; }
+    }
+    else
+    {
+        //4 interpolated values and the extremes
+        for (int i = 1; i < 5; i++) { palette[i+1] = ((5-i)*e0 + i*e1) / 5; }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+/**
+ * @brief encode a single chanel as a BC4 block
+ *
+ * @param px the pixels of the block
+ * @param chanel the chanel to encode
+ * @param preset the quality preset
+ * @param out the 8 bytes to write the block to
+ */
+static void glgeEncodeBC4(const float px[16][4], int chanel, unsigned int preset, uint8_t* out)
+{
+    //the weights of the second endpoint in the 8 value mode
+    static const float w8[8] = {0.f, 1.f, 1.f/7.f, 2.f/7.f, 3.f/7.f, 4.f/7.f, 5.f/7.f, 6.f/7.f};
+    //extract the chanel
+    float v[16][4] = {};
+    float mn = 255, mx = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        v[i][0] = px[i][chanel];
+        mn = std::min(mn, v[i][0]);
+        mx = std::max(mx, v[i][0]);
+    }
+    //store the best result
+    int bestE0 = 0, bestE1 = 0;
+    uint8_t bestIdx[16] = {};
+    float bestErr = std::numeric_limits<float>::max();
+    //start with the extremes in the 8 value mode
+    float e0[4] = {mx, 0, 0, 0}, e1[4] = {mn, 0, 0, 0};
+    int iterations = (preset == GLGE_BC_PRESET_FAST) ? 0 : ((preset == GLGE_BC_PRESET_NORMAL) ? 1 : 3);
+    for (int it = 0; it <= iterations; it++)
+    {
+        //quantize the endpoints, the 8 value mode needs e0 > e1
+        int q0 = (int)(glgeClampByte(e0[0]) + .5f), q1 = (int)(glgeClampByte(e1[0]) + .5f);
+        if (q0 < q1) { std::swap(q0, q1); }
+        //build the palette
+        int ipal[8];
+        glgeBC4Palette(q0, q1, ipal);
+        float palette[8][4] = {};
+        for (int p = 0; p < 8; p++) { palette[p][0] = (float)ipal[p]; }
+        //find the indices
+        uint8_t idx[16] = {};
+        float err = glgeFindIndices(v, 1, palette, 8, NULL, idx);
+        if (err < bestErr)
+        {
+            bestErr = err;
+            bestE0 = q0;
+            bestE1 = q1;
+            std::memcpy(bestIdx, idx, 16);
+        }
+        //refine the endpoints, only the 8 value mode can be refined
+        if ((it == iterations) || (q0 == q1) || !glgeRefineEndpoints(v, 1, NULL, w8, idx, e0, e1)) { break; }
+    }
+    //the high preset also tries the 6 value mode, that stores 0 and 255 exactly
+    if (preset == GLGE_BC_PRESET_HIGH)
+    {
+        //get the range without the extremes
+        float inner0 = 255, inner1 = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            if ((v[i][0] > .5f) && (v[i][0] < 254.5f))
+            {
+                inner0 = std::min(inner0, v[i][0]);
+                inner1 = std::max(inner1, v[i][0]);
+            }
+        }
+        //only try if there are values between the extremes
+        if (inner0 <= inner1)
+        {
+            int q0 = (int)(inner0 + .5f), q1 = (int)(inner1 + .5f);
+            int ipal[8];
+            glgeBC4Palette(q0, q1, ipal);
+            float palette[8][4] = {};
+            for (int p = 0; p < 8; p++) { palette[p][0] = (float)ipal[p]; }
+            uint8_t idx[16] = {};
+            float err = glgeFindIndices(v, 1, palette, 8, NULL, idx);
+            if (err < bestErr)
+            {
+                bestErr = err;
+                bestE0 = q0;
+                bestE1 = q1;
+                std::memcpy(bestIdx, idx, 16);
+            }
+        }
+    }
+    //write the endpoints
+    out[0] = (uint8_t)bestE0;
+    out[1] = (uint8_t)bestE1;
+    //write the 3 bit indices
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; i++) { bits |= (uint64_t)bestIdx[i] << (i*3); }
+    for (int b = 0; b < 6; b++) { out[2+b] = (uint8_t)(bits >> (b*8)); }
+}
+
+/**
+ * @brief decode a BC4 block into a single chanel
+ *
+ * @param in the 8 bytes of the block
+ * @param chanel the chanel to write to
+ * @param out the 16 RGBA pixels to write to
+ */
+static void glgeDecodeBC4(const uint8_t* in, int chanel, uint8_t out[16][4])
+{
+    //build the palette
+    int palette[8];
+    glgeBC4Palette(in[0], in[1], palette);
+    //read the indices
+    uint64_t bits = 0;
+    for (int b = 0; b < 6; b++) { bits |= (uint64_t)in[2+b] << (b*8); }
+    for (int i = 0; i < 16; i++)
+    {
+        out[i][chanel] = (uint8_t)palette[(bits >> (i*3)) & 7];
+    }
+}
+
+/**
+ * @brief write bits to a block, starting with the lowest bit
+ *
+ * @param block the block to write to, must be cleared
+ * @param pos the current bit position, is advanced
+ * @param value the value to write
+ * @param count the amount of bits to write
+ */
+static void glgeWriteBits(uint8_t* block, int& pos, uint32_t value, int count)
+{
+    for (int i = 0; i < count; i++, pos++)
+    {
+        if ((value >> i) & 1) { block[pos >> 3] |= (uint8_t)(1 << (pos & 7)); }
+    }
+}
+
+/**
+ * @brief read bits from a block, starting with the lowest bit
+ *
+ * @param block the block to read from
+ * @param pos the current bit position, is advanced
+ * @param count the amount of bits to read
+ * @return uint32_t the read value
+ */
+static uint32_t glgeReadBits(const uint8_t* block, int& pos, int count)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < count; i++, pos++)
+    {
+        value |= (uint32_t)((block[pos >> 3] >> (pos & 7)) & 1) << i;
+    }
+    return value;
+}
+
+/**
+ * @brief quantize a BC7 mode 6 endpoint, the shared p-bit is chosen to minimize the error
+ *
+ * @param e the endpoint to quantize
+ * @param opaque true : the block is fully opaque, the p-bit is set so the alpha is stored as exactly 255 | false : both p-bits are tried
+ * @param q the 7 bit chanels to write to
+ * @param p the p-bit to write to
+ */
+static void glgeQuantizeBC7(const float e[4], bool opaque, int q[4], int& p)
+{
+    float bestErr = std::numeric_limits<float>::max();
+    //try both p-bits, an alpha of 255 can only be stored with a p-bit of 1
+    for (int pbit = opaque ? 1 : 0; pbit < 2; pbit++)
+    {
+        float err = 0;
+        int tmp[4];
+        for (int c = 0; c < 4; c++)
+        {
+            tmp[c] = std::min(127, std::max(0, (int)std::floor((glgeClampByte(e[c]) - (float)pbit) / 2.f + .5f)));
+            float diff = (float)(tmp[c]*2 + pbit) - e[c];
+            err += diff*diff;
+        }
+        if (err < bestErr)
+        {
+            bestErr = err;
+            p = pbit;
+            for (int c = 0; c < 4; c++) { q[c] = tmp[c]; }
+        }
+    }
+    //the refined endpoints can drift away from 255, so store the largest alpha for opaque blocks
+    if (opaque) { q[3] = 127; }
+}
+
+/**
+ * @brief calculate the palette of a BC7 mode 6 block
+ *
+ * @param q0 the first 7 bit endpoint
+ * @param p0 the p-bit of the first endpoint
+ * @param q1 the second 7 bit endpoint
+ * @param p1 the p-bit of the second endpoint
+ * @param palette the 16 RGBA entries to write to
+ */
+static void glgeBC7Palette(const int q0[4], int p0, const int q1[4], int p1, int palette[16][4])
+{
+    for (int c = 0; c < 4; c++)
+    {
+        //expand the endpoints to 8 bit
+        int a = q0[c]*2 + p0, b = q1[c]*2 + p1;
+        //interpolate with the 4 bit weights
+        for (int i = 0; i < 16; i++)
+        {
+            palette[i][c] = ((64 - glgeBC7Weights[i])*a + glgeBC7Weights[i]*b + 32) >> 6;
+        }
+    }
+}
+
+/**
+ * @brief encode a BC7 block, only mode 6 (one subset, RGBA, 7 bit endpoints with p-bits and 4 bit indices) is used
+ *
+ * @param px the pixels of the block
+ * @param preset the quality preset
+ * @param out the 16 bytes to write the block to
+ */
+static void glgeEncodeBC7(const float px[16][4], unsigned int preset, uint8_t* out)
+{
+    //the weights of the second endpoint for every index
+    float weights[16];
+    for (int i = 0; i < 16; i++) { weights[i] = (float)glgeBC7Weights[i] / 64.f; }
+    //check if the block is fully opaque, then the alpha must decode to exactly 255
+    bool opaque = true;
+    for (int i = 0; i < 16; i++) { opaque &= (px[i][3] >= 255.f); }
+    //fit the initial endpoints
+    float e0[4], e1[4];
+    glgeFitEndpoints(px, 4, NULL, preset != GLGE_BC_PRESET_FAST, e0, e1);
+    //store the best result
+    int bestQ0[4] = {}, bestQ1[4] = {}, bestP0 = 0, bestP1 = 0;
+    uint8_t bestIdx[16] = {};
+    float bestErr = std::numeric_limits<float>::max();
+    int iterations = (preset == GLGE_BC_PRESET_FAST) ? 0 : ((preset == GLGE_BC_PRESET_NORMAL) ? 1 : 3);
+    for (int it = 0; it <= iterations; it++)
+    {
+        //quantize the endpoints
+        int q0[4], q1[4], p0 = 0, p1 = 0;
+        glgeQuantizeBC7(e0, opaque, q0, p0);
+        glgeQuantizeBC7(e1, opaque, q1, p1);
+        //build the palette
+        int ipal[16][4];
+        glgeBC7Palette(q0, p0, q1, p1, ipal);
+        float palette[16][4];
+        for (int p = 0; p < 16; p++) { for (int c = 0; c < 4; c++) { palette[p][c] = (float)ipal[p][c]; } }
+        //find the indices
+        uint8_t idx[16] = {};
+        float err = glgeFindIndices(px, 4, palette, 16, NULL, idx);
+        if (err < bestErr)
+        {
+            bestErr = err;
+            for (int c = 0; c < 4; c++) { bestQ0[c] = q0[c]; bestQ1[c] = q1[c]; }
+            bestP0 = p0;
+            bestP1 = p1;
+            std::memcpy(bestIdx, idx, 16);
+        }
+        //refine the endpoints for the next iteration
+        if ((it == iterations) || !glgeRefineEndpoints(px, 4, NULL, weights, idx, e0, e1)) { break; }
+    }
+    //the highest bit of the anchor index is implicit zero, so swap the endpoints if it is set
+    if (bestIdx[0] & 8)
+    {
+        for (int c = 0; c < 4; c++) { std::swap(bestQ0[c], bestQ1[c]); }
+        std::swap(bestP0, bestP1);
+        for (int i = 0; i < 16; i++) { bestIdx[i] = (uint8_t)(15 - bestIdx[i]); }
+    }
+    //write the block
+    std::memset(out, 0, 16);
+    int pos = 0;
+    //mode 6 is stored as 6 zero bits followed by a one
+    glgeWriteBits(out, pos, 1 << 6, 7);
+    //the endpoints are stored per chanel
+    for (int c = 0; c < 4; c++)
+    {
+        glgeWriteBits(out, pos, (uint32_t)bestQ0[c], 7);
+        glgeWriteBits(out, pos, (uint32_t)bestQ1[c], 7);
+    }
+    //write the p-bits
+    glgeWriteBits(out, pos, (uint32_t)bestP0, 1);
+    glgeWriteBits(out, pos, (uint32_t)bestP1, 1);
+    //write the indices, the anchor index only has 3 bits
+    glgeWriteBits(out, pos, bestIdx[0], 3);
+    for (int i = 1; i < 16; i++) { glgeWriteBits(out, pos, bestIdx[i], 4); }
+}
+
+/**
+ * @brief decode a BC7 block, only mode 6 is supported, other modes decode to transparent black
+ *
+ * @param in the 16 bytes of the block
+ * @param out the 16 RGBA pixels to write to
+ */
+static void glgeDecodeBC7(const uint8_t* in, uint8_t out[16][4])
+{
+    //check for mode 6
+    if ((in[0] & 0x7F) != 0x40)
+    {
+        std::memset(out, 0, 64);
+        return;
+    }
+    //skip the mode bits
+    int pos = 7;
+    //read the endpoints
+    int q0[4], q1[4];
+    for (int c = 0; c < 4; c++)
+    {
+        q0[c] = (int)glgeReadBits(in, pos, 7);
+        q1[c] = (int)glgeReadBits(in, pos, 7);
+    }
+    //read the p-bits
+    int p0 = (int)glgeReadBits(in, pos, 1);
+    int p1 = (int)glgeReadBits(in, pos, 1);
+    //build the palette
+    int palette[16][4];
+    glgeBC7Palette(q0, p0, q1, p1, palette);
+    //read the indices
+    for (int i = 0; i < 16; i++)
+    {
+        int idx = (int)glgeReadBits(in, pos, (i == 0) ? 3 : 4);
+        for (int c = 0; c < 4; c++) { out[i][c] = (uint8_t)palette[idx][c]; }
+    }
+}
+
+/**
+ * @brief encode a single block in any supported format
+ *
+ * @param px the pixels of the block
+ * @param format the block compression format
+ * @param preset the quality preset
+ * @param out the block to write to
+ */
+static void glgeEncodeBlock(const float px[16][4], unsigned int format, unsigned int preset, uint8_t* out)
+{
+    switch (format)
+    {
+    case GLGE_BC1:
+        glgeEncodeBC1(px, preset, true, out);
+        break;
+    case GLGE_BC3:
+        //the alpha is stored like BC4, followed by an opaque color block
+        glgeEncodeBC4(px, 3, preset, out);
+        glgeEncodeBC1(px, preset, false, out + 8);
+        break;
+    case GLGE_BC4:
+        glgeEncodeBC4(px, 0, preset, out);
+        break;
+    case GLGE_BC5:
+        glgeEncodeBC4(px, 0, preset, out);
+        glgeEncodeBC4(px, 1, preset, out + 8);
+        break;
+    case GLGE_BC7:
+        glgeEncodeBC7(px, preset, out);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief decode a single block in any supported format
+ *
+ * @param in the block to decode
+ * @param format the block compression format
+ * @param out the 16 RGBA pixels to write to
+ */
+static void glgeDecodeBlock(const uint8_t* in, unsigned int format, uint8_t out[16][4])
+{
+    //single and dual chanel formats read as (r, g, 0, 1)
+    if ((format == GLGE_BC4) || (format == GLGE_BC5))
+    {
+        for (int i = 0; i < 16; i++) { out[i][0] = 0; out[i][1] = 0; out[i][2] = 0; out[i][3] = 255; }
+    }
+    switch (format)
+    {
+    case GLGE_BC1:
+        glgeDecodeBC1(in, false, out);
+        break;
+    case GLGE_BC3:
+        glgeDecodeBC1(in + 8, true, out);
+        glgeDecodeBC4(in, 3, out);
+        break;
+    case GLGE_BC4:
+        glgeDecodeBC4(in, 0, out);
+        break;
+    case GLGE_BC5:
+        glgeDecodeBC4(in, 0, out);
+        glgeDecodeBC4(in + 8, 1, out);
+        break;
+    case GLGE_BC7:
+        glgeDecodeBC7(in, out);
+        break;
+    default:
+        std::memset(out, 0, 64);
+        break;
+    }
+}
+
+unsigned int glgeGetBlockSize(unsigned int format)
+{
+    switch (format)
+    {
+    case GLGE_BC1:
+    case GLGE_BC4:
+        return 8;
+    case GLGE_BC3:
+    case GLGE_BC5:
+    case GLGE_BC7:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+const char* glgeGetBlockCompressionName(unsigned int format)
+{
+    //the names in the order of the format defines
+    static const char* names[] = {"none", "BC1", "BC3", "BC4", "BC5", "BC7"};
+    //check if the format exists
+    if (format > GLGE_BC7) { return "unknown"; }
+    return names[format];
+}
+
+uint64_t glgeGetCompressedSize(unsigned int format, int width, int height)
+{
+    //every started block is stored completely
+    return (uint64_t)((width + 3) / 4) * (uint64_t)((height + 3) / 4) * glgeGetBlockSize(format);
+}
+
+/**
+ * @brief compress every n-th block row of an image, used as the body of the worker threads
+ *
+ * @param rgba the image data
+ * @param width the width of the image
+ * @param height the height of the image
+ * @param format the block compression format
+ * @param preset the quality preset
+ * @param firstRow the first block row to compress
+ * @param rowStep the amount of rows to advance after each row
+ * @param out the compressed blocks of the whole image
+ */
+static void glgeCompressBlockRows(const uint8_t* rgba, int width, int height, unsigned int format, unsigned int preset, int firstRow, int rowStep, uint8_t* out)
+{
+    //get the amount of blocks and the size of a block
+    int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    unsigned int blockSize = glgeGetBlockSize(format);
+    float px[16][4];
+    for (int by = firstRow; by < blocksY; by += rowStep)
+    {
+        for (int bx = 0; bx < blocksX; bx++)
+        {
+            //read the block, pixels outside of the image repeat the edge
+            for (int y = 0; y < 4; y++)
+            {
+                int sy = std::min(by*4 + y, height - 1);
+                for (int x = 0; x < 4; x++)
+                {
+                    int sx = std::min(bx*4 + x, width - 1);
+                    const uint8_t* src = rgba + ((size_t)sy*width + sx)*4;
+                    for (int c = 0; c < 4; c++) { px[y*4 + x][c] = (float)src[c]; }
+                }
+            }
+            //encode the block
+            glgeEncodeBlock(px, format, preset, out + ((size_t)by*blocksX + bx)*blockSize);
+        }
+    }
+}
+
+std::vector<uint8_t> glgeCompressBlocks(const uint8_t* rgba, int width, int height, unsigned int format, unsigned int preset)
+{
+    //check the inputs
+    if (glgeGetBlockSize(format) == 0)
+    {
+        GLGE_THROW_ERROR("Unknown block compression format " + std::to_string(format))
+        return {};
+    }
+    if (!rgba || (width <= 0) || (height <= 0))
+    {
+        GLGE_THROW_ERROR("Can't compress an empty image")
+        return {};
+    }
+    //allocate the output
+    std::vector<uint8_t> out(glgeGetCompressedSize(format, width, height));
+    //split the block rows across the available cores
+    int blocksY = (height + 3) / 4;
+    int threadCount = std::max(1, std::min((int)std::thread::hardware_concurrency(), blocksY));
+    if (threadCount == 1)
+    {
+        glgeCompressBlockRows(rgba, width, height, format, preset, 0, 1, out.data());
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++)
+        {
+            threads.emplace_back(glgeCompressBlockRows, rgba, width, height, format, preset, t, threadCount, out.data());
+        }
+        for (std::thread& t : threads) { t.join(); }
+    }
+    //return the blocks
+    return out;
+}
+
+void glgeDecompressBlocks(const uint8_t* blocks, int width, int height, unsigned int format, uint8_t* rgba)
+{
+    //get the block size
+    unsigned int blockSize = glgeGetBlockSize(format);
+    if (blockSize == 0)
+    {
+        GLGE_THROW_ERROR("Unknown block compression format " + std::to_string(format))
+        return;
+    }
+    int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    uint8_t px[16][4];
+    for (int by = 0; by < blocksY; by++)
+    {
+        for (int bx = 0; bx < blocksX; bx++)
+        {
+            //decode the block
+            glgeDecodeBlock(blocks + ((size_t)by*blocksX + bx)*blockSize, format, px);
+            //write the pixels that are inside of the image
+            for (int y = 0; y < 4; y++)
+            {
+                int dy = by*4 + y;
+                if (dy >= height) { break; }
+                for (int x = 0; x < 4; x++)
+                {
+                    int dx = bx*4 + x;
+                    if (dx >= width) { break; }
+                    std::memcpy(rgba + ((size_t)dy*width + dx)*4, px[y*4 + x], 4);
+                }
+            }
+        }
+    }
+}
+
+float glgeCalculatePSNR(const uint8_t* original, const uint8_t* decoded, int width, int height, unsigned int format)
+{
+    //get the compared chanels
+    int chanels = 4;
+    if (format == GLGE_BC1) { chanels = 3; }
+    else if (format == GLGE_BC4) { chanels = 1; }
+    else if (format == GLGE_BC5) { chanels = 2; }
+    //sum the squared errors
+    double sum = 0;
+    size_t pixels = (size_t)width * height;
+    for (size_t i = 0; i < pixels; i++)
+    {
+        for (int c = 0; c < chanels; c++)
+        {
+            double diff = (double)original[i*4 + c] - (double)decoded[i*4 + c];
+            sum += diff*diff;
+        }
+    }
+    //identical images have an infinite PSNR
+    if ((sum == 0) || (pixels == 0)) { return std::numeric_limits<float>::infinity(); }
+    double mse = sum / (double)(pixels * chanels);
+    return (float)(10.0 * std::log10((255.0 * 255.0) / mse));
+}
+
+/**
+ * @brief halve an RGBA8 image with a box filter
+ *
+ * @param src the image to downsample
+ * @param width the width of the image
+ * @param height the height of the image
+ * @param newWidth the width of the new image
+ * @param newHeight the height of the new image
+ * @return std::vector<uint8_t> the downsampled image
+ */
+static std::vector<uint8_t> glgeDownsample(const uint8_t* src, int width, int height, int newWidth, int newHeight)
+{
+    std::vector<uint8_t> dst((size_t)newWidth * newHeight * 4);
+    for (int y = 0; y < newHeight; y++)
+    {
+        //odd sizes repeat the last row
+        int y0 = std::min(y*2, height - 1), y1 = std::min(y*2 + 1, height - 1);
+        for (int x = 0; x < newWidth; x++)
+        {
+            int x0 = std::min(x*2, width - 1), x1 = std::min(x*2 + 1, width - 1);
+            for (int c = 0; c < 4; c++)
+            {
+                int sum = src[((size_t)y0*width + x0)*4 + c] + src[((size_t)y0*width + x1)*4 + c] +
+                          src[((size_t)y1*width + x0)*4 + c] + src[((size_t)y1*width + x1)*4 + c];
+                dst[((size_t)y*newWidth + x)*4 + c] = (uint8_t)((sum + 2) >> 2);
+            }
+        }
+    }
+    return dst;
+}
+
+CompressedImage glgeCompressImage(const uint8_t* rgba, int width, int height, unsigned int format, unsigned int preset, bool mipmaps)
+{
+    //store the result
+    CompressedImage image;
+    image.format = format;
+    image.width = width;
+    image.height = height;
+    //compress the first level
+    image.levels.push_back(glgeCompressBlocks(rgba, width, height, format, preset));
+    //stop if the compression failed
+    if (image.levels[0].empty()) { image.levels.clear(); return image; }
+    //decode the first level again to measure the quality
+    std::vector<uint8_t> decoded((size_t)width * height * 4);
+    glgeDecompressBlocks(image.levels[0].data(), width, height, format, decoded.data());
+    image.psnr = glgeCalculatePSNR(rgba, decoded.data(), width, height, format);
+    //create the mip chain
+    if (mipmaps)
+    {
+        std::vector<uint8_t> level;
+        const uint8_t* src = rgba;
+        int w = width, h = height;
+        while ((w > 1) || (h > 1))
+        {
+            int nw = std::max(1, w / 2), nh = std::max(1, h / 2);
+            level = glgeDownsample(src, w, h, nw, nh);
+            image.levels.push_back(glgeCompressBlocks(level.data(), nw, nh, format, preset));
+            src = level.data();
+            w = nw;
+            h = nh;
+        }
+    }
+    //return the image
+    return image;
+}
+
+std::string glgeGetCompressedCachePath(const char* source)
+{
+    //the cache is stored next to the source
+    return std::string(source) + GLGE_BC_CACHE_ENDING;
+}
+
+bool glgeLoadCompressedCache(const char* source, unsigned int format, unsigned int preset, CompressedImage* image)
+{
+    //get the state of the source file
+    struct stat srcStat;
+    if (stat(source, &srcStat) != 0) { return false; }
+    //open the cache file
+    std::ifstream file(glgeGetCompressedCachePath(source), std::ios::binary);
+    if (!file) { return false; }
+    //read the header
+    char magic[8];
+    uint32_t header[5];
+    float psnr;
+    uint64_t srcSize;
+    int64_t srcTime;
+    file.read(magic, 8);
+    file.read((char*)header, sizeof(header));
+    file.read((char*)&psnr, sizeof(psnr));
+    file.read((char*)&srcSize, sizeof(srcSize));
+    file.read((char*)&srcTime, sizeof(srcTime));
+    if (!file) { return false; }
+    //check that the cache matches the request and the source did not change
+    if (std::memcmp(magic, glgeBCCacheMagic, 8) != 0) { return false; }
+    if ((header[0] != format) || (header[1] != preset)) { return false; }
+    if ((srcSize != (uint64_t)srcStat.st_size) || (srcTime != (int64_t)srcStat.st_mtime)) { return false; }
+    //check the size of the image
+    int width = (int)header[2], height = (int)header[3];
+    if ((header[2] == 0) || (header[3] == 0) || (header[2] > 65536) || (header[3] > 65536) || (header[4] == 0) || (header[4] > 32)) { return false; }
+    //read all levels
+    CompressedImage img;
+    img.format = format;
+    img.width = width;
+    img.height = height;
+    img.psnr = psnr;
+    img.levels.resize(header[4]);
+    int w = width, h = height;
+    for (uint32_t i = 0; i < header[4]; i++)
+    {
+        //every level must have exactly the size of its blocks
+        uint64_t size = 0;
+        file.read((char*)&size, sizeof(size));
+        if (!file || (size != glgeGetCompressedSize(format, w, h))) { return false; }
+        img.levels[i].resize(size);
+        file.read((char*)img.levels[i].data(), size);
+        if (!file) { return false; }
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    //the cache is valid
+    *image = std::move(img);
+    return true;
+}
+
+bool glgeStoreCompressedCache(const char* source, unsigned int preset, const CompressedImage& image)
+{
+    //get the state of the source file
+    struct stat srcStat;
+    if (stat(source, &srcStat) != 0) { return false; }
+    //write to a temporary file first, so a partial write is never read as a cache
+    std::string path = glgeGetCompressedCachePath(source);
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) { return false; }
+        //write the header
+        uint32_t header[5] = {image.format, preset, (uint32_t)image.width, (uint32_t)image.height, (uint32_t)image.levels.size()};
+        uint64_t srcSize = (uint64_t)srcStat.st_size;
+        int64_t srcTime = (int64_t)srcStat.st_mtime;
+        file.write(glgeBCCacheMagic, 8);
+        file.write((const char*)header, sizeof(header));
+        file.write((const char*)&image.psnr, sizeof(image.psnr));
+        file.write((const char*)&srcSize, sizeof(srcSize));
+        file.write((const char*)&srcTime, sizeof(srcTime));
+        //write all levels
+        for (const std::vector<uint8_t>& level : image.levels)
+        {
+            uint64_t size = level.size();
+            file.write((const char*)&size, sizeof(size));
+            file.write((const char*)level.data(), size);
+        }
+        if (!file) { std::remove(tmpPath.c_str()); return false; }
+    }
+    //replace the old cache
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) { std::remove(tmpPath.c_str()); return false; }
+    return true;
+}
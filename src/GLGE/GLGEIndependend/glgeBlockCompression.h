@@ -0,0 +1,193 @@
+/**
+ * @file glgeBlockCompression.h
+ * @author DM8AT
+ * @brief a CPU encoder and decoder for the BCn block compression formats and a cache file to store the compressed textures in
+ * @version 0.1
+ * @date 2024-03-02
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+#ifndef _GLGE_BLOCK_COMPRESSION_H_
+#define _GLGE_BLOCK_COMPRESSION_H_
+
+//include the needed standard librarys
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+/**
+ * @brief say that no block compression is used
+ */
+#define GLGE_BC_NONE 0
+/**
+ * @brief BC1 (DXT1), RGB with an optional 1 bit alpha, 8 bytes per block
+ */
+#define GLGE_BC1 1
+/**
+ * @brief BC3 (DXT5), RGBA with an interpolated alpha, 16 bytes per block
+ */
+#define GLGE_BC3 2
+/**
+ * @brief BC4, a single chanel (red), 8 bytes per block. Used for roughness and metallic maps
+ */
+#define GLGE_BC4 3
+/**
+ * @brief BC5, two chanels (red and green), 16 bytes per block. Used for normal maps
+ */
+#define GLGE_BC5 4
+/**
+ * @brief BC7, high quality RGBA, 16 bytes per block. Only mode 6 is produced and decoded
+ */
+#define GLGE_BC7 5
+
+/**
+ * @brief the fastest preset, uses the bounding box of the block as endpoints
+ */
+#define GLGE_BC_PRESET_FAST 0
+/**
+ * @brief the default preset, uses the principal axis of the block and refines the endpoints once
+ */
+#define GLGE_BC_PRESET_NORMAL 1
+/**
+ * @brief the slowest preset, refines the endpoints multiple times and tries alternative block modes
+ */
+#define GLGE_BC_PRESET_HIGH 2
+
+/**
+ * @brief the file ending appended to the source file to get the path of the compressed cache file
+ */
+#define GLGE_BC_CACHE_ENDING ".glgebc"
+
+/**
+ * @brief store a block compressed image with all of its mip levels
+ */
+struct CompressedImage
+{
+    /**
+     * @brief the block compression format of the image (GLGE_BC1, GLGE_BC3, ...)
+     */
+    unsigned int format = GLGE_BC_NONE;
+    /**
+     * @brief the width of the first mip level in pixels
+     */
+    int width = 0;
+    /**
+     * @brief the height of the first mip level in pixels
+     */
+    int height = 0;
+    /**
+     * @brief the peak signal to noise ratio of the first mip level in dB
+     */
+    float psnr = 0;
+    /**
+     * @brief the compressed blocks of all mip levels, the first level is the full resolution
+     */
+    std::vector<std::vector<uint8_t>> levels = {};
+};
+
+/**
+ * @brief get the size of a single 4x4 block in bytes
+ *
+ * @param format the block compression format
+ * @return unsigned int the size of a block in bytes, 0 if the format is unknown
+ */
+unsigned int glgeGetBlockSize(unsigned int format);
+
+/**
+ * @brief get the name of a block compression format
+ *
+ * @param format the block compression format
+ * @return const char* the name of the format, "unknown" if the format does not exist
+ */
+const char* glgeGetBlockCompressionName(unsigned int format);
+
+/**
+ * @brief get the size of an image compressed with a block compression format
+ *
+ * @param format the block compression format
+ * @param width the width of the image in pixels
+ * @param height the height of the image in pixels
+ * @return uint64_t the size of the compressed image in bytes
+ */
+uint64_t glgeGetCompressedSize(unsigned int format, int width, int height);
+
+/**
+ * @brief compress RGBA8 image data into blocks, the blocks are split across multiple threads
+ *
+ * @param rgba the image data, 4 bytes per pixel
+ * @param width the width of the image in pixels
+ * @param height the height of the image in pixels
+ * @param format the block compression format to use
+ * @param preset the quality preset to use (GLGE_BC_PRESET_FAST, GLGE_BC_PRESET_NORMAL or GLGE_BC_PRESET_HIGH)
+ * @return std::vector<uint8_t> the compressed blocks, empty if the format is unknown
+ */
+std::vector<uint8_t> glgeCompressBlocks(const uint8_t* rgba, int width, int height, unsigned int format, unsigned int preset = GLGE_BC_PRESET_NORMAL);
+
+/**
+ * @brief decompress blocks into RGBA8 image data
+ *
+ * @param blocks the compressed blocks
+ * @param width the width of the image in pixels
+ * @param height the height of the image in pixels
+ * @param format the block compression format of the blocks
+ * @param rgba the image data to write to, must have space for 4 bytes per pixel
+ */
+void glgeDecompressBlocks(const uint8_t* blocks, int width, int height, unsigned int format, uint8_t* rgba);
+
+/**
+ * @brief calculate the peak signal to noise ratio between two RGBA8 images, only the chanels stored by the format are compared
+ *
+ * @param original the original image data
+ * @param decoded the image data after compression
+ * @param width the width of both images in pixels
+ * @param height the height of both images in pixels
+ * @param format the block compression format to get the compared chanels from
+ * @return float the PSNR in dB, infinity if the images are identical
+ */
+float glgeCalculatePSNR(const uint8_t* original, const uint8_t* decoded, int width, int height, unsigned int format);
+
+/**
+ * @brief compress an RGBA8 image with a full mip chain
+ *
+ * @param rgba the image data, 4 bytes per pixel
+ * @param width the width of the image in pixels
+ * @param height the height of the image in pixels
+ * @param format the block compression format to use
+ * @param preset the quality preset to use
+ * @param mipmaps true : a full mip chain is generated | false : only the first level is compressed
+ * @return CompressedImage the compressed image including the PSNR of the first level
+ */
+CompressedImage glgeCompressImage(const uint8_t* rgba, int width, int height, unsigned int format, unsigned int preset = GLGE_BC_PRESET_NORMAL, bool mipmaps = true);
+
+/**
+ * @brief get the path of the compressed cache file for a source file
+ *
+ * @param source the path to the source image
+ * @return std::string the path to the cache file
+ */
+std::string glgeGetCompressedCachePath(const char* source);
+
+/**
+ * @brief load a compressed image from the cache file of a source file
+ *
+ * @param source the path to the source image
+ * @param format the block compression format the cache must have
+ * @param preset the preset the cache must have been created with
+ * @param image the image to load the data into
+ * @return true : the cache file exists and is up to date with the source | false : the image must be compressed again
+ */
+bool glgeLoadCompressedCache(const char* source, unsigned int format, unsigned int preset, CompressedImage* image);
+
+/**
+ * @brief store a compressed image in the cache file next to the source file
+ *
+ * @param source the path to the source image
+ * @param preset the preset the image was compressed with
+ * @param image the compressed image to store
+ * @return true : the cache file was written | false : the cache file could not be written
+ */
+bool glgeStoreCompressedCache(const char* source, unsigned int preset, const CompressedImage& image);
+
+#endif
@@ -0,0 +1,360 @@
+/**
+ * @file glgeCompression.cpp
+ * @author DM8AT
+ * @brief implement the compression of binary data
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the header
+#include "glgeCompression.h"
+//include the needed standard librarys
+#include <vector>
+#include <cstring>
+
+/**
+ * @brief the minimum length of a match
+ */
+#define GLGE_COMPRESSION_MIN_MATCH 4
+/**
+ * @brief the last bytes of a block are always stored as literals
+ */
+#define GLGE_COMPRESSION_LAST_LITERALS 5
+/**
+ * @brief the last match has to start this many bytes before the end of the block
+ */
+#define GLGE_COMPRESSION_MF_LIMIT 12
+/**
+ * @brief the largest distance a match can have
+ */
+#define GLGE_COMPRESSION_MAX_DISTANCE 65535
+/**
+ * @brief the amount of bits used for the hash table
+ */
+#define GLGE_COMPRESSION_HASH_BITS 16
+/**
+ * @brief the maximum amount of earlier matches checked per position by GLGE_COMPRESSION_HIGH
+ */
+#define GLGE_COMPRESSION_MAX_ATTEMPTS 256
+
+/**
+ * @brief read 4 bytes without alignment requirements
+ */
+static inline uint32_t glgeRead32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief hash 4 bytes for the hash table
+ */
+static inline uint32_t glgeHash4(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - GLGE_COMPRESSION_HASH_BITS);
+}
+
+/**
+ * @brief count how many bytes two positions have in common
+ *
+ * @param a the first position
+ * @param b the second position, it is before a
+ * @param end the end of the data for a
+ * @return size_t the amount of equal bytes
+ */
+static inline size_t glgeMatchLength(const uint8_t* a, const uint8_t* b, const uint8_t* end)
+{
+    //store the start
+    const uint8_t* start = a;
+    //compare 8 bytes at once
+    while (a + 8 <= end)
+    {
+        uint64_t x, y;
+        memcpy(&x, a, 8);
+        memcpy(&y, b, 8);
+        uint64_t diff = x ^ y;
+        if (diff)
+        {
+            //the first different byte is the lowest set byte on little endian machines
+#if defined(__GNUC__) || defined(__clang__)
+            return (size_t)(a - start) + (size_t)(__builtin_ctzll(diff) >> 3);
+#else
+            while (*a == *b) { a++; b++; }
+            return (size_t)(a - start);
+#endif
+        }
+        a += 8;
+        b += 8;
+    }
+    //compare the remaining bytes
+    while ((a < end) && (*a == *b)) { a++; b++; }
+    return (size_t)(a - start);
+}
+
+/**
+ * @brief write a length that doesn't fit into the token
+ */
+static inline uint8_t* glgeWriteLength(uint8_t* op, size_t length)
+{
+    //write as many 255 as needed and the remainder
+    while (length >= 255) { *op++ = 255; length -= 255; }
+    *op++ = (uint8_t)length;
+    return op;
+}
+
+/**
+ * @brief write a sequence of literals followed by a match
+ *
+ * @param op the output position
+ * @param literals the literals
+ * @param litLength the amount of literals
+ * @param offset the distance of the match
+ * @param matchLength the length of the match, 0 for the last sequence that has no match
+ * @return uint8_t* the new output position
+ */
+static inline uint8_t* glgeWriteSequence(uint8_t* op, const uint8_t* literals, size_t litLength, size_t offset, size_t matchLength)
+{
+    //write the token
+    uint8_t* token = op++;
+    *token = (uint8_t)(((litLength >= 15) ? 15 : litLength) << 4);
+    if (litLength >= 15) { op = glgeWriteLength(op, litLength - 15); }
+    //write the literals
+    if (litLength) { memcpy(op, literals, litLength); }
+    op += litLength;
+    //the last sequence has no match
+    if (matchLength == 0) { return op; }
+    //write the offset in little endian
+    *op++ = (uint8_t)(offset & 0xFF);
+    *op++ = (uint8_t)(offset >> 8);
+    //write the length of the match
+    size_t ml = matchLength - GLGE_COMPRESSION_MIN_MATCH;
+    *token |= (uint8_t)((ml >= 15) ? 15 : ml);
+    if (ml >= 15) { op = glgeWriteLength(op, ml - 15); }
+    return op;
+}
+
+size_t glgeCompressBound(size_t size)
+{
+    //incompressible data grows by one byte per 255 literals and the token
+    return size + size / 255 + 16;
+}
+
+/**
+ * @brief compress with a single hash lookup per position
+ */
+static size_t glgeCompressFast(const uint8_t* src, size_t size, uint8_t* dst)
+{
+    //store the output position
+    uint8_t* op = dst;
+    //store the start of the next literals
+    size_t anchor = 0;
+    //small blocks are stored as literals
+    if (size >= GLGE_COMPRESSION_MF_LIMIT + 1)
+    {
+        //store the last position of every hash
+        std::vector<uint32_t> table(1 << GLGE_COMPRESSION_HASH_BITS, 0);
+        //store the last position a match may start and end at
+        size_t limit = size - GLGE_COMPRESSION_MF_LIMIT;
+        const uint8_t* matchEnd = src + size - GLGE_COMPRESSION_LAST_LITERALS;
+        //store the read position
+        size_t ip = 1;
+        table[glgeHash4(glgeRead32(src))] = 0;
+        while (ip < limit)
+        {
+            //look up the last position with the same hash
+            uint32_t seq = glgeRead32(src + ip);
+            uint32_t h = glgeHash4(seq);
+            size_t ref = table[h];
+            table[h] = (uint32_t)ip;
+            //check if the position is a match
+            if ((ip - ref > GLGE_COMPRESSION_MAX_DISTANCE) || (glgeRead32(src + ref) != seq))
+            {
+                //skip faster through data that dosn't compress
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+            //extend the match backwards
+            while ((ip > anchor) && (ref > 0) && (src[ip - 1] == src[ref - 1])) { ip--; ref--; }
+            //extend the match forwards
+            size_t len = GLGE_COMPRESSION_MIN_MATCH + glgeMatchLength(src + ip + GLGE_COMPRESSION_MIN_MATCH, src + ref + GLGE_COMPRESSION_MIN_MATCH, matchEnd);
+            //write the sequence
+            op = glgeWriteSequence(op, src + anchor, ip - anchor, ip - ref, len);
+            ip += len;
+            anchor = ip;
+            //store a position inside of the match to find following matches
+            if (ip < limit) { table[glgeHash4(glgeRead32(src + ip - 2))] = (uint32_t)(ip - 2); }
+        }
+    }
+    //write the remaining literals
+    op = glgeWriteSequence(op, src + anchor, size - anchor, 0, 0);
+    return (size_t)(op - dst);
+}
+
+/**
+ * @brief compress with a search through all earlier positions with the same hash
+ */
+static size_t glgeCompressHigh(const uint8_t* src, size_t size, uint8_t* dst)
+{
+    //store the output position
+    uint8_t* op = dst;
+    //store the start of the next literals
+    size_t anchor = 0;
+    //small blocks are stored as literals
+    if (size >= GLGE_COMPRESSION_MF_LIMIT + 1)
+    {
+        //store the last position of every hash, -1 if no position has the hash
+        std::vector<int64_t> head(1 << GLGE_COMPRESSION_HASH_BITS, -1);
+        //store the distance to the previous position with the same hash, 0 ends the chain
+        std::vector<uint16_t> chain(GLGE_COMPRESSION_MAX_DISTANCE + 1, 0);
+        //store the last position a match may start and end at
+        size_t limit = size - GLGE_COMPRESSION_MF_LIMIT;
+        const uint8_t* matchEnd = src + size - GLGE_COMPRESSION_LAST_LITERALS;
+        //store the next position to insert into the chains
+        size_t next = 0;
+        //store the read position
+        size_t ip = 0;
+        while (ip < limit)
+        {
+            //insert all positions up to the current one
+            for (; next <= ip; next++)
+            {
+                uint32_t h = glgeHash4(glgeRead32(src + next));
+                size_t delta = (head[h] < 0) ? 0 : next - (size_t)head[h];
+                chain[next & GLGE_COMPRESSION_MAX_DISTANCE] = (uint16_t)((delta > GLGE_COMPRESSION_MAX_DISTANCE) ? 0 : delta);
+                head[h] = (int64_t)next;
+            }
+            //search the longest match
+            size_t bestLen = 0;
+            size_t bestRef = 0;
+            uint32_t seq = glgeRead32(src + ip);
+            size_t delta = chain[ip & GLGE_COMPRESSION_MAX_DISTANCE];
+            size_t ref = ip - delta;
+            for (int attempts = GLGE_COMPRESSION_MAX_ATTEMPTS; (delta != 0) && (ip - ref <= GLGE_COMPRESSION_MAX_DISTANCE) && (attempts > 0); attempts--)
+            {
+                //only compare the whole match if it can be longer than the best one
+                if ((src[ref + bestLen] == src[ip + bestLen]) && (glgeRead32(src + ref) == seq))
+                {
+                    size_t len = GLGE_COMPRESSION_MIN_MATCH + glgeMatchLength(src + ip + GLGE_COMPRESSION_MIN_MATCH, src + ref + GLGE_COMPRESSION_MIN_MATCH, matchEnd);
+                    if (len > bestLen) { bestLen = len; bestRef = ref; }
+                    //stop if the match reaches the end
+                    if (src + ip + len >= matchEnd) { break; }
+                }
+                //go to the previous position with the same hash
+                delta = chain[ref & GLGE_COMPRESSION_MAX_DISTANCE];
+                ref -= delta;
+            }
+            //check if a match was found
+            if (bestLen < GLGE_COMPRESSION_MIN_MATCH)
+            {
+                ip++;
+                continue;
+            }
+            //write the sequence
+            op = glgeWriteSequence(op, src + anchor, ip - anchor, ip - bestRef, bestLen);
+            ip += bestLen;
+            anchor = ip;
+        }
+    }
+    //write the remaining literals
+    op = glgeWriteSequence(op, src + anchor, size - anchor, 0, 0);
+    return (size_t)(op - dst);
+}
+
+size_t glgeCompress(const uint8_t* src, size_t size, uint8_t* dst, uint8_t mode)
+{
+    //select the compressor
+    if (mode == GLGE_COMPRESSION_HIGH) { return glgeCompressHigh(src, size, dst); }
+    return glgeCompressFast(src, size, dst);
+}
+
+bool glgeDecompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dstSize)
+{
+    //store the input and output positions
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + size;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dstSize;
+    //every block contains at least one token
+    if (size == 0) { return false; }
+    while (ip < iend)
+    {
+        //read the token
+        uint8_t token = *ip++;
+        //read the amount of literals
+        size_t litLength = token >> 4;
+        if (litLength == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend) { return false; }
+                b = *ip++;
+                litLength += b;
+            } while (b == 255);
+        }
+        //copy the literals
+        if ((litLength > (size_t)(iend - ip)) || (litLength > (size_t)(oend - op))) { return false; }
+        if ((litLength <= 16) && (iend - ip >= 16) && (oend - op >= 16))
+        {
+            //copy a fixed block, most literal runs are short and this avoids a call to memcpy
+            memcpy(op, ip, 16);
+        }
+        else if (litLength) { memcpy(op, ip, litLength); }
+        op += litLength;
+        ip += litLength;
+        //the last sequence ends after the literals
+        if (ip == iend) { break; }
+
+        //read the offset of the match
+        if (iend - ip < 2) { return false; }
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if ((offset == 0) || (offset > (size_t)(op - dst))) { return false; }
+        //read the length of the match
+        size_t matchLength = token & 15;
+        if (matchLength == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend) { return false; }
+                b = *ip++;
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += GLGE_COMPRESSION_MIN_MATCH;
+        if (matchLength > (size_t)(oend - op)) { return false; }
+        //copy the match
+        const uint8_t* match = op - offset;
+        if ((matchLength <= 16) && (offset >= 16) && (oend - op >= 16))
+        {
+            //copy a fixed block, the source and the destination don't overlap
+            memcpy(op, match, 16);
+            op += matchLength;
+        }
+        else if ((offset >= 8) && (matchLength + 8 <= (size_t)(oend - op)))
+        {
+            //copy 8 bytes at once, the source is always far enough behind the destination and the overshoot is overwritten later
+            uint8_t* end = op + matchLength;
+            while (op < end)
+            {
+                memcpy(op, match, 8);
+                op += 8;
+                match += 8;
+            }
+            op = end;
+        }
+        else
+        {
+            //copy overlapping matches byte by byte, this repeats the pattern
+            for (size_t i = 0; i < matchLength; i++) { op[i] = match[i]; }
+            op += matchLength;
+        }
+    }
+    //check if the whole output was written
+    return op == oend;
+}
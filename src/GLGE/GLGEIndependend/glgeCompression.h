@@ -0,0 +1,62 @@
+/**
+ * @file glgeCompression.h
+ * @author DM8AT
+ * @brief a fast lossless compression for binary data like scene files, the compressed blocks use the LZ4 block format
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+#ifndef _GLGE_COMPRESSION_H_
+#define _GLGE_COMPRESSION_H_
+
+//include the needed standard librarys
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief don't compress the data
+ */
+#define GLGE_COMPRESSION_NONE 0
+/**
+ * @brief compress the data fast with a single hash lookup per position
+ */
+#define GLGE_COMPRESSION_FAST 1
+/**
+ * @brief compress the data slower with a search through all earlier matches for a better ratio, the data decompresses as fast as with GLGE_COMPRESSION_FAST
+ */
+#define GLGE_COMPRESSION_HIGH 2
+
+/**
+ * @brief get the maximum size of the compressed data
+ *
+ * @param size the size of the data to compress
+ * @return size_t the size the output buffer for glgeCompress needs at least
+ */
+size_t glgeCompressBound(size_t size);
+
+/**
+ * @brief compress a block of data
+ *
+ * @param src the data to compress
+ * @param size the size of the data in bytes
+ * @param dst the buffer for the compressed data, it must have a size of at least glgeCompressBound(size)
+ * @param mode the compression mode, GLGE_COMPRESSION_FAST or GLGE_COMPRESSION_HIGH
+ * @return size_t the size of the compressed data in bytes
+ */
+size_t glgeCompress(const uint8_t* src, size_t size, uint8_t* dst, uint8_t mode = GLGE_COMPRESSION_FAST);
+
+/**
+ * @brief decompress a block of data, invalid data is detected and never read or written outside of the buffers
+ *
+ * @param src the compressed data
+ * @param size the size of the compressed data in bytes
+ * @param dst the buffer for the decompressed data
+ * @param dstSize the size of the decompressed data in bytes
+ * @return true : the data was decompressed | false : the data is invalid or dosn't decompress to exactly dstSize bytes
+ */
+bool glgeDecompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dstSize);
+
+#endif
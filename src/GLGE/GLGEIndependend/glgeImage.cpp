@@ -15,62 +15,519 @@
 #include "../stb_image_write.h"
 #include "../CML/CML.h"
 #include <fstream>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
 #include "glgePrivDefines.hpp"
 #include "glgeImage.h"
+#include "glgeImageCache.h"
+
+//use SSE2 for the pixel conversion if the compiler supports it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define GLGE_IMAGE_SSE2
+#endif
+
+/**
+ * @brief the amount of entries in the table to encode linear values with the sRGB curve
+ */
+#define GLGE_SRGB_TABLE_SIZE 4096
+/**
+ * @brief the amount of compressed bytes that are collected before an IDAT chunk is written
+ */
+#define GLGE_PNG_IDAT_SIZE (64*1024)
+/**
+ * @brief the size of the deflate window, the largest distance a match can have
+ */
+#define GLGE_PNG_WINDOW_SIZE 32768
+/**
+ * @brief the amount of bits of the hash that is used to find matches
+ */
+#define GLGE_PNG_HASH_BITS 15
+/**
+ * @brief the amount of entries in the hash table
+ */
+#define GLGE_PNG_HASH_SIZE (1 << GLGE_PNG_HASH_BITS)
+/**
+ * @brief the amount of earlier positions that are compared to find a match
+ */
+#define GLGE_PNG_MAX_CHAIN 16
+
+unsigned int getAutoFormat(const char* file, bool error = true);
+
+/**
+ * @brief read a big endian 32 bit integer
+ * 
+ * @param data the bytes to read
+ * @return uint32_t the integer
+ */
+static uint32_t glgeReadBigEndian(const uint8_t* data)
+{
+    //combine the bytes from the highest to the lowest
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+}
+
+/**
+ * @brief decode a QOI file in memory
+ * 
+ * @param data the bytes of the file
+ * @param size the size of the file in bytes
+ * @param x the width of the image
+ * @param y the height of the image
+ * @param comp the amount of chanels in the file
+ * @param req_comp the amount of chanels to decode (1 to 4), 0 uses the chanels of the file
+ * @return uint8_t* the decoded pixels, must be freed with glgeImageFree, NULL if the file is invalid
+ */
+static uint8_t* glgeDecodeQOI(const uint8_t* data, size_t size, int *x, int *y, int *comp, int req_comp)
+{
+    //check for a header and the end marker
+    if ((size < 22) || (std::memcmp(data, "qoif", 4) != 0)) { return NULL; }
+    //read the header
+    uint32_t width = glgeReadBigEndian(data + 4);
+    uint32_t height = glgeReadBigEndian(data + 8);
+    int chanels = data[12];
+    //check the header, limit the image to 400 million pixels like the reference decoder
+    if ((width == 0) || (height == 0) || ((chanels != 3) && (chanels != 4)) || (data[13] > 1) || 
+        (height >= 400000000u / width) || (req_comp < 0) || (req_comp > 4)) { return NULL; }
+    //get the amount of output chanels
+    int out = req_comp ? req_comp : chanels;
+    //allocate the pixels with malloc, so glgeImageFree can free them
+    size_t pixels = (size_t)width*height;
+    uint8_t* img = (uint8_t*)malloc(pixels*out);
+    if (!img) { return NULL; }
+
+    //store the recently seen pixels
+    uint8_t index[64*4] = {0};
+    //store the current pixel, it starts as opaque black
+    uint8_t px[4] = {0, 0, 0, 255};
+    //store the length of the current run
+    int run = 0;
+    //store the read position, the last 8 bytes are the end marker
+    size_t p = 14;
+    size_t end = size - 8;
+    //loop over all pixels
+    for (size_t i = 0; i < pixels; i++)
+    {
+        //check if a run continues
+        if (run > 0) { run--; }
+        //check if data is left
+        else if (p < end)
+        {
+            //read the tag
+            uint8_t b = data[p++];
+            //check for a full pixel
+            if (b == 0xff)
+            {
+                //stop if the chunk is cut off
+                if (p + 4 > end) { free(img); return NULL; }
+                std::memcpy(px, data + p, 4);
+                p += 4;
+            }
+            //check for a color
+            else if (b == 0xfe)
+            {
+                //stop if the chunk is cut off
+                if (p + 3 > end) { free(img); return NULL; }
+                std::memcpy(px, data + p, 3);
+                p += 3;
+            }
+            //check for an index
+            else if ((b & 0xc0) == 0x00)
+            {
+                std::memcpy(px, index + b*4, 4);
+            }
+            //check for a small difference
+            else if ((b & 0xc0) == 0x40)
+            {
+                px[0] += ((b >> 4) & 3) - 2;
+                px[1] += ((b >> 2) & 3) - 2;
+                px[2] += (b & 3) - 2;
+            }
+            //check for a difference relative to green
+            else if ((b & 0xc0) == 0x80)
+            {
+                //stop if the chunk is cut off
+                if (p + 1 > end) { free(img); return NULL; }
+                uint8_t b2 = data[p++];
+                int dg = (b & 0x3f) - 32;
+                px[0] += dg - 8 + ((b2 >> 4) & 0x0f);
+                px[1] += dg;
+                px[2] += dg - 8 + (b2 & 0x0f);
+            }
+            //the tag is a run
+            else
+            {
+                run = (b & 0x3f);
+            }
+            //remember the pixel
+            std::memcpy(index + ((px[0]*3 + px[1]*5 + px[2]*7 + px[3]*11) % 64)*4, px, 4);
+        }
+        //the file ended before all pixels were decoded
+        else { free(img); return NULL; }
+
+        //store the pixel
+        uint8_t* dst = img + i*out;
+        switch (out)
+        {
+        case 4:
+            std::memcpy(dst, px, 4);
+            break;
+        case 3:
+            std::memcpy(dst, px, 3);
+            break;
+        case 2:
+            //use the luminance like stb_image
+            dst[0] = (uint8_t)((px[0]*77 + px[1]*150 + px[2]*29) >> 8);
+            dst[1] = px[3];
+            break;
+        default:
+            dst[0] = (uint8_t)((px[0]*77 + px[1]*150 + px[2]*29) >> 8);
+            break;
+        }
+    }
+
+    //output the size
+    *x = (int)width;
+    *y = (int)height;
+    if (comp) { *comp = chanels; }
+    //return the pixels
+    return img;
+}
+
+/**
+ * @brief load a QOI file
+ * 
+ * @param filename a path to the file
+ * @param x the width of the image
+ * @param y the height of the image
+ * @param comp the amount of chanels in the file
+ * @param req_comp the amount of chanels to load, 0 uses the chanels of the file
+ * @return uint8_t* the decoded pixels, NULL if the file is missing or invalid
+ */
+static uint8_t* glgeLoadQOI(const char* filename, int *x, int *y, int *comp, int req_comp)
+{
+    //open the file at the end to get its size
+    std::ifstream f(filename, std::ios::binary | std::ios::ate);
+    if (!f.is_open()) { return NULL; }
+    std::streamsize size = f.tellg();
+    if (size <= 0) { return NULL; }
+    //read the whole file, QOI is decoded in one pass
+    std::vector<uint8_t> data((size_t)size);
+    f.seekg(0);
+    if (!f.read((char*)data.data(), size)) { return NULL; }
+    //decode the file
+    return glgeDecodeQOI(data.data(), data.size(), x, y, comp, req_comp);
+}
 
 uint8_t* glgeLoadImage(const char* filename, int *x, int *y, int *comp, int req_comp)
 {
-    //just call STB_Image function to load the image
-    return stbi_load(filename, x, y, comp, req_comp); 
+    //check if the image was decoded before
+    bool cache = glgeIsImageCacheActive();
+    if (cache)
+    {
+        //map the decoded pixels
+        uint8_t* cached = glgeLoadCachedImage(filename, req_comp, x, y, comp);
+        if (cached) { return cached; }
+    }
+    //store the chanels of the file, the caller may not need them
+    int chanels = 0;
+    uint8_t* data = NULL;
+    //check if the file is a QOI file, stb_image can't read those
+    if (getAutoFormat(filename, false) == GLGE_IMG_TYPE_QOI)
+    {
+        //decode the file
+        data = glgeLoadQOI(filename, x, y, &chanels, req_comp);
+    }
+    else
+    {
+        //call STB_Image function to load the image
+        data = stbi_load(filename, x, y, &chanels, req_comp);
+    }
+    //output the chanels
+    if (comp) { *comp = chanels; }
+    //store the decoded pixels for the next load
+    if (cache && data) { glgeStoreCachedImage(filename, req_comp, *x, *y, chanels, data); }
+    return data;
+}
+
+float* glgeLoadImageHDR(const char* filename, int *x, int *y, int *comp, int req_comp)
+{
+    //check if the file is a QOI file, stb_image can't read those
+    if (getAutoFormat(filename, false) == GLGE_IMG_TYPE_QOI)
+    {
+        //decode the file, the chanels of the file are stored locally because the caller may not need them
+        int fileChanels = 0;
+        uint8_t* bytes = glgeLoadQOI(filename, x, y, &fileChanels, req_comp);
+        if (!bytes) { return NULL; }
+        //output the chanels
+        if (comp) { *comp = fileChanels; }
+        //get the amount of decoded chanels
+        int chanels = req_comp ? req_comp : fileChanels;
+        size_t count = (size_t)(*x)*(*y)*chanels;
+        //allocate the floats with malloc, so glgeImageFree can free them
+        float* img = (float*)malloc(count*sizeof(float));
+        if (img)
+        {
+            //convert the colors to linear values with the same curve stb_image uses, alpha stays linear
+            bool alpha = (chanels == 2) || (chanels == 4);
+            for (size_t i = 0; i < count; i++)
+            {
+                float v = bytes[i] / 255.f;
+                img[i] = (alpha && ((i % chanels) == (size_t)(chanels-1))) ? v : powf(v, 2.2f);
+            }
+        }
+        //free the bytes
+        free(bytes);
+        return img;
+    }
+    //call STB_Image function to load the image as floats
+    return stbi_loadf(filename, x, y, comp, req_comp);
 }
 
 void glgeImageFree(uint8_t* data)
 {
+    //check if the data is mapped from the image cache
+    if (glgeFreeCachedImage(data)) { return; }
     //call the stb_image function to free the data
     stbi_image_free(data);
 }
 
-uint8_t* glgeTextureDataToImageData(ivec2 texSize, vec4* texData)
+void glgeImageFree(float* data)
 {
-    //make enough space for the texture
-    uint8_t* data = new uint8_t[texSize.x*texSize.y*4];
-    //loop over the texture
-    for (int x = 0; x < texSize.x; x++)
+    //call the stb_image function to free the data
+    stbi_image_free(data);
+}
+
+/**
+ * @brief a table to encode linear values with the sRGB curve
+ */
+struct SRGBTable
+{
+    //store the encoded byte for every linear step
+    uint8_t values[GLGE_SRGB_TABLE_SIZE];
+
+    /**
+     * @brief fill the table
+     */
+    SRGBTable()
     {
-        for (int y = 0; y < texSize.y; y++)
+        //loop over all entries
+        for (int i = 0; i < GLGE_SRGB_TABLE_SIZE; i++)
         {
-            //get the current pixel
-            vec4 c = texData[(int)((texSize.x - x)*texSize.y + y)];
-            //convert to an ivec4
-            ivec4 col = ivec4(c.x*255, c.y*255, c.z*255, c.w*255);
-            //store the pixel
-            //store the r component
-            data[(x*texSize.x + y)*4 + 0] = col.x;
-            //store the g component
-            data[(x*texSize.x + y)*4 + 1] = col.y;
-            //store the b component
-            data[(x*texSize.x + y)*4 + 2] = col.z;
-            //store the a component
-            data[(x*texSize.x + y)*4 + 3] = col.w;
+            //get the linear value of the entry
+            float l = i / (float)(GLGE_SRGB_TABLE_SIZE - 1);
+            //encode the value with the sRGB curve
+            float e = (l <= 0.0031308f) ? (l * 12.92f) : (1.055f * std::pow(l, 1.f / 2.4f) - 0.055f);
+            //store the rounded byte
+            this->values[i] = (uint8_t)std::min(255.f, e * 255.f + 0.5f);
         }
     }
+};
+
+//store the sRGB table
+static const SRGBTable glgeSRGBTable;
+
+/**
+ * @brief convert a single float to a byte
+ * 
+ * @param v the value, clamped to 0 to 1
+ * @return uint8_t the rounded byte, NaN is stored as 0
+ */
+static inline uint8_t glgeFloatToByte(float v)
+{
+    //NaN and negative values are 0
+    if (!(v > 0.f)) { return 0; }
+    //clamp the upper end
+    if (v >= 1.f) { return 255; }
+    //round to the closest byte
+    return (uint8_t)(v * 255.f + 0.5f);
+}
+
+/**
+ * @brief convert a single float to a byte with the sRGB curve
+ * 
+ * @param v the linear value, clamped to 0 to 1
+ * @return uint8_t the encoded byte, NaN is stored as 0
+ */
+static inline uint8_t glgeFloatToSRGBByte(float v)
+{
+    //NaN and negative values are 0
+    if (!(v > 0.f)) { return 0; }
+    //clamp the upper end
+    if (v >= 1.f) { return 255; }
+    //look up the encoded value
+    return glgeSRGBTable.values[(int)(v * (GLGE_SRGB_TABLE_SIZE - 1) + 0.5f)];
+}
+
+void glgeConvertFloatToBytes(const float* src, uint8_t* dst, size_t pixels, bool srgb)
+{
+    //store the amount of converted pixels
+    size_t i = 0;
+#ifdef GLGE_IMAGE_SSE2
+    //store the constants
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 scale = _mm_set1_ps(255.f);
+    const __m128 tableScale = _mm_set1_ps((float)(GLGE_SRGB_TABLE_SIZE - 1));
+    //convert 4 pixels per step
+    for (; i + 4 <= pixels; i += 4)
+    {
+        //load the pixels and clamp them, max returns 0 for NaN
+        __m128 p[4];
+        for (int j = 0; j < 4; j++) { p[j] = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + (i + j)*4), zero), one); }
+        //convert to rounded integers
+        __m128i v[4];
+        for (int j = 0; j < 4; j++) { v[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(p[j], scale), half)); }
+        //pack the integers to bytes and store all 16 bytes at once
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3]));
+        _mm_storeu_si128((__m128i*)(dst + i*4), bytes);
+        //check if the colors should be encoded
+        if (srgb)
+        {
+            //calculate the table indices
+            alignas(16) int idx[16];
+            for (int j = 0; j < 4; j++) { _mm_store_si128((__m128i*)(idx + j*4), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(p[j], tableScale), half))); }
+            //look up the colors, the alpha stays linear
+            for (int j = 0; j < 4; j++)
+            {
+                dst[(i + j)*4 + 0] = glgeSRGBTable.values[idx[j*4 + 0]];
+                dst[(i + j)*4 + 1] = glgeSRGBTable.values[idx[j*4 + 1]];
+                dst[(i + j)*4 + 2] = glgeSRGBTable.values[idx[j*4 + 2]];
+            }
+        }
+    }
+#endif
+    //convert the remaining pixels
+    for (; i < pixels; i++)
+    {
+        //convert the color
+        for (int c = 0; c < 3; c++) { dst[i*4 + c] = srgb ? glgeFloatToSRGBByte(src[i*4 + c]) : glgeFloatToByte(src[i*4 + c]); }
+        //the alpha is always linear
+        dst[i*4 + 3] = glgeFloatToByte(src[i*4 + 3]);
+    }
+}
+
+uint8_t* glgeTextureDataToImageData(ivec2 texSize, vec4* texData, bool srgb)
+{
+    //make enough space for the texture
+    uint8_t* data = new uint8_t[texSize.x*texSize.y*4];
+    //loop over all rows, images start with the top row and textures with the bottom row
+    for (int y = 0; y < texSize.y; y++)
+    {
+        //convert the whole row
+        glgeConvertFloatToBytes((const float*)(texData + (size_t)(texSize.y - 1 - y)*texSize.x), data + (size_t)y*texSize.x*4, texSize.x, srgb);
+    }
     //return the pointer
     return data;
 }
 
 /**
- * @brief store the image data in the file format "ppm"
+ * @brief hand out the rows of an image as RGBA bytes, the rows are converted one by one if the image is stored as floats
+ */
+struct ImageRowReader
+{
+    //the size of the image
+    ivec2 size;
+    //the image as bytes
+    const uint8_t* bytes = NULL;
+    //say if the first row of the bytes is the bottom row
+    bool bottomUp = false;
+    //the image as floats, the first row is the bottom row
+    const vec4* floats = NULL;
+    //say if the floats are encoded with the sRGB curve
+    bool srgb = false;
+    //store the converted row
+    std::vector<uint8_t> row;
+
+    /**
+     * @brief get a row of the image
+     * 
+     * @param y the row, 0 is the top row
+     * @return const uint8_t* the RGBA bytes of the row, valid until the next call
+     */
+    const uint8_t* getRow(int y)
+    {
+        //bytes can be used directly
+        if (this->bytes) { return this->bytes + (size_t)(this->bottomUp ? (this->size.y - 1 - y) : y)*this->size.x*4; }
+        //make space for the row
+        this->row.resize((size_t)this->size.x*4);
+        //convert the row
+        glgeConvertFloatToBytes((const float*)(this->floats + (size_t)(this->size.y - 1 - y)*this->size.x), this->row.data(), this->size.x, this->srgb);
+        //return the row
+        return this->row.data();
+    }
+};
+
+/**
+ * @brief store the image data in the binary file format "ppm" (P6)
+ * 
+ * @param file the file to store in
+ * @param reader the rows of the image
+ */
+static void storePPM(const char* file, ImageRowReader& reader)
+{
+    //open the file
+    std::ofstream f(file, std::ios::binary);
+    //check if the file was opend
+    if (!f.is_open())
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Failed to open file " + std::string(file))
+        return;
+    }
+
+    //write the header
+    f << "P6\n# This file was generated with GLGE\n" << reader.size.x << " " << reader.size.y << "\n255\n";
+    //store a row without alpha
+    std::vector<uint8_t> rgb((size_t)reader.size.x*3);
+    //loop over all rows
+    for (int y = 0; y < reader.size.y; y++)
+    {
+        //get the row
+        const uint8_t* row = reader.getRow(y);
+        //drop the alpha chanel
+        for (int x = 0; x < reader.size.x; x++)
+        {
+            rgb[x*3 + 0] = row[x*4 + 0];
+            rgb[x*3 + 1] = row[x*4 + 1];
+            rgb[x*3 + 2] = row[x*4 + 2];
+        }
+        //write the row
+        f.write((const char*)rgb.data(), rgb.size());
+    }
+
+    //store the file
+    f.close();
+}
+
+/**
+ * @brief write a 32 bit integer in big endian order
+ * 
+ * @param out the bytes to write to
+ * @param v the value to write
+ */
+static void glgeWriteBigEndian(std::vector<uint8_t>& out, uint32_t v)
+{
+    //write the bytes from the highest to the lowest
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+/**
+ * @brief store the image data in the file format "qoi", the rows are encoded and written one by one
  * 
  * @param file the file to store in
- * @param imgSize the size of the image
- * @param imgData the images data
+ * @param reader the rows of the image
  */
-void storePPM(const char* file, ivec2 imgSize, uint8_t* imgData)
+static void storeQOI(const char* file, ImageRowReader& reader)
 {
-    //create the file
-    std::fstream f;
     //open the file
-    f.open(file, std::fstream::out);
+    std::ofstream f(file, std::ios::binary);
     //check if the file was opend
     if (!f.is_open())
     {
@@ -78,41 +535,525 @@ void storePPM(const char* file, ivec2 imgSize, uint8_t* imgData)
         GLGE_THROW_ERROR("Failed to open file " + std::string(file))
         return;
     }
-    //clear the file
-    f.clear();
 
-    //create the header
-    std::string head = "P3 ";
-    //add the width to the header
-    head += std::to_string(imgSize.x) + " ";
-    //add the height to the header
-    head += std::to_string(imgSize.y) + " 255\n";
-    //add a comment
-    head += "# This file was generated with GLGE\n";
-    //write the header to the file
-    f << head;
+    //store the encoded bytes of a row, a pixel takes at most 5 bytes
+    std::vector<uint8_t> out;
+    out.reserve((size_t)reader.size.x*5 + 14);
+    //write the header, 4 chanels and sRGB colors with linear alpha
+    out.insert(out.end(), {'q', 'o', 'i', 'f'});
+    glgeWriteBigEndian(out, reader.size.x);
+    glgeWriteBigEndian(out, reader.size.y);
+    out.push_back(4);
+    out.push_back(0);
+
+    //store the recently seen pixels
+    uint8_t index[64*4] = {0};
+    //store the previous pixel, it starts as opaque black
+    uint8_t prev[4] = {0, 0, 0, 255};
+    //store the length of the current run
+    int run = 0;
+    //loop over all rows
+    for (int y = 0; y < reader.size.y; y++)
+    {
+        //get the row
+        const uint8_t* row = reader.getRow(y);
+        //loop over all pixels
+        for (int x = 0; x < reader.size.x; x++)
+        {
+            //get the pixel
+            const uint8_t* px = row + x*4;
+            //check if the pixel repeats the previous one
+            if ((px[0] == prev[0]) && (px[1] == prev[1]) && (px[2] == prev[2]) && (px[3] == prev[3]))
+            {
+                //extend the run
+                run++;
+                //a run can store at most 62 pixels
+                if (run == 62) { out.push_back(0xc0 | (run - 1)); run = 0; }
+                continue;
+            }
+            //finish the current run
+            if (run > 0) { out.push_back(0xc0 | (run - 1)); run = 0; }
+
+            //check if the pixel was seen recently
+            int hash = (px[0]*3 + px[1]*5 + px[2]*7 + px[3]*11) % 64;
+            if ((index[hash*4 + 0] == px[0]) && (index[hash*4 + 1] == px[1]) && (index[hash*4 + 2] == px[2]) && (index[hash*4 + 3] == px[3]))
+            {
+                //store the index
+                out.push_back((uint8_t)hash);
+            }
+            else
+            {
+                //remember the pixel
+                std::memcpy(index + hash*4, px, 4);
+                //check if only the color changed
+                if (px[3] == prev[3])
+                {
+                    //get the differences, wrapping around like bytes
+                    int dr = (int8_t)(px[0] - prev[0]);
+                    int dg = (int8_t)(px[1] - prev[1]);
+                    int db = (int8_t)(px[2] - prev[2]);
+                    int drg = dr - dg;
+                    int dbg = db - dg;
+                    //check for a small difference
+                    if ((dr > -3) && (dr < 2) && (dg > -3) && (dg < 2) && (db > -3) && (db < 2))
+                    {
+                        out.push_back(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+                    }
+                    //check for a difference relative to green
+                    else if ((dg > -33) && (dg < 32) && (drg > -9) && (drg < 8) && (dbg > -9) && (dbg < 8))
+                    {
+                        out.push_back(0x80 | (dg + 32));
+                        out.push_back(((drg + 8) << 4) | (dbg + 8));
+                    }
+                    else
+                    {
+                        //store the color
+                        out.insert(out.end(), {0xfe, px[0], px[1], px[2]});
+                    }
+                }
+                else
+                {
+                    //store the whole pixel
+                    out.insert(out.end(), {0xff, px[0], px[1], px[2], px[3]});
+                }
+            }
+            //store the previous pixel
+            std::memcpy(prev, px, 4);
+        }
+        //write the encoded row
+        f.write((const char*)out.data(), out.size());
+        out.clear();
+    }
+    //finish the last run
+    if (run > 0) { out.push_back(0xc0 | (run - 1)); }
+    //write the end marker
+    out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+    f.write((const char*)out.data(), out.size());
+
+    //store the file
+    f.close();
+}
+
+/**
+ * @brief update a CRC32 checksum as used by PNG
+ * 
+ * @param crc the checksum of the previous bytes, 0 for the first bytes
+ * @param data the bytes to add
+ * @param size the amount of bytes
+ * @return uint32_t the new checksum
+ */
+static uint32_t glgeCRC32(uint32_t crc, const uint8_t* data, size_t size)
+{
+    //store the table of all byte checksums
+    static uint32_t table[256] = {0};
+    //fill the table on the first call
+    if (table[1] == 0)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) { c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1); }
+            table[i] = c;
+        }
+    }
+    //add all bytes
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) { crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8); }
+    return ~crc;
+}
+
+/**
+ * @brief write a PNG chunk
+ * 
+ * @param f the file to write to
+ * @param type the four letters of the chunk type
+ * @param data the content of the chunk
+ * @param size the size of the content
+ */
+static void glgeWritePNGChunk(std::ofstream& f, const char* type, const uint8_t* data, size_t size)
+{
+    //write the length and the type
+    std::vector<uint8_t> head;
+    glgeWriteBigEndian(head, (uint32_t)size);
+    head.insert(head.end(), type, type + 4);
+    f.write((const char*)head.data(), head.size());
+    //write the content
+    if (size) { f.write((const char*)data, size); }
+    //the checksum covers the type and the content
+    uint32_t crc = glgeCRC32(glgeCRC32(0, (const uint8_t*)type, 4), data, size);
+    std::vector<uint8_t> tail;
+    glgeWriteBigEndian(tail, crc);
+    f.write((const char*)tail.data(), tail.size());
+}
+
+/**
+ * @brief compress a zlib stream that is fed in pieces and write it as IDAT chunks of a PNG file
+ * 
+ * The stream is a single deflate block with the fixed huffman codes, the matches are found with hash chains over a
+ * 32 KB window. Only the window, the bytes that wait for a match and one chunk of output are kept in memory.
+ */
+struct PNGDeflateStream
+{
+    //the file the chunks are written to
+    std::ofstream* file = NULL;
+    //the compressed bytes that are not written yet
+    std::vector<uint8_t> out;
+    //the bits that don't fill a byte yet
+    uint32_t bitBuffer = 0;
+    //the amount of bits in the bit buffer
+    int bitCount = 0;
+    //the last 32 KB of input and the input that is not compressed yet
+    std::vector<uint8_t> window;
+    //the position of the first byte of the window in the whole input
+    int64_t base = 0;
+    //the position of the next byte to compress in the whole input
+    int64_t pos = 0;
+    //the newest position for every hash
+    std::vector<int64_t> head;
+    //the previous position with the same hash, indexed by the position modulo the window size
+    std::vector<int64_t> prev;
+    //the adler32 checksum of the input
+    uint32_t adlerA = 1, adlerB = 0;
+
+    /**
+     * @brief start the zlib stream
+     * 
+     * @param f the file to write the chunks to
+     */
+    void begin(std::ofstream* f)
+    {
+        this->file = f;
+        this->out.reserve(GLGE_PNG_IDAT_SIZE + 64);
+        this->head.assign(GLGE_PNG_HASH_SIZE, -1);
+        this->prev.assign(GLGE_PNG_WINDOW_SIZE, -1);
+        //the zlib header, deflate with a 32 KB window
+        this->out.push_back(0x78);
+        this->out.push_back(0x5e);
+        //a single final block with the fixed huffman codes
+        this->writeBits(1, 1);
+        this->writeBits(1, 2);
+    }
+
+    /**
+     * @brief write bits to the output, starting with the lowest bit
+     */
+    inline void writeBits(uint32_t value, int count)
+    {
+        this->bitBuffer |= value << this->bitCount;
+        this->bitCount += count;
+        while (this->bitCount >= 8)
+        {
+            this->out.push_back((uint8_t)this->bitBuffer);
+            this->bitBuffer >>= 8;
+            this->bitCount -= 8;
+        }
+    }
+
+    /**
+     * @brief reverse the order of the bits of a huffman code, huffman codes are stored starting with the highest bit
+     */
+    static uint32_t reverseCode(uint32_t code, int count)
+    {
+        uint32_t reversed = 0;
+        for (int i = 0; i < count; i++) { reversed |= ((code >> i) & 1) << (count - 1 - i); }
+        return reversed;
+    }
+
+    /**
+     * @brief write a literal byte or a length symbol with the fixed huffman codes
+     */
+    inline void writeSymbol(int symbol)
+    {
+        //store the reversed code and the length of every symbol
+        static uint16_t codes[288] = {0};
+        static uint8_t lengths[288] = {0};
+        //fill the table on the first call
+        if (lengths[0] == 0)
+        {
+            for (uint32_t i = 0; i < 288; i++)
+            {
+                if (i < 144) { codes[i] = (uint16_t)reverseCode(0x30 + i, 8); lengths[i] = 8; }
+                else if (i < 256) { codes[i] = (uint16_t)reverseCode(0x190 + i - 144, 9); lengths[i] = 9; }
+                else if (i < 280) { codes[i] = (uint16_t)reverseCode(i - 256, 7); lengths[i] = 7; }
+                else { codes[i] = (uint16_t)reverseCode(0xc0 + i - 280, 8); lengths[i] = 8; }
+            }
+        }
+        this->writeBits(codes[symbol], lengths[symbol]);
+    }
+
+    /**
+     * @brief write a match
+     * 
+     * @param length the length of the match, between 3 and 258
+     * @param dist the distance to the match, between 1 and 32768
+     */
+    void writeMatch(int length, int dist)
+    {
+        //the first length and the extra bits of every length symbol
+        static const int lengthBase[29] = {3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258};
+        static const int lengthBits[29] = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+        //the first distance and the extra bits of every distance symbol
+        static const int distBase[30] = {1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577};
+        static const int distBits[30] = {0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+        //write the length
+        int l = 28;
+        while (lengthBase[l] > length) { l--; }
+        this->writeSymbol(257 + l);
+        this->writeBits(length - lengthBase[l], lengthBits[l]);
+        //write the distance
+        int d = 29;
+        while (distBase[d] > dist) { d--; }
+        this->writeBits(reverseCode(d, 5), 5);
+        this->writeBits(dist - distBase[d], distBits[d]);
+    }
+
+    /**
+     * @brief get the hash of the three bytes at a position of the window
+     */
+    inline uint32_t hash(int64_t p) const
+    {
+        const uint8_t* b = this->window.data() + (p - this->base);
+        return (((uint32_t)b[0] << 16 | (uint32_t)b[1] << 8 | b[2]) * 2654435761u) >> (32 - GLGE_PNG_HASH_BITS);
+    }
+
+    /**
+     * @brief add a position to the hash chains
+     */
+    inline void insert(int64_t p)
+    {
+        uint32_t h = this->hash(p);
+        this->prev[p & (GLGE_PNG_WINDOW_SIZE - 1)] = this->head[h];
+        this->head[h] = p;
+    }
+
+    /**
+     * @brief find the longest match for a position
+     * 
+     * @param p the position to match
+     * @param end the end of the input in the window
+     * @param dist the distance to the match
+     * @return int the length of the match, 0 if no match was found
+     */
+    int findMatch(int64_t p, int64_t end, int& dist)
+    {
+        int best = 0;
+        int maxLength = (int)std::min<int64_t>(258, end - p);
+        if (maxLength < 3) { return 0; }
+        const uint8_t* cur = this->window.data() + (p - this->base);
+        int64_t cand = this->head[this->hash(p)];
+        for (int chain = 0; (chain < GLGE_PNG_MAX_CHAIN) && (cand >= 0) && (p - cand <= GLGE_PNG_WINDOW_SIZE); chain++)
+        {
+            const uint8_t* m = this->window.data() + (cand - this->base);
+            //only compare the whole match if it can be longer than the best one
+            if (m[best] == cur[best])
+            {
+                int len = 0;
+                while ((len < maxLength) && (m[len] == cur[len])) { len++; }
+                if (len > best)
+                {
+                    best = len;
+                    dist = (int)(p - cand);
+                    if (len == maxLength) { break; }
+                }
+            }
+            cand = this->prev[cand & (GLGE_PNG_WINDOW_SIZE - 1)];
+        }
+        return (best >= 3) ? best : 0;
+    }
+
+    /**
+     * @brief compress the input in the window
+     * 
+     * @param last true : all input is known | false : the input that is not known yet could continue a match, so the longest match length is kept back
+     */
+    void compress(bool last)
+    {
+        int64_t inputEnd = this->base + (int64_t)this->window.size();
+        int64_t stop = last ? inputEnd : (inputEnd - 258);
+        while (this->pos < stop)
+        {
+            //the last two bytes can't start a match
+            if (this->pos + 3 > inputEnd)
+            {
+                this->writeSymbol(this->window[this->pos - this->base]);
+                this->pos++;
+                continue;
+            }
+            int dist = 0;
+            int length = this->findMatch(this->pos, inputEnd, dist);
+            this->insert(this->pos);
+            //use a literal if the next byte starts a longer match
+            if (length && (length < 32) && (this->pos + 4 <= inputEnd))
+            {
+                int nextDist = 0;
+                if (this->findMatch(this->pos + 1, inputEnd, nextDist) > length) { length = 0; }
+            }
+            if (length)
+            {
+                this->writeMatch(length, dist);
+                //add the skipped positions to the hash chains
+                for (int64_t p = this->pos + 1; (p < this->pos + length) && (p + 3 <= inputEnd); p++) { this->insert(p); }
+                this->pos += length;
+            }
+            else
+            {
+                this->writeSymbol(this->window[this->pos - this->base]);
+                this->pos++;
+            }
+            //write a chunk if enough output is stored
+            if (this->out.size() >= GLGE_PNG_IDAT_SIZE) { this->flush(); }
+        }
+    }
+
+    /**
+     * @brief add bytes to the stream
+     * 
+     * @param data the bytes to add
+     * @param size the amount of bytes
+     */
+    void write(const uint8_t* data, size_t size)
+    {
+        //update the checksum, the sums are reduced before they can overflow
+        for (size_t i = 0; i < size; )
+        {
+            size_t n = std::min<size_t>(size - i, 5552);
+            for (size_t k = 0; k < n; k++) { this->adlerA += data[i + k]; this->adlerB += this->adlerA; }
+            this->adlerA %= 65521;
+            this->adlerB %= 65521;
+            i += n;
+        }
+        //add the bytes to the window and compress all bytes that can't be part of a longer match anymore
+        this->window.insert(this->window.end(), data, data + size);
+        this->compress(false);
+        //drop the bytes that are too far away to be matched
+        int64_t keep = this->pos - GLGE_PNG_WINDOW_SIZE;
+        if (keep - this->base >= GLGE_PNG_WINDOW_SIZE)
+        {
+            this->window.erase(this->window.begin(), this->window.begin() + (size_t)(keep - this->base));
+            this->base = keep;
+        }
+    }
+
+    /**
+     * @brief write the compressed bytes as an IDAT chunk
+     */
+    void flush()
+    {
+        if (this->out.empty()) { return; }
+        glgeWritePNGChunk(*this->file, "IDAT", this->out.data(), this->out.size());
+        this->out.clear();
+    }
 
-    //loop over the texture
-    for (int x = 0; x < imgSize.x; x++)
+    /**
+     * @brief compress the remaining input and write the end of the stream
+     */
+    void finish()
     {
-        for (int y = 0; y < imgSize.y; y++)
+        this->compress(true);
+        //the end of the block
+        this->writeSymbol(256);
+        //fill the last byte
+        if (this->bitCount > 0) { this->writeBits(0, 8 - this->bitCount); }
+        //the checksum of the input
+        glgeWriteBigEndian(this->out, (this->adlerB << 16) | this->adlerA);
+        this->flush();
+    }
+};
+
+/**
+ * @brief store the image data in the file format "png", the rows are converted, filtered and compressed one by one
+ * 
+ * @param file the file to store in
+ * @param reader the rows of the image
+ */
+static void storePNG(const char* file, ImageRowReader& reader)
+{
+    //open the file
+    std::ofstream f(file, std::ios::binary);
+    //check if the file was opend
+    if (!f.is_open())
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Failed to open file " + std::string(file))
+        return;
+    }
+    //write the signature
+    const uint8_t signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    f.write((const char*)signature, 8);
+    //write the header, 8 bit RGBA without interlacing
+    std::vector<uint8_t> ihdr;
+    glgeWriteBigEndian(ihdr, reader.size.x);
+    glgeWriteBigEndian(ihdr, reader.size.y);
+    ihdr.insert(ihdr.end(), {8, 6, 0, 0, 0});
+    glgeWritePNGChunk(f, "IHDR", ihdr.data(), ihdr.size());
+
+    //the filtered rows are compressed while they are created
+    PNGDeflateStream stream;
+    stream.begin(&f);
+    //store the size of a row in bytes
+    size_t stride = (size_t)reader.size.x*4;
+    //store the filtered row, it starts with its filter type
+    std::vector<uint8_t> filtered(stride + 1);
+    //store the previous row, the row above the first row is black
+    std::vector<uint8_t> prev(stride, 0);
+    //store the candidates for every filter
+    std::vector<uint8_t> candidate(stride);
+    //loop over all rows
+    for (int y = 0; y < reader.size.y; y++)
+    {
+        //get the row
+        const uint8_t* row = reader.getRow(y);
+        uint8_t* dst = filtered.data();
+        //store the best filter
+        long bestSum = -1;
+        //try all five filters and keep the one with the smallest sum of absolute differences
+        for (int filter = 0; filter < 5; filter++)
         {
-            //get the current pixel
-            ivec4 col;
-            //store the r component
-            col.x = imgData[(x*imgSize.x + y)*4 + 0];
-            //store the g component
-            col.y = imgData[(x*imgSize.x + y)*4 + 1];
-            //store the b component
-            col.z = imgData[(x*imgSize.x + y)*4 + 2];
-            //store the a component
-            col.w = imgData[(x*imgSize.x + y)*4 + 3];
-            //convert the color to an string
-            std::string str = std::to_string(col.x) + " " + std::to_string(col.y) + " " + std::to_string(col.z) + "\n";
-            //store the string
-            f << str;
+            long sum = 0;
+            for (size_t i = 0; i < stride; i++)
+            {
+                //get the left, upper and upper left bytes
+                int a = (i >= 4) ? row[i - 4] : 0;
+                int b = prev[i];
+                int c = (i >= 4) ? prev[i - 4] : 0;
+                //get the prediction of the filter
+                int pred = 0;
+                switch (filter)
+                {
+                case 1: pred = a; break;
+                case 2: pred = b; break;
+                case 3: pred = (a + b) >> 1; break;
+                case 4:
+                {
+                    //the paeth predictor uses the closest neighbour to a + b - c
+                    int p = a + b - c;
+                    int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+                    pred = ((pa <= pb) && (pa <= pc)) ? a : ((pb <= pc) ? b : c);
+                    break;
+                }
+                default: break;
+                }
+                //store the filtered byte
+                candidate[i] = (uint8_t)(row[i] - pred);
+                sum += std::abs((int)(int8_t)candidate[i]);
+            }
+            //keep the best filter
+            if ((bestSum < 0) || (sum < bestSum))
+            {
+                bestSum = sum;
+                dst[0] = (uint8_t)filter;
+                std::memcpy(dst + 1, candidate.data(), stride);
+            }
         }
+        //compress the filtered row
+        stream.write(filtered.data(), filtered.size());
+        //store the row for the next row
+        std::memcpy(prev.data(), row, stride);
     }
+    //write the rest of the compressed rows
+    stream.finish();
+    //write the end
+    glgeWritePNGChunk(f, "IEND", NULL, 0);
 
     //store the file
     f.close();
@@ -122,9 +1063,10 @@ void storePPM(const char* file, ivec2 imgSize, uint8_t* imgData)
  * @brief automaticaly get the file format using the file extension
  * 
  * @param file the file to get the format from
+ * @param error true : throw an error for unknown endings | false : silently return -1 for unknown endings
  * @return unsigned int the encoded file format
  */
-unsigned int getAutoFormat(const char* file)
+unsigned int getAutoFormat(const char* file, bool error)
 {
     //creata a string from the file name
     std::string f = std::string(file);
@@ -140,6 +1082,8 @@ unsigned int getAutoFormat(const char* file)
         //check if the index is less than 0
         if (i < 0)
         {
+            //stop silently if no error is wanted
+            if (!error) { return -1; }
             //throw an error
             GLGE_THROW_ERROR("Inputed filename '" + f + "' has no file ending, but constructing a type from the ending was requested")
             //safy error return
@@ -174,7 +1118,7 @@ unsigned int getAutoFormat(const char* file)
         return GLGE_IMG_TYPE_PNG;
     }
     //check if the ending is jpeg alias jpg
-    else if ((end == ".jpg") || (ending == ".jpeg"))
+    else if ((end == ".jpg") || (end == ".jpeg"))
     {
         //return the identifyer for a jpg
         return GLGE_IMG_TYPE_JPG;
@@ -191,15 +1135,23 @@ unsigned int getAutoFormat(const char* file)
         //return the identifyer for a ppm
         return GLGE_IMG_TYPE_PPM;
     }
+    //check if the ending is for qoi
+    else if (end == ".qoi")
+    {
+        //return the identifyer for a qoi
+        return GLGE_IMG_TYPE_QOI;
+    }
 
     //at this point, the ending is undefined
+    //stop silently if no error is wanted
+    if (!error) { return -1; }
     //so, throw an error
     GLGE_THROW_ERROR(std::string("The file ending '") + end + std::string("' dose not name a valid image file format supported by GLGE."))
     //safty error return
     return -1;
 }
 
-void glgeStoreImage(const char* file, ivec2 imgSize, uint8_t* imgData, unsigned int fileFormat)
+void glgeStoreImage(const char* file, ivec2 imgSize, uint8_t* imgData, unsigned int fileFormat, bool bottomUp)
 {
     //store the wanted file format
     int type = fileFormat;
@@ -218,6 +1170,25 @@ void glgeStoreImage(const char* file, ivec2 imgSize, uint8_t* imgData, unsigned
         }
     }
 
+    //check if the rows must be flipped
+    if (bottomUp)
+    {
+        //the own writers can read the rows in any order
+        ImageRowReader reader;
+        reader.size = imgSize;
+        reader.bytes = imgData;
+        reader.bottomUp = true;
+        if (type == GLGE_IMG_TYPE_PNG) { storePNG(file, reader); return; }
+        if (type == GLGE_IMG_TYPE_PPM) { storePPM(file, reader); return; }
+        if (type == GLGE_IMG_TYPE_QOI) { storeQOI(file, reader); return; }
+        //STB_IMAGE_WRITE needs the rows in order
+        std::vector<uint8_t> flipped((size_t)imgSize.x*imgSize.y*4);
+        for (int y = 0; y < imgSize.y; y++) { std::memcpy(flipped.data() + (size_t)y*imgSize.x*4, reader.getRow(y), (size_t)imgSize.x*4); }
+        //store the flipped image
+        glgeStoreImage(file, imgSize, flipped.data(), type, false);
+        return;
+    }
+
     //switch to store as wich type (swtiches are faster)
     switch (type)
         {
@@ -246,7 +1217,20 @@ void glgeStoreImage(const char* file, ivec2 imgSize, uint8_t* imgData, unsigned
         case GLGE_IMG_TYPE_PPM:
         {
             //call a custom function
-            storePPM(file, imgSize, imgData);
+            ImageRowReader reader;
+            reader.size = imgSize;
+            reader.bytes = imgData;
+            storePPM(file, reader);
+            break;
+        }
+        //store as qoi file
+        case GLGE_IMG_TYPE_QOI:
+        {
+            //call a custom function
+            ImageRowReader reader;
+            reader.size = imgSize;
+            reader.bytes = imgData;
+            storeQOI(file, reader);
             break;
         }
         
@@ -255,4 +1239,53 @@ void glgeStoreImage(const char* file, ivec2 imgSize, uint8_t* imgData, unsigned
             GLGE_THROW_ERROR("The image type requested to store is undefined")
             break;
     }
-}
\ No newline at end of file
+}
+
+void glgeStoreImage(const char* file, ivec2 texSize, vec4* texData, unsigned int fileFormat, bool srgb)
+{
+    //store the wanted file format
+    int type = fileFormat;
+    //check if the file type should depend on the file ending
+    if (type == GLGE_IMG_TYPE_ENDING)
+    {
+        //if it is, read the file ending as type
+        type = getAutoFormat(file);
+        //check if an error occured
+        if (type == -1)
+        {
+            //throw an error
+            GLGE_THROW_ERROR("An error occured while getting the file type for storing the image. Please look above for more information.")
+            //stop the function
+            return;
+        }
+    }
+
+    //the rows are converted while they are written
+    ImageRowReader reader;
+    reader.size = texSize;
+    reader.floats = texData;
+    reader.srgb = srgb;
+    switch (type)
+    {
+    //store as a png
+    case GLGE_IMG_TYPE_PNG:
+        storePNG(file, reader);
+        break;
+    //store as ppm file
+    case GLGE_IMG_TYPE_PPM:
+        storePPM(file, reader);
+        break;
+    //store as qoi file
+    case GLGE_IMG_TYPE_QOI:
+        storeQOI(file, reader);
+        break;
+    default:
+    {
+        //the other formats are written by STB_IMAGE_WRITE from the whole image
+        uint8_t* imgData = glgeTextureDataToImageData(texSize, texData, srgb);
+        glgeStoreImage(file, texSize, imgData, type);
+        delete[] imgData;
+        break;
+    }
+    }
+}
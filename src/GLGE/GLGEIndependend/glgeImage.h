@@ -38,9 +38,13 @@
  * @brief say that the image should be stored as ppm file
  */
 #define GLGE_IMG_TYPE_PPM 4
+/**
+ * @brief say that the image should be stored as QOI file
+ */
+#define GLGE_IMG_TYPE_QOI 5
 
 /**
- * @brief an call of stb_image function "stbi_load"
+ * @brief an call of stb_image function "stbi_load", QOI files are decoded by GLGE
  * 
  * @param filename a path to the file
  * @param x the width of the image
@@ -51,6 +55,18 @@
  */
 uint8_t* glgeLoadImage(const char* filename, int *x, int *y, int *comp, int req_comp = 0);
 
+/**
+ * @brief an call of stb_image function "stbi_loadf", it loads the image as linear floats, QOI files are decoded by GLGE
+ * 
+ * @param filename a path to the file
+ * @param x the width of the image
+ * @param y the height of the image
+ * @param comp the amount of chanels in the file
+ * @param req_comp the amount of chanels to load, 0 uses the chanels of the file
+ * @return float* a data pointer to an image
+ */
+float* glgeLoadImageHDR(const char* filename, int *x, int *y, int *comp, int req_comp = 0);
+
 /**
  * @brief free the data allocated to an image
  * 
@@ -58,14 +74,32 @@ uint8_t* glgeLoadImage(const char* filename, int *x, int *y, int *comp, int req_
  */
 void glgeImageFree(uint8_t* data);
 
+/**
+ * @brief free the data allocated to a float image
+ * 
+ * @param data the allocated data
+ */
+void glgeImageFree(float* data);
+
+/**
+ * @brief convert RGBA float pixels to RGBA bytes, the values are clamped to 0 to 1 and rounded. Uses SSE2 if it is available
+ * 
+ * @param src the float pixels, 4 floats per pixel
+ * @param dst the byte pixels to write to, 4 bytes per pixel
+ * @param pixels the amount of pixels to convert
+ * @param srgb true : the color chanels are encoded with the sRGB curve, alpha stays linear | false : all chanels are stored linear
+ */
+void glgeConvertFloatToBytes(const float* src, uint8_t* dst, size_t pixels, bool srgb = false);
+
 /**
  * @brief convert the texture data stored in an texture object into image data that can be stored as an image
  * 
  * @param texSize the size of the texture to store
- * @param texData the texture data as Vec4 (1 vec4 per pixe, x = r, y = g, b = b, w = a)
- * @return uint8_t* a pointer to an array of RGBA image datas, 1 byte per chanel (4 byte per pixel)
+ * @param texData the texture data as Vec4 (1 vec4 per pixe, x = r, y = g, b = b, w = a), the first row is the bottom row like in OpenGL
+ * @param srgb say if the color chanels should be encoded with the sRGB curve (DEFAULT: false)
+ * @return uint8_t* a pointer to an array of RGBA image datas, 1 byte per chanel (4 byte per pixel), the first row is the top row
  */
-uint8_t* glgeTextureDataToImageData(ivec2 texSize, vec4* texData);
+uint8_t* glgeTextureDataToImageData(ivec2 texSize, vec4* texData, bool srgb = false);
 
 /**
  * @brief store a file using my own implementation or stb_image
@@ -74,7 +108,19 @@ uint8_t* glgeTextureDataToImageData(ivec2 texSize, vec4* texData);
  * @param texSize the size of the texture to store
  * @param imgData the data of the image to store
  * @param fileFormat the file format to use for texture storage (DEFAULT: GLGE_IMG_TYPE_ENDING)
+ * @param bottomUp say if the first row of the data is the bottom row, like data read from OpenGL (DEFAULT: false)
+ */
+void glgeStoreImage(const char* file, ivec2 texSize, uint8_t* imgData, unsigned int fileFormat = GLGE_IMG_TYPE_ENDING, bool bottomUp = false);
+
+/**
+ * @brief store texture data in a file, PNG, PPM and QOI files are converted and written row by row without a full copy of the image
+ * 
+ * @param file the file to store the texture in
+ * @param texSize the size of the texture to store
+ * @param texData the texture data as Vec4, the first row is the bottom row like in OpenGL
+ * @param fileFormat the file format to use for texture storage (DEFAULT: GLGE_IMG_TYPE_ENDING)
+ * @param srgb say if the color chanels should be encoded with the sRGB curve (DEFAULT: false)
  */
-void glgeStoreImage(const char* file, ivec2 texSize, uint8_t* imgData, unsigned int fileFormat = GLGE_IMG_TYPE_ENDING);
+void glgeStoreImage(const char* file, ivec2 texSize, vec4* texData, unsigned int fileFormat = GLGE_IMG_TYPE_ENDING, bool srgb = false);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,456 @@
+/**
+ * @file glgeImageCache.cpp
+ * @author DM8AT
+ * @brief implement the on-disk cache of decoded images
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the header
+#include "glgeImageCache.h"
+//include the private defines for the warning output
+#include "glgePrivDefines.hpp"
+//include the needed standard librarys
+#include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+//include the memory mapping
+#if defined(_WIN32)
+#define GLGE_IMAGE_CACHE_NO_MMAP
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//the magic bytes at the start of every cache file, the last character is the version
+static const char glgeImageCacheMagic[8] = {'G','L','G','E','I','M','G','2'};
+
+/**
+ * @brief the pixels of a cache file start at a multiple of this, so they are aligned for fast copies
+ */
+#define GLGE_IMAGE_CACHE_ALIGNMENT 64
+
+/**
+ * @brief the fixed part of the header of a cache file, it is followed by the path of the source and the pixels
+ */
+struct ImageCacheHeader
+{
+    //store the magic bytes
+    char magic[8];
+    //store the size of the image
+    uint32_t width;
+    uint32_t height;
+    //store the chanels of the pixels and the source file
+    uint32_t chanels;
+    uint32_t fileChanels;
+    //store the size, the last modification in the resolution of the file system and a hash of the content of the source
+    uint64_t srcSize;
+    int64_t srcTime;
+    uint64_t srcHash;
+    //store the length of the path of the source
+    uint32_t pathLength;
+    //store the requested chanels
+    uint32_t reqComp;
+};
+
+/**
+ * @brief the state of the image cache
+ */
+struct ImageCache
+{
+    //store the directory of the cache, empty if the cache is not active
+    std::string directory = "";
+    //store the maximum size of the cache
+    uint64_t maxBytes = GLGE_IMAGE_CACHE_DEFAULT_SIZE;
+    //store the mapped files by the pointer to their pixels
+    std::unordered_map<uint8_t*, std::pair<void*, size_t>> mappings;
+    //protect the cache, images are loaded by multiple threads
+    std::mutex mutex;
+};
+
+/**
+ * @brief get the image cache
+ *
+ * @return ImageCache& the state of the image cache
+ */
+static ImageCache& glgeGetImageCache()
+{
+    //create the cache on first use
+    static ImageCache cache;
+    return cache;
+}
+
+/**
+ * @brief get the path of the cache file for a source image
+ *
+ * @param directory the directory of the cache
+ * @param source the absolute path of the source
+ * @param req_comp the requested chanels
+ * @return std::string the path of the cache file
+ */
+static std::string glgeGetImageCachePath(const std::string& directory, const std::string& source, int req_comp)
+{
+    //hash the path and the chanels with FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : source) { hash = (hash ^ (uint8_t)c) * 1099511628211ull; }
+    hash = (hash ^ (uint8_t)req_comp) * 1099511628211ull;
+    //create the file name from the hash
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+    return (std::filesystem::path(directory) / (std::string(name) + GLGE_IMAGE_CACHE_ENDING)).string();
+}
+
+/**
+ * @brief get the absolute path of a source image, so relative paths from different working directories don't collide
+ *
+ * @param source the path to the source
+ * @return std::string the absolute path
+ */
+static std::string glgeGetAbsoluteSource(const char* source)
+{
+    //use the path as it is if it can't be resolved
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::absolute(source, error);
+    return error ? std::string(source) : path.lexically_normal().string();
+}
+
+/**
+ * @brief the size, the last modification and the content hash of a source image
+ */
+struct ImageCacheSource
+{
+    //store the size of the file in bytes
+    uint64_t size = 0;
+    //store the last modification, the unit depends on the file system clock
+    int64_t time = 0;
+    //store the hash of the content
+    uint64_t hash = 0;
+};
+
+/**
+ * @brief read the state of a source image, the content is hashed so changes that keep the size and the modification time are found
+ *
+ * @param source the path to the source
+ * @param state the state to fill
+ * @return true : the state was read | false : the source can't be read
+ */
+static bool glgeGetImageCacheSource(const char* source, ImageCacheSource* state)
+{
+    //get the size and the last modification
+    std::error_code error;
+    state->size = (uint64_t)std::filesystem::file_size(source, error);
+    if (error) { return false; }
+    state->time = (int64_t)std::filesystem::last_write_time(source, error).time_since_epoch().count();
+    if (error) { return false; }
+    //open the file
+    FILE* file = fopen(source, "rb");
+    if (!file) { return false; }
+    //hash 8 bytes at a time, the source is read in blocks so it is never stored completely
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ state->size;
+    std::vector<uint8_t> block(64*1024 + 8);
+    size_t read = 0;
+    while ((read = fread(block.data(), 1, block.size() - 8, file)) > 0)
+    {
+        //pad the last word with zeros
+        std::memset(block.data() + read, 0, 8);
+        for (size_t i = 0; i < read; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, block.data() + i, 8);
+            hash ^= word * 0x87C37B91114253D5ull;
+            hash = ((hash << 31) | (hash >> 33)) * 0x4CF5AD432745937Full;
+        }
+    }
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    //mix the bits of the last word into the whole hash
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    state->hash = hash;
+    return !failed;
+}
+
+/**
+ * @brief get the size of the header including the path and the padding before the pixels
+ *
+ * @param pathLength the length of the path of the source
+ * @return size_t the offset of the pixels in the file
+ */
+static size_t glgeGetImageCacheDataOffset(size_t pathLength)
+{
+    //round the header up to the alignment
+    size_t size = sizeof(ImageCacheHeader) + pathLength;
+    return (size + GLGE_IMAGE_CACHE_ALIGNMENT - 1) / GLGE_IMAGE_CACHE_ALIGNMENT * GLGE_IMAGE_CACHE_ALIGNMENT;
+}
+
+/**
+ * @brief delete the least recently used files until the cache fits its maximum size
+ *
+ * @param directory the directory of the cache
+ * @param maxBytes the maximum size of the cache
+ */
+static void glgeEvictImageCache(const std::string& directory, uint64_t maxBytes)
+{
+    //collect all cache files with their size and last use
+    struct Entry { std::filesystem::path path; std::filesystem::file_time_type time; uint64_t size; };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && (it != end); it.increment(error))
+    {
+        //only use cache files
+        if (it->path().extension() != GLGE_IMAGE_CACHE_ENDING) { continue; }
+        Entry entry;
+        entry.path = it->path();
+        entry.size = (uint64_t)it->file_size(error);
+        if (error) { error.clear(); continue; }
+        entry.time = it->last_write_time(error);
+        if (error) { error.clear(); continue; }
+        total += entry.size;
+        entries.push_back(entry);
+    }
+    //stop if the cache is small enough
+    if (total <= maxBytes) { return; }
+    //delete the oldest files first, files are touched when they are used
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    for (size_t i = 0; (i < entries.size()) && (total > maxBytes); i++)
+    {
+        //mapped files stay valid after they are removed
+        if (std::filesystem::remove(entries[i].path, error)) { total -= entries[i].size; }
+    }
+}
+
+void glgeSetImageCache(const char* directory, uint64_t maxBytes)
+{
+    //lock the cache
+    ImageCache& cache = glgeGetImageCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    //store the settings
+    cache.directory = directory ? std::string(directory) : std::string("");
+    cache.maxBytes = maxBytes;
+    //stop if the cache is deactivated
+    if (cache.directory.empty()) { return; }
+    //create the directory
+    std::error_code error;
+    std::filesystem::create_directories(cache.directory, error);
+    if (error)
+    {
+        //print a warning if warnings are enabled and deactivate the cache
+        if (glgeWarningOutput)
+        {
+            printf("[GLGE WARNING] Failed to create the image cache directory '%s', the image cache is deactivated\n", cache.directory.c_str());
+        }
+        cache.directory = "";
+        return;
+    }
+    //apply the new size
+    glgeEvictImageCache(cache.directory, cache.maxBytes);
+}
+
+bool glgeIsImageCacheActive()
+{
+    //lock the cache
+    ImageCache& cache = glgeGetImageCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    //the cache is active if a directory is set
+    return !cache.directory.empty();
+}
+
+uint64_t glgeGetImageCacheSize()
+{
+    //lock the cache
+    ImageCache& cache = glgeGetImageCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    //return the size
+    return cache.maxBytes;
+}
+
+uint8_t* glgeLoadCachedImage(const char* source, int req_comp, int* x, int* y, int* comp)
+{
+    //get the cache directory
+    ImageCache& cache = glgeGetImageCache();
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        directory = cache.directory;
+    }
+    if (directory.empty()) { return NULL; }
+    //get the state of the source file
+    ImageCacheSource src;
+    if (!glgeGetImageCacheSource(source, &src)) { return NULL; }
+    std::string absSource = glgeGetAbsoluteSource(source);
+    std::string path = glgeGetImageCachePath(directory, absSource, req_comp);
+
+#ifdef GLGE_IMAGE_CACHE_NO_MMAP
+    //read the whole file into the heap
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) { return NULL; }
+    std::streamsize fileSize = in.tellg();
+    if (fileSize < (std::streamsize)sizeof(ImageCacheHeader)) { return NULL; }
+    uint8_t* mapping = (uint8_t*)malloc((size_t)fileSize);
+    if (!mapping) { return NULL; }
+    in.seekg(0);
+    in.read((char*)mapping, fileSize);
+    if (!in) { free(mapping); return NULL; }
+    size_t mappingSize = (size_t)fileSize;
+#else
+    //open the file
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return NULL; }
+    //get the size of the file
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size < (off_t)sizeof(ImageCacheHeader))) { close(fd); return NULL; }
+    size_t mappingSize = (size_t)fileStat.st_size;
+    //map the file, the file descriptor is not needed after mapping
+    void* map = mmap(NULL, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { return NULL; }
+    uint8_t* mapping = (uint8_t*)map;
+#endif
+
+    //read the header
+    ImageCacheHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    size_t offset = glgeGetImageCacheDataOffset(header.pathLength);
+    //check that the file belongs to the source, the source did not change and the size of the file matches the pixels
+    bool valid = (std::memcmp(header.magic, glgeImageCacheMagic, 8) == 0) && (header.reqComp == (uint32_t)req_comp) &&
+                 (header.srcSize == src.size) && (header.srcTime == src.time) && (header.srcHash == src.hash) &&
+                 (header.pathLength == absSource.size()) && (header.width > 0) && (header.height > 0) &&
+                 (header.width <= 65536) && (header.height <= 65536) && (header.chanels >= 1) && (header.chanels <= 4) &&
+                 (mappingSize == offset + (size_t)header.width*header.height*header.chanels) &&
+                 (std::memcmp(mapping + sizeof(header), absSource.data(), absSource.size()) == 0);
+    if (!valid)
+    {
+        //free the file
+#ifdef GLGE_IMAGE_CACHE_NO_MMAP
+        free(mapping);
+#else
+        munmap(mapping, mappingSize);
+#endif
+        return NULL;
+    }
+
+    //mark the file as recently used
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    //output the size
+    *x = (int)header.width;
+    *y = (int)header.height;
+    if (comp) { *comp = (int)header.fileChanels; }
+#ifdef GLGE_IMAGE_CACHE_NO_MMAP
+    //move the pixels to the start of the allocation, so it can be freed like a decoded image
+    std::memmove(mapping, mapping + offset, mappingSize - offset);
+    return mapping;
+#else
+    //remember the mapping, so it can be unmapped when the pixels are freed
+    uint8_t* pixels = mapping + offset;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.mappings[pixels] = std::pair<void*, size_t>(mapping, mappingSize);
+    }
+    return pixels;
+#endif
+}
+
+void glgeStoreCachedImage(const char* source, int req_comp, int x, int y, int comp, const uint8_t* pixels)
+{
+    //get the cache settings
+    ImageCache& cache = glgeGetImageCache();
+    std::string directory;
+    uint64_t maxBytes;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        directory = cache.directory;
+        maxBytes = cache.maxBytes;
+    }
+    if (directory.empty() || !pixels || (x <= 0) || (y <= 0)) { return; }
+    //get the state of the source file
+    ImageCacheSource src;
+    if (!glgeGetImageCacheSource(source, &src)) { return; }
+    std::string absSource = glgeGetAbsoluteSource(source);
+    //fill the header
+    ImageCacheHeader header;
+    std::memcpy(header.magic, glgeImageCacheMagic, 8);
+    header.width = (uint32_t)x;
+    header.height = (uint32_t)y;
+    header.chanels = (uint32_t)(req_comp ? req_comp : comp);
+    header.fileChanels = (uint32_t)comp;
+    header.srcSize = src.size;
+    header.srcTime = src.time;
+    header.srcHash = src.hash;
+    header.pathLength = (uint32_t)absSource.size();
+    header.reqComp = (uint32_t)req_comp;
+    //don't cache images that would fill most of the cache on their own
+    uint64_t size = glgeGetImageCacheDataOffset(absSource.size()) + (uint64_t)x*y*header.chanels;
+    if (size > maxBytes / 2) { return; }
+
+    //write to a temporary file first, so a partial write is never read as a cache
+    std::string path = glgeGetImageCachePath(directory, absSource, req_comp);
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%p.tmp", (const void*)pixels);
+    std::string tmpPath = path + suffix;
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) { return; }
+        //write the header and the path
+        file.write((const char*)&header, sizeof(header));
+        file.write(absSource.data(), absSource.size());
+        //pad the header to the alignment
+        char padding[GLGE_IMAGE_CACHE_ALIGNMENT] = {0};
+        file.write(padding, glgeGetImageCacheDataOffset(absSource.size()) - sizeof(header) - absSource.size());
+        //write the pixels
+        file.write((const char*)pixels, (std::streamsize)((size_t)x*y*header.chanels));
+        if (!file) { file.close(); std::remove(tmpPath.c_str()); return; }
+    }
+    //replace the old cache file
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) { std::remove(tmpPath.c_str()); return; }
+    //keep the cache below its maximum size
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    glgeEvictImageCache(directory, maxBytes);
+}
+
+bool glgeFreeCachedImage(uint8_t* pixels)
+{
+#ifdef GLGE_IMAGE_CACHE_NO_MMAP
+    //cached images are heap copies that are freed like decoded images
+    (void)pixels;
+    return false;
+#else
+    //find the mapping of the pixels
+    ImageCache& cache = glgeGetImageCache();
+    std::pair<void*, size_t> mapping;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.mappings.find(pixels);
+        if (it == cache.mappings.end()) { return false; }
+        mapping = it->second;
+        cache.mappings.erase(it);
+    }
+    //unmap the file
+    munmap(mapping.first, mapping.second);
+    return true;
+#endif
+}
+
+void glgeClearImageCache()
+{
+    //lock the cache
+    ImageCache& cache = glgeGetImageCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.directory.empty()) { return; }
+    //an empty cache is smaller than every limit
+    glgeEvictImageCache(cache.directory, 0);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file glgeImageCache.h
+ * @author DM8AT
+ * @brief an on-disk cache of decoded images that is memory mapped instead of decoding the source again
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+#ifndef _GLGE_IMAGE_CACHE_H_
+#define _GLGE_IMAGE_CACHE_H_
+
+//include the needed standard librarys
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief the file ending of the files in the image cache
+ */
+#define GLGE_IMAGE_CACHE_ENDING ".glgeimg"
+/**
+ * @brief the default maximum size of the image cache in bytes (1 GiB)
+ */
+#define GLGE_IMAGE_CACHE_DEFAULT_SIZE (1024ull*1024ull*1024ull)
+
+/**
+ * @brief activate or deactivate the image cache
+ *
+ * @param directory the directory to store the decoded images in, it is created if it dosn't exist. NULL or an empty string deactivates the cache
+ * @param maxBytes the maximum size of all cached images, the least recently used images are deleted if the cache grows larger
+ */
+void glgeSetImageCache(const char* directory, uint64_t maxBytes = GLGE_IMAGE_CACHE_DEFAULT_SIZE);
+
+/**
+ * @brief check if the image cache is active
+ *
+ * @return true : decoded images are cached | false : the cache is not used
+ */
+bool glgeIsImageCacheActive();
+
+/**
+ * @brief get the maximum size of the image cache
+ *
+ * @return uint64_t the maximum size of all cached images in bytes
+ */
+uint64_t glgeGetImageCacheSize();
+
+/**
+ * @brief map the cached pixels of an image
+ *
+ * @param source the path to the source image
+ * @param req_comp the amount of chanels that were requested when the image was decoded
+ * @param x the width of the image
+ * @param y the height of the image
+ * @param comp the amount of chanels in the source file
+ * @return uint8_t* the pixels, must be freed with glgeImageFree, NULL if no valid cache for the source exists
+ */
+uint8_t* glgeLoadCachedImage(const char* source, int req_comp, int* x, int* y, int* comp);
+
+/**
+ * @brief store the decoded pixels of an image in the cache
+ *
+ * @param source the path to the source image
+ * @param req_comp the amount of chanels that were requested when the image was decoded, 0 if the chanels of the file were used
+ * @param x the width of the image
+ * @param y the height of the image
+ * @param comp the amount of chanels in the source file
+ * @param pixels the decoded pixels
+ */
+void glgeStoreCachedImage(const char* source, int req_comp, int x, int y, int comp, const uint8_t* pixels);
+
+/**
+ * @brief unmap pixels returned by glgeLoadCachedImage
+ *
+ * @param pixels the pixels to free
+ * @return true : the pixels were mapped from the cache and are unmapped | false : the pixels don't belong to the cache
+ */
+bool glgeFreeCachedImage(uint8_t* pixels);
+
+/**
+ * @brief delete all files in the image cache
+ */
+void glgeClearImageCache();
+
+#endif
@@ -196,6 +196,8 @@ std::string precompileShaderSource(std::string source, std::vector<std::string>
                     }
                     else
                     {
+                        //materials read their textures from the handle table if bindless textures are used
+                        if ((commandArgs == "<glgeMaterial>") && glgeBindlessTextures) { commandArgs = "<glgeMaterialBindless>"; }
                         //include the other needed things
                         std::string newSRC = precompileShaderSource(glgeIncludeDefaults[commandArgs], files);
                         //insert the string corresponding to the input
@@ -221,6 +223,14 @@ std::string precompileShaderSource(std::string source, std::vector<std::string>
         }
     }
 
+    //check if this is the whole shader (it starts with the version) and it uses bindless handles
+    if ((src.compare(0, 8, "#version") == 0) && (src.find("glgeMaterialHandleTable") != std::string::npos))
+    {
+        //the extension must be enabled directly after the version
+        size_t versionEnd = src.find('\n');
+        if (versionEnd != std::string::npos) { src.insert(versionEnd+1, "#extension GL_ARB_bindless_texture : require\n"); }
+    }
+
     return src;
 }
 
@@ -260,7 +270,10 @@ void loadIncludeDefaults()
 "vec4 lightSpaceMatR1;",
 "vec4 lightSpaceMatR2;",
 "vec4 lightSpaceMatR3;",
+"vec4 shadowRect;",
 "int type;",
+"int shadowed;",
+"int cascadeLayer;",
 "};"
 "\n#endif\n"
     });
@@ -279,6 +292,7 @@ void loadIncludeDefaults()
     glgeIncludeDefaults["<glgeLightEvaluationFunction>"] = flattenString({
 "#include <glgeLightStructure>\n",
 "#include <glgePixelStructure>\n",
+"#include <glgeShadowDefines>\n",
 "/*GLGE LIGHT EVALUATION FUNCTION START*/",
 "/*attenuation values for the light sources*/",
 "/*constant attenuation, isn't influenced by distance*/",
@@ -328,11 +342,59 @@ void loadIncludeDefaults()
 "    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);",
 "}",
 "",
+"/*the depth texture all shadow maps are packed into*/",
+"uniform sampler2D glgeShadowAtlas;",
+"/*the light space matrices and far distances of the shadow cascades of directional lights*/",
+"layout (std140, binding = 4) uniform glgeCascadeData",
+"{",
+"    mat4 glgeCascadeMats[GLGE_SHADOW_MAX_DIRECTIONAL * GLGE_SHADOW_CASCADE_COUNT];",
+"    vec4 glgeCascadeSplits[GLGE_SHADOW_MAX_DIRECTIONAL];",
+"};",
+"/*the depth array texture with all shadow cascades*/",
+"layout (binding = GLGE_SHADOW_CASCADE_TEXTURE_UNIT) uniform sampler2DArray glgeCascadeShadowMaps;",
+"/*Calculate the shadow factor for a directional light with cascades*/",
+"float glgeCalcCascadeShadowFac(glgePixel p, glgeLight l)",
+"{",
+"    float viewDepth = (vec4(p.pos - glgeCameraPos, 0) * glgeCamRotMat).z;",
+"    vec4 splits = glgeCascadeSplits[l.cascadeLayer / GLGE_SHADOW_CASCADE_COUNT];",
+"    if (viewDepth > splits.w) { return 1.f; }",
+"    int c = (viewDepth > splits.x ? 1 : 0) + (viewDepth > splits.y ? 1 : 0) + (viewDepth > splits.z ? 1 : 0);",
+"    vec4 lp = vec4(p.pos, 1) * glgeCascadeMats[l.cascadeLayer + c];",
+"    vec3 ndc = lp.xyz / lp.w;",
+"    vec2 uv = ndc.xy * 0.5 + 0.5;",
+"    if (any(lessThan(uv, vec2(0))) || any(greaterThan(uv, vec2(1)))) { return 1.f; }",
+"    float depth = ndc.z * 0.5 + 0.5;",
+"    vec2 texel = 1.f / vec2(textureSize(glgeCascadeShadowMaps, 0).xy);",
+"    float lit = 0.f;",
+"    for (int x = -1; x <= 1; x++) {",
+"        for (int y = -1; y <= 1; y++) {",
+"            lit += ((texture(glgeCascadeShadowMaps, vec3(uv + vec2(x,y) * texel, float(l.cascadeLayer + c))).r > depth + biasAngle) ? 0.f : 1.f);",
+"        }",
+"    }",
+"    return lit / 9.f;",
+"}",
 "/*Calculate the shadow factor for this pixel*/",
 "float glgeCalcShadowFac(glgePixel p, glgeLight l)",
 "{",
-"    if (l.type != 1) { return 1.f; }",
-"    return 1.f;",
+"    if (l.type == 2) { return (l.cascadeLayer < 0) ? 1.f : glgeCalcCascadeShadowFac(p, l); }",
+"    if ((l.type != 1) || (l.shadowed == 0)) { return 1.f; }",
+"    vec4 lp = vec4(p.pos, 1) * mat4(l.lightSpaceMatR0, l.lightSpaceMatR1, l.lightSpaceMatR2, l.lightSpaceMatR3);",
+"    if (lp.w <= 0.f) { return 1.f; }",
+"    vec3 ndc = lp.xyz / lp.w;",
+"    vec2 uv = ndc.xy * 0.5 + 0.5;",
+"    if (any(lessThan(uv, vec2(0))) || any(greaterThan(uv, vec2(1)))) { return 1.f; }",
+"    float depth = ndc.z * 0.5 + 0.5;",
+"    vec2 texel = 1.f / vec2(textureSize(glgeShadowAtlas, 0));",
+"    vec2 minUV = l.shadowRect.xy + texel * 0.5;",
+"    vec2 maxUV = l.shadowRect.xy + l.shadowRect.zw - texel * 0.5;",
+"    float lit = 0.f;",
+"    for (int x = -1; x <= 1; x++) {",
+"        for (int y = -1; y <= 1; y++) {",
+"            vec2 aUV = clamp(l.shadowRect.xy + uv * l.shadowRect.zw + vec2(x,y) * texel, minUV, maxUV);",
+"            lit += ((texture(glgeShadowAtlas, aUV).r > depth + biasAngle) ? 0.f : 1.f);",
+"        }",
+"    }",
+"    return lit / 9.f;",
 "}",
 "",
 "vec3 glgeEvaluateLight(glgeLight l, glgePixel p)",
@@ -414,6 +476,7 @@ void loadIncludeDefaults()
 "    mat4 glgeModelMat;",
 "    mat4 glgeRotMat;",
 "    int glgeObjectUUID;",
+"    int glgeMaterialIndex;",
 "};",
     });
     //the way to get the current material data
@@ -439,6 +502,42 @@ void loadIncludeDefaults()
 "uniform sampler2D glgeRoughnessMap;",
 "uniform sampler2D glgeMetalicMap;",
 "uniform sampler2D glgeDisplacementMap;",
+    });
+    //the way to get the current material data if the textures are accessed through bindless handles
+    glgeIncludeDefaults["<glgeMaterialBindless>"] = flattenString({
+"layout (std140, binding = 2) uniform glgeMaterialData",
+"{",
+"    vec4 glgeColor;",
+"    float glgeRoughness;",
+"    float glgeMetalic;",
+"    float dispStrength;",
+"    int minLayers;",
+"    int maxLayers;",
+"    int binarySteps;",
+"    int glgeLit;",
+"    int glgeAmbientMapActive;",
+"    int glgeNormalMapActive;",
+"    int glgeRoughnessMapActive;",
+"    int glgeMetalicMapActive;",
+"    int glgeDisplacementMapActive;",
+"};\n",
+"struct glgeMaterialHandles",
+"{",
+"    uvec2 ambient;",
+"    uvec2 normal;",
+"    uvec2 roughness;",
+"    uvec2 metalic;",
+"    uvec2 displacement;",
+"};\n",
+"layout (std430, binding = 5) readonly buffer glgeMaterialHandleData",
+"{",
+"    glgeMaterialHandles glgeMaterialHandleTable[];",
+"};\n",
+"#define glgeAmbientMap sampler2D(glgeMaterialHandleTable[glgeMaterialIndex].ambient)\n",
+"#define glgeNormalMap sampler2D(glgeMaterialHandleTable[glgeMaterialIndex].normal)\n",
+"#define glgeRoughnessMap sampler2D(glgeMaterialHandleTable[glgeMaterialIndex].roughness)\n",
+"#define glgeMetalicMap sampler2D(glgeMaterialHandleTable[glgeMaterialIndex].metalic)\n",
+"#define glgeDisplacementMap sampler2D(glgeMaterialHandleTable[glgeMaterialIndex].displacement)\n",
     });
     //the way to get the light data
     glgeIncludeDefaults["<glgeLights>"] = flattenString({
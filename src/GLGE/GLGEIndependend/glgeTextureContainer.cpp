@@ -0,0 +1,485 @@
+/**
+ * @file glgeTextureContainer.cpp
+ * @author DM8AT
+ * @brief implement the KTX2 and DDS readers
+ * @version 0.1
+ * @date 2024-03-09
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the header
+#include "glgeTextureContainer.h"
+//include the needed standard librarys
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+//include the memory mapping
+#if defined(_WIN32)
+#define GLGE_CONTAINER_NO_MMAP
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//the identifier at the start of every KTX2 file
+static const uint8_t glgeKTX2Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+/**
+ * @brief create a four character code like DDS files store them
+ */
+#define GLGE_FOURCC(a,b,c,d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+/**
+ * @brief read a 32 bit little endian value from a mapped file
+ *
+ * @param data the mapped file
+ * @param offset the offset of the value, must be in range
+ * @return uint32_t the value
+ */
+static inline uint32_t glgeReadU32(const uint8_t* data, size_t offset)
+{
+    uint32_t v;
+    std::memcpy(&v, data + offset, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief read a 64 bit little endian value from a mapped file
+ *
+ * @param data the mapped file
+ * @param offset the offset of the value, must be in range
+ * @return uint64_t the value
+ */
+static inline uint64_t glgeReadU64(const uint8_t* data, size_t offset)
+{
+    uint64_t v;
+    std::memcpy(&v, data + offset, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief get the size of a single image in a container format
+ *
+ * @param format the container format
+ * @param width the width of the image in pixels
+ * @param height the height of the image in pixels
+ * @return uint64_t the size in bytes, 0 if the format is unknown
+ */
+static uint64_t glgeGetContainerImageSize(unsigned int format, int width, int height)
+{
+    //get the block layout
+    unsigned int blockBytes = 0;
+    int block = glgeGetContainerFormatBlock(format, &blockBytes);
+    if (block == 0) { return 0; }
+    //every started block is stored completely
+    return (uint64_t)((width + block - 1) / block) * (uint64_t)((height + block - 1) / block) * blockBytes;
+}
+
+/**
+ * @brief convert a Vulkan format, like KTX2 stores it, to a container format
+ *
+ * @param vkFormat the Vulkan format
+ * @return unsigned int the container format
+ */
+static unsigned int glgeFormatFromVulkan(uint32_t vkFormat)
+{
+    switch (vkFormat)
+    {
+    case 9: return GLGE_CONTAINER_FORMAT_R8;
+    case 16: return GLGE_CONTAINER_FORMAT_RG8;
+    case 37: return GLGE_CONTAINER_FORMAT_RGBA8;
+    case 43: return GLGE_CONTAINER_FORMAT_RGBA8_SRGB;
+    case 44: return GLGE_CONTAINER_FORMAT_BGRA8;
+    case 50: return GLGE_CONTAINER_FORMAT_BGRA8_SRGB;
+    case 76: return GLGE_CONTAINER_FORMAT_R16F;
+    case 83: return GLGE_CONTAINER_FORMAT_RG16F;
+    case 97: return GLGE_CONTAINER_FORMAT_RGBA16F;
+    case 100: return GLGE_CONTAINER_FORMAT_R32F;
+    case 103: return GLGE_CONTAINER_FORMAT_RG32F;
+    case 109: return GLGE_CONTAINER_FORMAT_RGBA32F;
+    //BC1 with and without alpha use the same blocks
+    case 131: case 133: return GLGE_CONTAINER_FORMAT_BC1;
+    case 132: case 134: return GLGE_CONTAINER_FORMAT_BC1_SRGB;
+    case 135: return GLGE_CONTAINER_FORMAT_BC2;
+    case 136: return GLGE_CONTAINER_FORMAT_BC2_SRGB;
+    case 137: return GLGE_CONTAINER_FORMAT_BC3;
+    case 138: return GLGE_CONTAINER_FORMAT_BC3_SRGB;
+    case 139: return GLGE_CONTAINER_FORMAT_BC4;
+    case 141: return GLGE_CONTAINER_FORMAT_BC5;
+    case 143: return GLGE_CONTAINER_FORMAT_BC6H_UF;
+    case 144: return GLGE_CONTAINER_FORMAT_BC6H_SF;
+    case 145: return GLGE_CONTAINER_FORMAT_BC7;
+    case 146: return GLGE_CONTAINER_FORMAT_BC7_SRGB;
+    default: return GLGE_CONTAINER_FORMAT_UNKNOWN;
+    }
+}
+
+/**
+ * @brief convert a DXGI format, like the DX10 header of a DDS file stores it, to a container format
+ *
+ * @param dxgiFormat the DXGI format
+ * @return unsigned int the container format
+ */
+static unsigned int glgeFormatFromDXGI(uint32_t dxgiFormat)
+{
+    switch (dxgiFormat)
+    {
+    case 61: return GLGE_CONTAINER_FORMAT_R8;
+    case 49: return GLGE_CONTAINER_FORMAT_RG8;
+    case 28: return GLGE_CONTAINER_FORMAT_RGBA8;
+    case 29: return GLGE_CONTAINER_FORMAT_RGBA8_SRGB;
+    case 87: return GLGE_CONTAINER_FORMAT_BGRA8;
+    case 91: return GLGE_CONTAINER_FORMAT_BGRA8_SRGB;
+    case 54: return GLGE_CONTAINER_FORMAT_R16F;
+    case 34: return GLGE_CONTAINER_FORMAT_RG16F;
+    case 10: return GLGE_CONTAINER_FORMAT_RGBA16F;
+    case 41: return GLGE_CONTAINER_FORMAT_R32F;
+    case 16: return GLGE_CONTAINER_FORMAT_RG32F;
+    case 2: return GLGE_CONTAINER_FORMAT_RGBA32F;
+    case 71: return GLGE_CONTAINER_FORMAT_BC1;
+    case 72: return GLGE_CONTAINER_FORMAT_BC1_SRGB;
+    case 74: return GLGE_CONTAINER_FORMAT_BC2;
+    case 75: return GLGE_CONTAINER_FORMAT_BC2_SRGB;
+    case 77: return GLGE_CONTAINER_FORMAT_BC3;
+    case 78: return GLGE_CONTAINER_FORMAT_BC3_SRGB;
+    case 80: return GLGE_CONTAINER_FORMAT_BC4;
+    case 83: return GLGE_CONTAINER_FORMAT_BC5;
+    case 95: return GLGE_CONTAINER_FORMAT_BC6H_UF;
+    case 96: return GLGE_CONTAINER_FORMAT_BC6H_SF;
+    case 98: return GLGE_CONTAINER_FORMAT_BC7;
+    case 99: return GLGE_CONTAINER_FORMAT_BC7_SRGB;
+    default: return GLGE_CONTAINER_FORMAT_UNKNOWN;
+    }
+}
+
+/**
+ * @brief check the size of a container and the amount of mip levels
+ *
+ * @param container the container to check
+ * @return true : the size is valid | false : the size is invalid
+ */
+static bool glgeCheckContainerSize(const TextureContainer* container)
+{
+    //check the size
+    if ((container->width <= 0) || (container->height <= 0) || (container->width > 65536) || (container->height > 65536)) { return false; }
+    //check the array size
+    if ((container->layers < 0) || (container->layers > 2048)) { return false; }
+    //check that no more levels exist than a full mip chain has
+    int maxLevels = 1;
+    for (int s = std::max(container->width, container->height); s > 1; s >>= 1) { maxLevels++; }
+    return (container->levels >= 1) && (container->levels <= maxLevels);
+}
+
+/**
+ * @brief read the header of a KTX2 file
+ *
+ * @param container the container with the mapped file
+ * @return true : the file is valid | false : the file is invalid or unsupported
+ */
+static bool glgeReadKTX2(TextureContainer* container)
+{
+    //get the file
+    const uint8_t* data = container->mapping;
+    size_t size = container->mappingSize;
+    //the header and the index are 80 bytes
+    if (size < 80) { return false; }
+    //read the header
+    uint32_t vkFormat = glgeReadU32(data, 12);
+    uint32_t pixelWidth = glgeReadU32(data, 20);
+    uint32_t pixelHeight = glgeReadU32(data, 24);
+    uint32_t pixelDepth = glgeReadU32(data, 28);
+    uint32_t layerCount = glgeReadU32(data, 32);
+    uint32_t faceCount = glgeReadU32(data, 36);
+    uint32_t levelCount = glgeReadU32(data, 40);
+    uint32_t supercompression = glgeReadU32(data, 44);
+    //only 2D textures, arrays and cube maps without supercompression are supported
+    if ((pixelDepth != 0) || (supercompression != 0)) { return false; }
+    if ((faceCount != 1) && (faceCount != 6)) { return false; }
+    if ((pixelWidth > 65536) || (pixelHeight > 65536) || (layerCount > 2048) || (levelCount > 32)) { return false; }
+    //get the format
+    container->format = glgeFormatFromVulkan(vkFormat);
+    if (container->format == GLGE_CONTAINER_FORMAT_UNKNOWN) { return false; }
+    //store the size
+    container->width = (int)pixelWidth;
+    container->height = (int)pixelHeight;
+    container->layers = (int)layerCount;
+    container->faces = (int)faceCount;
+    //a level count of 0 asks for the mip levels to be generated
+    container->levels = std::max(1, (int)levelCount);
+    container->generateMipmaps = (levelCount == 0);
+    if (!glgeCheckContainerSize(container)) { return false; }
+    //check that the level index fits in the file
+    if (size < 80 + (size_t)container->levels*24) { return false; }
+
+    //get the amount of images per level
+    int perLevel = std::max(1, container->layers) * container->faces;
+    container->images.resize((size_t)container->levels * perLevel);
+    for (int l = 0; l < container->levels; l++)
+    {
+        //read the level index
+        uint64_t offset = glgeReadU64(data, 80 + (size_t)l*24);
+        uint64_t length = glgeReadU64(data, 80 + (size_t)l*24 + 8);
+        //get the size of a single image
+        uint64_t imageSize = glgeGetContainerImageSize(container->format, std::max(1, container->width >> l), std::max(1, container->height >> l));
+        //the level must contain all images and be inside of the file
+        if ((length < imageSize * perLevel) || (offset > size) || (length > size - offset)) { return false; }
+        //the images of a level are sorted by layer and then by face
+        for (int i = 0; i < perLevel; i++)
+        {
+            TextureContainerImage& img = container->images[(size_t)l*perLevel + i];
+            img.data = data + offset + imageSize*i;
+            img.size = imageSize;
+        }
+    }
+    //the file is valid
+    return true;
+}
+
+/**
+ * @brief read the header of a DDS file
+ *
+ * @param container the container with the mapped file
+ * @return true : the file is valid | false : the file is invalid or unsupported
+ */
+static bool glgeReadDDS(TextureContainer* container)
+{
+    //get the file
+    const uint8_t* data = container->mapping;
+    size_t size = container->mappingSize;
+    //the magic and the header are 128 bytes
+    if ((size < 128) || (glgeReadU32(data, 4) != 124)) { return false; }
+    //read the header
+    uint32_t flags = glgeReadU32(data, 8);
+    uint32_t height = glgeReadU32(data, 12);
+    uint32_t width = glgeReadU32(data, 16);
+    uint32_t mipCount = glgeReadU32(data, 28);
+    uint32_t pfFlags = glgeReadU32(data, 80);
+    uint32_t fourCC = glgeReadU32(data, 84);
+    uint32_t bitCount = glgeReadU32(data, 88);
+    uint32_t rMask = glgeReadU32(data, 92);
+    uint32_t bMask = glgeReadU32(data, 100);
+    uint32_t caps2 = glgeReadU32(data, 112);
+    //volume textures are not supported
+    if (caps2 & 0x200000) { return false; }
+    if ((width > 65536) || (height > 65536)) { return false; }
+    //the data starts after the header
+    size_t dataStart = 128;
+    container->layers = 0;
+    container->faces = 1;
+    //check for a cube map, only complete cube maps are supported
+    if (caps2 & 0x200)
+    {
+        if ((caps2 & 0xFC00) != 0xFC00) { return false; }
+        container->faces = 6;
+    }
+    //check for the extended header
+    if ((pfFlags & 0x4) && (fourCC == GLGE_FOURCC('D','X','1','0')))
+    {
+        //the extended header is 20 bytes
+        if (size < 148) { return false; }
+        container->format = glgeFormatFromDXGI(glgeReadU32(data, 128));
+        uint32_t dimension = glgeReadU32(data, 132);
+        uint32_t misc = glgeReadU32(data, 136);
+        uint32_t arraySize = glgeReadU32(data, 140);
+        //only 2D textures are supported
+        if ((dimension != 3) || (arraySize == 0) || (arraySize > 2048)) { return false; }
+        //check for a cube map
+        if (misc & 0x4) { container->faces = 6; }
+        //single textures are no arrays
+        container->layers = (arraySize > 1) ? (int)arraySize : 0;
+        dataStart = 148;
+    }
+    else if (pfFlags & 0x4)
+    {
+        //select the format from the four character code
+        switch (fourCC)
+        {
+        case GLGE_FOURCC('D','X','T','1'): container->format = GLGE_CONTAINER_FORMAT_BC1; break;
+        case GLGE_FOURCC('D','X','T','2'):
+        case GLGE_FOURCC('D','X','T','3'): container->format = GLGE_CONTAINER_FORMAT_BC2; break;
+        case GLGE_FOURCC('D','X','T','4'):
+        case GLGE_FOURCC('D','X','T','5'): container->format = GLGE_CONTAINER_FORMAT_BC3; break;
+        case GLGE_FOURCC('A','T','I','1'):
+        case GLGE_FOURCC('B','C','4','U'): container->format = GLGE_CONTAINER_FORMAT_BC4; break;
+        case GLGE_FOURCC('A','T','I','2'):
+        case GLGE_FOURCC('B','C','5','U'): container->format = GLGE_CONTAINER_FORMAT_BC5; break;
+        //legacy D3D formats are stored as numbers
+        case 111: container->format = GLGE_CONTAINER_FORMAT_R16F; break;
+        case 112: container->format = GLGE_CONTAINER_FORMAT_RG16F; break;
+        case 113: container->format = GLGE_CONTAINER_FORMAT_RGBA16F; break;
+        case 114: container->format = GLGE_CONTAINER_FORMAT_R32F; break;
+        case 115: container->format = GLGE_CONTAINER_FORMAT_RG32F; break;
+        case 116: container->format = GLGE_CONTAINER_FORMAT_RGBA32F; break;
+        default: container->format = GLGE_CONTAINER_FORMAT_UNKNOWN; break;
+        }
+    }
+    else if ((pfFlags & 0x40) && (bitCount == 32))
+    {
+        //select the chanel order from the masks
+        if ((rMask == 0x000000FF) && (bMask == 0x00FF0000)) { container->format = GLGE_CONTAINER_FORMAT_RGBA8; }
+        else if ((rMask == 0x00FF0000) && (bMask == 0x000000FF)) { container->format = GLGE_CONTAINER_FORMAT_BGRA8; }
+        else { container->format = GLGE_CONTAINER_FORMAT_UNKNOWN; }
+    }
+    else
+    {
+        //the format is not supported
+        container->format = GLGE_CONTAINER_FORMAT_UNKNOWN;
+    }
+    if (container->format == GLGE_CONTAINER_FORMAT_UNKNOWN) { return false; }
+    //store the size
+    container->width = (int)width;
+    container->height = (int)height;
+    //the mip count is only valid if the flag is set
+    container->levels = (flags & 0x20000) ? std::max(1, (int)std::min(mipCount, 32u)) : 1;
+    container->generateMipmaps = false;
+    if ((mipCount > 32) || !glgeCheckContainerSize(container)) { return false; }
+
+    //the images are stored by layer, then by face and then by mip level
+    int layers = std::max(1, container->layers);
+    container->images.resize((size_t)container->levels * layers * container->faces);
+    uint64_t offset = dataStart;
+    for (int layer = 0; layer < layers; layer++)
+    {
+        for (int face = 0; face < container->faces; face++)
+        {
+            for (int l = 0; l < container->levels; l++)
+            {
+                //get the size of the image
+                uint64_t imageSize = glgeGetContainerImageSize(container->format, std::max(1, container->width >> l), std::max(1, container->height >> l));
+                //the image must be inside of the file
+                if ((offset > size) || (imageSize > size - offset)) { return false; }
+                //store the image sorted by level, layer and face
+                TextureContainerImage& img = container->images[((size_t)l*layers + layer)*container->faces + face];
+                img.data = data + offset;
+                img.size = imageSize;
+                offset += imageSize;
+            }
+        }
+    }
+    //the file is valid
+    return true;
+}
+
+bool glgeIsTextureContainer(const char* file)
+{
+    //get the file ending in lower case
+    std::string path = file;
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) { return false; }
+    std::string ending = path.substr(dot + 1);
+    std::transform(ending.begin(), ending.end(), ending.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+    //check for the container endings
+    return (ending == "ktx2") || (ending == "dds");
+}
+
+int glgeGetContainerFormatBlock(unsigned int format, unsigned int* blockBytes)
+{
+    //get the size of a block or pixel
+    unsigned int bytes = 0;
+    int block = 1;
+    switch (format)
+    {
+    case GLGE_CONTAINER_FORMAT_R8: bytes = 1; break;
+    case GLGE_CONTAINER_FORMAT_RG8: bytes = 2; break;
+    case GLGE_CONTAINER_FORMAT_RGBA8:
+    case GLGE_CONTAINER_FORMAT_RGBA8_SRGB:
+    case GLGE_CONTAINER_FORMAT_BGRA8:
+    case GLGE_CONTAINER_FORMAT_BGRA8_SRGB: bytes = 4; break;
+    case GLGE_CONTAINER_FORMAT_R16F: bytes = 2; break;
+    case GLGE_CONTAINER_FORMAT_RG16F: bytes = 4; break;
+    case GLGE_CONTAINER_FORMAT_RGBA16F: bytes = 8; break;
+    case GLGE_CONTAINER_FORMAT_R32F: bytes = 4; break;
+    case GLGE_CONTAINER_FORMAT_RG32F: bytes = 8; break;
+    case GLGE_CONTAINER_FORMAT_RGBA32F: bytes = 16; break;
+    case GLGE_CONTAINER_FORMAT_BC1:
+    case GLGE_CONTAINER_FORMAT_BC1_SRGB:
+    case GLGE_CONTAINER_FORMAT_BC4: bytes = 8; block = 4; break;
+    case GLGE_CONTAINER_FORMAT_BC2:
+    case GLGE_CONTAINER_FORMAT_BC2_SRGB:
+    case GLGE_CONTAINER_FORMAT_BC3:
+    case GLGE_CONTAINER_FORMAT_BC3_SRGB:
+    case GLGE_CONTAINER_FORMAT_BC5:
+    case GLGE_CONTAINER_FORMAT_BC6H_UF:
+    case GLGE_CONTAINER_FORMAT_BC6H_SF:
+    case GLGE_CONTAINER_FORMAT_BC7:
+    case GLGE_CONTAINER_FORMAT_BC7_SRGB: bytes = 16; block = 4; break;
+    default: block = 0; break;
+    }
+    //store the size
+    if (blockBytes) { *blockBytes = bytes; }
+    return block;
+}
+
+bool glgeOpenTextureContainer(const char* file, TextureContainer* container)
+{
+    //start with an empty container
+    *container = TextureContainer();
+#ifdef GLGE_CONTAINER_NO_MMAP
+    //read the whole file into the heap
+    std::ifstream in(file, std::ios::binary | std::ios::ate);
+    if (!in) { return false; }
+    std::streamsize fileSize = in.tellg();
+    if (fileSize <= 0) { return false; }
+    uint8_t* buffer = new uint8_t[(size_t)fileSize];
+    in.seekg(0);
+    in.read((char*)buffer, fileSize);
+    if (!in) { delete[] buffer; return false; }
+    container->mapping = buffer;
+    container->mappingSize = (size_t)fileSize;
+    container->heapMapping = true;
+#else
+    //open the file
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) { return false; }
+    //get the size of the file
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0)) { close(fd); return false; }
+    //map the file, the file descriptor is not needed after mapping
+    void* mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) { return false; }
+    container->mapping = (const uint8_t*)mapping;
+    container->mappingSize = (size_t)fileStat.st_size;
+#endif
+
+    //select the reader from the magic bytes
+    bool valid = false;
+    if ((container->mappingSize >= 12) && (std::memcmp(container->mapping, glgeKTX2Identifier, 12) == 0))
+    {
+        valid = glgeReadKTX2(container);
+    }
+    else if ((container->mappingSize >= 4) && (glgeReadU32(container->mapping, 0) == GLGE_FOURCC('D','D','S',' ')))
+    {
+        valid = glgeReadDDS(container);
+    }
+    //close the file if it can't be used
+    if (!valid)
+    {
+        glgeCloseTextureContainer(container);
+        return false;
+    }
+    return true;
+}
+
+void glgeCloseTextureContainer(TextureContainer* container)
+{
+    //check if a file is mapped
+    if (container->mapping)
+    {
+#ifdef GLGE_CONTAINER_NO_MMAP
+        delete[] container->mapping;
+#else
+        //unmap the file, the read data was read-only
+        if (container->heapMapping) { delete[] container->mapping; }
+        else { munmap((void*)container->mapping, container->mappingSize); }
+#endif
+    }
+    //clear the container
+    *container = TextureContainer();
+}
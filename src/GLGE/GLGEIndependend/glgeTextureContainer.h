@@ -0,0 +1,236 @@
+/**
+ * @file glgeTextureContainer.h
+ * @author DM8AT
+ * @brief read KTX2 and DDS texture containers with prebuilt mip levels, array layers and cube faces from a memory mapped file
+ * @version 0.1
+ * @date 2024-03-09
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+#ifndef _GLGE_TEXTURE_CONTAINER_H_
+#define _GLGE_TEXTURE_CONTAINER_H_
+
+//include the needed standard librarys
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+//the pixel formats a container can store
+
+/**
+ * @brief the format is not supported
+ */
+#define GLGE_CONTAINER_FORMAT_UNKNOWN 0
+/**
+ * @brief one 8 bit unsigned normalized chanel
+ */
+#define GLGE_CONTAINER_FORMAT_R8 1
+/**
+ * @brief two 8 bit unsigned normalized chanels
+ */
+#define GLGE_CONTAINER_FORMAT_RG8 2
+/**
+ * @brief four 8 bit unsigned normalized chanels
+ */
+#define GLGE_CONTAINER_FORMAT_RGBA8 3
+/**
+ * @brief four 8 bit sRGB chanels
+ */
+#define GLGE_CONTAINER_FORMAT_RGBA8_SRGB 4
+/**
+ * @brief four 8 bit unsigned normalized chanels in BGRA order
+ */
+#define GLGE_CONTAINER_FORMAT_BGRA8 5
+/**
+ * @brief four 8 bit sRGB chanels in BGRA order
+ */
+#define GLGE_CONTAINER_FORMAT_BGRA8_SRGB 6
+/**
+ * @brief one 16 bit float chanel
+ */
+#define GLGE_CONTAINER_FORMAT_R16F 7
+/**
+ * @brief two 16 bit float chanels
+ */
+#define GLGE_CONTAINER_FORMAT_RG16F 8
+/**
+ * @brief four 16 bit float chanels
+ */
+#define GLGE_CONTAINER_FORMAT_RGBA16F 9
+/**
+ * @brief one 32 bit float chanel
+ */
+#define GLGE_CONTAINER_FORMAT_R32F 10
+/**
+ * @brief two 32 bit float chanels
+ */
+#define GLGE_CONTAINER_FORMAT_RG32F 11
+/**
+ * @brief four 32 bit float chanels
+ */
+#define GLGE_CONTAINER_FORMAT_RGBA32F 12
+/**
+ * @brief BC1 compressed blocks
+ */
+#define GLGE_CONTAINER_FORMAT_BC1 13
+/**
+ * @brief BC1 compressed blocks with sRGB colors
+ */
+#define GLGE_CONTAINER_FORMAT_BC1_SRGB 14
+/**
+ * @brief BC2 compressed blocks
+ */
+#define GLGE_CONTAINER_FORMAT_BC2 15
+/**
+ * @brief BC2 compressed blocks with sRGB colors
+ */
+#define GLGE_CONTAINER_FORMAT_BC2_SRGB 16
+/**
+ * @brief BC3 compressed blocks
+ */
+#define GLGE_CONTAINER_FORMAT_BC3 17
+/**
+ * @brief BC3 compressed blocks with sRGB colors
+ */
+#define GLGE_CONTAINER_FORMAT_BC3_SRGB 18
+/**
+ * @brief BC4 compressed blocks
+ */
+#define GLGE_CONTAINER_FORMAT_BC4 19
+/**
+ * @brief BC5 compressed blocks
+ */
+#define GLGE_CONTAINER_FORMAT_BC5 20
+/**
+ * @brief BC6H compressed blocks with unsigned floats
+ */
+#define GLGE_CONTAINER_FORMAT_BC6H_UF 21
+/**
+ * @brief BC6H compressed blocks with signed floats
+ */
+#define GLGE_CONTAINER_FORMAT_BC6H_SF 22
+/**
+ * @brief BC7 compressed blocks
+ */
+#define GLGE_CONTAINER_FORMAT_BC7 23
+/**
+ * @brief BC7 compressed blocks with sRGB colors
+ */
+#define GLGE_CONTAINER_FORMAT_BC7_SRGB 24
+
+/**
+ * @brief a single image (one mip level of one layer and face) inside of a container
+ */
+struct TextureContainerImage
+{
+    /**
+     * @brief a pointer to the data of the image inside of the mapped file
+     */
+    const uint8_t* data = 0;
+    /**
+     * @brief the size of the image data in bytes
+     */
+    uint64_t size = 0;
+};
+
+/**
+ * @brief a memory mapped KTX2 or DDS file
+ */
+struct TextureContainer
+{
+    /**
+     * @brief the pixel format of all images (GLGE_CONTAINER_FORMAT_*)
+     */
+    unsigned int format = GLGE_CONTAINER_FORMAT_UNKNOWN;
+    /**
+     * @brief the width of the first mip level in pixels
+     */
+    int width = 0;
+    /**
+     * @brief the height of the first mip level in pixels
+     */
+    int height = 0;
+    /**
+     * @brief the amount of mip levels stored in the file
+     */
+    int levels = 0;
+    /**
+     * @brief the amount of array layers, 0 if the texture is not an array
+     */
+    int layers = 0;
+    /**
+     * @brief the amount of faces, 6 for cube maps and 1 for everything else
+     */
+    int faces = 1;
+    /**
+     * @brief say if the file asks for the mip levels to be generated after loading
+     */
+    bool generateMipmaps = false;
+    /**
+     * @brief all images, sorted by mip level, then by layer, then by face
+     */
+    std::vector<TextureContainerImage> images = {};
+    /**
+     * @brief the mapped file
+     */
+    const uint8_t* mapping = 0;
+    /**
+     * @brief the size of the mapped file in bytes
+     */
+    size_t mappingSize = 0;
+    /**
+     * @brief say if the mapping was read into the heap because memory mapping is not available
+     */
+    bool heapMapping = false;
+
+    /**
+     * @brief get an image of the container
+     *
+     * @param level the mip level of the image
+     * @param layer the array layer of the image
+     * @param face the cube face of the image
+     * @return const TextureContainerImage& the image
+     */
+    const TextureContainerImage& getImage(int level, int layer = 0, int face = 0) const
+    {
+        //the images are sorted by level, then layer and then face
+        return this->images[((size_t)level*(this->layers ? this->layers : 1) + layer)*this->faces + face];
+    }
+};
+
+/**
+ * @brief check if a file is a texture container by its file ending (.ktx2 or .dds)
+ *
+ * @param file the path to the file
+ * @return true : the file should be loaded as a texture container | false : the file is a normal image
+ */
+bool glgeIsTextureContainer(const char* file);
+
+/**
+ * @brief get the size of a block and the block dimension of a container format
+ *
+ * @param format the container format
+ * @param blockBytes the size of a block (or a pixel for uncompressed formats) in bytes
+ * @return int the width and height of a block, 4 for compressed formats and 1 for uncompressed formats, 0 if the format is unknown
+ */
+int glgeGetContainerFormatBlock(unsigned int format, unsigned int* blockBytes);
+
+/**
+ * @brief map a KTX2 or DDS file and read the location of all images
+ *
+ * @param file the path to the file
+ * @param container the container to fill, must be closed with glgeCloseTextureContainer
+ * @return true : the container was opened | false : the file is missing, invalid or uses an unsupported format
+ */
+bool glgeOpenTextureContainer(const char* file, TextureContainer* container);
+
+/**
+ * @brief unmap the file of a container
+ *
+ * @param container the container to close
+ */
+void glgeCloseTextureContainer(TextureContainer* container);
+
+#endif
@@ -178,6 +178,11 @@ bool glgeShadowPass = false;
  */
 int glgeShadowCasterIndex = 0;
 
+/**
+ * @brief say if material textures are accessed through bindless handles
+ */
+bool glgeBindlessTextures = false;
+
 /**
  * @brief say if GLGE should keep track of generel debug data
  */
@@ -206,6 +211,14 @@ int glgeBytesPassedToGPU = 0;
  * @brief store the amount of bytes read back from the GPU last tick
  */
 int glgeBytesReadFromGPU = 0;
+/**
+ * @brief store the amount of objects drawn into shadow maps last tick
+ */
+int glgeShadowCastersDrawn = 0;
+/**
+ * @brief store the amount of objects skipped for shadow maps last tick, because they where outside of the light frustum
+ */
+int glgeShadowCastersSkipped = 0;
 /**
  * @brief store the amount of draw calls taken this tick
  */
@@ -229,4 +242,12 @@ int glgeBytesPassedToGPUT = 0;
 /**
  * @brief store the amount of bytes read back from the GPU taken this tick
  */
-int glgeBytesReadFromGPUT = 0;
\ No newline at end of file
+int glgeBytesReadFromGPUT = 0;
+/**
+ * @brief store the amount of objects drawn into shadow maps this tick
+ */
+int glgeShadowCastersDrawnT = 0;
+/**
+ * @brief store the amount of objects skipped for shadow maps this tick, because they where outside of the light frustum
+ */
+int glgeShadowCastersSkippedT = 0;
\ No newline at end of file
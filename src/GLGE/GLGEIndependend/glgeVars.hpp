@@ -132,6 +132,9 @@ extern bool glgeShadowPass;
 //store the index of the current shadow caster
 extern int glgeShadowCasterIndex;
 
+//say if material textures are accessed through bindless handles
+extern bool glgeBindlessTextures;
+
 /**
  * @brief say if GLGE should keep track of generel debug data
  */
@@ -160,6 +163,14 @@ extern int glgeBytesPassedToGPU;
  * @brief store the amount of bytes read back from the GPU last tick
  */
 extern int glgeBytesReadFromGPU;
+/**
+ * @brief store the amount of objects drawn into shadow maps last tick
+ */
+extern int glgeShadowCastersDrawn;
+/**
+ * @brief store the amount of objects skipped for shadow maps last tick, because they where outside of the light frustum
+ */
+extern int glgeShadowCastersSkipped;
 /**
  * @brief store the amount of draw calls taken this tick
  */
@@ -184,5 +195,13 @@ extern int glgeBytesPassedToGPUT;
  * @brief store the amount of bytes read back from the GPU taken this tick
  */
 extern int glgeBytesReadFromGPUT;
+/**
+ * @brief store the amount of objects drawn into shadow maps this tick
+ */
+extern int glgeShadowCastersDrawnT;
+/**
+ * @brief store the amount of objects skipped for shadow maps this tick, because they where outside of the light frustum
+ */
+extern int glgeShadowCastersSkippedT;
 
 #endif
\ No newline at end of file
@@ -503,4 +503,29 @@ vec3 glgeAngleToDir(float x, float y, float z)
 {
     //cast to another function
     return glgeAngleToDir(vec3(x,y,z));
+}
+
+bool glgeSphereInFrustum(mat4 viewProj, vec3 center, float radius)
+{
+    //loop over the x, y and z rows of the matrix, each one defines two planes
+    for (int r = 0; r < 3; r++)
+    {
+        //loop over the positive and negative plane
+        for (int sign = -1; sign <= 1; sign += 2)
+        {
+            //extract the plane from the matrix (Gribb-Hartmann)
+            float a = viewProj.m[3][0] + sign*viewProj.m[r][0];
+            float b = viewProj.m[3][1] + sign*viewProj.m[r][1];
+            float c = viewProj.m[3][2] + sign*viewProj.m[r][2];
+            float d = viewProj.m[3][3] + sign*viewProj.m[r][3];
+            //calculate the length of the plane normal
+            float len = std::sqrt(a*a + b*b + c*c);
+            //skip degenerated planes
+            if (len == 0.f) { continue; }
+            //check if the sphere is completely behind the plane
+            if ((a*center.x + b*center.y + c*center.z + d) / len < -radius) { return false; }
+        }
+    }
+    //the sphere is not behind any plane
+    return true;
 }
\ No newline at end of file
@@ -349,4 +349,15 @@ vec3 glgeAngleToDir(vec3 angles);
  */
 vec3 glgeAngleToDir(float x, float y, float z);
 
+/**
+ * @brief check if a sphere is at least partly inside the frustum of a view-projection matrix
+ * 
+ * @param viewProj the view-projection matrix that defines the frustum
+ * @param center the center of the sphere
+ * @param radius the radius of the sphere
+ * @return true : the sphere intersects the frustum | 
+ * @return false : the sphere is completely outside of the frustum
+ */
+bool glgeSphereInFrustum(mat4 viewProj, vec3 center, float radius);
+
 #endif
\ No newline at end of file
@@ -24,6 +24,8 @@
 #include "openglGLGEVars.hpp"
 #include "openglGLGEFuncs.hpp"
 #include "openglGLGEDefaultFuncs.hpp"
+#include "openglGLGETexture.hpp"
+#include "openglGLGELightingCore.h"
 #include "../GLGEIndependend/glgePrivDefines.hpp"
 
 //include acess to images
@@ -37,6 +39,11 @@
 #include <ctime>
 #include <fstream>
 #include <algorithm>
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 ////////////////////
 //Public functions//
@@ -100,6 +107,12 @@ void glgeInit()
     glgeCurrentWindowIndex = 0;
     //load the include defaults
     loadIncludeDefaults();
+    //the sizes of the shadow cascades in the shaders are created from the defines, so the std140 layout always matches the CascadeData struct
+    glgeIncludeDefaults["<glgeShadowDefines>"] = std::string("\n#ifndef GLGE_SHADOW_CASCADE_COUNT\n") + 
+                                                 "#define GLGE_SHADOW_CASCADE_COUNT " + std::to_string(GLGE_SHADOW_CASCADE_COUNT) + "\n" + 
+                                                 "#define GLGE_SHADOW_MAX_DIRECTIONAL " + std::to_string(GLGE_SHADOW_MAX_DIRECTIONAL) + "\n" + 
+                                                 "#define GLGE_SHADOW_CASCADE_TEXTURE_UNIT " + std::to_string(GLGE_SHADOW_CASCADE_TEXTURE_UNIT) + "\n" + 
+                                                 "#endif\n";
 }
 
 //first window creation methode
@@ -345,6 +358,8 @@ void glgeRunMainLoop()
             glgeUniformsPassed = glgeUniformsPassedT;
             glgeBytesPassedToGPU = glgeBytesPassedToGPUT;
             glgeBytesReadFromGPU = glgeBytesReadFromGPUT;
+            glgeShadowCastersDrawn = glgeShadowCastersDrawnT;
+            glgeShadowCastersSkipped = glgeShadowCastersSkippedT;
             //reset the data for this tick
             glgeDrawCallCountT = 0;
             glgeTriangleCountT = 0;
@@ -352,6 +367,8 @@ void glgeRunMainLoop()
             glgeUniformsPassedT = 0;
             glgeBytesPassedToGPUT = 0;
             glgeBytesReadFromGPUT = 0;
+            glgeShadowCastersDrawnT = 0;
+            glgeShadowCastersSkippedT = 0;
         }
         //clear whatever was written last tick
         glgeTypedThisTick = "";
@@ -598,6 +615,12 @@ void glgeRunMainLoop()
             glgeCurrentWindowIndex = i;
             //activate the window
             wptr->makeCurrent();
+            //continue the uploads of textures that load in the background
+            glgeUploadLoadedTextures(i);
+            //upload and evict the levels of streamed textures
+            glgeUpdateTextureStreaming(i);
+            //run the queued tasks that need the context of the window
+            glgeRunGLTasks(i);
             //call the tick function
             wptr->tick();
             //call the draw function
@@ -702,6 +725,24 @@ void glgeSetSkybox(const char* top, const char* bottom, const char* left, const
     glgeWindows[glgeMainWindowIndex]->setSkybox(top, bottom, left, right, front, back);
 }
 
+void glgeSetSkybox(const char* cubeMap)
+{
+    //check if a window is bound
+    if (!glgeHasMainWindow)
+    {
+        //if not, check if an warning should be printed
+        if (glgeWarningOutput)
+        {
+            //if it should, print a warning
+            printf("[GLGE WARNING] can't set a skybox for a main window, if no main window exists\n");
+        }
+        //stop the function
+        return;
+    }
+    //call the function from the main window
+    glgeWindows[glgeMainWindowIndex]->setSkybox(cubeMap);
+}
+
 //bind a display func callback
 void glgeBindDisplayFunc(void (*func)())
 {
@@ -2563,4 +2604,164 @@ int glgeDebugGetDrawnTriangleCount()
 {
     //retuen the triangle count
     return glgeTriangleCount;
-}
\ No newline at end of file
+}
+
+int glgeDebugGetBytesPassedToGPU()
+{
+    //return the amount of uploaded bytes
+    return glgeBytesPassedToGPU;
+}
+
+int glgeDebugGetShadowCastersDrawn()
+{
+    //return the amount of drawn shadow casters
+    return glgeShadowCastersDrawn;
+}
+
+int glgeDebugGetShadowCastersSkipped()
+{
+    //return the amount of skipped shadow casters
+    return glgeShadowCastersSkipped;
+}
+
+/**
+ * @brief store the tasks that need the OpenGL context of a window
+ */
+struct GLTaskQueue
+{
+    //protect all members
+    std::mutex mutex;
+    //store the tasks with the index of theyre window, in the order they were queued
+    std::deque<std::pair<int, std::function<void()>>> tasks;
+    //store the time the tasks can take per frame in milliseconds
+    float budget = GLGE_DEFAULT_GL_TASK_BUDGET;
+};
+
+//store the queued GL tasks
+static GLTaskQueue glgeGLTasks;
+
+void glgeQueueGLTask(std::function<void()> task, int windowIndex)
+{
+    //use the current window if no window is specified
+    if (windowIndex < 0) { windowIndex = glgeCurrentWindowIndex; }
+    //lock the queue
+    std::lock_guard<std::mutex> lock(glgeGLTasks.mutex);
+    //store the task
+    glgeGLTasks.tasks.push_back(std::pair<int, std::function<void()>>(windowIndex, task));
+}
+
+void glgeRunGLTasks(int windowIndex)
+{
+    //store the start of the tasks
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    //get the budget
+    float budget = glgeGetGLTaskBudget();
+    //run tasks until the budget is used
+    while (true)
+    {
+        //take the first task of this window
+        std::function<void()> task;
+        {
+            //lock the queue
+            std::lock_guard<std::mutex> lock(glgeGLTasks.mutex);
+            //search the task
+            for (std::deque<std::pair<int, std::function<void()>>>::iterator it = glgeGLTasks.tasks.begin(); it != glgeGLTasks.tasks.end(); ++it)
+            {
+                if (it->first != windowIndex) { continue; }
+                task = std::move(it->second);
+                glgeGLTasks.tasks.erase(it);
+                break;
+            }
+        }
+        //stop if nothing is left to run
+        if (!task) { return; }
+        //run the task without holding the lock, so it can queue new tasks
+        task();
+
+        //check if the budget is used
+        if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budget)
+        {
+            //continue next frame
+            return;
+        }
+    }
+}
+
+void glgeSetGLTaskBudget(float milliseconds)
+{
+    //lock the queue
+    std::lock_guard<std::mutex> lock(glgeGLTasks.mutex);
+    //store the budget
+    glgeGLTasks.budget = milliseconds;
+}
+
+float glgeGetGLTaskBudget()
+{
+    //lock the queue
+    std::lock_guard<std::mutex> lock(glgeGLTasks.mutex);
+    //return the budget
+    return glgeGLTasks.budget;
+}
+
+int glgeGetQueuedGLTaskCount()
+{
+    //lock the queue
+    std::lock_guard<std::mutex> lock(glgeGLTasks.mutex);
+    //return the amount of tasks
+    return (int)glgeGLTasks.tasks.size();
+}
+
+/**
+ * @brief store the threads that decode objects for GL tasks
+ */
+struct GLDecodeJob
+{
+    //store the threads
+    std::vector<std::thread> threads;
+    //protect the threads while they are started
+    std::mutex mutex;
+    //store the next index to decode
+    std::atomic<size_t> next{0};
+    //store the amount of threads that are still running
+    std::atomic<size_t> running{0};
+
+    ~GLDecodeJob()
+    {
+        //wait for threads whose join task never ran, a thread can't join itself
+        for (std::thread& t : this->threads)
+        {
+            if (!t.joinable()) { continue; }
+            if (t.get_id() == std::this_thread::get_id()) { t.detach(); }
+            else { t.join(); }
+        }
+    }
+};
+
+void glgeRunDecodeWorkers(size_t count, std::function<void(size_t, int)> func, int windowIndex)
+{
+    //check if anything should be decoded
+    if (count == 0) { return; }
+    //the workers can't read the current window
+    if (windowIndex < 0) { windowIndex = glgeCurrentWindowIndex; }
+    //start one thread per core, the threads take the next index when they are done
+    std::shared_ptr<GLDecodeJob> job = std::make_shared<GLDecodeJob>();
+    size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), count);
+    job->running = threadCount;
+    std::lock_guard<std::mutex> lock(job->mutex);
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        job->threads.emplace_back([job, count, func, windowIndex]()
+        {
+            for (size_t i = job->next++; i < count; i = job->next++) { func(i, windowIndex); }
+            //the last thread queues the join after all objects, so the threads are joined on the main thread
+            if (--job->running == 0)
+            {
+                glgeQueueGLTask([job]()
+                {
+                    std::lock_guard<std::mutex> lock(job->mutex);
+                    for (std::thread& t : job->threads) { t.join(); }
+                }, windowIndex);
+            }
+        });
+    }
+}
@@ -28,11 +28,23 @@
 #include "../GLGEIndependend/GLGEScene.hpp"
 //include a class for compacting data
 #include "../GLGEIndependend/GLGEData.h"
+//include the default librarys
+#include <functional>
+#include <typeinfo>
+#include <type_traits>
+#include <exception>
+#include <vector>
+#include <string>
 
 ///////////
 //DEFINES//
 ///////////
 
+/**
+ * @brief the default time in milliseconds that queued GL tasks can take each frame
+ */
+#define GLGE_DEFAULT_GL_TASK_BUDGET 2.f
+
 /**
  * @brief the screen space in pixels, from -halfWidth to halfWidth on x and from -halfHeight to halfHeight on y
  */
@@ -249,6 +261,13 @@ void glgeSetClearColor(vec4 color, bool normalise = false);
  */
 void glgeSetSkybox(const char* top, const char* bottom, const char* left, const char* right, const char* front, const char* back);
 
+/**
+ * @brief load a KTX2 or DDS cube map with prebuilt mip levels as a skybox
+ * 
+ * @param cubeMap the path to the cube map file
+ */
+void glgeSetSkybox(const char* cubeMap);
+
 /**
  * @brief input a function that should be called every time the window refreshes
  * 
@@ -1055,4 +1074,135 @@ int glgeDebugGetDrawCallCount();
  */
 int glgeDebugGetDrawnTriangleCount();
 
+/**
+ * @brief get the amount of bytes uploaded to the GPU last tick
+ * 
+ * @return int the amount of bytes uploaded to the GPU last tick
+ */
+int glgeDebugGetBytesPassedToGPU();
+
+/**
+ * @brief get the amount of objects drawn into shadow maps last tick
+ * 
+ * @return int the amount of drawn shadow casters last tick
+ */
+int glgeDebugGetShadowCastersDrawn();
+
+/**
+ * @brief get the amount of objects that where skipped for shadow maps last tick, because they where outside of the light frustum
+ * 
+ * @return int the amount of skipped shadow casters last tick
+ */
+int glgeDebugGetShadowCastersSkipped();
+
+/**
+ * @brief queue a task that needs the OpenGL context of a window, like creating the GPU resources of a decoded object. The tasks run in the main loop in the order they were queued
+ * 
+ * @param task the function to run
+ * @param windowIndex the index of the window whose context the task needs, -1 for the current window. Tasks queued from other threads should specify the window
+ */
+void glgeQueueGLTask(std::function<void()> task, int windowIndex = -1);
+
+/**
+ * @brief run the queued tasks of a window until the budget is used, this is called every frame by the main loop
+ * 
+ * @param windowIndex the index of the window whose tasks should run, the window must be current
+ */
+void glgeRunGLTasks(int windowIndex);
+
+/**
+ * @brief Set the time that queued GL tasks can take each frame
+ * 
+ * @param milliseconds the time in milliseconds, at least one task runs each frame
+ */
+void glgeSetGLTaskBudget(float milliseconds);
+
+/**
+ * @brief Get the time that queued GL tasks can take each frame
+ * 
+ * @return float the time in milliseconds
+ */
+float glgeGetGLTaskBudget();
+
+/**
+ * @brief Get the amount of queued GL tasks that didn't run yet
+ * 
+ * @return int the amount of tasks
+ */
+int glgeGetQueuedGLTaskCount();
+
+/**
+ * @brief run a function for a range of indices on background threads, the threads are joined by a GL task after the last index
+ * 
+ * @param count the amount of indices
+ * @param func the function to run for every index, it gets the index and the window index. It is called from multiple threads at once and must not throw
+ * @param windowIndex the index of the window the GL tasks belong to, -1 for the current window
+ */
+void glgeRunDecodeWorkers(size_t count, std::function<void(size_t, int)> func, int windowIndex = -1);
+
+/**
+ * @brief check if a type can be decoded without an OpenGL context, this needs decodeData(DataView) for the data and initGPU() for the GPU resources
+ * 
+ * @tparam T the type to check
+ */
+template<typename T, typename = void> struct glgeHasGPUInit : std::false_type {};
+template<typename T> struct glgeHasGPUInit<T, std::void_t<decltype(std::declval<T&>().decodeData(std::declval<DataView>())), decltype(std::declval<T&>().initGPU())>> : std::true_type {};
+
+/**
+ * @brief decode all objects of a type in a scene over multiple frames
+ * 
+ * Types with decodeData and initGPU, like Object, are decoded on background threads and only the creation of theyre GPU resources
+ * runs in a GL task. Other types are decoded completely in theyre own GL task.
+ * 
+ * @tparam T the type of the objects to decode, objects of other types are skipped
+ * @param scene the scene to decode the objects from, it must exist and not change until all tasks ran
+ * @param onDecoded the function that gets the name and the decoded object, it is called on the main thread
+ * @param windowIndex the index of the window the objects belong to, -1 for the current window
+ * @return int the amount of queued objects
+ */
+template<typename T> int glgeQueueSceneObjects(Scene* scene, std::function<void(std::string, T*)> onDecoded, int windowIndex = -1)
+{
+    //get the type name the objects are stored with
+    std::string type = std::string(typeid(T).name());
+    //collect all objects of the type
+    std::vector<std::pair<std::string, NamedObject*>> objs;
+    for (const std::string& name : scene->getObjectNames())
+    {
+        //skip objects of other types
+        NamedObject* obj = scene->get(name);
+        if (!obj || (obj->getTypeName() != type)) { continue; }
+        objs.push_back(std::pair<std::string, NamedObject*>(name, obj));
+    }
+    if constexpr (glgeHasGPUInit<T>::value)
+    {
+        //decode the objects on background threads, only the GPU resources are created on the main thread
+        glgeRunDecodeWorkers(objs.size(), [objs, onDecoded](size_t i, int window)
+        {
+            std::string name = objs[i].first;
+            T* decoded = NULL;
+            try { decoded = objs[i].second->template getObjectData<T>(); }
+            catch (...)
+            {
+                //raise the error on the main thread
+                std::exception_ptr error = std::current_exception();
+                glgeQueueGLTask([error]() { std::rethrow_exception(error); }, window);
+                return;
+            }
+            glgeQueueGLTask([decoded, name, onDecoded]() { decoded->initGPU(); onDecoded(name, decoded); }, window);
+        }, windowIndex);
+    }
+    else
+    {
+        //decode every object on the main thread
+        for (const std::pair<std::string, NamedObject*>& obj : objs)
+        {
+            NamedObject* named = obj.second;
+            std::string name = obj.first;
+            glgeQueueGLTask([named, name, onDecoded]() { onDecoded(name, named->getObject<T>()); }, windowIndex);
+        }
+    }
+    //return the amount of objects
+    return (int)objs.size();
+}
+
 #endif
\ No newline at end of file
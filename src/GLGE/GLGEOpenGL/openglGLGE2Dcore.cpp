@@ -949,7 +949,7 @@ Data* Object2D::encode()
     return dat;
 }
 
-void Object2D::decode(Data dat)
+void Object2D::decode(DataView dat)
 {
     //call early decode hook
     this->decodeHookEarly(&dat);
@@ -1029,12 +1029,12 @@ void Object2D::encodeHookEarly(Data*)
     //override code here
 }
 
-void Object2D::decodeHook(Data*)
+void Object2D::decodeHook(DataView*)
 {
     //override code here
 }
 
-void Object2D::decodeHookEarly(Data*)
+void Object2D::decodeHookEarly(DataView*)
 {
     //override code here
 }
@@ -1555,7 +1555,7 @@ void Button::encodeHook(Data* data)
     data->writeBool(this->isCircle);
 }
 
-void Button::decodeHook(Data* data)
+void Button::decodeHook(DataView* data)
 {
     //read the size
     this->size = data->readVec2();
@@ -1679,7 +1679,7 @@ void Text::encodeHook(Data* data)
     data->writeBool(this->dynamicMesh);
 }
 
-void Text::decodeHook(Data* data)
+void Text::decodeHook(DataView* data)
 {
     //decode the stored text
     this->text = data->readString();
@@ -2013,7 +2013,7 @@ void TextInput::encodeHook(Data* data)
     data->writeInt(this->cursourPos);
 }
 
-void TextInput::decodeHook(Data* data)
+void TextInput::decodeHook(DataView* data)
 {
     //decode the stored text
     this->text = data->readString();
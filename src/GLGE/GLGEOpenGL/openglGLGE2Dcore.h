@@ -453,7 +453,7 @@ public:
      * 
      * @param data the data to set the object to
      */
-    void decode(Data data);
+    void decode(DataView data);
 
     /**
      * @brief a hook into the encoding process to use if you don't want to override the original function | TIMESTAMP: before return
@@ -474,14 +474,14 @@ public:
      * 
      * @param data a pointer to the left data AFTER the decoding process
      */
-    virtual void decodeHook(Data* data);
+    virtual void decodeHook(DataView* data);
 
     /**
      * @brief a hook into the decoding process to use if you don't want to override the original function | TIMESTAMP: before start
      * 
      * @param data a pointer to the entire data BEFORE the decoding process
      */
-    virtual void decodeHookEarly(Data* data);
+    virtual void decodeHookEarly(DataView* data);
 
 protected:
     /**
@@ -878,7 +878,7 @@ public:
      * 
      * @param data the data to decode
      */
-    void decodeHook(Data* data) override;
+    void decodeHook(DataView* data) override;
 
 protected:
     /**
@@ -1030,7 +1030,7 @@ public:
      * 
      * @param data the data to use
      */
-    void decodeHook(Data* data) override;
+    void decodeHook(DataView* data) override;
 
 protected:
     //the text the object is displaying
@@ -1143,7 +1143,7 @@ public:
      * 
      * @param data the data to use
      */
-    void decodeHook(Data* data) override;
+    void decodeHook(DataView* data) override;
     
 protected:
     //store the current courser position
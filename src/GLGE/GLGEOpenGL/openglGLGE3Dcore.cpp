@@ -37,6 +37,7 @@
 #include <math.h>
 #include <sstream>
 #include <map>
+#include <algorithm>
 
 ///////////////////////
 // PRIVATE FUNCTIONS //
@@ -451,6 +452,12 @@ Object::~Object()
 
 void Object::destroy()
 {
+    //check if the object was visible in a window
+    if (this->matricesCalculated && (this->windowIndex >= 0))
+    {
+        //the shadows where the object was must be redrawn
+        glgeWindows[this->windowIndex]->markShadowRegionDirty(this->getBoundingSphere());
+    }
     //delete the mesh
     delete this->mesh;
     //reset the window id
@@ -531,6 +538,23 @@ void Object::draw()
     //bind the shader
     this->shader.applyShader();
 
+    //check if textures are streamed and the mesh has texture coordinates
+    if (glgeIsTextureStreamingActive() && (this->mesh->uvDensity > 0) && glgeWindows[this->windowIndex]->getCamera())
+    {
+        //get the camera and the bounds
+        Camera* cam = glgeWindows[this->windowIndex]->getCamera();
+        vec4 bounds = this->getBoundingSphere();
+        //get the distance from the camera to the closest point of the bounds
+        vec3 d = vec3(bounds.x, bounds.y, bounds.z) - cam->getPos();
+        float dist = std::max(std::sqrt(d.x*d.x + d.y*d.y + d.z*d.z) - bounds.w, 0.001f);
+        //get the size of a pixel in world space at that distance
+        float worldPerPixel = 2.f * dist * std::tan(cam->getFOV() * 0.5f) / std::max(glgeWindows[this->windowIndex]->getSize().y, 1.f);
+        //the scale makes the texture coordinates less dense in world space
+        float scale = std::max(std::abs(this->transf.scale.x), std::max(std::abs(this->transf.scale.y), std::abs(this->transf.scale.z)));
+        //request the detail for all textures of the material
+        this->mat->requestDetail(worldPerPixel * this->mesh->uvDensity / std::max(scale, 0.0001f));
+    }
+
     //Bind the material
     this->mat->apply();
 
@@ -576,6 +600,8 @@ void Object::update()
     }
     //recalculate the move matrix
     this->recalculateMatrices();
+    //store where the shader finds the texture handles of the material
+    this->objData.materialIndex = (this->mat != NULL) ? this->mat->getBindlessIndex() : -1;
 
     //update the own UBO
     glBindBuffer(GL_UNIFORM_BUFFER, this->ubo);
@@ -881,34 +907,29 @@ bool Object::getFullyTransparent()
     return this->fullyTransparent;
 }
 
+vec4 Object::getBoundingSphere()
+{
+    //an object without a mesh has no size
+    if (this->mesh == NULL) { return vec4(this->transf.pos.x, this->transf.pos.y, this->transf.pos.z, 0); }
+    //calculate the bounds if they where never calculated
+    if ((this->mesh->boundsRadius == 0) && (this->mesh->vertices.size() > 0)) { this->mesh->calculateBounds(); }
+    //transform the center of the mesh into world space
+    vec4 center = this->objData.modelMat * vec4(this->mesh->boundsCenter.x, this->mesh->boundsCenter.y, this->mesh->boundsCenter.z, 1);
+    //the radius is scaled by the biggest scale
+    float scale = std::max(std::abs(this->transf.scale.x), std::max(std::abs(this->transf.scale.y), std::abs(this->transf.scale.z)));
+    //return the bounding sphere
+    return vec4(center.x, center.y, center.z, this->mesh->boundsRadius * scale);
+}
+
 Data* Object::encode()
 {
     //create a new data object
     Data* dat = new Data();
+    //reserve the space for the mesh, the layout and the arrays
+    dat->reserve(64 + this->mesh->vertices.size()*sizeof(Vertex) + this->mesh->indices.size()*sizeof(unsigned int) + 256);
 
-    //store the amount of vertives
-    dat->writeLong(this->mesh->vertices.size());
-    //loop over every vertex
-    for (Vertex vert : this->mesh->vertices)
-    {
-        //store the vertex position
-        dat->writeVec3(vert.pos);
-        //store the vertex color
-        dat->writeVec4(vert.color);
-        //store the texture coordinate
-        dat->writeVec2(vert.texCoord);
-        //store the normal
-        dat->writeVec3(vert.normal);
-    }
-
-    //store the amount of indices
-    dat->writeLong(this->mesh->indices.size());
-    //loop over every vertex
-    for (unsigned int ind : this->mesh->indices)
-    {
-        //store the index
-        dat->writeUInt(ind);
-    }
+    //store the vertices and indices of the mesh
+    glgeEncodeMesh(dat, this->mesh->vertices, this->mesh->indices);
 
     //store the transform
     //store the position
@@ -932,43 +953,24 @@ Data* Object::encode()
     return dat;
 }
 
-void Object::decode(Data dat)
+void Object::decode(DataView dat)
+{
+    //read the data of the object
+    this->decodeData(dat);
+    //create the GPU resources
+    this->initGPU();
+}
+
+void Object::decodeData(DataView dat)
 {
     //create a new empty mesh
     Mesh m;
 
-    //store the amount of vertives
-    long vert = dat.readLong();
-    //loop over every vertex
-    for (long i = 0; i < vert; i++)
-    {
-        //create a new vertex
-        Vertex vert;
-        //store the vertex position
-        vert.pos = dat.readVec3();
-        //store the vertex color
-        vert.color = dat.readVec4();
-        //store the texture coordinate
-        vert.texCoord = dat.readVec2();
-        //store the normal
-        vert.normal = dat.readVec3();
-        //store the vertex
-        m.vertices.push_back(vert);
-    }
+    //read the vertices and indices of the mesh
+    if (!glgeDecodeMesh(dat, m.vertices, m.indices)) { return; }
 
-    //store the amount of indices
-    long ind = dat.readLong();
-    //loop over every vertex
-    for (long i = 0; i < ind; i++)
-    {
-        //store the index
-        m.indices.push_back(dat.readUInt());
-    }
-
-    //say that the window index is the one from the current window
-    this->windowIndex = glgeCurrentWindowIndex;
-    //construct and save a mesh from the pointers
-    this->mesh = new Mesh(m.vertices, m.indices);
+    //construct and save a mesh from the vectors, the GPU buffers are created by initGPU
+    this->mesh = new Mesh(std::move(m.vertices), std::move(m.indices));
 
     //store the transform
     //store the position
@@ -978,10 +980,26 @@ void Object::decode(Data dat)
     //store the scale
     this->transf.scale = dat.readVec3();
 
-    //save if the object is static
-    this->isStatic = isStatic;
-    //save if the object is transparent
-    this->isTransparent = isTransparent;
+    //store if the object is transparent
+    this->isTransparent = dat.readBool();
+    //store if the object is fully transparent
+    this->fullyTransparent = dat.readBool();
+    //store if the object is static
+    this->isStatic = dat.readBool();
+
+    //load the material
+    //create a new material
+    this->mat = new Material();
+    //read the material data, the material is bound to the window by initGPU
+    this->mat->decodeData(dat);
+}
+
+void Object::initGPU()
+{
+    //an object without a mesh was not decoded
+    if (this->mesh == NULL) { return; }
+    //say that the window index is the one from the current window
+    this->windowIndex = glgeCurrentWindowIndex;
 
     //store the UUID
     this->objData.uuid = glgeObjectUUID;
@@ -1005,22 +1023,12 @@ void Object::decode(Data dat)
     //get the uniforms
     this->getUniforms();
 
+    //apply the material to the window
+    this->mat->bindToWindow(this->windowIndex);
+
     //THIS MAY CAUSE AN MEMORY ACCES ERROR, IF NO CAMERA IS BOUND!
     //update the object
     this->update();
-
-    //store if the object is transparent
-    this->isTransparent = dat.readBool();
-    //store if the object is fully transparent
-    this->fullyTransparent = dat.readBool();
-    //store if the object is static
-    this->isStatic = dat.readBool();
-
-    //load the material
-    //create a new material
-    this->mat = new Material();
-    //decode the material data
-    this->mat->decode(dat);
 }
 
 //PRIV
@@ -1042,10 +1050,29 @@ void Object::shaderSetup(const char* vs, const char* fs)
 
 void Object::recalculateMatrices()
 {
+    //store the old bounding sphere
+    vec4 oldBounds = this->getBoundingSphere();
+    //store the old model matrix
+    mat4 oldModelMat = this->objData.modelMat;
     //save the model matrix
     this->objData.modelMat = this->transf.getMatrix();
     //recalculate the rotation matrix
     this->objData.rotMat = this->transf.getRotationMatrix();
+
+    //check if the object moved or appeared for the first time
+    if ((!this->matricesCalculated || !(oldModelMat == this->objData.modelMat)) && (this->windowIndex >= 0))
+    {
+        //check if the object was allready visible
+        if (this->matricesCalculated)
+        {
+            //the shadows at the old position must be redrawn
+            glgeWindows[this->windowIndex]->markShadowRegionDirty(oldBounds);
+        }
+        //the shadows at the new position must be redrawn
+        glgeWindows[this->windowIndex]->markShadowRegionDirty(this->getBoundingSphere());
+    }
+    //say that the matrices are calculated
+    this->matricesCalculated = true;
 }
 
 void Object::getUniforms()
@@ -1075,6 +1102,8 @@ void Object::getUniforms()
         this->shader.setCustomInt("glgePass", false);
         //add the depth and alpha buffer
         this->shader.setCustomTexture("glgeDepthAlbedoBuffer", glgeWindows[this->windowIndex]->getEIDATex());
+        //add the shadow atlas
+        this->shader.setCustomTexture("glgeShadowAtlas", glgeWindows[this->windowIndex]->getShadowAtlas());
     }
 
     //get all uniform positions
@@ -1164,10 +1193,25 @@ void Object::loadLights()
 
 void Object::shadowDraw()
 {
+    //get the bounding sphere of the object
+    vec4 bounds = this->getBoundingSphere();
+    //check if the object is inside the frustum of the current shadow map (spot light or cascade)
+    bool visible = glgeSphereInFrustum(glgeCurrentShadowMat, vec3(bounds.x, bounds.y, bounds.z), bounds.w);
+    //check if debug data gathering is enabled
+    if (glgeGatherDebugInfo)
+    {
+        //count the object for the light
+        if (glgeCurrentShadowCaster != NULL) { glgeCurrentShadowCaster->countShadowCaster(visible); }
+        //count the object for the whole tick
+        if (visible) { glgeShadowCastersDrawnT++; }
+        else { glgeShadowCastersSkippedT++; }
+    }
+    //skip the object if it can't cast a shadow into the shadow map
+    if (!visible) { return; }
     //get the shadow shader from the window
     Shader* sShader = glgeWindows[glgeCurrentWindowIndex]->getShadowShader();
     //pass the light matrix
-    sShader->setCustomMat4("glgeLightSpaceMat", glgeCurrentShadowCaster->getLightMat());
+    sShader->setCustomMat4("glgeLightSpaceMat", glgeCurrentShadowMat);
     //activate the shadow shader
     sShader->applyShader();
 
@@ -1450,6 +1494,12 @@ float Camera::getFarPlane()
     return this->camData.far;
 }
 
+float Camera::getNearPlane()
+{
+    //return the near cliping plane
+    return this->camData.near;
+}
+
 float* Camera::getRotMatPointer()
 {
     //return a pointer to the rotation matrix
@@ -2491,6 +2541,73 @@ void Mesh::update()
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(this->indices[0]), this->indices.data(), GL_STATIC_DRAW);
     //unbind the IBO
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    //the vertices may have moved, so recalculate the bounding sphere
+    this->calculateBounds();
+}
+
+void Mesh::calculateBounds()
+{
+    //check if the mesh has vertices
+    if (this->vertices.size() == 0)
+    {
+        //reset the bounds
+        this->boundsCenter = vec3(0);
+        this->boundsRadius = 0;
+        this->uvDensity = 0;
+        //stop the function
+        return;
+    }
+    //store the minimal and maximal position
+    vec3 min = this->vertices[0].pos;
+    vec3 max = this->vertices[0].pos;
+    //loop over all vertices
+    for (size_t i = 1; i < this->vertices.size(); i++)
+    {
+        //get the position of the vertex
+        vec3 p = this->vertices[i].pos;
+        //expand the box
+        min = vec3(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+        max = vec3(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+    }
+    //the center of the box is the center of the sphere
+    this->boundsCenter = vec3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+    //store the biggest squared distance from the center
+    float maxDist = 0;
+    //loop over all vertices
+    for (size_t i = 0; i < this->vertices.size(); i++)
+    {
+        //calculate the difference to the center
+        vec3 d = this->vertices[i].pos - this->boundsCenter;
+        //store the biggest distance
+        maxDist = std::max(maxDist, d.x*d.x + d.y*d.y + d.z*d.z);
+    }
+    //store the radius
+    this->boundsRadius = std::sqrt(maxDist);
+
+    //sum up the area of all triangles in object space and in texture space
+    double posArea = 0;
+    double uvArea = 0;
+    for (size_t i = 0; i + 2 < this->indices.size(); i += 3)
+    {
+        //skip triangles with invalid indices
+        if ((this->indices[i] >= this->vertices.size()) || (this->indices[i+1] >= this->vertices.size()) || (this->indices[i+2] >= this->vertices.size())) { continue; }
+        //get the vertices of the triangle
+        Vertex& a = this->vertices[this->indices[i]];
+        Vertex& b = this->vertices[this->indices[i+1]];
+        Vertex& c = this->vertices[this->indices[i+2]];
+        //the length of the cross product of two edges is twice the area
+        vec3 e1 = b.pos - a.pos;
+        vec3 e2 = c.pos - a.pos;
+        vec3 n = vec3(e1.y*e2.z - e1.z*e2.y, e1.z*e2.x - e1.x*e2.z, e1.x*e2.y - e1.y*e2.x);
+        posArea += 0.5 * std::sqrt((double)(n.x*n.x + n.y*n.y + n.z*n.z));
+        //do the same in texture space
+        vec2 t1 = b.texCoord - a.texCoord;
+        vec2 t2 = c.texCoord - a.texCoord;
+        uvArea += 0.5 * std::abs((double)(t1.x*t2.y - t1.y*t2.x));
+    }
+    //the density is the ratio of the side lengths, so the square root of the ratio of the areas
+    this->uvDensity = (posArea > 0) ? (float)std::sqrt(uvArea / posArea) : 0;
 }
 
 void Mesh::init()
@@ -2498,6 +2615,9 @@ void Mesh::init()
     //check if this mesh is allready initalised
     if (!((this->VBO == 0) || (this->IBO == 0))) { return; }
 
+    //calculate the bounding sphere
+    this->calculateBounds();
+
     //create the new VBO buffer
     glCreateBuffers(1, &this->VBO);
     //bind the VBO
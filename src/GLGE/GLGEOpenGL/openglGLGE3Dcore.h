@@ -35,6 +35,8 @@ struct ObjectData
     mat4 rotMat;
     //the objects uuid
     unsigned int uuid;
+    //the index of the material in the bindless handle table, -1 if bindless textures are not used
+    int materialIndex = -1;
 };
 
 /**
@@ -166,10 +168,21 @@ public:
      */
     void unbind();
 
+    /**
+     * @brief recalculate the bounding sphere and the texture coordinate density of the mesh from the vertices
+     */
+    void calculateBounds();
+
     //store the vertices for the object
     std::vector<Vertex> vertices;
     //store the indices for the object
     std::vector<unsigned int> indices;
+    //store the center of the bounding sphere in object space
+    vec3 boundsCenter = vec3(0);
+    //store the radius of the bounding sphere in object space
+    float boundsRadius = 0;
+    //store how many texture coordinate units cover one unit in object space, used to request the detail of streamed textures
+    float uvDensity = 0;
 
 public:
     /**
@@ -585,6 +598,13 @@ public:
      */
     bool getFullyTransparent();
 
+    /**
+     * @brief Get the bounding sphere of the object in world space
+     * 
+     * @return vec4 the bounding sphere (x, y, z for the center, w for the radius)
+     */
+    vec4 getBoundingSphere();
+
     /**
      * @brief encode the data to a single data object
      * 
@@ -596,13 +616,23 @@ public:
      * 
      * @param data the encoded data
      */
-    void decode(Data data);
+    void decode(DataView data);
+    /**
+     * @brief decode the object without creating GPU resources, this can run on any thread. initGPU must be called before the object is used
+     * 
+     * @param data the encoded data
+     */
+    void decodeData(DataView data);
+    /**
+     * @brief create the GPU resources of an object that was decoded with decodeData, this needs the OpenGL context of the current window
+     */
+    void initGPU();
 
 private:
     //store the transform for the object
     Transform transf;
     //store a mesh
-    Mesh* mesh;
+    Mesh* mesh = NULL;
     //store if the object is transparent or opaque
     bool isTransparent = false;
     //save the shader
@@ -638,6 +668,8 @@ private:
     bool fullyTransparent = false;
     //store the index of the window the object is used in
     int windowIndex = -1;
+    //store if the matrices where calculated at least once
+    bool matricesCalculated = false;
 
     //recalculate the move matrix
     void recalculateMatrices();
@@ -831,6 +863,13 @@ public:
      */
     float getFarPlane();
 
+    /**
+     * @brief Get the Near Plane of the camera
+     * 
+     * @return float the near cliping plane
+     */
+    float getNearPlane();
+
     /**
      * @brief Get a pointer to the rotation matrix of the camera
      * 
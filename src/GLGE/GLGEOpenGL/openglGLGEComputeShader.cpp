@@ -65,7 +65,7 @@ void ComputeShader::encode(Data* data)
     this->encodeUniforms(data);
 }
 
-void ComputeShader::decode(Data* data)
+void ComputeShader::decode(DataView* data)
 {
     //deocde the source
     std::string src = data->readString();
@@ -76,7 +76,7 @@ public:
      * 
      * @param data the data to decode from
      */
-    void decode(Data* data);
+    void decode(DataView* data);
 
     /**
      * @brief get the source code of the shader
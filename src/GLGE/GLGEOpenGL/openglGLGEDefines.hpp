@@ -29,7 +29,7 @@
 //the default 3D vertex shader, it is bound by default to any 3D object
 #define GLGE_DEFAULT_3D_VERTEX std::string("#version 450 core\nlayout (location = 0) in vec3 pos;layout (location = 1) in vec4 vColor;layout (location = 2) in vec2 vTexcoord;layout (location = 3) in vec3 vNormal;\n#include <glgeObject>\n#include <glgeCamera>\nout vec4 color;out vec2 texCoord;out vec3 normal;out vec3 fragPos;out vec3 vPos;void main(){color = vColor;texCoord = vTexcoord;fragPos = (vec4(pos, 1) * glgeModelMat).xyz;normal = normalize(vec4(vNormal, 1) * glgeRotMat).xyz;gl_Position = vec4(fragPos,1)*glgeCamMat;vPos = pos;}")
 //the default 3D fragment shader, it is bound by default to any 3D object
-#define GLGE_DEFAULT_3D_FRAGMENT std::string("#version 450 core\nprecision highp float;layout(location = 0) out vec4 Albedo;layout(location = 1) out vec4 Normal;layout(location = 2) out vec4 Position;layout(location = 3) out vec4 Roughness;layout(location = 5) out vec4 DepthAndAlpha;\n#include <glgeObject>\n#include <glgeCamera>\nin vec4 color;in vec2 texCoord;in vec3 normal;in vec3 tangent;in vec3 bitangent;in vec3 fragPos;in vec3 vPos;\n#include <glgeMaterial>\nstruct FragmentData{vec4 color;vec3 pos;vec3 normal;vec2 uv;};FragmentData parallaxMapping(mat3 TBN){FragmentData f = FragmentData(color, fragPos, normal, texCoord);if (!bool(glgeDisplacementMapActive)) { return f; }vec3 viewDir = normalize((glgeCameraPos*TBN) - (fragPos*TBN));float numLayers = mix(maxLayers, minLayers, max(dot(vec3(0.0, 0.0, 1.0), viewDir), 0.0));float layerDepth = 1.f / numLayers;float currentLayerDepth = 0.0;vec2 P = viewDir.xy * dispStrength; vec2 deltaTexCoords = P * layerDepth;vec2 currentTexCoords = f.uv;float currentDepthMapValue = texture(glgeDisplacementMap, currentTexCoords).r;while(currentLayerDepth < currentDepthMapValue){currentTexCoords -= deltaTexCoords;currentDepthMapValue = texture(glgeDisplacementMap, currentTexCoords).r;  currentLayerDepth += layerDepth;}float depthStep = -layerDepth / 2.f;for (int i = 0; i < binarySteps; i++){currentTexCoords -= P * depthStep;currentLayerDepth += depthStep;currentDepthMapValue = texture(glgeDisplacementMap, currentTexCoords).r;depthStep /= 2.f * sign(currentLayerDepth - currentDepthMapValue);}f.pos += currentLayerDepth*f.normal;f.uv = currentTexCoords;if (f.uv.x > 1.0 || f.uv.y > 1.0 || f.uv.x < 0.0 || f.uv.y < 0.0) { discard; }return f;}void main(){vec3 Q1 = dFdx(fragPos);vec3 Q2 = dFdy(fragPos);vec2 st1 = dFdx(texCoord);vec2 st2 = dFdy(texCoord);vec3 tangent = normalize(Q1*st2.t - Q2*st1.t);vec3 bitangent = normalize(-Q1*st2.s + Q2*st1.s);mat3 TBN = mat3(tangent,bitangent,normal);FragmentData frag = parallaxMapping(TBN);vec4 col = glgeColor + frag.color;col.rgb *= (1-int(glgeAmbientMapActive));col.rgb += texture(glgeAmbientMap, frag.uv).rgb * int(glgeAmbientMapActive);if(col.w < 0.5){discard;}Q1 = dFdx(frag.pos);Q2 = dFdy(frag.pos);st1 = dFdx(frag.uv);st2 = dFdy(frag.uv);tangent = normalize(Q1*st2.t - Q2*st1.t);bitangent = normalize(-Q1*st2.s + Q2*st1.s);vec3 n = mix(vec3(0,0,1),normalize(texture(glgeNormalMap,frag.uv).rgb * 2.f - 1.f),float(glgeNormalMapActive));n = normalize(TBN * n);float rough = texture(glgeRoughnessMap, frag.uv).r * float(int(glgeRoughnessMapActive));rough += glgeRoughness * (1.f - float(int(glgeRoughnessMapActive)));Albedo = vec4(col.rgb, vPos.x);Normal = vec4(n, vPos.y);Position = vec4(frag.pos, vPos.z);Roughness = vec4(rough,glgeMetalic,int(glgeLit),1);DepthAndAlpha = vec4(gl_FragCoord.z,glgeObjectUUID,0,1);}")
+#define GLGE_DEFAULT_3D_FRAGMENT std::string("#version 450 core\nprecision highp float;layout(location = 0) out vec4 Albedo;layout(location = 1) out vec4 Normal;layout(location = 2) out vec4 Position;layout(location = 3) out vec4 Roughness;layout(location = 5) out vec4 DepthAndAlpha;\n#include <glgeObject>\n#include <glgeCamera>\nin vec4 color;in vec2 texCoord;in vec3 normal;in vec3 tangent;in vec3 bitangent;in vec3 fragPos;in vec3 vPos;\n#include <glgeMaterial>\nstruct FragmentData{vec4 color;vec3 pos;vec3 normal;vec2 uv;};FragmentData parallaxMapping(mat3 TBN){FragmentData f = FragmentData(color, fragPos, normal, texCoord);if (!bool(glgeDisplacementMapActive)) { return f; }vec3 viewDir = normalize((glgeCameraPos*TBN) - (fragPos*TBN));float numLayers = mix(maxLayers, minLayers, max(dot(vec3(0.0, 0.0, 1.0), viewDir), 0.0));float layerDepth = 1.f / numLayers;float currentLayerDepth = 0.0;vec2 P = viewDir.xy * dispStrength; vec2 deltaTexCoords = P * layerDepth;vec2 currentTexCoords = f.uv;float currentDepthMapValue = texture(glgeDisplacementMap, currentTexCoords).r;while(currentLayerDepth < currentDepthMapValue){currentTexCoords -= deltaTexCoords;currentDepthMapValue = texture(glgeDisplacementMap, currentTexCoords).r;  currentLayerDepth += layerDepth;}float depthStep = -layerDepth / 2.f;for (int i = 0; i < binarySteps; i++){currentTexCoords -= P * depthStep;currentLayerDepth += depthStep;currentDepthMapValue = texture(glgeDisplacementMap, currentTexCoords).r;depthStep /= 2.f * sign(currentLayerDepth - currentDepthMapValue);}f.pos += currentLayerDepth*f.normal;f.uv = currentTexCoords;if (f.uv.x > 1.0 || f.uv.y > 1.0 || f.uv.x < 0.0 || f.uv.y < 0.0) { discard; }return f;}void main(){vec3 Q1 = dFdx(fragPos);vec3 Q2 = dFdy(fragPos);vec2 st1 = dFdx(texCoord);vec2 st2 = dFdy(texCoord);vec3 tangent = normalize(Q1*st2.t - Q2*st1.t);vec3 bitangent = normalize(-Q1*st2.s + Q2*st1.s);mat3 TBN = mat3(tangent,bitangent,normal);FragmentData frag = parallaxMapping(TBN);vec4 col = glgeColor + frag.color;col.rgb *= (1-int(glgeAmbientMapActive));col.rgb += texture(glgeAmbientMap, frag.uv).rgb * int(glgeAmbientMapActive);if(col.w < 0.5){discard;}Q1 = dFdx(frag.pos);Q2 = dFdy(frag.pos);st1 = dFdx(frag.uv);st2 = dFdy(frag.uv);tangent = normalize(Q1*st2.t - Q2*st1.t);bitangent = normalize(-Q1*st2.s + Q2*st1.s);vec2 nXY = texture(glgeNormalMap,frag.uv).rg * 2.f - 1.f;vec3 n = mix(vec3(0,0,1),normalize(vec3(nXY, sqrt(max(1.f - dot(nXY,nXY), 0.f)))),float(glgeNormalMapActive));n = normalize(TBN * n);float rough = texture(glgeRoughnessMap, frag.uv).r * float(int(glgeRoughnessMapActive));rough += glgeRoughness * (1.f - float(int(glgeRoughnessMapActive)));Albedo = vec4(col.rgb, vPos.x);Normal = vec4(n, vPos.y);Position = vec4(frag.pos, vPos.z);Roughness = vec4(rough,glgeMetalic,int(glgeLit),1);DepthAndAlpha = vec4(gl_FragCoord.z,glgeObjectUUID,0,1);}")
 
 //the default 2D vertex shader, it is boud automaticaly to every 2D shape
 #define GLGE_DEFAULT_2D_VERTEX std::string("#version 450 core\nlayout (location = 0) in vec2 pos;layout (location = 1) in vec4 color;layout (location = 2) in vec2 texcoord;uniform mat3 glgeCamMat;out vec4 fColor;out vec2 fTexCoord;void main(){fColor = color;fTexCoord = texcoord;vec4 memPos = vec4(vec3(pos,1)*glgeCamMat, 1.0);memPos.zw = vec2(1.f);gl_Position = memPos;}")
@@ -34,6 +34,9 @@
 
 //include the defalt library
 #include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 
 
 Light::Light()
@@ -117,6 +120,8 @@ void Light::move(vec3 v)
 {
     //change the position of the light source
     this->lightDat.pos += v;
+    //say that the light needs to be updated
+    this->needsUpdate = true;
 }
 
 //move the light source
@@ -321,15 +326,31 @@ Data* Light::encode()
 {
     //create a new data
     Data* data = new Data();
-    //add the own data
-    data->writeBytes((uint8_t*)&this->lightDat, sizeof(this->lightDat));
+    //add the own data up to the shadow atlas region, the atlas region is recalculated every frame
+    data->writeBytes((uint8_t*)&this->lightDat, offsetof(LightData, shadowRect));
+    //add the light type
+    data->writeBytes((uint8_t*)&this->lightDat.type, sizeof(this->lightDat.type));
     //return the data
     return data;
 }
-void Light::decode(Data data)
-{
-    //read the own data
-    this->lightDat = *(LightData*)data.readBytes(sizeof(this->lightDat));
+void Light::decode(DataView data)
+{
+    //read the own data up to the shadow atlas region
+    uint8_t* dat = data.readBytes(offsetof(LightData, shadowRect));
+    //check if the data could be read
+    if (dat == NULL) { return; }
+    //store the data
+    memcpy((uint8_t*)&this->lightDat, dat, offsetof(LightData, shadowRect));
+    //free the read data
+    delete[] dat;
+    //read the light type
+    dat = data.readBytes(sizeof(this->lightDat.type));
+    //check if the type could be read
+    if (dat == NULL) { return; }
+    //store the light type
+    memcpy(&this->lightDat.type, dat, sizeof(this->lightDat.type));
+    //free the read data
+    delete[] dat;
     //setup the shadow map
     this->setupShadowMap();
     //say that the light needs to be updated
@@ -348,11 +369,15 @@ void Light::makeCurrentShadowCaster()
     glgeCurrentShadowCaster = this;
     //update the light space matrix
     this->updateLightMat();
-    //resize the viewport
-    glViewport(0,0,1024,1024);
-    //bind the shadow fbo
-    glBindFramebuffer(GL_FRAMEBUFFER, this->shadowFBO);
-    //clear the buffer
+    //draw with the light space matrix of this light
+    glgeCurrentShadowMat = this->lightDat.lightSpaceMat;
+    //this is not a shadow cascade
+    glgeCurrentShadowCascade = -1;
+    //resize the viewport to the region in the shadow atlas
+    glViewport(this->shadowRegion.x, this->shadowRegion.y, this->shadowRegion.z, this->shadowRegion.w);
+    //only clear the own region of the shadow atlas
+    glScissor(this->shadowRegion.x, this->shadowRegion.y, this->shadowRegion.z, this->shadowRegion.w);
+    //clear the region
     glClear(GL_DEPTH_BUFFER_BIT);
 }
 
@@ -368,8 +393,8 @@ void Light::bind()
     glActiveTexture(GL_TEXTURE0 + glgeTextureUnit);
     //store the texture unit
     this->texUnit = glgeTextureUnit;
-    //bind the texture
-    glBindTexture(GL_TEXTURE_2D, this->shadowDepth);
+    //bind the shadow atlas
+    glBindTexture(GL_TEXTURE_2D, this->shadowAtlas);
     //increase the amount of texture units
     glgeTextureUnit++;
 }
@@ -412,42 +437,121 @@ void Light::queueUpdate()
 
 void Light::setupShadowMap()
 {
-    //create the texture for depth
-    glGenTextures(1, &this->shadowDepth);
-    //bind the texture
-    glBindTexture(GL_TEXTURE_2D, this->shadowDepth);
-    //set the size of the texture
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, 1024, 1024, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
-    //set simple text parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-
-    //create a new framebuffer
-    glGenFramebuffers(1, &this->shadowFBO);
-    //bind the framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, this->shadowFBO);
-    //add a depth attachment
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, this->shadowDepth, 0);
-
-    //check the framebuffer status
-    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-    //check if the framebuffer is compleate
-    if (status != GL_FRAMEBUFFER_COMPLETE)
-    {
-        //throw an error
-        GLGE_THROW_ERROR("Failed to create framebuffer for shadow mapping")
-    }
+    //the shadow map is stored in the shadow atlas of the window, so just reset the region
+    this->shadowRegion = ivec4(0,0,0,0);
+    //the cascades are assigned by the window
+    this->lightDat.cascadeLayer = -1;
+    //say that the light has no shadow map yet
+    this->lightDat.shadowed = 0;
+    //say that the shadow map must be drawn
+    this->shadowCached = false;
+    //say that the light needs to be updated
+    this->needsUpdate = true;
+}
 
-    //unbind the texture
-    glBindTexture(GL_TEXTURE_2D, 0);
-    //unbind the framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+bool Light::setShadowRegion(ivec4 region, unsigned int atlas, int atlasSize)
+{
+    //store the shadow atlas
+    this->shadowAtlas = atlas;
+    //check if the region is the same as before
+    if (this->shadowRegion == region) { return false; }
+    //store the new region
+    this->shadowRegion = region;
+    //store the region in texture coordinates for the GPU
+    this->lightDat.shadowRect = vec4(region.x / (float)atlasSize, region.y / (float)atlasSize, region.z / (float)atlasSize, region.w / (float)atlasSize);
+    //store if the light has a shadow map
+    this->lightDat.shadowed = (region.z > 0);
+    //the old shadow map is not in the region anymore
+    this->shadowCached = false;
+    //say that the light needs to be updated
+    this->needsUpdate = true;
+    //say that the region changed
+    return true;
+}
+
+ivec4 Light::getShadowRegion()
+{
+    //return the region in the shadow atlas
+    return this->shadowRegion;
+}
+
+bool Light::isShadowCacheValid()
+{
+    //update the light space matrix
+    this->updateLightMat();
+    //the cache is valid if it was drawn with the same light space matrix
+    return this->shadowCached && (this->cachedShadowMat == this->lightDat.lightSpaceMat);
+}
+
+void Light::storeShadowCache()
+{
+    //store the matrix the shadow map was drawn with
+    this->cachedShadowMat = this->lightDat.lightSpaceMat;
+    //say that the shadow map is valid
+    this->shadowCached = true;
+}
+
+void Light::invalidateShadowCache()
+{
+    //say that the shadow map must be redrawn
+    this->shadowCached = false;
+}
+
+void Light::setCascadeLayer(int layer)
+{
+    //check if the layer changed
+    if (this->lightDat.cascadeLayer == layer) { return; }
+    //store the new layer
+    this->lightDat.cascadeLayer = layer;
     //say that the light needs to be updated
     this->needsUpdate = true;
 }
 
+int Light::getCascadeLayer()
+{
+    //return the first cascade layer
+    return this->lightDat.cascadeLayer;
+}
+
+void Light::countShadowCaster(bool drawn)
+{
+    //count the object as drawn or skipped
+    if (drawn) { this->shadowCastersDrawn++; }
+    else { this->shadowCastersSkipped++; }
+}
+
+void Light::resetShadowCasterStats()
+{
+    //reset both counters
+    this->shadowCastersDrawn = 0;
+    this->shadowCastersSkipped = 0;
+}
+
+int Light::getShadowCastersDrawn()
+{
+    //return the amount of drawn shadow casters
+    return this->shadowCastersDrawn;
+}
+
+int Light::getShadowCastersSkipped()
+{
+    //return the amount of skipped shadow casters
+    return this->shadowCastersSkipped;
+}
+
+float Light::getShadowImportance(vec3 cameraPos)
+{
+    //calculate the distance at which the quadratic attenuation drops the light below 1/256 of its intensity
+    float range = std::sqrt(std::max(this->lightDat.color.w, 0.f) * 256.f);
+    //calculate the distance from the camera to the light
+    vec3 delta = this->lightDat.pos - cameraPos;
+    float dist = std::sqrt(delta.x*delta.x + delta.y*delta.y + delta.z*delta.z);
+    //if the camera is inside the lit area, the light is as important as possible
+    if (dist <= range) { return 1.f; }
+    //else, use the size of the lit area on the screen
+    return range / dist;
+}
+
 void Light::updateLightMat()
 {
     //create the rotation matrix
@@ -511,7 +615,7 @@ void Light::updateLightMat()
     //store the light space matrix
     this->lightDat.lightSpaceMat = (projMat * rotMat * transfMat);
     //say that the light sould update if the matrix changed
-    this->needsUpdate = oldLMat == this->lightDat.lightSpaceMat;
+    this->needsUpdate = this->needsUpdate || !(oldLMat == this->lightDat.lightSpaceMat);
 }
 
 void glgeAddGlobalLighSource(Light* l)
@@ -15,6 +15,7 @@
 
 //include the needed math librarys
 #include "../CML/CMLVec3.h"
+#include "../CML/CMLIVec4.h"
 //include GLGE
 #include "openglGLGE.h"
 
@@ -45,6 +46,60 @@
  */
 #define GLGE_LIGHT_SOURCE_TYPE_DIRECTIONAL 2
 
+/**
+ * @brief define the width and height of the shadow atlas all shadow maps of a window are packed into
+ */
+#define GLGE_SHADOW_ATLAS_SIZE 4096
+
+/**
+ * @brief define the biggest resolution a single shadow map in the shadow atlas can have
+ */
+#define GLGE_SHADOW_MAX_RESOLUTION 2048
+
+/**
+ * @brief define the smallest resolution a single shadow map in the shadow atlas can have
+ */
+#define GLGE_SHADOW_MIN_RESOLUTION 128
+
+/**
+ * @brief define the amount of shadow cascades for a directional light (the shader stores the splits in a vec4, so 4 is the maximum)
+ */
+#define GLGE_SHADOW_CASCADE_COUNT 4
+//the split distances of a light are stored in a single vec4
+#if GLGE_SHADOW_CASCADE_COUNT > 4
+#error "GLGE_SHADOW_CASCADE_COUNT can't be larger than 4"
+#endif
+
+/**
+ * @brief define the width and height of a single shadow cascade
+ */
+#define GLGE_SHADOW_CASCADE_RESOLUTION 1024
+
+/**
+ * @brief define the maximum amount of directional lights that can cast shadows
+ */
+#define GLGE_SHADOW_MAX_DIRECTIONAL 2
+
+/**
+ * @brief define how much the practical split scheme uses logarithmic splits (0 = uniform, 1 = logarithmic)
+ */
+#define GLGE_SHADOW_CASCADE_SPLIT_LAMBDA 0.75f
+
+/**
+ * @brief define how far shadows of directional lights reach from the camera at most
+ */
+#define GLGE_SHADOW_CASCADE_MAX_DISTANCE 250.f
+
+/**
+ * @brief define how far behind a cascade objects can be and still cast shadows into it
+ */
+#define GLGE_SHADOW_CASCADE_CASTER_DISTANCE 100.f
+
+/**
+ * @brief define the texture unit the shadow cascades are bound to
+ */
+#define GLGE_SHADOW_CASCADE_TEXTURE_UNIT 15
+
 /**
  * @brief describes how the data looks that is transferd to the GPU
  */
@@ -74,10 +129,41 @@ struct LightData
      * @brief store the light position matrix
      */
     mat4 lightSpaceMat;
+    /**
+     * @brief store the region of the shadow map in the shadow atlas (x, y, width, height in texture coordinates)
+     */
+    vec4 shadowRect = vec4(0);
     /**
      * @brief store the light source type
      */
     int type = 0;
+    /**
+     * @brief store if the light has a valid shadow map in the shadow atlas
+     */
+    int shadowed = 0;
+    /**
+     * @brief store the first layer of the shadow cascades of a directional light (-1 if it has no cascades)
+     */
+    int cascadeLayer = -1;
+    /**
+     * @brief pad the structure to the std140 array stride
+     */
+    int padding = 0;
+};
+
+/**
+ * @brief describes how the data for the shadow cascades looks on the GPU
+ */
+struct CascadeData
+{
+    /**
+     * @brief store the light space matrix of every cascade
+     */
+    mat4 mats[GLGE_SHADOW_MAX_DIRECTIONAL * GLGE_SHADOW_CASCADE_COUNT];
+    /**
+     * @brief store the far distance of every cascade of a light
+     */
+    vec4 splits[GLGE_SHADOW_MAX_DIRECTIONAL];
 };
 
 /**
@@ -314,7 +400,7 @@ public:
      * 
      * @param data the data to decode from
      */
-    void decode(Data data);
+    void decode(DataView data);
 
     /**
      * @brief Get the matrix to transform anything into light space
@@ -370,19 +456,111 @@ public:
      */
     void queueUpdate();
 
+    /**
+     * @brief Set the region of the shadow map in a shadow atlas
+     * 
+     * @param region the region in pixels (x, y, width, height), a width of 0 removes the shadow map
+     * @param atlas the OpenGL texture of the shadow atlas
+     * @param atlasSize the width and height of the shadow atlas in pixels
+     * @return true : the region changed and the shadow map must be redrawn | 
+     * @return false : the region is the same as before
+     */
+    bool setShadowRegion(ivec4 region, unsigned int atlas, int atlasSize);
+
+    /**
+     * @brief Get the region of the shadow map in the shadow atlas
+     * 
+     * @return ivec4 the region in pixels (x, y, width, height)
+     */
+    ivec4 getShadowRegion();
+
+    /**
+     * @brief get if the shadow map from the last draw can be reused
+     * 
+     * This updates the light space matrix and checks it against the one the shadow map was drawn with
+     * 
+     * @return true : the shadow map is still valid | 
+     * @return false : the shadow map must be redrawn
+     */
+    bool isShadowCacheValid();
+
+    /**
+     * @brief say that the shadow map was drawn with the current light space matrix
+     */
+    void storeShadowCache();
+
+    /**
+     * @brief say that the shadow map must be redrawn
+     */
+    void invalidateShadowCache();
+
+    /**
+     * @brief Set the first layer of the shadow cascades for a directional light
+     * 
+     * @param layer the first layer in the cascade array texture (-1 for no cascades)
+     */
+    void setCascadeLayer(int layer);
+
+    /**
+     * @brief Get the first layer of the shadow cascades of a directional light
+     * 
+     * @return int the first layer in the cascade array texture (-1 for no cascades)
+     */
+    int getCascadeLayer();
+
+    /**
+     * @brief count an object that was tested against the frustum of the light for the shadow map
+     * 
+     * @param drawn true : the object was drawn into the shadow map | false : the object was skipped
+     */
+    void countShadowCaster(bool drawn);
+
+    /**
+     * @brief reset the shadow caster statistics, done at the start of every shadow pass
+     */
+    void resetShadowCasterStats();
+
+    /**
+     * @brief Get the amount of objects drawn into the shadow map in the last shadow pass
+     * 
+     * @return int the amount of drawn shadow casters
+     */
+    int getShadowCastersDrawn();
+
+    /**
+     * @brief Get the amount of objects skipped for the shadow map in the last shadow pass
+     * 
+     * @return int the amount of skipped shadow casters
+     */
+    int getShadowCastersSkipped();
+
+    /**
+     * @brief Get how important the shadow of the light is for a camera
+     * 
+     * @param cameraPos the position of the camera
+     * @return float the importance, 1 or more means the light is as important as possible
+     */
+    float getShadowImportance(vec3 cameraPos);
+
 private:
     //store the lights data
     LightData lightDat;
-    //store the shadow depth map
-    unsigned int shadowDepth;
-    //store the shadow map texture
-    unsigned int shadowMapTex;
-    //store the shadow map FBO
-    unsigned int shadowFBO;
+    //store the shadow atlas the shadow map is in
+    unsigned int shadowAtlas = 0;
+    //store the region of the shadow map in the shadow atlas in pixels
+    ivec4 shadowRegion = ivec4(0,0,0,0);
+    //store the light space matrix the cached shadow map was drawn with
+    mat4 cachedShadowMat;
+    //store if the cached shadow map is valid
+    bool shadowCached = false;
+    //store the amount of objects drawn into the shadow map in the last shadow pass
+    int shadowCastersDrawn = 0;
+    //store the amount of objects skipped for the shadow map in the last shadow pass
+    int shadowCastersSkipped = 0;
     //store the shadow map texture unit
     unsigned int texUnit;
     //store if an update is needed
-    bool needsUpdate;
+    bool needsUpdate = true;
     /**
      * @brief initalises the shadow map
      */
@@ -28,6 +28,105 @@
 //include the private defines
 #include "../GLGEIndependend/glgePrivDefines.hpp"
 
+//include the needed standard librarys
+#include <cstring>
+#include <algorithm>
+
+//store if material textures are block compressed
+static bool glgeMaterialTextureCompression = false;
+
+/**
+ * @brief get the load flags for a texture of a material
+ * 
+ * @param compression the compression flag to use if compression is enabled
+ * @return unsigned int the load flags
+ */
+static unsigned int glgeGetMaterialLoadFlags(unsigned int compression)
+{
+    //only compress if it is enabled
+    return glgeMaterialTextureCompression ? compression : GLGE_TEXTURE_LOAD_DEFAULT;
+}
+
+/**
+ * @brief the handles of the textures of a material, the same as the structure in the shader
+ */
+struct MaterialHandles
+{
+    //the handle of the ambient map
+    uint64_t ambient = 0;
+    //the handle of the normal map
+    uint64_t normal = 0;
+    //the handle of the roughness map
+    uint64_t roughness = 0;
+    //the handle of the metalic map
+    uint64_t metalic = 0;
+    //the handle of the displacement map
+    uint64_t displacement = 0;
+};
+
+/**
+ * @brief store the handles of all materials of a window
+ */
+struct MaterialHandleTable
+{
+    //store the handles of all materials, indexed by the bindless index
+    std::vector<MaterialHandles> handles;
+    //store the indices of deleted materials
+    std::vector<int> freeSlots;
+    //store the shader storage buffer
+    unsigned int ssbo = 0;
+    //store the amount of materials the buffer has space for
+    size_t capacity = 0;
+    //store a white pixel that is used for missing and loading textures
+    unsigned int fallback = 0;
+    //store the handle of the white pixel
+    uint64_t fallbackHandle = 0;
+};
+
+//store the handle table of every window
+static std::vector<MaterialHandleTable> glgeMaterialHandleTables;
+
+/**
+ * @brief get the handle table of a window
+ * 
+ * @param windowId the index of the window
+ * @return MaterialHandleTable& the handle table
+ */
+static MaterialHandleTable& glgeGetMaterialHandleTable(int windowId)
+{
+    //create the tables of all windows up to the requested one
+    if (windowId >= (int)glgeMaterialHandleTables.size()) { glgeMaterialHandleTables.resize(windowId+1); }
+    //return the table
+    return glgeMaterialHandleTables[windowId];
+}
+
+/**
+ * @brief get the handle of a texture for the handle table
+ * 
+ * @param texture the texture, may be NULL
+ * @param table the table the handle is for
+ * @return uint64_t the handle of the texture or the fallback if the texture dosn't exist or is still loading
+ */
+static uint64_t glgeGetMaterialTextureHandle(Texture* texture, MaterialHandleTable& table)
+{
+    //a handle can only be created for finished textures
+    if (texture && texture->isResident()) { return texture->getHandler(); }
+    //check if the white pixel exists
+    if (!table.fallback)
+    {
+        //create the white pixel
+        uint8_t white[4] = {255, 255, 255, 255};
+        glCreateTextures(GL_TEXTURE_2D, 1, &table.fallback);
+        glTextureStorage2D(table.fallback, 1, GL_RGBA8, 1, 1);
+        glTextureSubImage2D(table.fallback, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, white);
+        //create the handle
+        table.fallbackHandle = glGetTextureHandleARB(table.fallback);
+        glMakeTextureHandleResidentARB(table.fallbackHandle);
+    }
+    //return the white pixel, so the shader never samples an invalid handle
+    return table.fallbackHandle;
+}
+
 Material::Material()
 {
     //default constructor
@@ -67,7 +166,7 @@ Material::Material(Texture* texture, float roughness, bool lit, float metalic)
 Material::Material(const char* texture, float roughness, bool lit, float metalic)
 {
     //create a new texture
-    this->ambientMap = new Texture(texture);
+    this->ambientMap = new Texture(texture, glgeGetMaterialLoadFlags(GLGE_TEXTURE_LOAD_BC7));
     //store the roughness
     this->matData.roughness = roughness;
     //store if the object is lit
@@ -88,6 +187,12 @@ Material::~Material()
     delete this->roughnessMap;
     //delete the metalic map
     delete this->metalicMap;
+    //check if the material has a slot in the handle table
+    if (this->bindlessIndex != -1)
+    {
+        //give the slot back
+        glgeGetMaterialHandleTable(this->windowId).freeSlots.push_back(this->bindlessIndex);
+    }
 }
 
 void Material::update(unsigned int shader, bool force)
@@ -190,10 +295,35 @@ void Material::update(unsigned int shader, bool force)
 
 void Material::bindToWindow(unsigned int windowId)
 {
+    //check if the material has a slot in the handle table of another window
+    if (this->bindlessIndex != -1)
+    {
+        //give the slot back
+        glgeGetMaterialHandleTable(this->windowId).freeSlots.push_back(this->bindlessIndex);
+        this->bindlessIndex = -1;
+    }
     //store the window id
     this->windowId = windowId;
     //create a new buffer
     glCreateBuffers(1, &this->ubo);
+    //check if the textures are accessed through handles
+    if (glgeBindlessTextures)
+    {
+        //get a slot in the handle table
+        MaterialHandleTable& table = glgeGetMaterialHandleTable(this->windowId);
+        if (!table.freeSlots.empty())
+        {
+            //reuse a slot of a deleted material
+            this->bindlessIndex = table.freeSlots.back();
+            table.freeSlots.pop_back();
+        }
+        else
+        {
+            //add a new slot
+            this->bindlessIndex = (int)table.handles.size();
+            table.handles.push_back(MaterialHandles());
+        }
+    }
     //say that an update should be done
     this->quedUpdate = true;
 }
@@ -279,7 +409,7 @@ void Material::setAmbientTexture(Texture* texture)
 void Material::setAmbientTexture(const char* texture)
 {
     //create a new texture and cast to another function
-    this->setAmbientTexture(new Texture(texture));
+    this->setAmbientTexture(new Texture(texture, glgeGetMaterialLoadFlags(GLGE_TEXTURE_LOAD_BC7)));
 }
 
 Texture* Material::getAmbientTexture()
@@ -299,7 +429,7 @@ void Material::setNormalMap(Texture* normalMap)
 void Material::setNormalMap(const char* texture)
 {
     //create a new texutre and cast to another function
-    this->setNormalMap(new Texture(texture));
+    this->setNormalMap(new Texture(texture, glgeGetMaterialLoadFlags(GLGE_TEXTURE_LOAD_BC5)));
 }
 
 Texture* Material::getNormalMap()
@@ -319,7 +449,7 @@ void Material::setRoughnessMap(Texture* roughnessMap)
 void Material::setRoughnessMap(const char* texture)
 {
     //create a new texture and cast to another function
-    this->setRoughnessMap(new Texture(texture));
+    this->setRoughnessMap(new Texture(texture, glgeGetMaterialLoadFlags(GLGE_TEXTURE_LOAD_BC4)));
 }
 
 Texture* Material::getRoughnessMap()
@@ -339,7 +469,7 @@ void Material::setMetalicMap(Texture* metalicMap)
 void Material::setMetalicMap(const char* texture)
 {
     //create a new texture and cast to another function
-    this->setMetalicMap(new Texture(texture));
+    this->setMetalicMap(new Texture(texture, glgeGetMaterialLoadFlags(GLGE_TEXTURE_LOAD_BC4)));
 }
 
 Texture* Material::getMetalicMap()
@@ -421,6 +551,17 @@ void Material::apply()
     //bind the ubo
     glBindBufferBase(GL_UNIFORM_BUFFER, 2, this->ubo);
 
+    //check if the textures are accessed through handles
+    if (this->bindlessIndex != -1)
+    {
+        //make sure the handles of all textures are in the table
+        this->updateHandles();
+        //bind the handle table, no texture units are needed
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, glgeGetMaterialHandleTable(this->windowId).ssbo);
+        //stop the function
+        return;
+    }
+
     //store the amount of texture units used
     unsigned int texUnits = 0;
     //check if an ambient texture exists
@@ -478,8 +619,20 @@ void Material::apply()
     }
 }
 
+void Material::requestDetail(float uvPerPixel)
+{
+    //pass the request to all existing textures
+    if (this->ambientMap) { this->ambientMap->requestDetail(uvPerPixel); }
+    if (this->normalMap) { this->normalMap->requestDetail(uvPerPixel); }
+    if (this->roughnessMap) { this->roughnessMap->requestDetail(uvPerPixel); }
+    if (this->metalicMap) { this->metalicMap->requestDetail(uvPerPixel); }
+    if (this->displacementMap) { this->displacementMap->requestDetail(uvPerPixel); }
+}
+
 void Material::remove()
 {
+    //textures accessed through handles are not bound
+    if (this->bindlessIndex != -1) { return; }
     //store the amount of texture units used
     unsigned int texUnits = 0;
     //check if an ambient texture exists
@@ -524,16 +677,87 @@ void Material::remove()
     }
 }
 
+int Material::getBindlessIndex()
+{
+    //return the index in the handle table
+    return this->bindlessIndex;
+}
+
+void Material::updateHandles()
+{
+    //get the table of the window
+    MaterialHandleTable& table = glgeGetMaterialHandleTable(this->windowId);
+    //get the current handles, they change if a texture finished loading or a streamed texture changed its levels
+    MaterialHandles handles;
+    handles.ambient = glgeGetMaterialTextureHandle(this->ambientMap, table);
+    handles.normal = glgeGetMaterialTextureHandle(this->normalMap, table);
+    handles.roughness = glgeGetMaterialTextureHandle(this->roughnessMap, table);
+    handles.metalic = glgeGetMaterialTextureHandle(this->metalicMap, table);
+    handles.displacement = glgeGetMaterialTextureHandle(this->displacementMap, table);
+    //check if the buffer is to small for all materials
+    if (table.capacity < table.handles.size())
+    {
+        //store the handles
+        table.handles[this->bindlessIndex] = handles;
+        //grow the buffer, so it isn't recreated for every new material
+        table.capacity = std::max((size_t)64, table.handles.size() * 2);
+        if (!table.ssbo) { glCreateBuffers(1, &table.ssbo); }
+        glNamedBufferData(table.ssbo, sizeof(MaterialHandles) * table.capacity, NULL, GL_DYNAMIC_DRAW);
+        //upload the handles of all materials
+        glNamedBufferSubData(table.ssbo, 0, sizeof(MaterialHandles) * table.handles.size(), table.handles.data());
+        //stop the function
+        return;
+    }
+    //check if the handles changed
+    if (std::memcmp(&table.handles[this->bindlessIndex], &handles, sizeof(MaterialHandles)) != 0)
+    {
+        //store the handles
+        table.handles[this->bindlessIndex] = handles;
+        //only upload the own slot
+        glNamedBufferSubData(table.ssbo, sizeof(MaterialHandles) * this->bindlessIndex, sizeof(MaterialHandles), &handles);
+    }
+}
+
 void Material::encode(Data* data)
 {
     //write all of the own data
     data->writeBytes((uint8_t*)&this->matData, sizeof(matData));
 }
 
-void Material::decode(Data data)
+void Material::decode(DataView data)
 {
     //read the material data
-    this->matData = *(MaterialData*)data.readBytes(sizeof(matData));
+    this->decodeData(data);
     //apply to the current window
     this->bindToWindow(glgeCurrentWindowIndex);
-}
\ No newline at end of file
+}
+
+void Material::decodeData(DataView& data)
+{
+    //read the material data directly into the material
+    data.readBytes(&this->matData, sizeof(matData));
+}
+
+void glgeSetMaterialTextureCompression(bool compress)
+{
+    //store if textures are compressed
+    glgeMaterialTextureCompression = compress;
+}
+
+bool glgeGetMaterialTextureCompression()
+{
+    //return if textures are compressed
+    return glgeMaterialTextureCompression;
+}
+
+void glgeSetBindlessTextures(bool bindless)
+{
+    //store if handles are used
+    glgeBindlessTextures = bindless;
+}
+
+bool glgeGetBindlessTextures()
+{
+    //return if handles are used
+    return glgeBindlessTextures;
+}
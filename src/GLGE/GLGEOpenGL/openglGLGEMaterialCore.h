@@ -321,6 +321,20 @@ public:
      */
     void remove();
 
+    /**
+     * @brief request the detail all streamed textures of the material are needed with
+     * 
+     * @param uvPerPixel the size of a screen pixel in texture coordinates
+     */
+    void requestDetail(float uvPerPixel);
+
+    /**
+     * @brief Get the index of the material in the bindless handle table of its window
+     * 
+     * @return int the index, -1 if bindless textures are not used
+     */
+    int getBindlessIndex();
+
     /**
      * @brief encode the object into some data
      * 
@@ -332,7 +346,13 @@ public:
      * 
      * @param data the data to decode from
      */
-    void decode(Data data);
+    void decode(DataView data);
+    /**
+     * @brief read the material from some data without binding it to a window, this can run on any thread
+     * 
+     * @param data the data to read from, the read position is moved behind the material
+     */
+    void decodeData(DataView& data);
 
 private:
     /**
@@ -393,13 +413,57 @@ private:
     int displacementMapLoc = -1;
     //store the window id
     int windowId = -1;
+    //store the index in the bindless handle table
+    int bindlessIndex = -1;
     //store the material data
     MaterialData matData = {};
     //store the ubo
     unsigned int ubo;
     //store if a update is qued
     bool quedUpdate = true;
+
+    /**
+     * @brief write the current handles of all textures into the bindless handle table
+     */
+    void updateHandles();
 };
 
 
+/**
+ * @brief say if textures loaded from files by a material are block compressed
+ * \par Info
+ * The ambient map is stored as BC7, the normal map as BC5 and the roughness and metalic maps as BC4. 
+ * The compressed data is cached next to the source file. 
+ * 
+ * @param compress true : the textures are compressed | false : the textures are loaded uncompressed
+ */
+void glgeSetMaterialTextureCompression(bool compress);
+
+/**
+ * @brief Get if textures loaded from files by a material are block compressed
+ * 
+ * @return true : the textures are compressed | 
+ * @return false : the textures are loaded uncompressed
+ */
+bool glgeGetMaterialTextureCompression();
+
+/**
+ * @brief say if material textures are accessed through bindless handles (ARB_bindless_texture)
+ * \par Info
+ * All textures of a material are made resident once and their handles are stored in a shader storage buffer, 
+ * so applying a material dosn't bind any texture units. Must be set before the first window is created, 
+ * it is turned off if the driver dosn't support bindless textures. 
+ * 
+ * @param bindless true : textures are accessed through handles | false : textures are bound to texture units
+ */
+void glgeSetBindlessTextures(bool bindless);
+
+/**
+ * @brief Get if material textures are accessed through bindless handles
+ * 
+ * @return true : textures are accessed through handles | 
+ * @return false : textures are bound to texture units
+ */
+bool glgeGetBindlessTextures();
+
 #endif
\ No newline at end of file
@@ -298,6 +298,8 @@ RenderPipeline::RenderPipeline(std::vector<Stage> stages)
 {
     //store the inputed stage map
     this->stages = stages;
+    //the frame graph must be build before the first execution
+    this->graphDirty = true;
 }
 
 RenderPipeline::~RenderPipeline()
@@ -316,6 +318,8 @@ RenderPipeline::~RenderPipeline()
 
 std::vector<Stage>* RenderPipeline::getStages()
 {
+    //the stages may be changed trough the pointer, so rebuild the frame graph
+    this->graphDirty = true;
     //return a pointer to all stages
     return &this->stages;
 }
@@ -330,6 +334,8 @@ void RenderPipeline::setStage(std::string name, Stage stage)
         {
             //set the stage
             this->stages[i] = stage;
+            //rebuild the frame graph
+            this->graphDirty = true;
             //stop the function
             return;
         }
@@ -338,6 +344,8 @@ void RenderPipeline::setStage(std::string name, Stage stage)
     stage.name = name;
     //if it wasn't found, add the stage
     this->stages.push_back(stage);
+    //rebuild the frame graph
+    this->graphDirty = true;
 }
 
 Stage* RenderPipeline::getStage(std::string name)
@@ -348,6 +356,8 @@ Stage* RenderPipeline::getStage(std::string name)
         //check if the stage is the searched one
         if (this->stages[i].name == name)
         {
+            //the stage may be changed trough the pointer, so rebuild the frame graph
+            this->graphDirty = true;
             //return a pointer to the stage
             return &this->stages[i];
         }
@@ -416,12 +426,22 @@ PostProcessingStack* RenderPipeline::getPPStagePPS(Stage* stage)
 
 void RenderPipeline::execute()
 {
+    //check if the frame graph is outdated
+    if (this->graphDirty)
+    {
+        //rebuild the frame graph
+        this->compile();
+    }
     //say that this pipeline is now executing
     this->isCurrent = true;
+    //only keep the storage of resources the active stages use
+    glgeWindows[glgeCurrentWindowIndex]->setUsedResources(this->usedResources);
 
     //loop over all stages
     for (int i = 0; i < (int)this->stages.size(); i++)
     {
+        //skip stages that don't contribute to the final image
+        if (!this->activeStages[i]) { continue; }
         //extract the current stage
         Stage stage = this->stages[i];
 
@@ -504,6 +524,13 @@ void RenderPipeline::execute()
             //call the post-execution function
             (*stage.postExecCallback)();
         }
+
+        //check if transient resources end theyre lifetime in this stage
+        if (this->discardAfter[i])
+        {
+            //discard the content of the resources
+            glgeWindows[glgeCurrentWindowIndex]->invalidateResources(this->discardAfter[i]);
+        }
     }
 
     //say that the pipeline finished
@@ -518,10 +545,268 @@ bool RenderPipeline::isExecuting()
 
 Stage* RenderPipeline::operator[](unsigned int index)
 {
+    //the stage may be changed trough the pointer, so rebuild the frame graph
+    this->graphDirty = true;
     //return the stage at that index
     return &this->stages[index];
 }
 
+void RenderPipeline::compile()
+{
+    //store the amount of stages
+    int count = (int)this->stages.size();
+    //store the accessed resources of all stages
+    std::vector<unsigned int> reads(count);
+    std::vector<unsigned int> writes(count);
+    //store which stages can't be culled
+    std::vector<bool> fixed(count);
+    //get the access of all stages
+    for (int i = 0; i < count; i++)
+    {
+        //store the access and if the stage is fixed
+        fixed[i] = this->getStageAccess(&this->stages[i], &reads[i], &writes[i]);
+    }
+
+    //reset the stage states
+    this->activeStages.assign(count, false);
+    this->discardAfter.assign(count, 0);
+    //the window presents the post processing framebuffer, so it is alive at the end of the pipeline
+    unsigned int live = GLGE_RESOURCE_POST_PROCESSING;
+    //walk backwards trough the stages to find the ones contributing to the final image
+    for (int i = count-1; i >= 0; i--)
+    {
+        //skip stages that neither write a needed resource nor can be culled
+        if (!(fixed[i] || (writes[i] & live))) { continue; }
+        //mark the stage as active
+        this->activeStages[i] = true;
+        //resources that are written without being read are dead before this stage
+        live &= ~(writes[i] & ~reads[i]);
+        //everything that is read must be produced by an earlier stage
+        live |= reads[i];
+    }
+
+    //reset the lifetimes
+    for (int r = 0; r < GLGE_RESOURCE_COUNT; r++)
+    {
+        //say that the resource is unused
+        this->firstUse[r] = -1;
+        this->lastUse[r] = -1;
+    }
+    //the window always presents the post processing framebuffer
+    this->usedResources = GLGE_RESOURCE_POST_PROCESSING;
+    //compute the lifetimes of all resources
+    for (int i = 0; i < count; i++)
+    {
+        //skip culled stages
+        if (!this->activeStages[i]) { continue; }
+        //get all resources of the stage
+        unsigned int access = (reads[i] | writes[i]) & GLGE_RESOURCE_ALL;
+        //store the resources as used
+        this->usedResources |= access;
+        //loop over all resources
+        for (int r = 0; r < GLGE_RESOURCE_COUNT; r++)
+        {
+            //check if the stage uses the resource
+            if (!(access & (1 << r))) { continue; }
+            //check if this is the first use
+            if (this->firstUse[r] == -1) { this->firstUse[r] = i; }
+            //store the stage as the last use
+            this->lastUse[r] = i;
+        }
+    }
+    //mark the transient resources to discard after theyre last use
+    for (int r = 0; r < GLGE_RESOURCE_COUNT; r++)
+    {
+        //check if the resource is used and transient
+        if ((this->lastUse[r] != -1) && (this->transientResources & (1 << r)))
+        {
+            //discard the resource after the last stage using it
+            this->discardAfter[this->lastUse[r]] |= (1 << r);
+        }
+    }
+
+    //say that the frame graph is up to date
+    this->graphDirty = false;
+}
+
+bool RenderPipeline::isStageActive(unsigned int index)
+{
+    //check if the frame graph is outdated
+    if (this->graphDirty)
+    {
+        //rebuild the frame graph
+        this->compile();
+    }
+    //check if the index is in range
+    if (index >= this->activeStages.size()) { return false; }
+    //return if the stage is active
+    return this->activeStages[index];
+}
+
+unsigned int RenderPipeline::getUsedResources()
+{
+    //check if the frame graph is outdated
+    if (this->graphDirty)
+    {
+        //rebuild the frame graph
+        this->compile();
+    }
+    //return the used resources
+    return this->usedResources;
+}
+
+int RenderPipeline::getFirstUse(unsigned int resource)
+{
+    //get the index of the resource
+    int r = this->getResourceIndex(resource);
+    //check if the resource is valid
+    if (r == -1)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Can only get the lifetime of a single resource")
+        //stop the function
+        return -1;
+    }
+    //check if the frame graph is outdated
+    if (this->graphDirty)
+    {
+        //rebuild the frame graph
+        this->compile();
+    }
+    //return the first use
+    return this->firstUse[r];
+}
+
+int RenderPipeline::getLastUse(unsigned int resource)
+{
+    //get the index of the resource
+    int r = this->getResourceIndex(resource);
+    //check if the resource is valid
+    if (r == -1)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Can only get the lifetime of a single resource")
+        //stop the function
+        return -1;
+    }
+    //check if the frame graph is outdated
+    if (this->graphDirty)
+    {
+        //rebuild the frame graph
+        this->compile();
+    }
+    //return the last use
+    return this->lastUse[r];
+}
+
+void RenderPipeline::setTransientResources(unsigned int resources)
+{
+    //store the transient resources
+    this->transientResources = resources & GLGE_RESOURCE_ALL;
+    //rebuild the frame graph
+    this->graphDirty = true;
+}
+
+unsigned int RenderPipeline::getTransientResources()
+{
+    //return the transient resources
+    return this->transientResources;
+}
+
+bool RenderPipeline::getStageAccess(Stage* stage, unsigned int* reads, unsigned int* writes)
+{
+    //store the default access of the pass
+    unsigned int r = 0;
+    unsigned int w = 0;
+    //check wich pass the stage executes
+    switch (stage->pass)
+    {
+    //the shadow pass only redraws changed parts of the shadow maps
+    case GLGE_PASS_SHADOWS:
+        r = GLGE_RESOURCE_SHADOW_MAPS;
+        w = GLGE_RESOURCE_SHADOW_MAPS;
+        break;
+    //the clear pass overwrites the whole geometry buffer
+    case GLGE_PASS_CLEAR_G_BUFFER:
+        w = GLGE_RESOURCE_G_BUFFER | GLGE_RESOURCE_DEPTH;
+        break;
+    //the skybox only fills the empty pixels
+    case GLGE_PASS_DRAW_SKYBOX:
+        r = GLGE_RESOURCE_G_BUFFER | GLGE_RESOURCE_DEPTH;
+        w = GLGE_RESOURCE_G_BUFFER | GLGE_RESOURCE_DEPTH;
+        break;
+    //solid objects are depth tested and may sample the last frame
+    case GLGE_PASS_DRAW_SOLID:
+        r = GLGE_RESOURCE_G_BUFFER | GLGE_RESOURCE_DEPTH | GLGE_RESOURCE_LAST_TICK;
+        w = GLGE_RESOURCE_G_BUFFER | GLGE_RESOURCE_DEPTH;
+        break;
+    //the lighting reads the surface data and writes the lit image
+    case GLGE_PASS_LIGHING:
+        r = GLGE_RESOURCE_ALBEDO | GLGE_RESOURCE_NORMAL | GLGE_RESOURCE_POSITION | GLGE_RESOURCE_RML | GLGE_RESOURCE_EIDA | GLGE_RESOURCE_SHADOW_MAPS;
+        w = GLGE_RESOURCE_LIT | GLGE_RESOURCE_SOLID;
+        break;
+    //transparent objects are blended on top of the lit image
+    case GLGE_PASS_DRAW_TRANSPARENT:
+        r = GLGE_RESOURCE_G_BUFFER | GLGE_RESOURCE_DEPTH | GLGE_RESOURCE_SHADOW_MAPS | GLGE_RESOURCE_LAST_TICK;
+        w = GLGE_RESOURCE_G_BUFFER;
+        break;
+    //post processing shaders can sample every screen sized buffer
+    case GLGE_PASS_POST_PROCESSING:
+        r = GLGE_RESOURCE_POST_PROCESSING | GLGE_RESOURCE_G_BUFFER | GLGE_RESOURCE_DEPTH | GLGE_RESOURCE_LAST_TICK;
+        w = GLGE_RESOURCE_POST_PROCESSING;
+        break;
+    
+    case (GLGE_PASS_COPY_G_TO_PP | GLGE_G_BUFF_COLOR_ATTACHMENT_ALBEDO):
+    case (GLGE_PASS_COPY_G_TO_PP | GLGE_G_BUFF_COLOR_ATTACHMENT_NORMAL):
+    case (GLGE_PASS_COPY_G_TO_PP | GLGE_G_BUFF_COLOR_ATTACHMENT_POSITION):
+    case (GLGE_PASS_COPY_G_TO_PP | GLGE_G_BUFF_COLOR_ATTACHMENT_RML):
+    case (GLGE_PASS_COPY_G_TO_PP | GLGE_G_BUFF_COLOR_ATTACHMENT_LIT):
+    case (GLGE_PASS_COPY_G_TO_PP | GLGE_G_BUFF_COLOR_ATTACHMENT_EIDA):
+    case (GLGE_PASS_COPY_G_TO_PP | GLGE_G_BUFF_COLOR_ATTACHMENT_SOLID):
+    case (GLGE_PASS_COPY_G_TO_PP | GLGE_G_BUFF_COLOR_ATTACHMENT_TRANS_ACCUM):
+        //the copy overwrites the post processing framebuffer with one attachment
+        r = 1 << (stage->pass & (~GLGE_PASS_COPY_G_TO_PP));
+        w = GLGE_RESOURCE_POST_PROCESSING;
+        break;
+
+    //passes without build-in functionality access nothing
+    default:
+        break;
+    }
+
+    //check if the stage has callbacks
+    bool hasCallbacks = (stage->preExecCallback || stage->postExecCallback);
+    //callbacks can access everything if nothing else is specified
+    if (hasCallbacks)
+    {
+        //say that everything is accessed
+        r = GLGE_RESOURCE_ALL;
+        w = GLGE_RESOURCE_ALL;
+    }
+
+    //use the declared access if it exists
+    *reads = (stage->reads == GLGE_RESOURCE_DEFAULT) ? r : stage->reads;
+    *writes = (stage->writes == GLGE_RESOURCE_DEFAULT) ? w : stage->writes;
+    //stages with callbacks can't be culled
+    return hasCallbacks;
+}
+
+int RenderPipeline::getResourceIndex(unsigned int resource)
+{
+    //loop over all resources
+    for (int r = 0; r < GLGE_RESOURCE_COUNT; r++)
+    {
+        //check if the flag is exactly this resource
+        if (resource == (1u << r))
+        {
+            //return the index
+            return r;
+        }
+    }
+    //the flag isn't a single resource
+    return -1;
+}
+
 void RenderPipeline::drawPPS(PostProcessingStack* ppsStack)
 {
     //iterate over the post processing stacks
@@ -90,6 +90,75 @@
  */
 #define GLGE_G_BUFF_COLOR_ATTACHMENT_TRANS_ACCUM 7
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FRAME RESOURCES //
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief the albedo attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_ALBEDO (1 << GLGE_G_BUFF_COLOR_ATTACHMENT_ALBEDO)
+/**
+ * @brief the normal attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_NORMAL (1 << GLGE_G_BUFF_COLOR_ATTACHMENT_NORMAL)
+/**
+ * @brief the position attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_POSITION (1 << GLGE_G_BUFF_COLOR_ATTACHMENT_POSITION)
+/**
+ * @brief the roughness, metallic and lit attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_RML (1 << GLGE_G_BUFF_COLOR_ATTACHMENT_RML)
+/**
+ * @brief the lighting output attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_LIT (1 << GLGE_G_BUFF_COLOR_ATTACHMENT_LIT)
+/**
+ * @brief the object ID, distance and alpha attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_EIDA (1 << GLGE_G_BUFF_COLOR_ATTACHMENT_EIDA)
+/**
+ * @brief the solid attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_SOLID (1 << GLGE_G_BUFF_COLOR_ATTACHMENT_SOLID)
+/**
+ * @brief the transparent accumulation attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_TRANS_ACCUM (1 << GLGE_G_BUFF_COLOR_ATTACHMENT_TRANS_ACCUM)
+/**
+ * @brief all color attachments of the geometry buffer
+ */
+#define GLGE_RESOURCE_G_BUFFER 0xFF
+/**
+ * @brief the depth attachment of the geometry buffer
+ */
+#define GLGE_RESOURCE_DEPTH (1 << 8)
+/**
+ * @brief the post processing framebuffer, the window presents this resource after the pipeline finished
+ */
+#define GLGE_RESOURCE_POST_PROCESSING (1 << 9)
+/**
+ * @brief the copy of the last frame
+ */
+#define GLGE_RESOURCE_LAST_TICK (1 << 10)
+/**
+ * @brief the shadow atlas and the shadow cascades
+ */
+#define GLGE_RESOURCE_SHADOW_MAPS (1 << 11)
+/**
+ * @brief the amount of frame resources
+ */
+#define GLGE_RESOURCE_COUNT 12
+/**
+ * @brief all frame resources
+ */
+#define GLGE_RESOURCE_ALL ((1 << GLGE_RESOURCE_COUNT) - 1)
+/**
+ * @brief derive the accessed resources from the pass of the stage
+ */
+#define GLGE_RESOURCE_DEFAULT 0xFFFFFFFF
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // POST PROCESSING //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -286,6 +355,10 @@ struct Stage
     void(*postExecCallback)() = NULL;
     //store the name of a post processing stack for a post processing pass
     std::string ppsName = "";
+    //store the resources the stage depends on, including targets it only partialy overwrites
+    unsigned int reads = GLGE_RESOURCE_DEFAULT;
+    //store the resources the stage writes to
+    unsigned int writes = GLGE_RESOURCE_DEFAULT;
 };
 
 /**
@@ -372,13 +445,102 @@ public:
      */
     Stage* operator[](unsigned int index);
 
-private: 
+    /**
+     * @brief build the frame graph of the pipeline
+     * \par Info
+     * This culls all stages that don't contribute to the final image and computes the lifetime of all frame resources.
+     * It is called automaticaly by execute if the pipeline changed.
+     */
+    void compile();
+
+    /**
+     * @brief say if a stage survived the culling of the frame graph
+     *
+     * @param index the index of the stage
+     * @return true : the stage will execute |
+     * @return false : the stage was culled
+     */
+    bool isStageActive(unsigned int index);
+
+    /**
+     * @brief Get all resources used by the active stages
+     *
+     * @return unsigned int a bitmask of GLGE_RESOURCE_* flags
+     */
+    unsigned int getUsedResources();
+
+    /**
+     * @brief Get the index of the first stage that uses a resource
+     *
+     * @param resource a single GLGE_RESOURCE_* flag
+     * @return int the index of the stage or -1 if the resource is unused
+     */
+    int getFirstUse(unsigned int resource);
+
+    /**
+     * @brief Get the index of the last stage that uses a resource
+     *
+     * @param resource a single GLGE_RESOURCE_* flag
+     * @return int the index of the stage or -1 if the resource is unused
+     */
+    int getLastUse(unsigned int resource);
+
+    /**
+     * @brief Set the resources that don't need to keep their content between frames
+     * \par Info
+     * The content of transient resources is discarded after the last stage that uses them.
+     *
+     * @param resources a bitmask of GLGE_RESOURCE_* flags
+     */
+    void setTransientResources(unsigned int resources);
+
+    /**
+     * @brief Get the resources that don't need to keep their content between frames
+     *
+     * @return unsigned int a bitmask of GLGE_RESOURCE_* flags
+     */
+    unsigned int getTransientResources();
+
+private:
     //store all stages for the render pipeline
     std::vector<Stage> stages = {};
     //store all post processing stacks
     std::unordered_map<std::string, PostProcessingStack*> ppStacks = {};
     //stores if the render pipeline is currently active
     bool isCurrent = false;
+    //store if the frame graph must be rebuild before the next execution
+    bool graphDirty = true;
+    //store which stages survived the culling
+    std::vector<bool> activeStages = {};
+    //store the transient resources to discard after each stage
+    std::vector<unsigned int> discardAfter = {};
+    //store all resources used by the active stages
+    unsigned int usedResources = GLGE_RESOURCE_ALL;
+    //store the resources that don't need to keep theyre content between frames
+    unsigned int transientResources = GLGE_RESOURCE_G_BUFFER | GLGE_RESOURCE_DEPTH;
+    //store the index of the first stage using each resource
+    int firstUse[GLGE_RESOURCE_COUNT];
+    //store the index of the last stage using each resource
+    int lastUse[GLGE_RESOURCE_COUNT];
+
+    /**
+     * @brief Get the resources a stage accesses
+     *
+     * @param stage a pointer to the stage
+     * @param reads a pointer to store the read resources in
+     * @param writes a pointer to store the written resources in
+     * @return true : the stage has callbacks and can't be culled |
+     * @return false : the stage only does what its pass says
+     */
+    bool getStageAccess(Stage* stage, unsigned int* reads, unsigned int* writes);
+
+    /**
+     * @brief convert a single resource flag to its index
+     *
+     * @param resource a single GLGE_RESOURCE_* flag
+     * @return int the index of the resource or -1 if it isn't a single resource
+     */
+    int getResourceIndex(unsigned int resource);
 
     /**
      * @brief draw a post processing stack
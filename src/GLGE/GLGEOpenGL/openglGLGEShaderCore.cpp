@@ -1158,7 +1158,7 @@ void Shader::encode(Data* data)
     //call the encode hook
     this->encodeHook(data);
 }
-void Shader::decode(Data data)
+void Shader::decode(DataView data)
 {
     //read the vertex source
     std::string vert = data.readString();
@@ -1284,7 +1284,7 @@ void Shader::encodeUniforms(Data* data)
         data->writeUInt(key.second);
     }
 }
-void Shader::decodeUniforms(Data* data)
+void Shader::decodeUniforms(DataView* data)
 {
     //decode the amount of integers
     long max = data->readLong();
@@ -1412,7 +1412,7 @@ void Shader::encodeHook(Data*)
 {
     //override here
 }
-void Shader::decodeHook(Data*)
+void Shader::decodeHook(DataView*)
 {
     //override here
 }
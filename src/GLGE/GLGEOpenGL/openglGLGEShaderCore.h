@@ -483,7 +483,7 @@ public:
      * 
      * @param data the data to decode from
      */
-    void decode(Data data);
+    void decode(DataView data);
 
     /**
      * @brief encode all the uniforms for the shader
@@ -496,7 +496,7 @@ public:
      * 
      * @param data the data to decode from
      */
-    void decodeUniforms(Data* data);
+    void decodeUniforms(DataView* data);
 
     /**
      * @brief a hook into the encoding process
@@ -509,7 +509,7 @@ public:
      * 
      * @param data the data to decode from
      */
-    virtual void decodeHook(Data* data);
+    virtual void decodeHook(DataView* data);
 
 protected:
     /**
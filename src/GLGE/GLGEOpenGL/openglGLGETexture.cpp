@@ -19,12 +19,444 @@
 //default includes
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <string>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+///////////////////////////
+// ASYNCHRONOUS LOADING //
+///////////////////////////
+
+/**
+ * @brief the job is waiting for a worker thread
+ */
+#define GLGE_TEXTURE_JOB_PENDING 0
+/**
+ * @brief a worker thread decodes the file
+ */
+#define GLGE_TEXTURE_JOB_DECODING 1
+/**
+ * @brief the file is decoded and waits for the upload
+ */
+#define GLGE_TEXTURE_JOB_DECODED 2
+/**
+ * @brief the file could not be decoded
+ */
+#define GLGE_TEXTURE_JOB_FAILED 3
+
+struct TextureLoadJob
+{
+    //store the texture to load, NULL if the texture was deleted while loading
+    Texture* texture = NULL;
+    //store the file to load
+    std::string file = "";
+    //store the load flags
+    unsigned int flags = 0;
+    //store the window the texture belongs to
+    int windowID = -1;
+    //store the state of the job
+    int state = GLGE_TEXTURE_JOB_PENDING;
+    //store the decoded 8-bit pixels
+    uint8_t* bytes = NULL;
+    //store the decoded float pixels
+    float* floats = NULL;
+    //store the size of the image
+    int width = 0;
+    int height = 0;
+    //store the texture the image is uploaded into
+    unsigned int staging = 0;
+    //store the amount of rows that are allready uploaded
+    int uploadedRows = 0;
+    //store the pixel unpack buffer that is reused for all chunks of the job
+    unsigned int pbo = 0;
+    //store the size of the pixel unpack buffer in bytes
+    unsigned int pboSize = 0;
+};
+
+/**
+ * @brief store the shared state of the texture loader
+ */
+struct TextureLoader
+{
+    //protect all members
+    std::mutex mutex;
+    //wake worker threads if a job was added
+    std::condition_variable jobAdded;
+    //wake waiting threads if a job was decoded
+    std::condition_variable jobDecoded;
+    //store the jobs waiting for a worker thread
+    std::deque<TextureLoadJob*> decodeQueue;
+    //store the jobs that are decoded or still decoding, in load order
+    std::vector<TextureLoadJob*> uploadQueue;
+    //store the worker threads
+    std::vector<std::thread> threads;
+    //store if the worker threads should keep running
+    bool running = true;
+    //store the upload time per frame in milliseconds
+    float uploadBudget = GLGE_TEXTURE_DEFAULT_UPLOAD_BUDGET;
+
+    /**
+     * @brief stop and join all worker threads
+     */
+    ~TextureLoader()
+    {
+        {
+            //lock the loader
+            std::lock_guard<std::mutex> lock(this->mutex);
+            //say that the threads should stop
+            this->running = false;
+        }
+        //wake all threads
+        this->jobAdded.notify_all();
+        //wait for all threads
+        for (std::thread& t : this->threads) { t.join(); }
+    }
+};
+
+//store the texture loader
+static TextureLoader glgeTextureLoader;
+//store the quality preset used to compress textures
+static unsigned int glgeTextureCompressionPreset = GLGE_BC_PRESET_NORMAL;
+//store if the quality of compressed textures is printed
+static bool glgeTextureCompressionReport = false;
+
+////////////////////////
+// TEXTURE STREAMING //
+////////////////////////
+
+struct TextureStreamSource
+{
+    //store the texture the levels belong to
+    Texture* texture = NULL;
+    //store the mapped file, if the levels are read from a container
+    TextureContainer container;
+    //store the compressed levels, if the texture was compressed while loading
+    CompressedImage compressed;
+    //store the data of all mip levels
+    std::vector<TextureContainerImage> images;
+    //store the OpenGL formats
+    GLenum internalFormat = 0;
+    GLenum pixelFormat = GL_RGBA;
+    GLenum type = GL_UNSIGNED_BYTE;
+    //store if the levels are block compressed
+    bool blockCompressed = false;
+    //store the size of the first level
+    int width = 0;
+    int height = 0;
+    //store the amount of mip levels
+    int levels = 0;
+    //store the finest level on the GPU, levels if nothing is uploaded
+    int residentLevel = 0;
+    //store the coarsest level that is streamed, it and all coarser levels are always on the GPU
+    int minimalLevel = 0;
+    //store the finest level requested in the last requested frame
+    int requestLevel = 0;
+    //store the frame the texture was last requested in
+    uint64_t requestFrame = 0;
+    //store the level the streamer wants on the GPU
+    int wantedLevel = 0;
+    //store the bytes of all levels on the GPU
+    uint64_t residentBytes = 0;
+    //store the bytes of all levels
+    uint64_t fullBytes = 0;
+    //store the window the texture belongs to
+    int windowID = -1;
+};
+
+/**
+ * @brief store the state of the texture streamer
+ */
+struct TextureStreamer
+{
+    //store all streamed textures
+    std::vector<TextureStreamSource*> sources;
+    //store the amount of updates per window, used as frame counter
+    std::vector<uint64_t> frames;
+    //store the amount of bytes the streamed textures can use
+    uint64_t budget = GLGE_TEXTURE_DEFAULT_STREAMING_BUDGET;
+    //store the amount of bytes uploaded per frame
+    uint64_t uploadLimit = GLGE_TEXTURE_DEFAULT_STREAMING_UPLOAD_LIMIT;
+    //store the state of the last update
+    TextureStreamingStats stats;
+};
+
+//store the texture streamer
+static TextureStreamer glgeTextureStreamer;
+
+/**
+ * @brief get the current frame of a window for the texture streamer
+ * 
+ * @param windowIndex the index of the window
+ * @return uint64_t the amount of streaming updates of the window
+ */
+static uint64_t glgeGetStreamingFrame(int windowIndex)
+{
+    //windows without an update are in frame 0
+    if ((windowIndex < 0) || (windowIndex >= (int)glgeTextureStreamer.frames.size())) { return 0; }
+    //return the frame
+    return glgeTextureStreamer.frames[windowIndex];
+}
+
+/**
+ * @brief unregister a streamed texture and free its levels
+ * 
+ * @param source the mip levels of the texture
+ */
+static void glgeFreeStreamSource(TextureStreamSource* source)
+{
+    //remove the texture from the streamer
+    std::vector<TextureStreamSource*>& sources = glgeTextureStreamer.sources;
+    sources.erase(std::remove(sources.begin(), sources.end(), source), sources.end());
+    //unmap the file if the levels are read from a container
+    if (source->container.mapping) { glgeCloseTextureContainer(&source->container); }
+    //delete the source
+    delete source;
+}
+
+/**
+ * @brief decode the file of a job
+ * 
+ * @param job the job to decode
+ */
+static void glgeDecodeTextureJob(TextureLoadJob* job)
+{
+    //store the amount of chanels in the file
+    int nrChannels;
+    //check if the file should be decoded as floats
+    if (job->flags & GLGE_TEXTURE_LOAD_HDR)
+    {
+        //decode with 4 float chanels
+        job->floats = glgeLoadImageHDR(job->file.c_str(), &job->width, &job->height, &nrChannels, 4);
+    }
+    else
+    {
+        //decode with 4 8-bit chanels
+        job->bytes = glgeLoadImage(job->file.c_str(), &job->width, &job->height, &nrChannels, 4);
+    }
+}
+
+/**
+ * @brief the main function of a worker thread
+ */
+static void glgeTextureLoaderThread()
+{
+    //lock the loader
+    std::unique_lock<std::mutex> lock(glgeTextureLoader.mutex);
+    //run until the loader stops
+    while (true)
+    {
+        //wait for a job
+        glgeTextureLoader.jobAdded.wait(lock, []{ return !glgeTextureLoader.running || !glgeTextureLoader.decodeQueue.empty(); });
+        //check if the thread should stop
+        if (!glgeTextureLoader.running) { return; }
+        //take the next job
+        TextureLoadJob* job = glgeTextureLoader.decodeQueue.front();
+        glgeTextureLoader.decodeQueue.pop_front();
+        //say that the job is decoding
+        job->state = GLGE_TEXTURE_JOB_DECODING;
+
+        //decode without holding the lock
+        lock.unlock();
+        glgeDecodeTextureJob(job);
+        lock.lock();
+
+        //store the result
+        job->state = (job->bytes || job->floats) ? GLGE_TEXTURE_JOB_DECODED : GLGE_TEXTURE_JOB_FAILED;
+        //wake threads waiting for the job
+        glgeTextureLoader.jobDecoded.notify_all();
+    }
+}
+
+/**
+ * @brief free the decoded data and the staging texture of a job
+ * 
+ * @param job the job to clean up
+ */
+static void glgeFreeTextureJob(TextureLoadJob* job)
+{
+    //free the decoded pixels
+    if (job->bytes) { glgeImageFree(job->bytes); }
+    if (job->floats) { glgeImageFree(job->floats); }
+    //delete the staging texture
+    if (job->staging) { glDeleteTextures(1, &job->staging); }
+    //delete the pixel unpack buffer, the driver keeps it alive until the last copy finished
+    if (job->pbo) { glDeleteBuffers(1, &job->pbo); }
+    //delete the job
+    delete job;
+}
+
+/**
+ * @brief upload the next chunk of a decoded job
+ * 
+ * @param job the job to upload
+ * @param chunkSize the maximum amount of bytes to upload or 0 to upload everything
+ * @return true : the texture is completely uploaded | 
+ * @return false : there are rows left to upload
+ */
+static bool glgeUploadTextureChunk(TextureLoadJob* job, unsigned int chunkSize)
+{
+    //get the format of the decoded pixels
+    bool hdr = (job->floats != NULL);
+    //store the size of a row in bytes
+    unsigned int rowSize = job->width * 4 * (hdr ? sizeof(float) : sizeof(uint8_t));
+    //check if the staging texture exists
+    if (!job->staging)
+    {
+        //create the texture the image is uploaded into
+        glGenTextures(1, &job->staging);
+        glBindTexture(GL_TEXTURE_2D, job->staging);
+        //set the texture wrapping/filtering options
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glgeInterpolationMode);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glgeInterpolationMode);
+        //select the format like the synchronous path
+        int internalFormat = hdr ? GL_RGBA16F : ((job->flags & GLGE_TEXTURE_LOAD_SRGB) ? GL_SRGB8_ALPHA8 : GL_RGBA8);
+        //allocate the storage
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, job->width, job->height, 0, GL_RGBA, hdr ? GL_FLOAT : GL_UNSIGNED_BYTE, NULL);
+    }
+
+    //calculate the amount of rows to upload
+    int rows = job->height - job->uploadedRows;
+    //check if the upload is limited
+    if (chunkSize)
+    {
+        //upload at least one row
+        rows = std::min(rows, std::max(1, (int)(chunkSize / rowSize)));
+    }
+    //store the size of the upload
+    unsigned int size = rows * rowSize;
+    //get the first byte to upload
+    const uint8_t* src = (hdr ? (const uint8_t*)job->floats : job->bytes) + (size_t)job->uploadedRows * rowSize;
+
+    //create the pixel unpack buffer of the job on the first chunk, so the copy to the GPU dosn't stall
+    if (!job->pbo) { glGenBuffers(1, &job->pbo); }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, job->pbo);
+    //only allocate new storage if the chunk is larger than every chunk before, the first chunk is the largest one
+    if (size > job->pboSize)
+    {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        job->pboSize = size;
+    }
+    //map the buffer, invalidating it lets the driver use new memory while the last chunk is still copied
+    void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    //check if the buffer could be mapped
+    if (dst)
+    {
+        //copy the rows into the buffer
+        std::memcpy(dst, src, size);
+        //unmap the buffer
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        //bind the staging texture
+        glBindTexture(GL_TEXTURE_2D, job->staging);
+        //start the copy from the buffer to the texture
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, job->uploadedRows, job->width, rows, GL_RGBA, hdr ? GL_FLOAT : GL_UNSIGNED_BYTE, (void*)0);
+    }
+    //unbind the buffer, it is reused for the next chunk
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    //check if the buffer could not be mapped
+    if (!dst)
+    {
+        //upload the rows directly
+        glBindTexture(GL_TEXTURE_2D, job->staging);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, job->uploadedRows, job->width, rows, GL_RGBA, hdr ? GL_FLOAT : GL_UNSIGNED_BYTE, src);
+    }
+
+    //check if debug data gathering is enabled
+    if (glgeGatherDebugInfo)
+    {
+        //add the uploaded bytes
+        glgeBytesPassedToGPUT += size;
+    }
+    //store the uploaded rows
+    job->uploadedRows += rows;
+    //check if all rows are uploaded
+    if (job->uploadedRows < job->height)
+    {
+        //unbind the texture
+        glBindTexture(GL_TEXTURE_2D, 0);
+        //there is more to upload
+        return false;
+    }
+    //make a mipmap
+    glGenerateMipmap(GL_TEXTURE_2D);
+    //unbind the texture
+    glBindTexture(GL_TEXTURE_2D, 0);
+    //the texture is complete
+    return true;
+}
+
+/**
+ * @brief finish a job and remove it from the upload queue, the loader must not be locked
+ * 
+ * @param job the job to finish
+ * @param success say if the texture is completely uploaded
+ */
+static void glgeFinishTextureJob(TextureLoadJob* job, bool success)
+{
+    {
+        //lock the loader
+        std::lock_guard<std::mutex> lock(glgeTextureLoader.mutex);
+        //remove the job from the upload queue
+        glgeTextureLoader.uploadQueue.erase(std::find(glgeTextureLoader.uploadQueue.begin(), glgeTextureLoader.uploadQueue.end(), job));
+    }
+    //the texture is only deleted on the main thread, so it can be read without the lock
+    //check if the texture still exists
+    if (job->texture)
+    {
+        //hand the result to the texture
+        job->texture->completeAsyncLoad(job, success);
+    }
+    //free the job
+    glgeFreeTextureJob(job);
+}
 
 Texture::Texture()
 { /* Default constructor */ }
 
-Texture::Texture(const char* textureFile)
+Texture::Texture(const char* textureFile, unsigned int loadFlags)
 {
+    //check if the file is a container with prebuilt mip levels
+    if (glgeIsTextureContainer(textureFile))
+    {
+        //upload the stored levels
+        this->loadContainer(textureFile, loadFlags);
+        //stop the function
+        return;
+    }
+    //check if the texture should be block compressed, HDR data can't be stored in the supported formats
+    if ((loadFlags & GLGE_TEXTURE_LOAD_COMPRESSION_MASK) && !(loadFlags & GLGE_TEXTURE_LOAD_HDR))
+    {
+        //load the compressed texture
+        this->loadCompressed(textureFile, loadFlags);
+        //stop the function
+        return;
+    }
+    //check if streaming was requested for a texture without stored mip levels
+    if (loadFlags & GLGE_TEXTURE_LOAD_STREAM)
+    {
+        //print a warning if warnings are enabled, the texture is loaded completely
+        if (glgeWarningOutput)
+        {
+            printf("[GLGE WARNING] Only texture containers and block compressed textures can be streamed, loading all levels of %s\n", textureFile);
+        }
+    }
+    //check if the texture should load in the background
+    if (loadFlags & GLGE_TEXTURE_LOAD_ASYNC)
+    {
+        //start the asynchronous load
+        this->startAsyncLoad(textureFile, loadFlags);
+        //stop the function
+        return;
+    }
+
     unsigned int texture;
     glGenTextures(1, &texture);
     glBindTexture(GL_TEXTURE_2D, texture);
@@ -36,55 +468,77 @@ Texture::Texture(const char* textureFile)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glgeInterpolationMode);
 
     // load and generate the texture
-    int width, height, nrChannels;
-    unsigned char *data = glgeLoadImage(textureFile, &width, &height, &nrChannels);
-    //check if the data could be read
-    if (!data)
-    {
-        //if not, throw an error
-        GLGE_THROW_ERROR("Failed to load texture file: " + std::string(textureFile))
-    }
-    //create a new vec4 array
-    this->texData = new vec4[width*height];
-    //check if the new opperation was sucessfull
-    if (!this->texData)
+    int width = 0, height = 0, nrChannels;
+    //check if the image should be loaded as floats
+    if (loadFlags & GLGE_TEXTURE_LOAD_HDR)
     {
-        //throw an error
-        GLGE_THROW_ERROR("Failed to allocate data to store an image");
+        //load the image with 4 float chanels per pixel
+        float* data = glgeLoadImageHDR(textureFile, &width, &height, &nrChannels, 4);
+        //check if the data could be read
+        if (!data)
+        {
+            //if not, throw an error
+            GLGE_THROW_ERROR("Failed to load texture file: " + std::string(textureFile))
+            //stop the function
+            return;
+        }
+        //upload the floats directly, half floats keep the range of HDR data
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, data);
+        //store the encode type
+        this->encodeType = GL_RGBA16F;
+        //check if a copy should be kept in RAM
+        if (loadFlags & GLGE_TEXTURE_LOAD_KEEP_DATA)
+        {
+            //create a new vec4 array
+            this->texData = new vec4[width*height];
+            //the pixels are allready 4 floats, so just copy them
+            std::memcpy((void*)this->texData, data, sizeof(vec4)*width*height);
+        }
+        //free the decoded image
+        glgeImageFree(data);
     }
-    //copy the data into the own data vector
-    for (int x = 0; x < width; x++)
+    else
     {
-        for (int y = 0; y < height; y++)
+        //load the image with 4 8-bit chanels per pixel
+        uint8_t* data = glgeLoadImage(textureFile, &width, &height, &nrChannels, 4);
+        //check if the data could be read
+        if (!data)
+        {
+            //if not, throw an error
+            GLGE_THROW_ERROR("Failed to load texture file: " + std::string(textureFile))
+            //stop the function
+            return;
+        }
+        //select the format, sRGB is decoded to linear by the sampler
+        this->encodeType = (loadFlags & GLGE_TEXTURE_LOAD_SRGB) ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+        //upload the decoded bytes without converting them
+        glTexImage2D(GL_TEXTURE_2D, 0, this->encodeType, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        //check if a copy should be kept in RAM
+        if (loadFlags & GLGE_TEXTURE_LOAD_KEEP_DATA)
         {
-            //create a new array for the vector
-            float v[4];
-            //clear the vector
-            bzero(v, sizeof(float)*4);
-            //fill the vector with data
-            for (int i = 0; i < nrChannels; i++)
+            //create a new vec4 array
+            this->texData = new vec4[width*height];
+            //convert all pixels in memory order
+            for (int i = 0; i < width*height; i++)
             {
-                //store the pixel as an float between 0 and 1
-                v[i] = data[(x*height + y)*nrChannels + i] / 255.f;
+                //store the pixel as floats between 0 and 1
+                this->texData[i] = vec4(data[i*4 + 0] / 255.f, data[i*4 + 1] / 255.f, data[i*4 + 2] / 255.f, data[i*4 + 3] / 255.f);
             }
-            //store the pixel
-            this->texData[x*height + y] = vec4(v[0], v[1], v[2], v[3]);
         }
+        //free the decoded image
+        glgeImageFree(data);
     }
-    //generate mipmap and upload to GPU
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_FLOAT, this->texData);
     //make a mipmap
     glGenerateMipmap(GL_TEXTURE_2D);
-    //store the image number of chanels and encode type
-    this->encodeType = GL_RGBA;
+    //store the image chanels
     this->channels = GL_RGBA;
 
     //store the texture size
     this->size = ivec2(width, height);
-    //clear memory and return the texture
-    glgeImageFree(data);
     //store the texture
     this->texture = texture;
+    //say that the texture belongs to this object
+    this->ownsTexture = true;
     //store the window
     this->windowID = glgeCurrentWindowIndex;
 }
@@ -105,6 +559,8 @@ Texture::Texture(vec2 size, int et, vec4* data)
     glTexImage2D(GL_TEXTURE_2D, 0, this->encodeType, size.x, size.y, 0, this->channels, GL_FLOAT, data);
     //unbind the texture
 	glBindTexture(GL_TEXTURE_2D, 0);
+    //say that the texture belongs to this object
+    this->ownsTexture = true;
     //store the window
     this->windowID = glgeCurrentWindowIndex;
     //store the size
@@ -143,6 +599,8 @@ Texture::Texture(unsigned int width, unsigned int height, int et, vec4* data)
     glTexImage2D(GL_TEXTURE_2D, 0, this->encodeType, width, height, 0, this->channels, GL_FLOAT, data);
     //unbind the texture
 	glBindTexture(GL_TEXTURE_2D, 0);
+    //say that the texture belongs to this object
+    this->ownsTexture = true;
     //store the window
     this->windowID = glgeCurrentWindowIndex;
     //store the size
@@ -175,11 +633,29 @@ Texture::Texture(unsigned int openGLTex, unsigned int encodeType)
 
 Texture::~Texture()
 {
+    //check if the texture is streamed
+    if (this->stream)
+    {
+        //stop streaming and free the levels
+        glgeFreeStreamSource(this->stream);
+    }
+    //check if the texture is still loading
+    if (this->loadJob)
+    {
+        //lock the loader
+        std::lock_guard<std::mutex> lock(glgeTextureLoader.mutex);
+        //say that the texture no longer exists, the loader will free the job
+        this->loadJob->texture = NULL;
+    }
     //check if texture data exists
     if (this->texData)
     {
         //free the data buffer
         delete[] this->texData;
+    }
+    //check if the OpenGL texture was created by this object
+    if (this->ownsTexture)
+    {
         //delete the open gl texture
         glDeleteTextures(1, &this->texture);
     }
@@ -206,10 +682,14 @@ void Texture::resize(vec2 size)
         return;
     }
 
-    //delete the old array
-    delete[]this->texData;
-    //create a new array
-    this->texData = new vec4[(int)(size.x*size.y)];
+    //check if a copy of the texture is kept in RAM
+    if (this->texData)
+    {
+        //delete the old array
+        delete[]this->texData;
+        //create a new array
+        this->texData = new vec4[(int)(size.x*size.y)];
+    }
     //bind the texture
     this->bind(0);
     //update the size
@@ -371,6 +851,12 @@ unsigned int Texture::indexInTexture(int x, int y)
 
 void Texture::readbackTexture()
 {
+    //check if the texture has a copy in RAM
+    if (!this->texData)
+    {
+        //create the copy, it is kept from now on
+        this->texData = new vec4[this->size.x*this->size.y];
+    }
     //make sure to unbind the texture
     this->unbind();
     //bind the texture
@@ -384,6 +870,14 @@ void Texture::readbackTexture()
 
 void Texture::writeTexture()
 {
+    //check if the texture has a copy in RAM
+    if (!this->texData)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Can't write a texture that has no data in RAM, load it with GLGE_TEXTURE_LOAD_KEEP_DATA or read it back first")
+        //stop the function
+        return;
+    }
     //unbind the texture
     this->unbind();
     //bind the texture
@@ -404,12 +898,16 @@ void Texture::storeImage(const char* file, unsigned int format, bool readback)
         this->readbackTexture();
     }
 
-    //convert the texture data to image data
-    uint8_t* imgData = glgeTextureDataToImageData(this->size, this->texData);
-    //call the image store function
-    glgeStoreImage(file, this->size, imgData, format);
-    //free the image data
-    delete[] imgData;
+    //check if texture data exists
+    if (!this->texData)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Can't store a texture that has no data in RAM, load it with GLGE_TEXTURE_LOAD_KEEP_DATA or read it back first")
+        //stop the function
+        return;
+    }
+    //call the image store function, the pixels are converted while they are written
+    glgeStoreImage(file, this->size, this->texData, format);
 }
 
 void Texture::setData(vec4* data)
@@ -555,6 +1053,8 @@ void Texture::decode(int encodeType)
 
 uint64_t Texture::getHandler()
 {
+    //a handle can't be created for the placeholder, so finish loading first
+    this->finishLoading();
     //check if the handler exists
     if (this->handler == 0)
     {
@@ -565,4 +1065,985 @@ uint64_t Texture::getHandler()
     }
     //return the handler
     return this->handler;
-}
\ No newline at end of file
+}
+
+unsigned int Texture::getCompressionFormat()
+{
+    //return the block compression format
+    return this->compression;
+}
+
+float Texture::getCompressionPSNR()
+{
+    //return the quality of the compression
+    return this->compressionPSNR;
+}
+
+bool Texture::isStreamed()
+{
+    //the texture is streamed if it has a source for its levels
+    return this->stream != NULL;
+}
+
+void Texture::requestDetail(float uvPerPixel)
+{
+    //only streamed textures use the request
+    if (!this->stream) { return; }
+    //get how many texels of the first level cover one pixel
+    float texels = uvPerPixel * (float)std::max(this->size.x, this->size.y);
+    //every coarser level halves the texels per pixel
+    int level = (texels > 1.f) ? (int)std::floor(std::log2(texels)) : 0;
+    //the coarse levels are always on the GPU
+    level = std::min(level, this->stream->minimalLevel);
+    //get the current frame
+    uint64_t frame = glgeGetStreamingFrame(this->stream->windowID);
+    //check if this is the first request in this frame
+    if (this->stream->requestFrame != frame)
+    {
+        //store the request
+        this->stream->requestFrame = frame;
+        this->stream->requestLevel = level;
+    }
+    else
+    {
+        //the finest request of the frame is used
+        this->stream->requestLevel = std::min(this->stream->requestLevel, level);
+    }
+}
+
+int Texture::getResidentMipLevel()
+{
+    //return the finest level on the GPU
+    return this->stream ? this->stream->residentLevel : 0;
+}
+
+int Texture::getRequestedMipLevel()
+{
+    //return the finest requested level
+    return this->stream ? this->stream->requestLevel : 0;
+}
+
+void Texture::setResidentMipLevel(int level)
+{
+    //only streamed textures can change their levels
+    if (!this->stream) { return; }
+    //store the source
+    TextureStreamSource* source = this->stream;
+    //the coarse levels are always on the GPU
+    level = std::max(0, std::min(level, source->minimalLevel));
+    //stop if nothing changes
+    if (level == source->residentLevel) { return; }
+
+    //create a texture that only stores the requested levels, the requested level is its first level
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    //set the texture wrapping/filtering options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glgeInterpolationMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glgeInterpolationMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, source->levels - 1 - level);
+    //the rows of the stored images are tightly packed
+    int alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    //store the bytes on the GPU
+    uint64_t bytes = 0;
+    uint64_t uploaded = 0;
+    for (int l = level; l < source->levels; l++)
+    {
+        //get the size of the level
+        int w = std::max(1, source->width >> l), h = std::max(1, source->height >> l);
+        const TextureContainerImage& img = source->images[l];
+        bytes += img.size;
+        //check if the level is allready on the GPU
+        if (l >= source->residentLevel)
+        {
+            //allocate the level without data
+            if (source->blockCompressed) { glCompressedTexImage2D(GL_TEXTURE_2D, l - level, source->internalFormat, w, h, 0, (int)img.size, NULL); }
+            else { glTexImage2D(GL_TEXTURE_2D, l - level, source->internalFormat, w, h, 0, source->pixelFormat, source->type, NULL); }
+            //copy the level on the GPU
+            glCopyImageSubData(this->texture, GL_TEXTURE_2D, l - source->residentLevel, 0, 0, 0, texture, GL_TEXTURE_2D, l - level, 0, 0, 0, w, h, 1);
+        }
+        else
+        {
+            //upload the level from RAM
+            if (source->blockCompressed) { glCompressedTexImage2D(GL_TEXTURE_2D, l - level, source->internalFormat, w, h, 0, (int)img.size, img.data); }
+            else { glTexImage2D(GL_TEXTURE_2D, l - level, source->internalFormat, w, h, 0, source->pixelFormat, source->type, img.data); }
+            uploaded += img.size;
+        }
+    }
+    //restore the alignment
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+    //unbind the texture
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    //check if a handler exists for the old texture
+    if (this->handler)
+    {
+        //the handler can't be used anymore
+        glMakeTextureHandleNonResidentARB(this->handler);
+        this->handler = 0;
+    }
+    //delete the old texture
+    if (this->texture) { glDeleteTextures(1, &this->texture); }
+    //use the new texture
+    this->texture = texture;
+    //update the statistics
+    glgeTextureStreamer.stats.uploadedBytes += uploaded;
+    if (bytes < source->residentBytes) { glgeTextureStreamer.stats.evictedBytes += source->residentBytes - bytes; }
+    //store the new levels
+    source->residentLevel = level;
+    source->residentBytes = bytes;
+    //check if the texture is bound
+    if (this->binding != -1)
+    {
+        //rebind the texture, so the new texture is used
+        this->bind(this->binding, this->unit, true);
+    }
+}
+
+bool Texture::isResident()
+{
+    //the texture is resident if it isn't loading and didn't fail
+    return (!this->loadJob) && (!this->loadFailed);
+}
+
+bool Texture::hasLoadFailed()
+{
+    //return if the load failed
+    return this->loadFailed;
+}
+
+void Texture::setLoadCallback(void (*callback)(Texture*, bool))
+{
+    //store the callback
+    this->loadCallback = callback;
+}
+
+void Texture::finishLoading()
+{
+    //check if the texture is loading
+    if (!this->loadJob) { return; }
+    //store the job
+    TextureLoadJob* job = this->loadJob;
+    //lock the loader
+    std::unique_lock<std::mutex> lock(glgeTextureLoader.mutex);
+    //search the job in the decode queue
+    std::deque<TextureLoadJob*>::iterator it = std::find(glgeTextureLoader.decodeQueue.begin(), glgeTextureLoader.decodeQueue.end(), job);
+    //check if no worker thread started the job yet
+    if (it != glgeTextureLoader.decodeQueue.end())
+    {
+        //take the job
+        glgeTextureLoader.decodeQueue.erase(it);
+        //decode the file on this thread
+        job->state = GLGE_TEXTURE_JOB_DECODING;
+        lock.unlock();
+        glgeDecodeTextureJob(job);
+        lock.lock();
+        //store the result
+        job->state = (job->bytes || job->floats) ? GLGE_TEXTURE_JOB_DECODED : GLGE_TEXTURE_JOB_FAILED;
+    }
+    else
+    {
+        //wait until a worker thread decoded the job
+        glgeTextureLoader.jobDecoded.wait(lock, [job]{ return job->state >= GLGE_TEXTURE_JOB_DECODED; });
+    }
+    //no worker thread uses the job anymore
+    lock.unlock();
+    //check if the job failed
+    if (job->state == GLGE_TEXTURE_JOB_FAILED)
+    {
+        //finish the job without a texture
+        glgeFinishTextureJob(job, false);
+        return;
+    }
+    //upload the rest of the texture at once
+    glgeUploadTextureChunk(job, 0);
+    //finish the job
+    glgeFinishTextureJob(job, true);
+}
+
+void Texture::completeAsyncLoad(TextureLoadJob* job, bool success)
+{
+    //say that the texture is no longer loading
+    this->loadJob = NULL;
+    //check if the load failed
+    if (!success)
+    {
+        //store that the load failed
+        this->loadFailed = true;
+        //throw an error
+        GLGE_THROW_ERROR("Failed to load texture file: " + job->file)
+    }
+    else
+    {
+        //delete the placeholder
+        glDeleteTextures(1, &this->texture);
+        //take the staging texture
+        this->texture = job->staging;
+        //say that the job no longer owns the staging texture
+        job->staging = 0;
+        //store the size
+        this->size = ivec2(job->width, job->height);
+        //store the format
+        this->encodeType = job->floats ? GL_RGBA16F : ((job->flags & GLGE_TEXTURE_LOAD_SRGB) ? GL_SRGB8_ALPHA8 : GL_RGBA8);
+        //check if a copy should be kept in RAM
+        if (job->flags & GLGE_TEXTURE_LOAD_KEEP_DATA)
+        {
+            //create a new vec4 array
+            this->texData = new vec4[job->width*job->height];
+            //check if the pixels are floats
+            if (job->floats)
+            {
+                //the pixels are allready 4 floats, so just copy them
+                std::memcpy((void*)this->texData, job->floats, sizeof(vec4)*job->width*job->height);
+            }
+            else
+            {
+                //convert all pixels in memory order
+                for (int i = 0; i < job->width*job->height; i++)
+                {
+                    //store the pixel as floats between 0 and 1
+                    this->texData[i] = vec4(job->bytes[i*4 + 0] / 255.f, job->bytes[i*4 + 1] / 255.f, job->bytes[i*4 + 2] / 255.f, job->bytes[i*4 + 3] / 255.f);
+                }
+            }
+        }
+        //check if the texture is bound
+        if (this->binding != -1)
+        {
+            //rebind the texture, so the new texture is used
+            this->bind(this->binding, this->unit, true);
+        }
+    }
+    //check if a callback exists
+    if (this->loadCallback)
+    {
+        //call the callback
+        (*this->loadCallback)(this, success);
+    }
+}
+
+void Texture::startAsyncLoad(const char* textureFile, unsigned int loadFlags)
+{
+    //create the placeholder texture
+    glGenTextures(1, &this->texture);
+    glBindTexture(GL_TEXTURE_2D, this->texture);
+    //set the texture wrapping/filtering options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    //the placeholder is a single white pixel, so it dosn't tint the object
+    uint8_t white[4] = {255, 255, 255, 255};
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    //unbind the texture
+    glBindTexture(GL_TEXTURE_2D, 0);
+    //store the placeholder format
+    this->encodeType = GL_RGBA8;
+    this->channels = GL_RGBA;
+    this->size = ivec2(1,1);
+    //say that the texture belongs to this object
+    this->ownsTexture = true;
+    //store the window
+    this->windowID = glgeCurrentWindowIndex;
+
+    //create the job
+    this->loadJob = new TextureLoadJob();
+    this->loadJob->texture = this;
+    this->loadJob->file = std::string(textureFile);
+    this->loadJob->flags = loadFlags;
+    this->loadJob->windowID = glgeCurrentWindowIndex;
+
+    {
+        //lock the loader
+        std::lock_guard<std::mutex> lock(glgeTextureLoader.mutex);
+        //check if the worker threads exist
+        if (glgeTextureLoader.threads.empty())
+        {
+            //use all cores except the one of the main thread
+            int count = std::max(1, std::min((int)std::thread::hardware_concurrency() - 1, GLGE_TEXTURE_MAX_LOADER_THREADS));
+            //start the threads
+            for (int i = 0; i < count; i++)
+            {
+                //create a worker thread
+                glgeTextureLoader.threads.push_back(std::thread(glgeTextureLoaderThread));
+            }
+        }
+        //queue the job for decoding
+        glgeTextureLoader.decodeQueue.push_back(this->loadJob);
+        //queue the job for the upload
+        glgeTextureLoader.uploadQueue.push_back(this->loadJob);
+    }
+    //wake a worker thread
+    glgeTextureLoader.jobAdded.notify_one();
+}
+
+void Texture::loadCompressed(const char* textureFile, unsigned int loadFlags)
+{
+    //get the format from the flags
+    unsigned int format = (loadFlags & GLGE_TEXTURE_LOAD_COMPRESSION_MASK) >> 4;
+    //check if the format exists
+    if (glgeGetBlockSize(format) == 0)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Unknown texture compression format in the load flags of " + std::string(textureFile))
+        //stop the function
+        return;
+    }
+    //try to use the cached data
+    CompressedImage image;
+    if (!glgeLoadCompressedCache(textureFile, format, glgeTextureCompressionPreset, &image))
+    {
+        //load the image with 4 8-bit chanels per pixel
+        int width = 0, height = 0, nrChannels;
+        uint8_t* data = glgeLoadImage(textureFile, &width, &height, &nrChannels, 4);
+        //check if the data could be read
+        if (!data)
+        {
+            //if not, throw an error
+            GLGE_THROW_ERROR("Failed to load texture file: " + std::string(textureFile))
+            //stop the function
+            return;
+        }
+        //compress the image with all mip levels
+        image = glgeCompressImage(data, width, height, format, glgeTextureCompressionPreset, true);
+        //free the decoded image
+        glgeImageFree(data);
+        //stop if the compression failed
+        if (image.levels.empty()) { return; }
+        //store the cache for the next load
+        if (!glgeStoreCompressedCache(textureFile, glgeTextureCompressionPreset, image))
+        {
+            //print a warning if warnings are enabled, the texture still works
+            if (glgeWarningOutput)
+            {
+                printf("[GLGE WARNING] Failed to write the compressed texture cache %s\n", glgeGetCompressedCachePath(textureFile).c_str());
+            }
+        }
+    }
+    //check if the quality should be printed
+    if (glgeTextureCompressionReport)
+    {
+        //print the PSNR of the texture
+        printf("[GLGE] Compressed texture %s as %s: %.2f dB PSNR\n", textureFile, glgeGetBlockCompressionName(format), image.psnr);
+    }
+
+    //select the OpenGL format
+    bool srgb = loadFlags & GLGE_TEXTURE_LOAD_SRGB;
+    GLenum glFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+    switch (format)
+    {
+    case GLGE_BC1:
+        glFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        break;
+    case GLGE_BC3:
+        glFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        break;
+    case GLGE_BC4:
+        glFormat = GL_COMPRESSED_RED_RGTC1;
+        break;
+    case GLGE_BC5:
+        glFormat = GL_COMPRESSED_RG_RGTC2;
+        break;
+    default:
+        glFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        break;
+    }
+
+    //check if a copy should be kept in RAM
+    if (loadFlags & GLGE_TEXTURE_LOAD_KEEP_DATA)
+    {
+        //decompress the first level
+        std::vector<uint8_t> rgba((size_t)image.width*image.height*4);
+        glgeDecompressBlocks(image.levels[0].data(), image.width, image.height, format, rgba.data());
+        //create a new vec4 array
+        this->texData = new vec4[image.width*image.height];
+        //convert all pixels in memory order
+        for (int i = 0; i < image.width*image.height; i++)
+        {
+            //store the pixel as floats between 0 and 1
+            this->texData[i] = vec4(rgba[i*4 + 0] / 255.f, rgba[i*4 + 1] / 255.f, rgba[i*4 + 2] / 255.f, rgba[i*4 + 3] / 255.f);
+        }
+    }
+
+    //store the compression
+    this->compression = format;
+    this->compressionPSNR = image.psnr;
+    //check if the levels should be streamed
+    if (loadFlags & GLGE_TEXTURE_LOAD_STREAM)
+    {
+        //create the source of the levels
+        TextureStreamSource* source = new TextureStreamSource();
+        source->internalFormat = glFormat;
+        source->blockCompressed = true;
+        source->width = image.width;
+        source->height = image.height;
+        source->compressed = std::move(image);
+        //point to the compressed levels
+        for (size_t i = 0; i < source->compressed.levels.size(); i++)
+        {
+            TextureContainerImage img;
+            img.data = source->compressed.levels[i].data();
+            img.size = source->compressed.levels[i].size();
+            source->images.push_back(img);
+        }
+        //store the encode type
+        this->encodeType = glFormat;
+        //store the image chanels
+        this->channels = GL_RGBA;
+        //upload the coarse levels
+        this->startStreaming(source);
+        //stop the function
+        return;
+    }
+
+    //create the texture
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    // set the texture wrapping/filtering options (on the currently bound texture object)
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glgeInterpolationMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glgeInterpolationMode);
+    //say how many mip levels exist, the mip chain is stored compressed
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (int)image.levels.size() - 1);
+    //upload all levels without decompressing them
+    int w = image.width, h = image.height;
+    for (size_t i = 0; i < image.levels.size(); i++)
+    {
+        glCompressedTexImage2D(GL_TEXTURE_2D, (int)i, glFormat, w, h, 0, (int)image.levels[i].size(), image.levels[i].data());
+        //get the size of the next level
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+
+    //store the encode type
+    this->encodeType = glFormat;
+    //store the image chanels
+    this->channels = GL_RGBA;
+    //store the texture size
+    this->size = ivec2(image.width, image.height);
+    //store the texture
+    this->texture = texture;
+    //say that the texture belongs to this object
+    this->ownsTexture = true;
+    //store the window
+    this->windowID = glgeCurrentWindowIndex;
+}
+
+void Texture::startStreaming(TextureStreamSource* source)
+{
+    //store the texture the levels belong to
+    source->texture = this;
+    source->levels = (int)source->images.size();
+    source->windowID = glgeCurrentWindowIndex;
+    //search the first level that is small enough to always stay on the GPU
+    source->minimalLevel = source->levels - 1;
+    for (int l = 0; l < source->levels; l++)
+    {
+        //check the bigger side of the level
+        if (std::max(source->width >> l, source->height >> l) <= GLGE_TEXTURE_STREAM_MIN_SIZE)
+        {
+            //use the level
+            source->minimalLevel = l;
+            break;
+        }
+    }
+    //sum up the size of all levels
+    for (const TextureContainerImage& img : source->images) { source->fullBytes += img.size; }
+    //nothing is on the GPU yet
+    source->residentLevel = source->levels;
+    source->requestLevel = source->minimalLevel;
+    source->wantedLevel = source->minimalLevel;
+
+    //store the source
+    this->stream = source;
+    //store the full texture size, the size dosn't change with the levels on the GPU
+    this->size = ivec2(source->width, source->height);
+    //say that the texture belongs to this object
+    this->ownsTexture = true;
+    //store the window
+    this->windowID = glgeCurrentWindowIndex;
+    //upload the coarse levels
+    this->setResidentMipLevel(source->minimalLevel);
+    //register the texture
+    glgeTextureStreamer.sources.push_back(source);
+}
+
+/**
+ * @brief get the OpenGL formats for a container format
+ * 
+ * @param format the container format
+ * @param srgb say if linear 8 bit and BC formats should use their sRGB variant
+ * @param internalFormat the internal format of the texture
+ * @param pixelFormat the format of the pixel data, only used for uncompressed formats
+ * @param type the type of the pixel data, only used for uncompressed formats
+ * @return true : the format is block compressed | false : the format is uncompressed
+ */
+static bool glgeGetContainerGLFormat(unsigned int format, bool srgb, GLenum* internalFormat, GLenum* pixelFormat, GLenum* type)
+{
+    //default to unsigned bytes
+    *pixelFormat = GL_RGBA;
+    *type = GL_UNSIGNED_BYTE;
+    switch (format)
+    {
+    case GLGE_CONTAINER_FORMAT_R8: *internalFormat = GL_R8; *pixelFormat = GL_RED; return false;
+    case GLGE_CONTAINER_FORMAT_RG8: *internalFormat = GL_RG8; *pixelFormat = GL_RG; return false;
+    case GLGE_CONTAINER_FORMAT_RGBA8: *internalFormat = srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8; return false;
+    case GLGE_CONTAINER_FORMAT_RGBA8_SRGB: *internalFormat = GL_SRGB8_ALPHA8; return false;
+    case GLGE_CONTAINER_FORMAT_BGRA8: *internalFormat = srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8; *pixelFormat = GL_BGRA; return false;
+    case GLGE_CONTAINER_FORMAT_BGRA8_SRGB: *internalFormat = GL_SRGB8_ALPHA8; *pixelFormat = GL_BGRA; return false;
+    case GLGE_CONTAINER_FORMAT_R16F: *internalFormat = GL_R16F; *pixelFormat = GL_RED; *type = GL_HALF_FLOAT; return false;
+    case GLGE_CONTAINER_FORMAT_RG16F: *internalFormat = GL_RG16F; *pixelFormat = GL_RG; *type = GL_HALF_FLOAT; return false;
+    case GLGE_CONTAINER_FORMAT_RGBA16F: *internalFormat = GL_RGBA16F; *type = GL_HALF_FLOAT; return false;
+    case GLGE_CONTAINER_FORMAT_R32F: *internalFormat = GL_R32F; *pixelFormat = GL_RED; *type = GL_FLOAT; return false;
+    case GLGE_CONTAINER_FORMAT_RG32F: *internalFormat = GL_RG32F; *pixelFormat = GL_RG; *type = GL_FLOAT; return false;
+    case GLGE_CONTAINER_FORMAT_RGBA32F: *internalFormat = GL_RGBA32F; *type = GL_FLOAT; return false;
+    case GLGE_CONTAINER_FORMAT_BC1: *internalFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; return true;
+    case GLGE_CONTAINER_FORMAT_BC1_SRGB: *internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT; return true;
+    case GLGE_CONTAINER_FORMAT_BC2: *internalFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT : GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; return true;
+    case GLGE_CONTAINER_FORMAT_BC2_SRGB: *internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT; return true;
+    case GLGE_CONTAINER_FORMAT_BC3: *internalFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; return true;
+    case GLGE_CONTAINER_FORMAT_BC3_SRGB: *internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT; return true;
+    case GLGE_CONTAINER_FORMAT_BC4: *internalFormat = GL_COMPRESSED_RED_RGTC1; return true;
+    case GLGE_CONTAINER_FORMAT_BC5: *internalFormat = GL_COMPRESSED_RG_RGTC2; return true;
+    case GLGE_CONTAINER_FORMAT_BC6H_UF: *internalFormat = GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT; return true;
+    case GLGE_CONTAINER_FORMAT_BC6H_SF: *internalFormat = GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT; return true;
+    case GLGE_CONTAINER_FORMAT_BC7: *internalFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM; return true;
+    case GLGE_CONTAINER_FORMAT_BC7_SRGB:
+    default: *internalFormat = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM; return true;
+    }
+}
+
+void Texture::loadContainer(const char* textureFile, unsigned int loadFlags)
+{
+    //check if the levels should be streamed
+    if (loadFlags & GLGE_TEXTURE_LOAD_STREAM)
+    {
+        //map the file and read the location of all images
+        TextureStreamSource* source = new TextureStreamSource();
+        if (!glgeOpenTextureContainer(textureFile, &source->container))
+        {
+            //free the source
+            delete source;
+            //throw an error
+            GLGE_THROW_ERROR("Failed to load texture container (missing, invalid or unsupported format): " + std::string(textureFile))
+            //stop the function
+            return;
+        }
+        //only single 2D images with stored levels can be streamed, the copy in RAM needs the full level on the GPU
+        const TextureContainer& container = source->container;
+        if ((container.layers == 0) && (container.faces == 1) && (!container.generateMipmaps) && (container.levels > 1) && !(loadFlags & GLGE_TEXTURE_LOAD_KEEP_DATA))
+        {
+            //get the OpenGL formats
+            source->blockCompressed = glgeGetContainerGLFormat(container.format, loadFlags & GLGE_TEXTURE_LOAD_SRGB, &source->internalFormat, &source->pixelFormat, &source->type);
+            source->width = container.width;
+            source->height = container.height;
+            //the images point into the mapped file
+            source->images = container.images;
+            //store the encode type
+            this->encodeType = source->internalFormat;
+            //store the image chanels
+            this->channels = GL_RGBA;
+            //upload the coarse levels
+            this->startStreaming(source);
+            //stop the function
+            return;
+        }
+        //print a warning if warnings are enabled, the texture is loaded completely
+        if (glgeWarningOutput)
+        {
+            printf("[GLGE WARNING] The texture container %s can't be streamed (only 2D images with stored mip levels and without a copy in RAM), loading all levels\n", textureFile);
+        }
+        //unmap the file
+        glgeCloseTextureContainer(&source->container);
+        delete source;
+    }
+    //load the file into a new texture
+    unsigned int target = 0, internalFormat = 0;
+    ivec2 texSize = ivec2(0,0);
+    unsigned int texture = glgeLoadTextureContainer(textureFile, loadFlags, &target, &texSize, &internalFormat);
+    //stop if the file could not be loaded, the error was allready thrown
+    if (!texture) { return; }
+    //this class can only store 2D textures
+    if (target != GL_TEXTURE_2D)
+    {
+        //delete the texture
+        glDeleteTextures(1, &texture);
+        //throw an error
+        GLGE_THROW_ERROR("The texture container " + std::string(textureFile) + " stores an array or a cube map, use glgeLoadTextureContainer or load it as a skybox")
+        //stop the function
+        return;
+    }
+    //store the encode type
+    this->encodeType = internalFormat;
+    //store the image chanels
+    this->channels = GL_RGBA;
+    //store the texture size
+    this->size = texSize;
+    //store the texture
+    this->texture = texture;
+    //say that the texture belongs to this object
+    this->ownsTexture = true;
+    //store the window
+    this->windowID = glgeCurrentWindowIndex;
+    //check if a copy should be kept in RAM
+    if (loadFlags & GLGE_TEXTURE_LOAD_KEEP_DATA)
+    {
+        //the driver decodes the first level for the copy
+        this->readbackTexture();
+    }
+}
+
+unsigned int glgeLoadTextureContainer(const char* file, unsigned int loadFlags, unsigned int* target, ivec2* size, unsigned int* internalFormat)
+{
+    //map the file and read the location of all images
+    TextureContainer container;
+    if (!glgeOpenTextureContainer(file, &container))
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Failed to load texture container (missing, invalid or unsupported format): " + std::string(file))
+        //stop the function
+        return 0;
+    }
+    //get the OpenGL formats
+    GLenum glInternal, glPixelFormat, glType;
+    bool compressed = glgeGetContainerGLFormat(container.format, loadFlags & GLGE_TEXTURE_LOAD_SRGB, &glInternal, &glPixelFormat, &glType);
+    //select the target from the layers and faces
+    GLenum glTarget = GL_TEXTURE_2D;
+    if (container.faces == 6) { glTarget = container.layers ? GL_TEXTURE_CUBE_MAP_ARRAY : GL_TEXTURE_CUBE_MAP; }
+    else if (container.layers) { glTarget = GL_TEXTURE_2D_ARRAY; }
+
+    //create the texture
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(glTarget, texture);
+    //the rows of the stored images are tightly packed
+    int alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    //upload all levels
+    int layers = std::max(1, container.layers);
+    for (int l = 0; l < container.levels; l++)
+    {
+        //get the size of the level
+        int w = std::max(1, container.width >> l), h = std::max(1, container.height >> l);
+        if ((glTarget == GL_TEXTURE_2D) || (glTarget == GL_TEXTURE_CUBE_MAP))
+        {
+            //upload every face on its own, 2D textures only have one face
+            for (int f = 0; f < container.faces; f++)
+            {
+                //get the image and the target of the face
+                const TextureContainerImage& img = container.getImage(l, 0, f);
+                GLenum faceTarget = (glTarget == GL_TEXTURE_CUBE_MAP) ? (GLenum)(GL_TEXTURE_CUBE_MAP_POSITIVE_X + f) : GL_TEXTURE_2D;
+                //upload the mapped data directly
+                if (compressed) { glCompressedTexImage2D(faceTarget, l, glInternal, w, h, 0, (int)img.size, img.data); }
+                else { glTexImage2D(faceTarget, l, glInternal, w, h, 0, glPixelFormat, glType, img.data); }
+            }
+        }
+        else
+        {
+            //allocate the level for all layers, the layers of a cube map array are layer-faces
+            int depth = layers * container.faces;
+            uint64_t levelSize = container.getImage(l).size * depth;
+            if (compressed) { glCompressedTexImage3D(glTarget, l, glInternal, w, h, depth, 0, (int)levelSize, NULL); }
+            else { glTexImage3D(glTarget, l, glInternal, w, h, depth, 0, glPixelFormat, glType, NULL); }
+            //upload every layer and face
+            for (int layer = 0; layer < layers; layer++)
+            {
+                for (int f = 0; f < container.faces; f++)
+                {
+                    const TextureContainerImage& img = container.getImage(l, layer, f);
+                    int z = layer*container.faces + f;
+                    if (compressed) { glCompressedTexSubImage3D(glTarget, l, 0, 0, z, w, h, 1, glInternal, (int)img.size, img.data); }
+                    else { glTexSubImage3D(glTarget, l, 0, 0, z, w, h, 1, glPixelFormat, glType, img.data); }
+                }
+            }
+        }
+    }
+    //restore the alignment
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+    //set the sampling parameters, cube maps should not wrap
+    GLenum wrap = ((glTarget == GL_TEXTURE_CUBE_MAP) || (glTarget == GL_TEXTURE_CUBE_MAP_ARRAY)) ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+    glTexParameteri(glTarget, GL_TEXTURE_WRAP_S, wrap);
+    glTexParameteri(glTarget, GL_TEXTURE_WRAP_T, wrap);
+    glTexParameteri(glTarget, GL_TEXTURE_WRAP_R, wrap);
+    glTexParameteri(glTarget, GL_TEXTURE_MIN_FILTER, glgeInterpolationMode);
+    glTexParameteri(glTarget, GL_TEXTURE_MAG_FILTER, glgeInterpolationMode);
+    //only the stored levels exist
+    glTexParameteri(glTarget, GL_TEXTURE_BASE_LEVEL, 0);
+    if (container.generateMipmaps)
+    {
+        //the file asks for generated levels, this only works for uncompressed formats
+        if (!compressed) { glGenerateMipmap(glTarget); }
+        else { glTexParameteri(glTarget, GL_TEXTURE_MAX_LEVEL, 0); }
+    }
+    else
+    {
+        glTexParameteri(glTarget, GL_TEXTURE_MAX_LEVEL, container.levels - 1);
+    }
+    //unbind the texture
+    glBindTexture(glTarget, 0);
+
+    //store the outputs
+    if (target) { *target = glTarget; }
+    if (size) { *size = ivec2(container.width, container.height); }
+    if (internalFormat) { *internalFormat = glInternal; }
+    //unmap the file
+    glgeCloseTextureContainer(&container);
+    //return the texture
+    return texture;
+}
+
+void glgeUploadLoadedTextures(int windowIndex)
+{
+    //store the start of the upload
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    //get the budget
+    float budget = glgeGetTextureUploadBudget();
+    //upload until the budget is used
+    while (true)
+    {
+        //search the first job of this window that finished decoding
+        TextureLoadJob* job = NULL;
+        {
+            //lock the loader
+            std::lock_guard<std::mutex> lock(glgeTextureLoader.mutex);
+            //loop over all jobs
+            for (TextureLoadJob* j : glgeTextureLoader.uploadQueue)
+            {
+                //check if the job belongs to the window and is decoded
+                if ((j->windowID == windowIndex) && (j->state >= GLGE_TEXTURE_JOB_DECODED))
+                {
+                    //use the job
+                    job = j;
+                    break;
+                }
+            }
+        }
+        //stop if nothing is left to upload
+        if (!job) { return; }
+
+        //check if the job failed or the texture was deleted
+        if ((job->state == GLGE_TEXTURE_JOB_FAILED) || (!job->texture))
+        {
+            //finish the job without a texture
+            glgeFinishTextureJob(job, false);
+        }
+        //upload the next chunk
+        else if (glgeUploadTextureChunk(job, GLGE_TEXTURE_UPLOAD_CHUNK_SIZE))
+        {
+            //the texture is complete
+            glgeFinishTextureJob(job, true);
+        }
+
+        //check if the budget is used
+        if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budget)
+        {
+            //continue next frame
+            return;
+        }
+    }
+}
+
+void glgeSetTextureUploadBudget(float milliseconds)
+{
+    //lock the loader
+    std::lock_guard<std::mutex> lock(glgeTextureLoader.mutex);
+    //store the budget
+    glgeTextureLoader.uploadBudget = milliseconds;
+}
+
+float glgeGetTextureUploadBudget()
+{
+    //lock the loader
+    std::lock_guard<std::mutex> lock(glgeTextureLoader.mutex);
+    //return the budget
+    return glgeTextureLoader.uploadBudget;
+}
+
+int glgeGetLoadingTextureCount()
+{
+    //lock the loader
+    std::lock_guard<std::mutex> lock(glgeTextureLoader.mutex);
+    //return the amount of unfinished jobs
+    return (int)glgeTextureLoader.uploadQueue.size();
+}
+
+void glgeSetTextureCompressionPreset(unsigned int preset)
+{
+    //check if the preset exists
+    if (preset > GLGE_BC_PRESET_HIGH)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Invalid texture compression preset " + std::to_string(preset))
+        //stop the function
+        return;
+    }
+    //store the preset
+    glgeTextureCompressionPreset = preset;
+}
+
+unsigned int glgeGetTextureCompressionPreset()
+{
+    //return the preset
+    return glgeTextureCompressionPreset;
+}
+
+void glgeSetTextureCompressionReport(bool report)
+{
+    //store if the quality is printed
+    glgeTextureCompressionReport = report;
+}
+
+bool glgeGetTextureCompressionReport()
+{
+    //return if the quality is printed
+    return glgeTextureCompressionReport;
+}
+
+/**
+ * @brief evict levels of textures until the budget has space for new levels
+ * 
+ * @param candidates the textures with more levels on the GPU than wanted, sorted by priority
+ * @param next the index of the next candidate
+ * @param resident the bytes on the GPU
+ * @param needed the bytes that should be uploaded
+ * @return true : the levels fit into the budget | 
+ * @return false : the budget is to small
+ */
+static bool glgeEvictStreamedLevels(std::vector<TextureStreamSource*>& candidates, size_t& next, uint64_t& resident, uint64_t needed)
+{
+    //evict until the levels fit
+    while ((resident + needed > glgeTextureStreamer.budget) && (next < candidates.size()))
+    {
+        //drop the levels of the candidate that are not wanted
+        TextureStreamSource* source = candidates[next++];
+        uint64_t before = source->residentBytes;
+        source->texture->setResidentMipLevel(source->wantedLevel);
+        resident -= before - source->residentBytes;
+    }
+    //return if the levels fit
+    return resident + needed <= glgeTextureStreamer.budget;
+}
+
+void glgeUpdateTextureStreaming(int windowIndex)
+{
+    //stop if nothing is streamed
+    if (glgeTextureStreamer.sources.empty()) { return; }
+    //count the frame of the window
+    if (windowIndex >= (int)glgeTextureStreamer.frames.size()) { glgeTextureStreamer.frames.resize(windowIndex+1, 0); }
+    uint64_t frame = ++glgeTextureStreamer.frames[windowIndex];
+    //reset the statistics of the update
+    glgeTextureStreamer.stats.uploadedBytes = 0;
+    glgeTextureStreamer.stats.evictedBytes = 0;
+    glgeTextureStreamer.stats.budgetLimited = false;
+
+    //sort the textures of the window by the levels they want
+    uint64_t resident = 0;
+    std::vector<TextureStreamSource*> missing;
+    std::vector<TextureStreamSource*> surplus;
+    for (TextureStreamSource* source : glgeTextureStreamer.sources)
+    {
+        //all textures count towards the budget
+        resident += source->residentBytes;
+        //only the textures of the window can be changed, because its context is current
+        if (source->windowID != windowIndex) { continue; }
+        //keep the requested level for a few frames, so levels are not evicted while the texture is briefly hidden
+        source->wantedLevel = ((frame - source->requestFrame) <= GLGE_TEXTURE_STREAM_KEEP_FRAMES) ? source->requestLevel : source->minimalLevel;
+        //store if levels are missing or not needed
+        if (source->wantedLevel < source->residentLevel) { missing.push_back(source); }
+        else if (source->wantedLevel > source->residentLevel) { surplus.push_back(source); }
+    }
+    //the blurriest textures are uploaded first
+    std::sort(missing.begin(), missing.end(), [](TextureStreamSource* a, TextureStreamSource* b)
+    { return (a->residentLevel - a->wantedLevel) > (b->residentLevel - b->wantedLevel); });
+    //the textures that were not requested for the longest time are evicted first
+    std::sort(surplus.begin(), surplus.end(), [](TextureStreamSource* a, TextureStreamSource* b)
+    { return a->requestFrame < b->requestFrame; });
+
+    //evict levels if the budget was lowered
+    size_t nextEviction = 0;
+    glgeEvictStreamedLevels(surplus, nextEviction, resident, 0);
+    //upload one level per texture until the upload limit is reached
+    uint64_t uploaded = 0;
+    for (TextureStreamSource* source : missing)
+    {
+        //get the size of the next finer level
+        int level = source->residentLevel - 1;
+        uint64_t cost = source->images[level].size;
+        //check the upload limit, the first level is always uploaded so big levels can't stall the streaming
+        if ((uploaded > 0) && (uploaded + cost > glgeTextureStreamer.uploadLimit)) { break; }
+        //make space in the budget
+        if (!glgeEvictStreamedLevels(surplus, nextEviction, resident, cost))
+        {
+            //the budget is full
+            glgeTextureStreamer.stats.budgetLimited = true;
+            break;
+        }
+        //upload the level
+        source->texture->setResidentMipLevel(level);
+        resident += cost;
+        uploaded += cost;
+    }
+
+    //update the statistics
+    TextureStreamingStats& stats = glgeTextureStreamer.stats;
+    stats.textures = (int)glgeTextureStreamer.sources.size();
+    stats.pendingTextures = 0;
+    stats.residentBytes = 0;
+    stats.fullBytes = 0;
+    stats.budgetBytes = glgeTextureStreamer.budget;
+    for (TextureStreamSource* source : glgeTextureStreamer.sources)
+    {
+        //count the textures with missing levels
+        if (source->wantedLevel < source->residentLevel) { stats.pendingTextures++; }
+        //sum up the sizes
+        stats.residentBytes += source->residentBytes;
+        stats.fullBytes += source->fullBytes;
+    }
+}
+
+bool glgeIsTextureStreamingActive()
+{
+    //streaming is active if a texture is streamed
+    return !glgeTextureStreamer.sources.empty();
+}
+
+void glgeSetTextureStreamingBudget(uint64_t bytes)
+{
+    //store the budget
+    glgeTextureStreamer.budget = bytes;
+}
+
+uint64_t glgeGetTextureStreamingBudget()
+{
+    //return the budget
+    return glgeTextureStreamer.budget;
+}
+
+void glgeSetTextureStreamingUploadLimit(uint64_t bytes)
+{
+    //store the upload limit
+    glgeTextureStreamer.uploadLimit = bytes;
+}
+
+uint64_t glgeGetTextureStreamingUploadLimit()
+{
+    //return the upload limit
+    return glgeTextureStreamer.uploadLimit;
+}
+
+TextureStreamingStats glgeGetTextureStreamingStats()
+{
+    //return the statistics of the last update
+    TextureStreamingStats stats = glgeTextureStreamer.stats;
+    stats.budgetBytes = glgeTextureStreamer.budget;
+    return stats;
+}
@@ -16,6 +16,10 @@
 #include "openglGLGE.h"
 //include the image wraper
 #include "../GLGEIndependend/glgeImage.h"
+//include the block compression
+#include "../GLGEIndependend/glgeBlockCompression.h"
+//include the KTX2 and DDS reader
+#include "../GLGEIndependend/glgeTextureContainer.h"
 
 /**
  * @brief define the value for auto-binding
@@ -209,6 +213,137 @@
  */
 #define GLGE_TEXTURE_BIND_IMAGE_UNIT 0x01
 
+//Defines to say how to load a texture from a file
+
+/**
+ * @brief load the texture with 8 bits per chanel, linear color and without a copy in RAM
+ */
+#define GLGE_TEXTURE_LOAD_DEFAULT 0x00
+/**
+ * @brief say that the texture stores sRGB colors. The sampler converts them to linear colors. 
+ */
+#define GLGE_TEXTURE_LOAD_SRGB 0x01
+/**
+ * @brief say that a float copy of the texture should be kept in RAM. It can be acessed with getTexture. 
+ */
+#define GLGE_TEXTURE_LOAD_KEEP_DATA 0x02
+/**
+ * @brief say that the texture should be loaded as floats. Use this for HDR images, sRGB is ignored. 
+ */
+#define GLGE_TEXTURE_LOAD_HDR 0x04
+/**
+ * @brief say that the texture should be decoded in the background and uploaded over multiple frames. A placeholder is bound until the texture is resident. 
+ */
+#define GLGE_TEXTURE_LOAD_ASYNC 0x08
+/**
+ * @brief compress the texture to BC1 (RGB, 1 bit alpha). The compressed data is cached next to the file, asynchronous loading is ignored. 
+ */
+#define GLGE_TEXTURE_LOAD_BC1 (GLGE_BC1 << 4)
+/**
+ * @brief compress the texture to BC3 (RGBA). The compressed data is cached next to the file, asynchronous loading is ignored. 
+ */
+#define GLGE_TEXTURE_LOAD_BC3 (GLGE_BC3 << 4)
+/**
+ * @brief compress the red chanel of the texture to BC4, use this for roughness and metallic maps
+ */
+#define GLGE_TEXTURE_LOAD_BC4 (GLGE_BC4 << 4)
+/**
+ * @brief compress the red and green chanel of the texture to BC5, use this for normal maps. The shaders reconstruct the blue chanel. 
+ */
+#define GLGE_TEXTURE_LOAD_BC5 (GLGE_BC5 << 4)
+/**
+ * @brief compress the texture to BC7 (high quality RGBA)
+ */
+#define GLGE_TEXTURE_LOAD_BC7 (GLGE_BC7 << 4)
+/**
+ * @brief the bits of the load flags that store the block compression format
+ */
+#define GLGE_TEXTURE_LOAD_COMPRESSION_MASK 0x70
+/**
+ * @brief stream the mip levels of the texture. Only the low levels are uploaded first, finer levels are uploaded when they are requested. 
+ * Only works for KTX2 and DDS files and block compressed textures, because they store all mip levels. 
+ */
+#define GLGE_TEXTURE_LOAD_STREAM 0x80
+
+/**
+ * @brief the default time in milliseconds that is spend each frame to upload asynchronously loaded textures
+ */
+#define GLGE_TEXTURE_DEFAULT_UPLOAD_BUDGET 2.f
+/**
+ * @brief the maximum amount of bytes uploaded in one step of an asynchronous texture upload
+ */
+#define GLGE_TEXTURE_UPLOAD_CHUNK_SIZE (4*1024*1024)
+/**
+ * @brief the maximum amount of threads decoding textures in the background
+ */
+#define GLGE_TEXTURE_MAX_LOADER_THREADS 4
+
+/**
+ * @brief the biggest size in pixels of the mip level a streamed texture starts with, this level is never evicted
+ */
+#define GLGE_TEXTURE_STREAM_MIN_SIZE 64
+/**
+ * @brief the default amount of bytes all streamed textures can use on the GPU
+ */
+#define GLGE_TEXTURE_DEFAULT_STREAMING_BUDGET (256ull*1024*1024)
+/**
+ * @brief the default amount of bytes streamed to the GPU each frame
+ */
+#define GLGE_TEXTURE_DEFAULT_STREAMING_UPLOAD_LIMIT (8ull*1024*1024)
+/**
+ * @brief the amount of frames a request for a mip level is kept before the level can be evicted
+ */
+#define GLGE_TEXTURE_STREAM_KEEP_FRAMES 120
+
+/**
+ * @brief store the state of an asynchronous texture load, defined in openglGLGETexture.cpp
+ */
+struct TextureLoadJob;
+
+/**
+ * @brief store the mip levels of a streamed texture, defined in openglGLGETexture.cpp
+ */
+struct TextureStreamSource;
+
+/**
+ * @brief store the state of the texture streaming
+ */
+struct TextureStreamingStats
+{
+    /**
+     * @brief the amount of streamed textures
+     */
+    int textures = 0;
+    /**
+     * @brief the amount of textures that have less detail on the GPU than requested
+     */
+    int pendingTextures = 0;
+    /**
+     * @brief the bytes of all mip levels on the GPU
+     */
+    uint64_t residentBytes = 0;
+    /**
+     * @brief the bytes all streamed textures would need if all levels were on the GPU
+     */
+    uint64_t fullBytes = 0;
+    /**
+     * @brief the amount of bytes the streamed textures can use on the GPU
+     */
+    uint64_t budgetBytes = 0;
+    /**
+     * @brief the bytes uploaded during the last update
+     */
+    uint64_t uploadedBytes = 0;
+    /**
+     * @brief the bytes evicted during the last update
+     */
+    uint64_t evictedBytes = 0;
+    /**
+     * @brief say if the budget prevented an upload during the last update
+     */
+    bool budgetLimited = false;
+};
+
 /**
  * @brief a simple texture
  */
@@ -222,10 +357,13 @@ public:
 
     /**
      * @brief create a texture from an file
+     * \par Info
+     * KTX2 and DDS files (detected by the file ending) are uploaded with their prebuilt mip levels, the compression and asynchronous flags are ignored for them. 
      * 
      * @param textureFile the texture file to read from
+     * @param loadFlags the GLGE_TEXTURE_LOAD_* flags to load the texture with (DEFAULT: GLGE_TEXTURE_LOAD_DEFAULT)
      */
-    Texture(const char* textureFile);
+    Texture(const char* textureFile, unsigned int loadFlags = GLGE_TEXTURE_LOAD_DEFAULT);
 
     /**
      * @brief Construct a texture from a size
@@ -310,7 +448,7 @@ public:
     /**
      * @brief get a pointer to the content of the texture. The length is texture width * texture height
      * @warning if the texture is resized, the pointer becomes invalide
-     * @return vec4* a pointer to the texture
+     * @return vec4* a pointer to the texture or NULL if no copy is kept in RAM
      */
     vec4* getTexture();
 
@@ -338,7 +476,7 @@ public:
     unsigned int indexInTexture(int x, int y);
 
     /**
-     * @brief read the texture from the GPU
+     * @brief read the texture from the GPU. If no copy is kept in RAM, one is created
      * @warning this reads back data from the GPU and may be slow. Use only when nesessary. 
      */
     void readbackTexture();
@@ -371,6 +509,96 @@ public:
      */
     uint64_t getHandler();
 
+    /**
+     * @brief say if the texture data is on the GPU
+     * 
+     * @return true : the texture is loaded | 
+     * @return false : the texture is still loading asynchronously or failed to load
+     */
+    bool isResident();
+
+    /**
+     * @brief say if an asynchronous load of the texture failed
+     * 
+     * @return true : the file could not be decoded | 
+     * @return false : the texture is loaded or still loading
+     */
+    bool hasLoadFailed();
+
+    /**
+     * @brief Set a function that is called once an asynchronous load finished
+     * \par Info
+     * The function is called on the main thread with the texture and if the load was sucessfull. 
+     * 
+     * @param callback the function to call
+     */
+    void setLoadCallback(void (*callback)(Texture*, bool));
+
+    /**
+     * @brief block until an asynchronous load finished and upload the rest of the texture at once
+     */
+    void finishLoading();
+
+    /**
+     * @brief replace the placeholder with the uploaded texture, this is called by the texture loader
+     * 
+     * @param job the job that finished
+     * @param success say if the texture could be decoded
+     */
+    void completeAsyncLoad(TextureLoadJob* job, bool success);
+
+    /**
+     * @brief Get the block compression format of the texture
+     * 
+     * @return unsigned int the format (GLGE_BC1, GLGE_BC3, ...) or GLGE_BC_NONE if the texture is not compressed
+     */
+    unsigned int getCompressionFormat();
+
+    /**
+     * @brief Get the peak signal to noise ratio of the compressed texture compared to the source file
+     * 
+     * @return float the PSNR in dB, 0 if the texture is not compressed
+     */
+    float getCompressionPSNR();
+
+    /**
+     * @brief say if the texture is streamed
+     * 
+     * @return true : the mip levels are streamed | 
+     * @return false : all mip levels are on the GPU
+     */
+    bool isStreamed();
+
+    /**
+     * @brief request the detail the texture is needed with in this frame, only used by streamed textures
+     * 
+     * @param uvPerPixel the size of a screen pixel in texture coordinates
+     */
+    void requestDetail(float uvPerPixel);
+
+    /**
+     * @brief Get the finest mip level that is on the GPU
+     * 
+     * @return int the mip level, 0 if the texture is not streamed
+     */
+    int getResidentMipLevel();
+
+    /**
+     * @brief Get the finest mip level that was requested in the last frames
+     * 
+     * @return int the mip level, 0 if the texture is not streamed
+     */
+    int getRequestedMipLevel();
+
+    /**
+     * @brief upload or evict mip levels until the given level is the finest level on the GPU, this is called by the texture streamer
+     * \par Info
+     * The OpenGL texture is replaced, so bindless handles must be requested again. 
+     * 
+     * @param level the finest mip level to keep on the GPU
+     */
+    void setResidentMipLevel(int level);
+
 private:
     //store the texture data
     vec4* texData = 0;
@@ -394,6 +622,51 @@ private:
     int bindIntention = 0;
     //store the texture handler
     uint64_t handler = 0;
+    //store if the OpenGL texture was created by this object
+    bool ownsTexture = false;
+    //store the asynchronous load that is in progress
+    TextureLoadJob* loadJob = NULL;
+    //store if the asynchronous load failed
+    bool loadFailed = false;
+    //store the function to call once the asynchronous load finished
+    void (*loadCallback)(Texture*, bool) = NULL;
+    //store the block compression format
+    unsigned int compression = GLGE_BC_NONE;
+    //store the quality of the compression
+    float compressionPSNR = 0;
+    //store the mip levels if the texture is streamed
+    TextureStreamSource* stream = NULL;
+
+    /**
+     * @brief start an asynchronous load of a file
+     * 
+     * @param textureFile the file to load
+     * @param loadFlags the GLGE_TEXTURE_LOAD_* flags to load the texture with
+     */
+    void startAsyncLoad(const char* textureFile, unsigned int loadFlags);
+
+    /**
+     * @brief load a file as a block compressed texture, the compressed cache file is used if it is up to date
+     * 
+     * @param textureFile the file to load
+     * @param loadFlags the GLGE_TEXTURE_LOAD_* flags to load the texture with
+     */
+    void loadCompressed(const char* textureFile, unsigned int loadFlags);
+
+    /**
+     * @brief load a KTX2 or DDS file with all of its prebuilt mip levels
+     * 
+     * @param textureFile the file to load
+     * @param loadFlags the GLGE_TEXTURE_LOAD_* flags to load the texture with
+     */
+    void loadContainer(const char* textureFile, unsigned int loadFlags);
+
+    /**
+     * @brief start to stream the texture and upload the coarse mip levels
+     * 
+     * @param source the mip levels of the texture, the texture takes ownership
+     */
+    void startStreaming(TextureStreamSource* source);
 
     /**
      * @brief decode a type specification
@@ -403,4 +676,126 @@ private:
     void decode(int encodeType);
 };
 
+/**
+ * @brief upload the next parts of asynchronously loaded textures, this is called every frame by the main loop
+ * 
+ * @param windowIndex the index of the window whose textures should be uploaded, the window must be current
+ */
+void glgeUploadLoadedTextures(int windowIndex);
+
+/**
+ * @brief Set the time that can be spend each frame to upload asynchronously loaded textures
+ * 
+ * @param milliseconds the time in milliseconds, at least one part is uploaded each frame
+ */
+void glgeSetTextureUploadBudget(float milliseconds);
+
+/**
+ * @brief Get the time that can be spend each frame to upload asynchronously loaded textures
+ * 
+ * @return float the time in milliseconds
+ */
+float glgeGetTextureUploadBudget();
+
+/**
+ * @brief Get the amount of textures that are still loading asynchronously
+ * 
+ * @return int the amount of textures
+ */
+int glgeGetLoadingTextureCount();
+
+/**
+ * @brief upload and evict mip levels of streamed textures, this is called every frame by the main loop
+ * 
+ * @param windowIndex the index of the window whose textures should be streamed, the window must be current
+ */
+void glgeUpdateTextureStreaming(int windowIndex);
+
+/**
+ * @brief say if any texture is streamed
+ * 
+ * @return true : at least one texture is streamed | 
+ * @return false : no texture is streamed
+ */
+bool glgeIsTextureStreamingActive();
+
+/**
+ * @brief Set the amount of bytes all streamed textures can use on the GPU
+ * 
+ * @param bytes the budget in bytes, the coarsest levels are always kept
+ */
+void glgeSetTextureStreamingBudget(uint64_t bytes);
+
+/**
+ * @brief Get the amount of bytes all streamed textures can use on the GPU
+ * 
+ * @return uint64_t the budget in bytes
+ */
+uint64_t glgeGetTextureStreamingBudget();
+
+/**
+ * @brief Set the amount of bytes that are streamed to the GPU each frame
+ * 
+ * @param bytes the amount of bytes, at least one level is uploaded each frame
+ */
+void glgeSetTextureStreamingUploadLimit(uint64_t bytes);
+
+/**
+ * @brief Get the amount of bytes that are streamed to the GPU each frame
+ * 
+ * @return uint64_t the amount of bytes
+ */
+uint64_t glgeGetTextureStreamingUploadLimit();
+
+/**
+ * @brief Get the state of the texture streaming
+ * 
+ * @return TextureStreamingStats the residency of all streamed textures and the work of the last update
+ */
+TextureStreamingStats glgeGetTextureStreamingStats();
+
+/**
+ * @brief load a KTX2 or DDS file into a new OpenGL texture
+ * \par Info
+ * The file is memory mapped and all stored mip levels, array layers and cube faces are uploaded without decoding them. 
+ * Mip levels are only generated if a KTX2 file asks for it. 
+ * 
+ * @param file the path to the file
+ * @param loadFlags GLGE_TEXTURE_LOAD_SRGB upgrades linear 8 bit and BC formats to their sRGB variant, all other flags are ignored
+ * @param target the OpenGL target of the texture (GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP or GL_TEXTURE_CUBE_MAP_ARRAY)
+ * @param size the size of the first mip level in pixels
+ * @param internalFormat the OpenGL internal format of the texture
+ * @return unsigned int the OpenGL texture, 0 if the file could not be loaded
+ */
+unsigned int glgeLoadTextureContainer(const char* file, unsigned int loadFlags, unsigned int* target, ivec2* size, unsigned int* internalFormat);
+
+/**
+ * @brief Set the quality preset used to compress textures, changing it invalidates existing cache files
+ * 
+ * @param preset the preset (GLGE_BC_PRESET_FAST, GLGE_BC_PRESET_NORMAL or GLGE_BC_PRESET_HIGH)
+ */
+void glgeSetTextureCompressionPreset(unsigned int preset);
+
+/**
+ * @brief Get the quality preset used to compress textures
+ * 
+ * @return unsigned int the preset
+ */
+unsigned int glgeGetTextureCompressionPreset();
+
+/**
+ * @brief Say if the PSNR of every compressed texture should be printed when it is loaded
+ * 
+ * @param report true : the PSNR is printed | false : nothing is printed
+ */
+void glgeSetTextureCompressionReport(bool report);
+
+/**
+ * @brief Get if the PSNR of every compressed texture is printed when it is loaded
+ * 
+ * @return true : the PSNR is printed | 
+ * @return false : nothing is printed
+ */
+bool glgeGetTextureCompressionReport();
+
 #endif
\ No newline at end of file
@@ -55,6 +55,16 @@ unsigned int glgeTextureUnit = 0;
  */
 Light* glgeCurrentShadowCaster = NULL;
 
+/**
+ * @brief store the light space matrix of the shadow map that is currently drawn
+ */
+mat4 glgeCurrentShadowMat = mat4();
+
+/**
+ * @brief store the index of the shadow cascade that is currently drawn (-1 if no cascade is drawn)
+ */
+int glgeCurrentShadowCascade = -1;
+
 /**
  * @brief store the type of the current framebuffer
  */
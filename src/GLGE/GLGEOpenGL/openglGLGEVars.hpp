@@ -72,6 +72,16 @@ extern unsigned int glgeTextureUnit;
  */
 extern Light* glgeCurrentShadowCaster;
 
+/**
+ * @brief store the light space matrix of the shadow map that is currently drawn
+ */
+extern mat4 glgeCurrentShadowMat;
+
+/**
+ * @brief store the index of the shadow cascade that is currently drawn (-1 if no cascade is drawn)
+ */
+extern int glgeCurrentShadowCascade;
+
 /**
  * @brief store the type of the current framebuffer
  */
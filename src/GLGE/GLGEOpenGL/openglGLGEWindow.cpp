@@ -45,6 +45,160 @@
 //include default libs
 #include <iostream>
 #include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cstdio>
+
+/**
+ * @brief the capture slot is not used
+ */
+#define GLGE_CAPTURE_SLOT_FREE 0
+/**
+ * @brief the GPU copies a frame into the capture slot
+ */
+#define GLGE_CAPTURE_SLOT_READING 1
+/**
+ * @brief the encoder thread writes the frame of the capture slot to a file
+ */
+#define GLGE_CAPTURE_SLOT_ENCODING 2
+
+/**
+ * @brief a pixel pack buffer a frame is read into
+ */
+struct CaptureSlot
+{
+    //store the pixel pack buffer
+    unsigned int pbo = 0;
+    //store the persistent mapping of the buffer
+    uint8_t* mapping = NULL;
+    //store the size of the buffer in bytes
+    size_t capacity = 0;
+    //store the fence that signals the end of the read
+    GLsync fence = 0;
+    //store the size of the frame
+    ivec2 size = ivec2(0,0);
+    //store the file to write the frame to
+    std::string file = "";
+    //store the file format
+    unsigned int format = GLGE_IMG_TYPE_ENDING;
+    //store the state of the slot
+    int state = GLGE_CAPTURE_SLOT_FREE;
+};
+
+struct FrameCapture
+{
+    //store the ring of read back buffers
+    CaptureSlot slots[GLGE_CAPTURE_RING_SIZE];
+    //store the slot the next frame is read into
+    int next = 0;
+    //store the slots that are read by the GPU, in frame order
+    std::deque<int> reading;
+    //store the path pattern for continuous captures, empty if only single frames are captured
+    std::string pattern = "";
+    //store the file format of continuous captures
+    unsigned int format = GLGE_IMG_TYPE_ENDING;
+    //store the frame number of the next continuous capture
+    unsigned int frame = 0;
+    //store the files requested for the next frame
+    std::vector<std::pair<std::string, unsigned int>> single;
+
+    //protect the members shared with the encoder
+    std::mutex mutex;
+    //wake the encoder if a slot is ready
+    std::condition_variable slotReady;
+    //wake the main thread if a slot is free again
+    std::condition_variable slotFree;
+    //store the slots that wait for the encoder, in frame order
+    std::deque<int> encodeQueue;
+    //store the amount of written frames
+    unsigned int written = 0;
+    //say if the encoder should keep running
+    bool running = true;
+    //store the encoder thread
+    std::thread encoder;
+};
+
+/**
+ * @brief write the frames of a capture to files on a background thread
+ * 
+ * @param capture the capture to write the frames of
+ */
+static void glgeCaptureEncoderThread(FrameCapture* capture)
+{
+    //lock the capture
+    std::unique_lock<std::mutex> lock(capture->mutex);
+    while (true)
+    {
+        //wait for a frame or the stop
+        capture->slotReady.wait(lock, [capture]{ return !capture->encodeQueue.empty() || !capture->running; });
+        //stop if nothing is left to write
+        if (capture->encodeQueue.empty()) { return; }
+        //take the oldest frame
+        CaptureSlot& slot = capture->slots[capture->encodeQueue.front()];
+        capture->encodeQueue.pop_front();
+        //write the frame without holding the lock, the rows of OpenGL start at the bottom
+        lock.unlock();
+        glgeStoreImage(slot.file.c_str(), slot.size, slot.mapping, slot.format, true);
+        lock.lock();
+        //the slot can be used again
+        slot.state = GLGE_CAPTURE_SLOT_FREE;
+        capture->written++;
+        capture->slotFree.notify_all();
+    }
+}
+
+/**
+ * @brief hand a slot to the encoder once the GPU finished reading into it
+ * 
+ * @param capture the capture the slot belongs to
+ * @param wait true : wait until the GPU is done | false : only check if the GPU is done
+ * @return true : the slot was handed to the encoder | false : the GPU is still reading
+ */
+static bool glgeFinishCaptureRead(FrameCapture* capture, bool wait)
+{
+    //get the oldest slot the GPU reads into
+    CaptureSlot& slot = capture->slots[capture->reading.front()];
+    //check the fence, waiting flushes the commands so the fence can signal
+    GLenum result = glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000ull : 0);
+    //stop if the GPU is not done
+    if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED)) { return false; }
+    //the fence is not needed anymore
+    glDeleteSync(slot.fence);
+    slot.fence = 0;
+    {
+        //lock the capture
+        std::lock_guard<std::mutex> lock(capture->mutex);
+        //hand the slot to the encoder
+        slot.state = GLGE_CAPTURE_SLOT_ENCODING;
+        capture->encodeQueue.push_back(capture->reading.front());
+    }
+    capture->reading.pop_front();
+    //wake the encoder
+    capture->slotReady.notify_one();
+    return true;
+}
+
+/**
+ * @brief drop the oldest read of a capture, used if the GPU doesn't finish the read in time
+ * 
+ * @param capture the capture to drop the read of
+ */
+static void glgeDropCaptureRead(FrameCapture* capture)
+{
+    //get the oldest slot the GPU reads into
+    CaptureSlot& slot = capture->slots[capture->reading.front()];
+    //the frame is lost
+    glDeleteSync(slot.fence);
+    slot.fence = 0;
+    {
+        //lock the capture, the slot can be used again
+        std::lock_guard<std::mutex> lock(capture->mutex);
+        slot.state = GLGE_CAPTURE_SLOT_FREE;
+    }
+    capture->reading.pop_front();
+}
 
 Window::Window()
 {
@@ -91,6 +245,8 @@ void Window::close()
     glgeCurrentWindowIndex = this->id-glgeWindowIndexOffset;
     //bind the OpenGL context to the window
     SDL_GL_MakeCurrent((SDL_Window*)this->window, this->glContext);
+    //write all captured frames
+    this->stopCapture();
     //call the on exit function
     if (this->hasExitFunc)
     {
@@ -138,13 +294,26 @@ void Window::draw()
     //copy the data
     glBlitFramebuffer(0,0, this->size.x,this->size.y, 0,0, this->size.x,this->size.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
-    //copy the last frame to another fragment shader
-    //bind the default framebuffer as read only
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-    //bind the custom framebuffer as draw only
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->lastTickFramebuffer);
-    //copy the framebuffer
-    glBlitFramebuffer(0,0, this->size.x, this->size.y, 0,0, this->size.x, this->size.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    //check if the last frame is used by the render pipeline
+    if (this->usedResources & GLGE_RESOURCE_LAST_TICK)
+    {
+        //copy the last frame to another fragment shader
+        //bind the default framebuffer as read only
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        //bind the custom framebuffer as draw only
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->lastTickFramebuffer);
+        //copy the framebuffer
+        glBlitFramebuffer(0,0, this->size.x, this->size.y, 0,0, this->size.x, this->size.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+
+    //check if frames are captured
+    if (this->capture)
+    {
+        //read the final image
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, this->postProcessingFramebuffer);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        this->updateCapture();
+    }
 
     //bind the default framebuffer
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -158,6 +327,160 @@ void Window::draw()
     this->drawing = false;
 }
 
+void Window::updateCapture()
+{
+    //store the capture
+    FrameCapture* cap = this->capture;
+    //hand all finished reads to the encoder, the reads finish in order
+    while (!cap->reading.empty() && glgeFinishCaptureRead(cap, false)) {}
+
+    //collect the files the current frame is written to
+    std::vector<std::pair<std::string, unsigned int>> files;
+    files.swap(cap->single);
+    //check if every frame is captured
+    if (!cap->pattern.empty())
+    {
+        //create the file name from the pattern
+        std::vector<char> name(cap->pattern.size() + 32);
+        snprintf(name.data(), name.size(), cap->pattern.c_str(), cap->frame++);
+        files.push_back(std::pair<std::string, unsigned int>(std::string(name.data()), cap->format));
+    }
+
+    //read the frame for every file
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        //get the next slot
+        CaptureSlot& slot = cap->slots[cap->next];
+        //wait for the reads until the slot is not read by the GPU anymore, the ring is full
+        while ((slot.state == GLGE_CAPTURE_SLOT_READING) && !cap->reading.empty())
+        {
+            //wait for the oldest read
+            if (!glgeFinishCaptureRead(cap, true))
+            {
+                //the GPU didn't finish in time, drop the frame so the slot is never waited on forever
+                if (glgeWarningOutput)
+                {
+                    printf("[GLGE WARNING] The GPU didn't finish reading the frame for %s, the frame is not captured\n", cap->slots[cap->reading.front()].file.c_str());
+                }
+                glgeDropCaptureRead(cap);
+            }
+        }
+        {
+            //wait until the encoder wrote the frame of the slot
+            std::unique_lock<std::mutex> lock(cap->mutex);
+            cap->slotFree.wait(lock, [&slot]{ return slot.state == GLGE_CAPTURE_SLOT_FREE; });
+        }
+        //check if the buffer is to small for the frame
+        size_t bytes = (size_t)this->size.x*this->size.y*4;
+        if (slot.capacity < bytes)
+        {
+            //delete the old buffer
+            if (slot.pbo) { glUnmapNamedBuffer(slot.pbo); glDeleteBuffers(1, &slot.pbo); }
+            //create a buffer that stays mapped, so the encoder can read it without copying
+            glCreateBuffers(1, &slot.pbo);
+            glNamedBufferStorage(slot.pbo, bytes, NULL, GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+            slot.mapping = (uint8_t*)glMapNamedBufferRange(slot.pbo, 0, bytes, GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+            slot.capacity = bytes;
+        }
+        //store the frame information
+        slot.size = ivec2(this->size.x, this->size.y);
+        slot.file = files[i].first;
+        slot.format = files[i].second;
+        //read the frame into the buffer, the read runs asynchronously
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, this->size.x, this->size.y, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        //signal when the read is done
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.state = GLGE_CAPTURE_SLOT_READING;
+        cap->reading.push_back(cap->next);
+        //use the next slot for the next frame
+        cap->next = (cap->next + 1) % GLGE_CAPTURE_RING_SIZE;
+    }
+}
+
+void Window::startCapture(const char* pattern, unsigned int fileFormat)
+{
+    //create the capture if it dosn't exist
+    if (!this->capture)
+    {
+        //create the capture and start the encoder
+        this->capture = new FrameCapture();
+        this->capture->encoder = std::thread(glgeCaptureEncoderThread, this->capture);
+    }
+    //store the pattern
+    this->capture->pattern = std::string(pattern);
+    this->capture->format = fileFormat;
+    this->capture->frame = 0;
+}
+
+void Window::captureFrame(const char* file, unsigned int fileFormat)
+{
+    //create the capture if it dosn't exist
+    if (!this->capture)
+    {
+        //create the capture and start the encoder
+        this->capture = new FrameCapture();
+        this->capture->encoder = std::thread(glgeCaptureEncoderThread, this->capture);
+    }
+    //store the file for the next frame
+    this->capture->single.push_back(std::pair<std::string, unsigned int>(std::string(file), fileFormat));
+}
+
+void Window::stopCapture()
+{
+    //stop if nothing is captured
+    if (!this->capture) { return; }
+    //store the capture
+    FrameCapture* cap = this->capture;
+    //hand all reads to the encoder
+    while (!cap->reading.empty())
+    {
+        //wait for the oldest read
+        if (!glgeFinishCaptureRead(cap, true))
+        {
+            //the GPU didn't finish in time, the frame is lost
+            glgeDropCaptureRead(cap);
+        }
+    }
+    {
+        //stop the encoder after it wrote all frames
+        std::lock_guard<std::mutex> lock(cap->mutex);
+        cap->running = false;
+    }
+    cap->slotReady.notify_one();
+    cap->encoder.join();
+    //free the buffers
+    for (int i = 0; i < GLGE_CAPTURE_RING_SIZE; i++)
+    {
+        if (cap->slots[i].pbo)
+        {
+            glUnmapNamedBuffer(cap->slots[i].pbo);
+            glDeleteBuffers(1, &cap->slots[i].pbo);
+        }
+    }
+    //delete the capture
+    delete cap;
+    this->capture = NULL;
+}
+
+bool Window::isCapturing()
+{
+    //every frame is captured if a pattern exists
+    return this->capture && !this->capture->pattern.empty();
+}
+
+unsigned int Window::getCapturedFrameCount()
+{
+    //nothing was written without a capture
+    if (!this->capture) { return 0; }
+    //lock the capture
+    std::lock_guard<std::mutex> lock(this->capture->mutex);
+    //return the amount of written frames
+    return this->capture->written;
+}
+
 void Window::tick()
 {
     //make this the current window
@@ -201,36 +524,8 @@ void Window::tick()
     //call the tick function
     this->callTickFunc();
 
-    //store if the light data should update
-    bool updateLight = false;
-    //loop over all windows
-    for (int i = 0; i < (int)this->lights.size(); i++)
-    {
-        //get if a update is needed
-        if (this->lights[i]->shouldUpdate())
-        {
-            //store that an update should execute
-            updateLight = true;
-            //store the new light data
-            ((LightData*)(this->lightDatas + 16))[i] = this->lights[i]->getLightData();
-            //say that the update is now done
-            this->lights[i]->updateDone();
-        }
-    }
-    //check if an update is needed
-    if (updateLight)
-    {
-        //update the light count
-        *(int*)this->lightDatas = (int)this->lights.size();
-        //bind the ubo
-        glBindBuffer(GL_UNIFORM_BUFFER, this->lightUBO);
-        //store the data
-        glBufferData(GL_UNIFORM_BUFFER, 129*sizeof(LightData), this->lightDatas, GL_STATIC_DRAW);
-        //unbind the buffer
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
-        //bind the buffer to the correct slot
-        glBindBufferBase(GL_UNIFORM_BUFFER, 3, this->lightUBO);
-    }
+    //upload all changed light data
+    this->uploadLights();
     
     //update the camera data
     if (this->mainCamera != NULL)
@@ -916,6 +1211,31 @@ void Window::setSkybox(const char* top, const char* bottom, const char* left, co
     this->useSkybox = true;
 }
 
+void Window::setSkybox(const char* cubeMap)
+{
+    //load the file with all stored levels and faces
+    unsigned int target = 0;
+    unsigned int texture = glgeLoadTextureContainer(cubeMap, GLGE_TEXTURE_LOAD_DEFAULT, &target, NULL, NULL);
+    //stop if the file could not be loaded, the error was allready thrown
+    if (!texture) { return; }
+    //check that the file stores a cube map
+    if (target != GL_TEXTURE_CUBE_MAP)
+    {
+        //delete the texture
+        glDeleteTextures(1, &texture);
+        //throw an error
+        GLGE_THROW_ERROR("The skybox file " + std::string(cubeMap) + " is not a cube map")
+        //stop the function
+        return;
+    }
+    //delete the old skybox
+    if (this->skyboxTex) { glDeleteTextures(1, &this->skyboxTex); }
+    //store the new skybox
+    this->skyboxTex = texture;
+    //say that the skybox is active
+    this->useSkybox = true;
+}
+
 void Window::moveFunc(int x, int y)
 {
 
@@ -950,62 +1270,12 @@ void Window::resizeWindow(int width, int height)
     }
     
     //update all the renderbuffer sizes
-
-    //update the render texture parameters
-    glBindTexture(GL_TEXTURE_2D, this->mainDepthTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32, this->size.x, this->size.y, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
-
-    //update the render texture parameters
-    glBindTexture(GL_TEXTURE_2D, this->mainAlbedoTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, this->size.x, this->size.y, 0, GL_RGBA, GL_FLOAT, NULL);
-
-    //update all the texture sizes
-    //update the normal texture parameters
-    glBindTexture(GL_TEXTURE_2D, this->mainNormalTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, this->size.x, this->size.y, 0, GL_RGBA, GL_FLOAT, NULL);
-
-    //update the position texture parameters
-    glBindTexture(GL_TEXTURE_2D, this->mainPosTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, this->size.x, this->size.y, 0, GL_RGBA, GL_FLOAT, NULL);
-
-    //update the roughness texture parameters
-    glBindTexture(GL_TEXTURE_2D, this->mainRMLTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GLGE_FRAMEBUFFER_BIT_DEPTH, this->size.x, this->size.y, 0, GL_RGB, GL_FLOAT, NULL);
-
-    //update the depth and alpha texture parameters
-    glBindTexture(GL_TEXTURE_2D, this->mainEIDATex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GLGE_FRAMEBUFFER_BIT_DEPTH, this->size.x, this->size.y, 0, GL_RGB, GL_FLOAT, NULL);
-
-    //update the solid lit texture
-    glBindTexture(GL_TEXTURE_2D, this->mainSolidTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GLGE_FRAMEBUFFER_BIT_DEPTH, this->size.x, this->size.y, 0, GL_RGBA, GL_FLOAT, NULL);
-
-    //update the transparent accumulation texture
-    glBindTexture(GL_TEXTURE_2D, this->mainTransparentAccumTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, this->size.x, this->size.y, 0, GL_RGBA, GL_FLOAT, NULL);
-
-    //update the last tick texture
-    glBindTexture(GL_TEXTURE_2D, this->lastTickTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GLGE_FRAMEBUFFER_BIT_DEPTH, this->size.x, this->size.y, 0, GL_RGB, GL_FLOAT, NULL);
-
-    //update the lighting texture
-    glBindTexture(GL_TEXTURE_2D, this->mainOutTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GLGE_FRAMEBUFFER_BIT_DEPTH, this->size.x, this->size.y, 0, GL_RGB, GL_FLOAT, NULL);
-
-    //update the post processing texture
-    glBindTexture(GL_TEXTURE_2D, this->postProcessingTex);
-    //set the texture parameters so it dosn't loop around the screen
-    glTexImage2D(GL_TEXTURE_2D, 0, GLGE_FRAMEBUFFER_POST_PROCESSING_DEF, this->size.x, this->size.y, 0, GL_RGB, GL_FLOAT, NULL);
+    //loop over all frame resources
+    for (int i = 0; i < GLGE_RESOURCE_COUNT; i++)
+    {
+        //resize the resource, unused resources keep a single pixel
+        this->allocateFrameResource(1 << i);
+    }
 
     //unbind the texture
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -1029,6 +1299,8 @@ void Window::getLightingUniforms()
     this->lightShader->setCustomTexture("glgePositionMap", this->mainPosTex);
     //get the uniform for the roughness map
     this->lightShader->setCustomTexture("glgeRoughnessMap", this->mainRMLTex);
+    //get the uniform for the shadow atlas
+    this->lightShader->setCustomTexture("glgeShadowAtlas", this->shadowTex);
     
     //recalculate all uniforms
     this->lightShader->recalculateUniforms();
@@ -1070,7 +1342,7 @@ void Window::bindGBuff()
     glBindFramebuffer(GL_FRAMEBUFFER, this->mainFramebuffer);
 
     //specify the color buffers to draw into
-    glDrawBuffers(glgeLenAllUsedColorBuffers, glgeAllUsedColorBuffers);
+    glDrawBuffers(8, this->gBuffDrawBuffers);
 
     //say that now the geometry buffer is bound
     glgeCurrentFramebufferType = GLGE_FRAMEBUFFER_GEOMETRY;
@@ -1120,6 +1392,161 @@ void Window::setRenderPipeline(RenderPipeline* renderPipeline, bool del)
     this->renderPipeline = renderPipeline;
 }
 
+void Window::setUsedResources(unsigned int resources)
+{
+    //the post processing framebuffer is always presented
+    resources |= GLGE_RESOURCE_POST_PROCESSING;
+    //check if something changed
+    if (resources == this->usedResources) { return; }
+    //store which resources changed
+    unsigned int changed = resources ^ this->usedResources;
+    //store the new resources
+    this->usedResources = resources;
+
+    //bind the geometry framebuffer to change the attachments
+    glBindFramebuffer(GL_FRAMEBUFFER, this->mainFramebuffer);
+    //loop over all frame resources
+    for (int i = 0; i < GLGE_RESOURCE_COUNT; i++)
+    {
+        //get the resource flag
+        unsigned int resource = 1 << i;
+        //skip unchanged resources
+        if (!(changed & resource)) { continue; }
+        //allocate or release the storage
+        this->allocateFrameResource(resource);
+        //check if the resource is a color attachment of the geometry buffer
+        if (resource & GLGE_RESOURCE_G_BUFFER)
+        {
+            //attach the texture only if it is used
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0+i, GL_TEXTURE_2D, (resources & resource) ? this->getFrameResourceTexture(resource) : 0, 0);
+            //only draw into used attachments
+            this->gBuffDrawBuffers[i] = (resources & resource) ? GL_COLOR_ATTACHMENT0+i : GL_NONE;
+            //the albedo attachment is cleared seperatly
+            this->gBuffClearBuffers[i] = (i == 0) ? GL_NONE : this->gBuffDrawBuffers[i];
+        }
+        //check if the resource is the depth buffer
+        else if (resource == GLGE_RESOURCE_DEPTH)
+        {
+            //attach the texture only if it is used
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, (resources & resource) ? this->mainDepthTex : 0, 0);
+        }
+    }
+    //unbind the texture
+    glBindTexture(GL_TEXTURE_2D, 0);
+    //unbind the framebuffer
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    //say that the window surface is bound, so the draw buffers are set again
+    glgeCurrentFramebufferType = GLGE_FRAMEBUFFER_WINDOW_SURFACE;
+}
+
+unsigned int Window::getUsedResources()
+{
+    //return the used resources
+    return this->usedResources;
+}
+
+void Window::invalidateResources(unsigned int resources)
+{
+    //only resources with storage can be discarded
+    resources &= this->usedResources;
+    //loop over all frame resources
+    for (int i = 0; i < GLGE_RESOURCE_COUNT; i++)
+    {
+        //skip resources that should be kept
+        if (!(resources & (1 << i))) { continue; }
+        //get the texture of the resource
+        unsigned int tex = this->getFrameResourceTexture(1 << i);
+        //check if the window owns the texture
+        if (tex)
+        {
+            //discard the content, so the driver dosn't need to preserve it
+            glInvalidateTexImage(tex, 0);
+        }
+    }
+}
+
+void Window::allocateFrameResource(unsigned int resource)
+{
+    //get the texture of the resource
+    unsigned int tex = this->getFrameResourceTexture(resource);
+    //resources that aren't owned by the window are skipped
+    if (!tex) { return; }
+    //store the format of the resource
+    int internalFormat = GLGE_FRAMEBUFFER_BIT_DEPTH;
+    unsigned int format = GL_RGB;
+    //select the format of the resource
+    switch (resource)
+    {
+    //the depth buffer
+    case GLGE_RESOURCE_DEPTH:
+        internalFormat = GL_DEPTH_COMPONENT32;
+        format = GL_DEPTH_COMPONENT;
+        break;
+    //the half float attachments
+    case GLGE_RESOURCE_ALBEDO:
+    case GLGE_RESOURCE_NORMAL:
+    case GLGE_RESOURCE_POSITION:
+        internalFormat = GL_RGBA16F;
+        format = GL_RGBA;
+        break;
+    //the solid attachment
+    case GLGE_RESOURCE_SOLID:
+        format = GL_RGBA;
+        break;
+    //the transparent accumulation attachment
+    case GLGE_RESOURCE_TRANS_ACCUM:
+        internalFormat = GL_RGBA32F;
+        format = GL_RGBA;
+        break;
+    //the post processing framebuffer
+    case GLGE_RESOURCE_POST_PROCESSING:
+        internalFormat = GLGE_FRAMEBUFFER_POST_PROCESSING_DEF;
+        break;
+    //all other resources use the default format
+    default:
+        break;
+    }
+    //check if the resource is used
+    bool used = (this->usedResources & resource);
+    //bind the texture
+    glBindTexture(GL_TEXTURE_2D, tex);
+    //allocate the full size for used resources and a single pixel for unused ones
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, used ? this->size.x : 1, used ? this->size.y : 1, 0, format, GL_FLOAT, NULL);
+}
+
+unsigned int Window::getFrameResourceTexture(unsigned int resource)
+{
+    //select the texture of the resource
+    switch (resource)
+    {
+    case GLGE_RESOURCE_ALBEDO:
+        return this->mainAlbedoTex;
+    case GLGE_RESOURCE_NORMAL:
+        return this->mainNormalTex;
+    case GLGE_RESOURCE_POSITION:
+        return this->mainPosTex;
+    case GLGE_RESOURCE_RML:
+        return this->mainRMLTex;
+    case GLGE_RESOURCE_LIT:
+        return this->mainOutTex;
+    case GLGE_RESOURCE_EIDA:
+        return this->mainEIDATex;
+    case GLGE_RESOURCE_SOLID:
+        return this->mainSolidTex;
+    case GLGE_RESOURCE_TRANS_ACCUM:
+        return this->mainTransparentAccumTex;
+    case GLGE_RESOURCE_DEPTH:
+        return this->mainDepthTex;
+    case GLGE_RESOURCE_POST_PROCESSING:
+        return this->postProcessingTex;
+    case GLGE_RESOURCE_LAST_TICK:
+        return this->lastTickTex;
+    //the shadow maps are owned by the shadow pass
+    default:
+        return 0;
+    }
+}
+
 float Window::getWindowAspect()
 {
     //return the aspect ratio
@@ -1307,6 +1734,8 @@ void Window::bindLight(Light* l)
     if (l != nullptr)
     {
         this->lights.push_back(l);
+        //make sure the light is uploaded to the light ubo
+        l->queueUpdate();
     }
 
     //if the amount of bound light sources is bigger than the maximum supported light sources
@@ -2144,8 +2573,8 @@ void Window::clearGBuff()
     //clear the screen
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    //specify the color buffers
-    glDrawBuffers(glgeLenUsedColorBuffers, glgeUsedColorBuffers);
+    //specify the color buffers, unused attachments are skipped
+    glDrawBuffers(8, this->gBuffClearBuffers);
 
     //set the clear color to black
     glClearColor(0,0,0,0);
@@ -2154,7 +2583,7 @@ void Window::clearGBuff()
     glClear(GL_COLOR_BUFFER_BIT);
 
     //specify the color buffers to draw into
-    glDrawBuffers(glgeLenAllUsedColorBuffers, glgeAllUsedColorBuffers);
+    glDrawBuffers(8, this->gBuffDrawBuffers);
 }
 
 void Window::drawSolid()
@@ -2372,34 +2801,383 @@ void Window::drawSkybox()
     }
 }
 
+void Window::uploadLights()
+{
+    //store if the ubo is bound
+    bool uboBound = false;
+    //store the start of the current run of changed lights
+    int runStart = -1;
+    //loop over all lights and one past the end to close the last run
+    for (int i = 0; i <= (int)this->lights.size(); i++)
+    {
+        //check if the light at the index needs an update
+        bool dirty = (i < (int)this->lights.size()) ? this->lights[i]->shouldUpdate() : false;
+        //check if the light is dirty
+        if (dirty)
+        {
+            //store the new light data
+            ((LightData*)(this->lightDatas + 16))[i] = this->lights[i]->getLightData();
+            //say that the update is now done
+            this->lights[i]->updateDone();
+            //start a new run if none is open
+            if (runStart < 0) { runStart = i; }
+            //go to the next light
+            continue;
+        }
+        //check if a run of changed lights ended
+        if (runStart >= 0)
+        {
+            //check if the ubo is not bound
+            if (!uboBound)
+            {
+                //bind the ubo
+                glBindBuffer(GL_UNIFORM_BUFFER, this->lightUBO);
+                //store that the ubo is bound
+                uboBound = true;
+            }
+            //upload only the changed range of lights
+            this->uploadLightRange(runStart, i - runStart);
+            //close the run
+            runStart = -1;
+        }
+    }
+    //check if the amount of lights changed
+    if (this->uploadedLightCount != (int)this->lights.size())
+    {
+        //check if the ubo is not bound
+        if (!uboBound)
+        {
+            //bind the ubo
+            glBindBuffer(GL_UNIFORM_BUFFER, this->lightUBO);
+            //store that the ubo is bound
+            uboBound = true;
+        }
+        //update the light count
+        *(int*)this->lightDatas = (int)this->lights.size();
+        //upload only the light count
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(int), this->lightDatas);
+        //store the uploaded light count
+        this->uploadedLightCount = (int)this->lights.size();
+        //check if debug data gathering is enabled
+        if (glgeGatherDebugInfo)
+        {
+            //add the uploaded bytes
+            glgeBytesPassedToGPUT += sizeof(int);
+        }
+    }
+    //check if something was uploaded
+    if (uboBound)
+    {
+        //unbind the buffer
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        //bind the buffer to the correct slot
+        glBindBufferBase(GL_UNIFORM_BUFFER, 3, this->lightUBO);
+    }
+}
+
+void Window::uploadLightRange(int start, int count)
+{
+    //calculate the offset of the first light in bytes (the light array starts at byte 16)
+    unsigned int offset = 16 + start*sizeof(LightData);
+    //calculate the size of the range in bytes
+    unsigned int size = count*sizeof(LightData);
+    //upload only the changed lights
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, this->lightDatas + offset);
+    //check if debug data gathering is enabled
+    if (glgeGatherDebugInfo)
+    {
+        //add the uploaded bytes
+        glgeBytesPassedToGPUT += size;
+    }
+}
+
 void Window::shadowPass()
 {
+    //store the indices of all lights that cast shadows
+    std::vector<int> casters;
+    //store the resolution of the shadow map for each light
+    std::vector<int> resolutions = std::vector<int>(this->lights.size(), 0);
+    //loop over all light sources
+    for (int i = 0; i < (int)this->lights.size(); i++)
+    {
+        //reset the shadow caster statistics of the light
+        this->lights[i]->resetShadowCasterStats();
+        //check if the light source type is supported
+        if (this->lights[i]->getType() != GLGE_LIGHT_SOURCE_TYPE_SPOT)
+        {
+            //remove the shadow map from the light
+            this->lights[i]->setShadowRegion(ivec4(0,0,0,0), this->shadowTex, GLGE_SHADOW_ATLAS_SIZE);
+            //go to the next light
+            continue;
+        }
+        //get how important the shadow is for the camera, without a camera all shadows are equaly important
+        float importance = (this->mainCamera != NULL) ? this->lights[i]->getShadowImportance(this->mainCamera->getPos()) : 1.f;
+        //start with the biggest resolution
+        int res = GLGE_SHADOW_MAX_RESOLUTION;
+        //half the resolution while the half resolution is still enough for the importance
+        while ((res > GLGE_SHADOW_MIN_RESOLUTION) && ((res / 2) >= GLGE_SHADOW_MAX_RESOLUTION * importance)) { res /= 2; }
+        //store the resolution
+        resolutions[i] = res;
+        //store the light as a shadow caster
+        casters.push_back(i);
+    }
+    //sort the shadow casters by the resolution, biggest first. Keep the order of equal lights, so the regions don't jump around
+    std::stable_sort(casters.begin(), casters.end(), [&resolutions](int a, int b) { return resolutions[a] > resolutions[b]; });
+
+    //pack the shadow maps into the atlas. All sizes are powers of two and sorted descending, so placing them in z-order 
+    //tiles of the smallest resolution can't overlap or leave holes
+    //store the amount of tiles on one side of the atlas
+    unsigned int tilesPerSide = GLGE_SHADOW_ATLAS_SIZE / GLGE_SHADOW_MIN_RESOLUTION;
+    //store the next free tile in z-order
+    unsigned int cursor = 0;
+    //loop over all shadow casters
+    for (int i : casters)
+    {
+        //calculate the edge length in tiles
+        unsigned int edge = resolutions[i] / GLGE_SHADOW_MIN_RESOLUTION;
+        //check if the shadow map still fits into the atlas
+        if (cursor + edge*edge > tilesPerSide*tilesPerSide)
+        {
+            //the light gets no shadow map
+            this->lights[i]->setShadowRegion(ivec4(0,0,0,0), this->shadowTex, GLGE_SHADOW_ATLAS_SIZE);
+            //go to the next light
+            continue;
+        }
+        //decode the tile position from the z-order index
+        unsigned int x = 0;
+        unsigned int y = 0;
+        for (unsigned int b = 0; (1u << (2*b)) < tilesPerSide*tilesPerSide; b++)
+        {
+            //the even bits store the x position
+            x |= ((cursor >> (2*b)) & 1u) << b;
+            //the odd bits store the y position
+            y |= ((cursor >> (2*b + 1)) & 1u) << b;
+        }
+        //store the region of the light
+        this->lights[i]->setShadowRegion(ivec4(x*GLGE_SHADOW_MIN_RESOLUTION, y*GLGE_SHADOW_MIN_RESOLUTION, resolutions[i], resolutions[i]), 
+                                         this->shadowTex, GLGE_SHADOW_ATLAS_SIZE);
+        //go to the next free tile
+        cursor += edge*edge;
+    }
+
     //mark the beginning of the shadow pass
     glgeShadowPass = true;
+    //bind the shadow atlas
+    glBindFramebuffer(GL_FRAMEBUFFER, this->shadowFBO);
     //enable depth testing
     glEnable(GL_DEPTH_TEST);
+    //use the same depth direction as the geometry pass
+    glDepthFunc(GL_GREATER);
+    glClearDepth(0.f);
     //disable blending
     glDisable(GL_BLEND);
-    //set the clear color
-    glClearColor(0,0,0,0);
-    //loop over all light sources
-    for (size_t i = 0; i < this->lights.size(); i++)
-    {
-        //check if the light source type is supported
-        if (this->lights[i]->getType() != GLGE_LIGHT_SOURCE_TYPE_SPOT) { continue; }
+    //only draw and clear the region of the current light
+    glEnable(GL_SCISSOR_TEST);
+    //loop over all shadow casters
+    for (int i : casters)
+    {
+        //skip lights without a shadow map
+        if (this->lights[i]->getShadowRegion().z == 0) { continue; }
+        //check if the cached shadow map can be used
+        bool redraw = !this->lights[i]->isShadowCacheValid();
+        //check if something moved inside the frustum of the light
+        for (size_t r = 0; (r < this->shadowDirtyRegions.size()) && !redraw; r++)
+        {
+            //get the region
+            vec4 reg = this->shadowDirtyRegions[r];
+            //the shadow map must be redrawn if the region intersects the frustum of the light
+            redraw = glgeSphereInFrustum(this->lights[i]->getLightMat(), vec3(reg.x, reg.y, reg.z), reg.w);
+        }
+        //reuse the shadow map from the last frame
+        if (!redraw) { continue; }
         //bind the current shadow caster
         this->lights[i]->makeCurrentShadowCaster();
-        //say that the active light is the current
-        glgeCurrentShadowCaster = this->lights[i];
         //draw the scene geometry
         this->callDrawFunc();
+        //say that the shadow map is up to date
+        this->lights[i]->storeShadowCache();
+    }
+    //disable the scissor test again
+    glDisable(GL_SCISSOR_TEST);
+
+    //bind the framebuffer for the shadow cascades
+    glBindFramebuffer(GL_FRAMEBUFFER, this->cascadeFBO);
+    //all cascades have the same size
+    glViewport(0,0, GLGE_SHADOW_CASCADE_RESOLUTION,GLGE_SHADOW_CASCADE_RESOLUTION);
+    //store the amount of directional lights with cascades
+    int dirLights = 0;
+    //loop over all light sources
+    for (int i = 0; i < (int)this->lights.size(); i++)
+    {
+        //check if the light can get cascades
+        if ((this->lights[i]->getType() != GLGE_LIGHT_SOURCE_TYPE_DIRECTIONAL) || (dirLights >= GLGE_SHADOW_MAX_DIRECTIONAL) || (this->mainCamera == NULL))
+        {
+            //remove the cascades from the light
+            this->lights[i]->setCascadeLayer(-1);
+            //go to the next light
+            continue;
+        }
+        //store the first layer of the light
+        this->lights[i]->setCascadeLayer(dirLights * GLGE_SHADOW_CASCADE_COUNT);
+        //draw the cascades
+        this->drawCascades(this->lights[i], dirLights);
+        //go to the next directional light
+        dirLights++;
+    }
+    //no cascade is drawn anymore
+    glgeCurrentShadowCascade = -1;
+    //check if cascades where drawn
+    if (dirLights > 0)
+    {
+        //bind the cascade buffer
+        glBindBuffer(GL_UNIFORM_BUFFER, this->cascadeUBO);
+        //upload the cascade data
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CascadeData), &this->cascadeData);
+        //unbind the buffer
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        //bind the buffer to the correct slot
+        glBindBufferBase(GL_UNIFORM_BUFFER, 4, this->cascadeUBO);
+        //check if debug data gathering is enabled
+        if (glgeGatherDebugInfo)
+        {
+            //add the uploaded bytes
+            glgeBytesPassedToGPUT += sizeof(CascadeData);
+        }
     }
+    //bind the cascades to their texture unit
+    glBindTextureUnit(GLGE_SHADOW_CASCADE_TEXTURE_UNIT, this->cascadeTex);
+
+    //all changes are now in the shadow maps
+    this->shadowDirtyRegions.clear();
     //end the shadow pass
     glgeShadowPass = false;
+    //upload the new light space matrices and shadow regions
+    this->uploadLights();
     //correct the OpenGL viewport
     glViewport(0,0, this->size.x,this->size.y);
 }
 
+void Window::drawCascades(Light* light, int index)
+{
+    //get the range of the camera that gets shadows
+    float near = this->mainCamera->getNearPlane();
+    float far = std::min(this->mainCamera->getFarPlane(), GLGE_SHADOW_CASCADE_MAX_DISTANCE);
+    //get the tangent of the half field of view
+    float tHF = std::tan(this->mainCamera->getFOV() / 2.f);
+    //get the aspect ratio of the window
+    float ar = this->getWindowAspect();
+    //get the rotation and position of the camera
+    mat4 camRot = this->mainCamera->getRotMat();
+    vec3 camPos = this->mainCamera->getPos();
+
+    //build a rotation into light space, the z axis points in the direction of the light
+    vec3 f = light->getDir();
+    f.normalize();
+    //use an up vector that isn't parallel to the direction
+    vec3 up = (std::abs(f.y) > 0.99f) ? vec3(1,0,0) : vec3(0,1,0);
+    //calculate the right and up axis
+    vec3 r = up.cross(f);
+    r.normalize();
+    vec3 u = f.cross(r);
+    //store the rotation matrix
+    mat4 lightRot = mat4(r.x,r.y,r.z,0,
+                         u.x,u.y,u.z,0,
+                         f.x,f.y,f.z,0,
+                         0,  0,  0,  1);
+
+    //store the near distance of the current cascade
+    float splitNear = near;
+    //store the far distances of all cascades
+    float splits[4] = {far, far, far, far};
+    //loop over all cascades
+    for (int c = 0; c < GLGE_SHADOW_CASCADE_COUNT; c++)
+    {
+        //calculate the far distance with the practical split scheme (mix of logarithmic and uniform splits)
+        float t = (c + 1) / (float)GLGE_SHADOW_CASCADE_COUNT;
+        float splitFar = GLGE_SHADOW_CASCADE_SPLIT_LAMBDA * near * std::pow(far / near, t) + (1.f - GLGE_SHADOW_CASCADE_SPLIT_LAMBDA) * (near + (far - near) * t);
+
+        //calculate the corners of the slice of the camera frustum in world space
+        vec3 corners[8];
+        //store the center of the slice
+        vec3 center = vec3(0);
+        for (int k = 0; k < 8; k++)
+        {
+            //calculate the corner in view space
+            float d = (k & 4) ? splitFar : splitNear;
+            vec3 v = vec3(((k & 1) ? 1.f : -1.f) * d * tHF * ar, ((k & 2) ? 1.f : -1.f) * d * tHF, d);
+            //the rotation is orthogonal, so the transposed rotation brings the corner back into world space
+            corners[k] = vec3(camRot.m[0][0]*v.x + camRot.m[1][0]*v.y + camRot.m[2][0]*v.z,
+                              camRot.m[0][1]*v.x + camRot.m[1][1]*v.y + camRot.m[2][1]*v.z,
+                              camRot.m[0][2]*v.x + camRot.m[1][2]*v.y + camRot.m[2][2]*v.z) + camPos;
+            //add the corner to the center
+            center += corners[k];
+        }
+        //average the corners
+        center = center * 0.125f;
+        //calculate the radius of a sphere around the slice, a sphere dosn't change its size when the camera rotates
+        float radius = 0.f;
+        for (int k = 0; k < 8; k++)
+        {
+            //calculate the difference to the center
+            vec3 d = corners[k] - center;
+            //store the biggest distance
+            radius = std::max(radius, std::sqrt(d.x*d.x + d.y*d.y + d.z*d.z));
+        }
+        //round the radius up, so floating point noise dosn't change the size of the texels
+        radius = std::ceil(radius * 16.f) / 16.f;
+
+        //transform the center into light space
+        vec4 lc = lightRot * vec4(center.x, center.y, center.z, 1);
+        //snap the center to whole texels, so the shadow dosn't shimmer when the camera moves
+        float texel = (2.f * radius) / GLGE_SHADOW_CASCADE_RESOLUTION;
+        float lx = std::floor(lc.x / texel) * texel;
+        float ly = std::floor(lc.y / texel) * texel;
+        //calculate the depth range, include objects between the light and the slice
+        float zn = lc.z - radius - GLGE_SHADOW_CASCADE_CASTER_DISTANCE;
+        float zf = lc.z + radius;
+        //build the orthographic projection, the near plane maps to 1 like in the geometry pass
+        mat4 proj = mat4(1.f/radius, 0.f, 0.f, -lx/radius,
+                         0.f, 1.f/radius, 0.f, -ly/radius,
+                         0.f, 0.f, -2.f/(zf - zn), (zf + zn)/(zf - zn),
+                         0.f, 0.f, 0.f, 1.f);
+
+        //store the index of the cascade
+        int layer = index * GLGE_SHADOW_CASCADE_COUNT + c;
+        //store the light space matrix of the cascade
+        this->cascadeData.mats[layer] = proj * lightRot;
+        //store the far distance
+        splits[c] = splitFar;
+
+        //draw into the layer of the cascade
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->cascadeTex, 0, layer);
+        //clear the layer
+        glClear(GL_DEPTH_BUFFER_BIT);
+        //say which light and cascade is drawn
+        glgeCurrentShadowCaster = light;
+        glgeCurrentShadowMat = this->cascadeData.mats[layer];
+        glgeCurrentShadowCascade = layer;
+        //draw the scene geometry
+        this->callDrawFunc();
+
+        //the next cascade starts where this one ends
+        splitNear = splitFar;
+    }
+    //store the split distances
+    this->cascadeData.splits[index] = vec4(splits[0], splits[1], splits[2], splits[3]);
+}
+
+void Window::markShadowRegionDirty(vec4 sphere)
+{
+    //store the region
+    this->shadowDirtyRegions.push_back(sphere);
+}
+
+unsigned int Window::getShadowAtlas()
+{
+    //return the shadow atlas texture
+    return this->shadowTex;
+}
+
 void Window::copyGToPPFramebuffer(int source)
 {
     //check if the source is in range
@@ -2504,6 +3282,17 @@ void Window::super(std::string name, vec2 size, vec2 pos, unsigned int flags)
         //stop the function
         return;
     }
+    //check if bindless textures are requested but not supported
+    if (glgeBindlessTextures && !GLEW_ARB_bindless_texture)
+    {
+        //print a warning if warnings are enabled
+        if (glgeWarningOutput)
+        {
+            printf("[GLGE WARNING] Bindless textures are not supported by the driver, material textures are bound to texture units\n");
+        }
+        //use texture units
+        glgeBindlessTextures = false;
+    }
 
     //bind the context
     SDL_GL_MakeCurrent((SDL_Window*)this->window, this->glContext);
@@ -2676,6 +3465,15 @@ void Window::super(std::string name, vec2 size, vec2 pos, unsigned int flags)
     //unbind the render buffer
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
+    //by default, all attachments of the geometry buffer are used
+    for (int i = 0; i < 8; i++)
+    {
+        //draw into all attachments
+        this->gBuffDrawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+        //clear all attachments except the albedo attachment
+        this->gBuffClearBuffers[i] = (i == 0) ? GL_NONE : GL_COLOR_ATTACHMENT0 + i;
+    }
+
     //specify the number of used color buffers
     glDrawBuffers(glgeLenUsedColorBuffers, glgeUsedColorBuffers);
 
@@ -2888,6 +3686,86 @@ void Window::super(std::string name, vec2 size, vec2 pos, unsigned int flags)
     //create the default shader for transparent particles
     this->defaultTransparentParticleShader = new Shader(GLGE_DEFAULT_3D_PARTICLE_VERTEX_SHADER, GLGE_DEFAULT_TRANSPARENT_SHADER);
 
+    //create the depth texture for the shadow atlas
+    glGenTextures(1, &this->shadowTex);
+    //bind the texture
+    glBindTexture(GL_TEXTURE_2D, this->shadowTex);
+    //allocate the atlas
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, GLGE_SHADOW_ATLAS_SIZE, GLGE_SHADOW_ATLAS_SIZE, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    //set simple texture parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    //unbind the texture
+    glBindTexture(GL_TEXTURE_2D, 0);
+    //create the framebuffer for the shadow atlas
+    glGenFramebuffers(1, &this->shadowFBO);
+    //bind the framebuffer
+    glBindFramebuffer(GL_FRAMEBUFFER, this->shadowFBO);
+    //add the atlas as depth attachment
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, this->shadowTex, 0);
+    //the atlas has no color attachments
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    //check if the framebuffer is compleate
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Failed to create the framebuffer for the shadow atlas")
+    }
+    //unbind the framebuffer
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    //create the depth array texture for the shadow cascades
+    glGenTextures(1, &this->cascadeTex);
+    //bind the texture
+    glBindTexture(GL_TEXTURE_2D_ARRAY, this->cascadeTex);
+    //allocate a layer for every cascade
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, GLGE_SHADOW_CASCADE_RESOLUTION, GLGE_SHADOW_CASCADE_RESOLUTION, 
+                 GLGE_SHADOW_MAX_DIRECTIONAL * GLGE_SHADOW_CASCADE_COUNT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    //set simple texture parameters
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    //unbind the texture
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    //create the framebuffer for the cascades
+    glGenFramebuffers(1, &this->cascadeFBO);
+    //bind the framebuffer
+    glBindFramebuffer(GL_FRAMEBUFFER, this->cascadeFBO);
+    //add the first layer as depth attachment
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->cascadeTex, 0, 0);
+    //the cascades have no color attachments
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    //check if the framebuffer is compleate
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        //throw an error
+        GLGE_THROW_ERROR("Failed to create the framebuffer for the shadow cascades")
+    }
+    //unbind the framebuffer
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    //bind the cascades to their texture unit
+    glBindTextureUnit(GLGE_SHADOW_CASCADE_TEXTURE_UNIT, this->cascadeTex);
+    //create the uniform buffer for the cascade data
+    glCreateBuffers(1, &this->cascadeUBO);
+    //bind the buffer
+    glBindBuffer(GL_UNIFORM_BUFFER, this->cascadeUBO);
+    //allocate the buffer
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CascadeData), &this->cascadeData, GL_DYNAMIC_DRAW);
+    //unbind the buffer
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    //bind the buffer to location 4
+    glBindBufferBase(GL_UNIFORM_BUFFER, 4, this->cascadeUBO);
+
+    //pass the shadow atlas to the lighting shader
+    this->lightShader->setCustomTexture("glgeShadowAtlas", this->shadowTex);
+    //update the uniforms of the lighting shader
+    this->lightShader->recalculateUniforms();
+
     //create a new uniform buffer
     glCreateBuffers(1, &this->lightUBO);
     //bind it as a uniform buffer
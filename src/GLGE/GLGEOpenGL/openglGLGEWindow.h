@@ -55,6 +55,16 @@
  */
 #define GLGE_FRAMEBUFFER_CUSTOM_RENDER_TEXTURE 4
 
+/**
+ * @brief the amount of frames that can be read back at the same time while capturing
+ */
+#define GLGE_CAPTURE_RING_SIZE 4
+
+/**
+ * @brief store the read back buffers and the encoder thread of a frame capture, defined in openglGLGEWindow.cpp
+ */
+struct FrameCapture;
+
 /**
  * @brief a simple window to handle multiple windows
  */
@@ -415,6 +425,13 @@ public:
      */
     void setSkybox(const char* top, const char* bottom, const char* left, const char* right, const char* front, const char* back);
 
+    /**
+     * @brief set a skybox for the window from a KTX2 or DDS cube map, the prebuilt mip levels are uploaded directly
+     * 
+     * @param cubeMap the path to the cube map file
+     */
+    void setSkybox(const char* cubeMap);
+
     /**
      * @brief this function is called every time the window is moved
      * 
@@ -997,6 +1014,18 @@ public:
      * @brief do shadow-precalculation
      */
     void shadowPass();
+    /**
+     * @brief say that something changed inside a region, so all cached shadow maps that see the region must be redrawn
+     * 
+     * @param sphere the bounding sphere of the region (x, y, z for the center, w for the radius)
+     */
+    void markShadowRegionDirty(vec4 sphere);
+    /**
+     * @brief Get the depth texture all shadow maps are packed into
+     * 
+     * @return unsigned int the OpenGL texture of the shadow atlas
+     */
+    unsigned int getShadowAtlas();
     /**
      * @brief copy the image from the geometry buffer to the post processing buffer
      * 
@@ -1026,6 +1055,29 @@ public:
      */
     void setRenderPipeline(RenderPipeline* renderPipeline, bool del = true);
 
+    /**
+     * @brief Set the frame resources that need storage
+     * \par Info
+     * Unused resources are detached from theyre framebuffer and shrunk to a single pixel. This is called by the render pipeline.
+     * 
+     * @param resources a bitmask of GLGE_RESOURCE_* flags
+     */
+    void setUsedResources(unsigned int resources);
+
+    /**
+     * @brief Get the frame resources that have storage
+     * 
+     * @return unsigned int a bitmask of GLGE_RESOURCE_* flags
+     */
+    unsigned int getUsedResources();
+
+    /**
+     * @brief discard the content of frame resources
+     * 
+     * @param resources a bitmask of GLGE_RESOURCE_* flags
+     */
+    void invalidateResources(unsigned int resources);
+
     /**
      * @brief Get the default particle shader of this window
      * 
@@ -1040,6 +1092,45 @@ public:
      */
     Shader* getDefaultTransparentParticleShader();
 
+    /**
+     * @brief start to store every drawn frame in a numbered image file
+     * \par Info
+     * The frames are read into a ring of pixel pack buffers and written by a background thread once the GPU finished them, 
+     * so capturing only stalls if the encoder can't keep up. QOI and PPM are the fastest formats to write. 
+     * 
+     * @param pattern the path of the files with a printf placeholder for the frame number, like "capture/frame_%05d.qoi"
+     * @param fileFormat the file format to store the frames as (DEFAULT: GLGE_IMG_TYPE_ENDING)
+     */
+    void startCapture(const char* pattern, unsigned int fileFormat = GLGE_IMG_TYPE_ENDING);
+
+    /**
+     * @brief store the next drawn frame in an image file without stalling the frame
+     * 
+     * @param file the path of the file
+     * @param fileFormat the file format to store the frame as (DEFAULT: GLGE_IMG_TYPE_ENDING)
+     */
+    void captureFrame(const char* file, unsigned int fileFormat = GLGE_IMG_TYPE_ENDING);
+
+    /**
+     * @brief stop capturing, wait until all pending frames are written and free the read back buffers
+     */
+    void stopCapture();
+
+    /**
+     * @brief say if every frame is captured
+     * 
+     * @return true : every frame is captured | 
+     * @return false : no capture is running
+     */
+    bool isCapturing();
+
+    /**
+     * @brief Get the amount of frames that where written to files since the capture was created
+     * 
+     * @return unsigned int the amount of written frames
+     */
+    unsigned int getCapturedFrameCount();
+
 private:
     //////////////////////////////////
     //   Private handler functions  //
@@ -1066,6 +1157,42 @@ private:
      */
     void bindPPBuff();
 
+    /**
+     * @brief upload the data of all changed lights to the light ubo
+     */
+    void uploadLights();
+
+    /**
+     * @brief fit and draw the shadow cascades of a directional light to the main camera
+     * 
+     * @param light the directional light to draw the cascades for
+     * @param index the index of the light in the cascade data
+     */
+    void drawCascades(Light* light, int index);
+
+    /**
+     * @brief upload a range of the light data to the light ubo, the ubo must be bound
+     * 
+     * @param start the index of the first light to upload
+     * @param count the amount of lights to upload
+     */
+    void uploadLightRange(int start, int count);
+
+    /**
+     * @brief allocate the storage of a frame resource, unused resources get a single pixel
+     * 
+     * @param resource a single GLGE_RESOURCE_* flag
+     */
+    void allocateFrameResource(unsigned int resource);
+
+    /**
+     * @brief Get the texture of a frame resource
+     * 
+     * @param resource a single GLGE_RESOURCE_* flag
+     * @return unsigned int the OpenGL texture or 0 if the resource isn't owned by the window
+     */
+    unsigned int getFrameResourceTexture(unsigned int resource);
+
     /**
      * @brief super constructor for the window
      * 
@@ -1164,16 +1291,28 @@ private:
     /*
         Shadow pass stuff
     */
-    //store the framebuffer for shadow mapping
+    //store the framebuffer for the shadow atlas
     unsigned int shadowFBO = 0;
-    //store the screen space textures
+    //store the depth texture of the shadow atlas
     unsigned int shadowTex = 0;
+    //store the bounding spheres of all regions that changed since the last shadow pass
+    std::vector<vec4> shadowDirtyRegions;
+    //store the framebuffer for the shadow cascades
+    unsigned int cascadeFBO = 0;
+    //store the depth array texture for the shadow cascades
+    unsigned int cascadeTex = 0;
+    //store the uniform buffer for the cascade data
+    unsigned int cascadeUBO = 0;
+    //store the data of all shadow cascades
+    CascadeData cascadeData;
     //store the data for all the lights
     unsigned int lightUBO = 0;
     //store the data for all the lights
     uint8_t lightDatas[sizeof(LightData)*129];
     //store the light count
     unsigned int lightCount = 0;
+    //store the light count that was last uploaded to the light ubo
+    int uploadedLightCount = 0;
 
     /*
         Default shaders
@@ -1230,6 +1369,12 @@ private:
     unsigned int mainTransparentAccumTex = 0;
     //store the depth texture
     unsigned int mainDepthTex = 0;
+    //store the color buffers to draw into, unused attachments are set to GL_NONE
+    unsigned int gBuffDrawBuffers[8];
+    //store the color buffers to clear to black, this excludes the albedo attachment
+    unsigned int gBuffClearBuffers[8];
+    //store the frame resources that have storage
+    unsigned int usedResources = GLGE_RESOURCE_ALL;
 
     /*
         Last Tick Framebuffer
@@ -1290,6 +1435,17 @@ private:
     Shader* transparentCombineShader;
     //store if a custom transparent combination shader is bound
     bool customTransparentCombineShader = false;
+
+    /*
+        frame capture
+    */
+    //store the frame capture, NULL if nothing was captured
+    FrameCapture* capture = NULL;
+
+    /**
+     * @brief hand finished read backs to the encoder and read the current frame if it should be captured
+     */
+    void updateCapture();
 };
 
 /**
@@ -11,6 +11,7 @@
 
 #include "glgeAtlasFile.hpp"
 #include "GLGEIndependend/glgeErrors.hpp"
+#include <iterator>
 
 /**
  * @brief helper function to print the data in a beautifull way
@@ -54,14 +55,14 @@ bool GLGEAtlasFile::open( std::string fp, const char mode )
         exit(1);
     }
 
-    // open the file
+    // open the file, the integers are stored as raw bytes so no line endings may be converted
     if ( mode == 'r' )
     {
-        this->infile = std::ifstream(fp);
+        this->infile = std::ifstream(fp, std::ios::binary);
     }
     else if ( mode == 'w' )
     {
-        this->outfile = std::ofstream(fp);
+        this->outfile = std::ofstream(fp, std::ios::binary);
     }
     
     // save operation mode
@@ -118,16 +119,13 @@ bool GLGEAtlasFile::write()
 // read from a file
 bool GLGEAtlasFile::read()
 {
-    // read the full contents of the file
-    std::string data = "";
-    std::string line = "";
-
-    while ( std::getline( this->infile, line ) ) { data += line; }
+    // read the full contents of the file, getline would drop the bytes of integers that look like line breaks
+    std::string data( ( std::istreambuf_iterator<char>( this->infile ) ), std::istreambuf_iterator<char>() );
 
     // Read the Header //
 
-    // header
-    if ( data.substr(0,16) != GLGE_ATLAS_FILE_HEADER ) {
+    // header, texture count, width and height
+    if ( data.size() < 28 || data.substr(0,16) != GLGE_ATLAS_FILE_HEADER ) {
         printf(GLGE_ERROR_ATLAS_INVALID, this->fp.c_str());
         return false;
     }
@@ -141,14 +139,26 @@ bool GLGEAtlasFile::read()
     this->size.x = this->unpackInt( data.substr(20,4) );
     this->size.y = this->unpackInt( data.substr(24,4) );
 
+    // every texture takes at least 20 bytes, so a count that dosn't fit into the file is invalid
+    if ( textureCount < 0 || (size_t)textureCount > ( data.size() - 28 ) / 20 ) {
+        printf(GLGE_ERROR_ATLAS_INVALID, this->fp.c_str());
+        return false;
+    }
+
     // read textures //
-    int start = 28;
+    size_t start = 28;
     for ( int i = 0; i < textureCount; i++ )
     {
         // image data
         GLGEAtlasImage img;
         // read the first four bits for the name lenght
+        if ( data.size() - start < 4 ) { printf(GLGE_ERROR_ATLAS_INVALID, this->fp.c_str()); return false; }
         int nl = this->unpackInt( data.substr(start,4) ); start += 4;
+        // the name and the four integers after it must be inside of the file
+        if ( nl < 0 || (size_t)nl > data.size() - start || data.size() - start - nl < 16 ) {
+            printf(GLGE_ERROR_ATLAS_INVALID, this->fp.c_str());
+            return false;
+        }
         // read the name
         img.name = data.substr( start, nl ); start += nl;
         // read the pos
@@ -234,8 +244,8 @@ void GLGEAtlasFile::writeInt( int num, int numBytes )
 
 int GLGEAtlasFile::unpackInt( std::string inp )
 {
-    // go through all the charactars and add them to the final integer
-    int out = 0;
-    for ( ulong i = 0; i < inp.size(); i++ ) { out += inp[i] << (inp.size()-i-1)*8; }
-    return out;
+    // go through all the charactars and add them to the final integer, the bytes are unsigned so they don't carry a sign into the higher bytes
+    uint32_t out = 0;
+    for ( ulong i = 0; i < inp.size(); i++ ) { out |= (uint32_t)(uint8_t)inp[i] << (inp.size()-i-1)*8; }
+    return (int)out;
 }
\ No newline at end of file
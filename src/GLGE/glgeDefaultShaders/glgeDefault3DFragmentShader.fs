@@ -117,7 +117,9 @@ void main()
     if(col.w < 0.5){discard;}
 
     //if a normal map is active, get the normal of the normal map and use it, else use vec3(0,0,1)
-    vec3 n = mix(vec3(0,0,1),normalize(texture(glgeNormalMap,frag.uv).rgb * 2.f - 1.f),float(glgeNormalMapActive));
+    //only x and y are read, z is reconstructed so two chanel (BC5) normal maps work too
+    vec2 nXY = texture(glgeNormalMap,frag.uv).rg * 2.f - 1.f;
+    vec3 n = mix(vec3(0,0,1),normalize(vec3(nXY, sqrt(max(1.f - dot(nXY,nXY), 0.f)))),float(glgeNormalMapActive));
     n = normalize(TBN * n);
 
     //read the roughness and again use multiplikation like for the albedo texture
@@ -0,0 +1,75 @@
+/**
+ * @file benchBlockCompression.cpp
+ * @author DM8AT
+ * @brief measure the speed of the BCn encoder, build it with GLGE_BC_NO_SIMD to measure the scalar code
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "../tests/glgeTest.hpp"
+//include the block compression
+#include "../GLGE/GLGEIndependend/glgeBlockCompression.h"
+//include the needed standard librarys
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief the width and height of the compressed image
+ */
+#define GLGE_BENCH_BC_SIZE 512
+/**
+ * @brief how often every format is compressed, the fastest run is used
+ */
+#define GLGE_BENCH_BC_RUNS 3
+
+int main()
+{
+    //say wich code is measured
+#if !defined(GLGE_BC_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    printf("[GLGE BENCH] block compression with SSE2, %dx%d pixels, fastest of %d runs\n", GLGE_BENCH_BC_SIZE, GLGE_BENCH_BC_SIZE, GLGE_BENCH_BC_RUNS);
+#else
+    printf("[GLGE BENCH] block compression without SIMD, %dx%d pixels, fastest of %d runs\n", GLGE_BENCH_BC_SIZE, GLGE_BENCH_BC_SIZE, GLGE_BENCH_BC_RUNS);
+#endif
+    //create a smooth image with noise
+    const int size = GLGE_BENCH_BC_SIZE;
+    std::vector<uint8_t> rgba((size_t)size * size * 4);
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            uint8_t* p = rgba.data() + ((size_t)y * size + x) * 4;
+            p[0] = (uint8_t)((x + (x * y) % 7) & 0xFF);
+            p[1] = (uint8_t)(128 + 100 * std::sin(y * 0.05));
+            p[2] = (uint8_t)((x ^ y) & 0xFF);
+            p[3] = (uint8_t)((x + y) / 4);
+        }
+    }
+
+    //compress the image in every format and preset, the checksum must be the same with and without SIMD
+    const unsigned int formats[] = {GLGE_BC1, GLGE_BC3, GLGE_BC4, GLGE_BC5, GLGE_BC7};
+    const char* presets[] = {"fast", "normal", "high"};
+    uint64_t checksum = 0;
+    for (unsigned int format : formats)
+    {
+        for (unsigned int preset = GLGE_BC_PRESET_FAST; preset <= GLGE_BC_PRESET_HIGH; preset++)
+        {
+            double time = 1e9;
+            std::vector<uint8_t> blocks;
+            for (int r = 0; r < GLGE_BENCH_BC_RUNS; r++)
+            {
+                double start = glgeTestTime();
+                blocks = glgeCompressBlocks(rgba.data(), size, size, format, preset);
+                time = std::min(time, glgeTestTime() - start);
+            }
+            for (uint8_t b : blocks) { checksum = checksum * 31 + b; }
+            printf("[GLGE BENCH] %-4s %-6s : %8.2f ms, %7.2f M pixels/s\n", glgeGetBlockCompressionName(format), presets[preset], time * 1000.0,
+                   (double)size * size / 1e6 / time);
+        }
+    }
+    printf("[GLGE BENCH] checksum %llu\n", (unsigned long long)checksum);
+    return 0;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file benchCompression.cpp
+ * @author DM8AT
+ * @brief measure the ratio and the speed of the scene compression against storing the data uncompressed
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "../tests/glgeTest.hpp"
+//include the compression
+#include "../GLGE/GLGEIndependend/glgeCompression.h"
+//include the scenes
+#include "../GLGE/GLGEIndependend/GLGEScene.hpp"
+//include the needed standard librarys
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cmath>
+#include <stdio.h>
+
+/**
+ * @brief the size of the data blocks that are compressed
+ */
+#define GLGE_BENCH_COMPRESSION_SIZE (8*1024*1024)
+/**
+ * @brief how often every block is compressed and decompressed, the fastest run is used
+ */
+#define GLGE_BENCH_COMPRESSION_RUNS 5
+/**
+ * @brief the amount of objects in the benchmark scene
+ */
+#define GLGE_BENCH_SCENE_OBJECTS 20
+/**
+ * @brief the amount of vertices of every object in the benchmark scene
+ */
+#define GLGE_BENCH_SCENE_VERTICES (16*1024)
+
+/**
+ * @brief a mesh like object with the vertex layout of GLGE, it only stores floats like Object::encode
+ */
+class BenchMesh
+{
+public:
+    /**
+     * @brief store the vertex floats
+     */
+    std::vector<float> floats;
+
+    /**
+     * @brief encode the mesh
+     *
+     * @return Data* the encoded data
+     */
+    Data* encode()
+    {
+        Data* dat = new Data();
+        dat->writeULong(this->floats.size());
+        dat->writeLittleEndianArray(this->floats.data(), this->floats.size());
+        return dat;
+    }
+
+    /**
+     * @brief decode the mesh
+     *
+     * @param dat the data to decode from
+     */
+    void decode(DataView dat)
+    {
+        this->floats.resize(dat.readULong());
+        dat.readLittleEndianArray(this->floats.data(), this->floats.size());
+    }
+};
+
+/**
+ * @brief fill a vector with the floats of a grid mesh, 12 floats per vertex like the GLGE vertex layout
+ *
+ * @param floats the vector to fill
+ * @param vertices the amount of vertices
+ * @param seed changes the position of the grid
+ */
+static void glgeBenchFillMesh(std::vector<float>& floats, size_t vertices, int seed)
+{
+    floats.resize(vertices * 12);
+    size_t width = 256;
+    for (size_t i = 0; i < vertices; i++)
+    {
+        float x = (float)(i % width) * 0.5f + seed;
+        float z = (float)(i / width) * 0.5f;
+        float* v = &floats[i * 12];
+        //position with a small height function
+        v[0] = x; v[1] = std::sin(x * 0.1f) * std::cos(z * 0.1f); v[2] = z;
+        //a white color
+        v[3] = 1.f; v[4] = 1.f; v[5] = 1.f; v[6] = 1.f;
+        //the texture coordinate
+        v[7] = (float)(i % width) / width; v[8] = (float)(i / width) / width;
+        //a normal that points mostly up
+        v[9] = 0.f; v[10] = 1.f; v[11] = 0.f;
+    }
+}
+
+/**
+ * @brief compress and decompress a block and print the ratio and the speed compared to a plain copy
+ *
+ * @param name the name of the data
+ * @param src the data to compress
+ * @param size the size of the data in bytes
+ * @return true : the data decompressed to the input | false : the decompressed data is wrong
+ */
+static bool glgeBenchBlock(const char* name, const uint8_t* src, size_t size)
+{
+    std::vector<uint8_t> packed(glgeCompressBound(size));
+    std::vector<uint8_t> out(size);
+    double mb = size / (1024.0 * 1024.0);
+    bool same = true;
+
+    //the uncompressed path copies the data
+    double copyTime = 1e9;
+    for (int r = 0; r < GLGE_BENCH_COMPRESSION_RUNS; r++)
+    {
+        double start = glgeTestTime();
+        std::memcpy(out.data(), src, size);
+        copyTime = std::min(copyTime, glgeTestTime() - start);
+    }
+    printf("[GLGE BENCH] %-6s uncompressed : ratio %5.2f, write %8.1f MB/s, read %6.2f GB/s\n", name, 1.0, mb / copyTime, mb / 1024.0 / copyTime);
+
+    //compress with both modes
+    const uint8_t modes[] = {GLGE_COMPRESSION_FAST, GLGE_COMPRESSION_HIGH};
+    const char* modeNames[] = {"fast", "high"};
+    for (int m = 0; m < 2; m++)
+    {
+        double packTime = 1e9, unpackTime = 1e9;
+        size_t packedSize = 0;
+        for (int r = 0; r < GLGE_BENCH_COMPRESSION_RUNS; r++)
+        {
+            double start = glgeTestTime();
+            packedSize = glgeCompress(src, size, packed.data(), modes[m]);
+            packTime = std::min(packTime, glgeTestTime() - start);
+            start = glgeTestTime();
+            same &= glgeDecompress(packed.data(), packedSize, out.data(), size);
+            unpackTime = std::min(unpackTime, glgeTestTime() - start);
+        }
+        same &= (std::memcmp(out.data(), src, size) == 0);
+        printf("[GLGE BENCH] %-6s %-12s : ratio %5.2f, write %8.1f MB/s, read %6.2f GB/s\n", name, modeNames[m],
+               (double)size / packedSize, mb / packTime, mb / 1024.0 / unpackTime);
+    }
+    return same;
+}
+
+/**
+ * @brief store and load a scene with a compression mode and print the file size and the times
+ *
+ * @param mode the compression mode
+ * @param modeName the name of the compression mode
+ * @param meshes the meshes to store
+ * @return true : all objects were loaded correctly | false : an object changed
+ */
+static bool glgeBenchScene(uint8_t mode, const char* modeName, std::vector<BenchMesh>& meshes)
+{
+    //store the scene
+    double storeTime = 0;
+    {
+        Scene scene("benchCompressionScene");
+        scene.setCompression(mode);
+        for (size_t i = 0; i < meshes.size(); i++) { scene.set<BenchMesh>(&meshes[i], "mesh" + std::to_string(i)); }
+        double start = glgeTestTime();
+        scene.safeFile();
+        storeTime = glgeTestTime() - start;
+    }
+    //get the size of the scene file
+    FILE* f = fopen("benchCompressionScene.glges", "rb");
+    long fileSize = 0;
+    if (f) { fseek(f, 0, SEEK_END); fileSize = ftell(f); fclose(f); }
+
+    //load the scene and decode every object
+    bool same = true;
+    double loadTime = 1e9;
+    for (int r = 0; r < GLGE_BENCH_COMPRESSION_RUNS; r++)
+    {
+        double start = glgeTestTime();
+        Scene scene("benchCompressionScene");
+        scene.load();
+        std::vector<NamedObject*> objs = scene.getAllObjects();
+        size_t floats = 0;
+        for (NamedObject* obj : objs)
+        {
+            BenchMesh* mesh = obj->getObject<BenchMesh>();
+            floats += mesh->floats.size();
+            delete mesh;
+        }
+        loadTime = std::min(loadTime, glgeTestTime() - start);
+        same &= (objs.size() == meshes.size()) && (floats == meshes.size() * meshes[0].floats.size());
+    }
+    printf("[GLGE BENCH] scene  %-12s : %9ld bytes, store %7.2f ms, load and decode %7.2f ms\n", modeName, fileSize, storeTime * 1000.0, loadTime * 1000.0);
+    //remove the scene file
+    std::remove("benchCompressionScene.glges");
+    std::remove("benchCompressionScene.glges.delta");
+    return same;
+}
+
+int main()
+{
+    bool same = true;
+    printf("[GLGE BENCH] blocks of %d bytes, fastest of %d runs\n", GLGE_BENCH_COMPRESSION_SIZE, GLGE_BENCH_COMPRESSION_RUNS);
+
+    //vertex floats like Object::encode stores them
+    std::vector<float> mesh;
+    glgeBenchFillMesh(mesh, GLGE_BENCH_COMPRESSION_SIZE / (12 * sizeof(float)), 0);
+    same &= glgeBenchBlock("mesh", (const uint8_t*)mesh.data(), mesh.size() * sizeof(float));
+
+    //text like data from a small set of words
+    const char* words[] = {"object ", "scene ", "vertex ", "texture ", "light ", "shader ", "camera ", "mesh "};
+    std::string text;
+    uint32_t state = 2463534242u;
+    while (text.size() < GLGE_BENCH_COMPRESSION_SIZE)
+    {
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        text += words[state % 8];
+    }
+    text.resize(GLGE_BENCH_COMPRESSION_SIZE);
+    same &= glgeBenchBlock("text", (const uint8_t*)text.data(), text.size());
+
+    //random data can't be compressed, this is the worst case
+    std::vector<uint8_t> random(GLGE_BENCH_COMPRESSION_SIZE);
+    for (size_t i = 0; i < random.size(); i++)
+    {
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        random[i] = (uint8_t)state;
+    }
+    same &= glgeBenchBlock("random", random.data(), random.size());
+
+    //store a scene of meshes with every compression mode
+    printf("[GLGE BENCH] scene of %d meshes with %d vertices\n", GLGE_BENCH_SCENE_OBJECTS, GLGE_BENCH_SCENE_VERTICES);
+    std::vector<BenchMesh> meshes(GLGE_BENCH_SCENE_OBJECTS);
+    for (size_t i = 0; i < meshes.size(); i++) { glgeBenchFillMesh(meshes[i].floats, GLGE_BENCH_SCENE_VERTICES, (int)i); }
+    same &= glgeBenchScene(GLGE_COMPRESSION_NONE, "uncompressed", meshes);
+    same &= glgeBenchScene(GLGE_COMPRESSION_FAST, "fast", meshes);
+    same &= glgeBenchScene(GLGE_COMPRESSION_HIGH, "high", meshes);
+
+    //check that the decompressed data was correct
+    if (!same) { printf("[GLGE BENCH] DECOMPRESSED DATA CHANGED\n"); }
+    return same ? 0 : 1;
+}
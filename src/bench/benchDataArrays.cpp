@@ -0,0 +1,127 @@
+/**
+ * @file benchDataArrays.cpp
+ * @author DM8AT
+ * @brief compare writing and reading arrays with Data in one pass against writing and reading every element on its own
+ * @version 0.1
+ * @date 2024-03-26
+ * 
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license. 
+ * 
+ */
+
+//include the test helpers
+#include "../tests/glgeTest.hpp"
+//include the data class
+#include "../GLGE/GLGEIndependend/GLGEData.h"
+
+/**
+ * @brief the amount of elements in every array
+ */
+#define GLGE_BENCH_ARRAY_SIZE (8*1024*1024)
+/**
+ * @brief how often every array is written and read
+ */
+#define GLGE_BENCH_ARRAY_RUNS 5
+
+/**
+ * @brief print the speed of a write and a read
+ */
+static void glgeBenchPrint(const char* name, size_t bytes, double writeTime, double readTime)
+{
+    double mb = bytes / (1024.0 * 1024.0);
+    printf("[GLGE BENCH] %-32s : write %8.1f MB/s, read %8.1f MB/s\n", name, mb / writeTime, mb / readTime);
+}
+
+int main()
+{
+    //create the values
+    std::vector<float> floats(GLGE_BENCH_ARRAY_SIZE);
+    std::vector<int> ints(GLGE_BENCH_ARRAY_SIZE);
+    for (size_t i = 0; i < floats.size(); i++) { floats[i] = i * 0.25f - 1000.f; ints[i] = (int)(i * 2654435761u); }
+    std::vector<float> floatsOut(GLGE_BENCH_ARRAY_SIZE);
+    std::vector<int> intsOut(GLGE_BENCH_ARRAY_SIZE);
+    size_t bytes = floats.size() * sizeof(float);
+    //store a checksum, so the reads are not optimized away
+    double sum = 0;
+    printf("[GLGE BENCH] arrays of %d elements of 4 bytes, %d runs\n", GLGE_BENCH_ARRAY_SIZE, GLGE_BENCH_ARRAY_RUNS);
+
+    //write and read every float on its own like before the array functions existed
+    double writeTime = 0, readTime = 0;
+    for (int r = 0; r < GLGE_BENCH_ARRAY_RUNS; r++)
+    {
+        Data dat;
+        double start = glgeTestTime();
+        for (size_t i = 0; i < floats.size(); i++) { dat.writeFloat(floats[i]); }
+        writeTime += glgeTestTime() - start;
+        start = glgeTestTime();
+        for (size_t i = 0; i < floatsOut.size(); i++) { floatsOut[i] = dat.readFloat(); }
+        readTime += glgeTestTime() - start;
+        sum += floatsOut[r];
+    }
+    glgeBenchPrint("float, per element", bytes, writeTime / GLGE_BENCH_ARRAY_RUNS, readTime / GLGE_BENCH_ARRAY_RUNS);
+
+    //write and read the floats as one big endian array
+    writeTime = 0; readTime = 0;
+    for (int r = 0; r < GLGE_BENCH_ARRAY_RUNS; r++)
+    {
+        Data dat;
+        double start = glgeTestTime();
+        dat.writeArray(floats.data(), floats.size());
+        writeTime += glgeTestTime() - start;
+        start = glgeTestTime();
+        dat.readArray(floatsOut.data(), floatsOut.size());
+        readTime += glgeTestTime() - start;
+        sum += floatsOut[r];
+    }
+    glgeBenchPrint("float, writeArray / readArray", bytes, writeTime / GLGE_BENCH_ARRAY_RUNS, readTime / GLGE_BENCH_ARRAY_RUNS);
+
+    //write and read the floats as one little endian array, this is a plain copy
+    writeTime = 0; readTime = 0;
+    for (int r = 0; r < GLGE_BENCH_ARRAY_RUNS; r++)
+    {
+        Data dat;
+        double start = glgeTestTime();
+        dat.writeLittleEndianArray(floats.data(), floats.size());
+        writeTime += glgeTestTime() - start;
+        start = glgeTestTime();
+        dat.readLittleEndianArray(floatsOut.data(), floatsOut.size());
+        readTime += glgeTestTime() - start;
+        sum += floatsOut[r];
+    }
+    glgeBenchPrint("float, little endian array", bytes, writeTime / GLGE_BENCH_ARRAY_RUNS, readTime / GLGE_BENCH_ARRAY_RUNS);
+
+    //write and read every int on its own
+    writeTime = 0; readTime = 0;
+    for (int r = 0; r < GLGE_BENCH_ARRAY_RUNS; r++)
+    {
+        Data dat;
+        double start = glgeTestTime();
+        for (size_t i = 0; i < ints.size(); i++) { dat.writeInt(ints[i]); }
+        writeTime += glgeTestTime() - start;
+        start = glgeTestTime();
+        for (size_t i = 0; i < intsOut.size(); i++) { intsOut[i] = dat.readInt(); }
+        readTime += glgeTestTime() - start;
+        sum += intsOut[r];
+    }
+    glgeBenchPrint("int, per element", bytes, writeTime / GLGE_BENCH_ARRAY_RUNS, readTime / GLGE_BENCH_ARRAY_RUNS);
+
+    //write and read the ints as one big endian array
+    writeTime = 0; readTime = 0;
+    for (int r = 0; r < GLGE_BENCH_ARRAY_RUNS; r++)
+    {
+        Data dat;
+        double start = glgeTestTime();
+        dat.writeArray(ints.data(), ints.size());
+        writeTime += glgeTestTime() - start;
+        start = glgeTestTime();
+        dat.readArray(intsOut.data(), intsOut.size());
+        readTime += glgeTestTime() - start;
+        sum += intsOut[r];
+    }
+    glgeBenchPrint("int, writeArray / readArray", bytes, writeTime / GLGE_BENCH_ARRAY_RUNS, readTime / GLGE_BENCH_ARRAY_RUNS);
+
+    //check that the last read returned the written values
+    bool same = (intsOut == ints) && (floatsOut == floats);
+    printf("[GLGE BENCH] checksum %f%s\n", sum, same ? "" : ", VALUES CHANGED");
+    return same ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file benchDecoders.cpp
+ * @author DM8AT
+ * @brief measure the speed of the decoders that are fuzzed, so the checks against untrusted sizes can be compared to older versions
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "../tests/glgeTest.hpp"
+//include the scenes
+#include "../GLGE/GLGEIndependend/GLGEScene.hpp"
+//include the compression modes
+#include "../GLGE/GLGEIndependend/glgeCompression.h"
+//include the mesh encoding
+#include "../GLGE/GLGEIndependend/glge3DcoreDefClasses.h"
+//include the atlas files
+#include "../GLGE/glgeAtlasFile.hpp"
+//include the object type of the fuzz corpus
+#include "../fuzz/glgeFuzz.hpp"
+//include the needed standard librarys
+#include <vector>
+#include <string>
+#include <cstdio>
+
+/**
+ * @brief how often every decoder runs, the fastest run is used
+ */
+#define GLGE_BENCH_DECODER_RUNS 5
+/**
+ * @brief the amount of objects in the benchmark scene
+ */
+#define GLGE_BENCH_DECODER_OBJECTS 2000
+/**
+ * @brief the amount of images in the benchmark atlas file
+ */
+#define GLGE_BENCH_DECODER_IMAGES 100000
+
+/**
+ * @brief print the speed of a decoder
+ */
+static void glgeBenchPrint(const char* name, size_t bytes, double time)
+{
+    printf("[GLGE BENCH] %-36s : %10zu bytes, %8.2f ms, %8.1f MB/s\n", name, bytes, time * 1000.0, bytes / (1024.0 * 1024.0) / time);
+}
+
+/**
+ * @brief get the size of a file
+ *
+ * @param path the path to the file
+ * @return size_t the size in bytes, 0 if the file doesn't exist
+ */
+static size_t glgeBenchFileSize(const std::string& path)
+{
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) { return 0; }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return (size_t)size;
+}
+
+/**
+ * @brief store a scene of small objects and measure how fast it is loaded and decoded
+ *
+ * @param mode the compression mode
+ * @param name the name to print
+ * @return size_t the amount of decoded integers, so the decode is not optimized away
+ */
+static size_t glgeBenchScene(uint8_t mode, const char* name)
+{
+    //store the scene
+    {
+        Scene scene("benchDecodersScene");
+        scene.setCompression(mode, 64);
+        for (int i = 0; i < GLGE_BENCH_DECODER_OBJECTS; i++)
+        {
+            GLGEFuzzObject obj;
+            obj.name = "object " + std::to_string(i);
+            for (unsigned int j = 0; j < 256; j++) { obj.ints.push_back(j * 3 + i); obj.floats.push_back(j * 0.5f); }
+            scene.set<GLGEFuzzObject>(&obj, "obj" + std::to_string(i));
+        }
+        scene.safeFile();
+    }
+    size_t bytes = glgeBenchFileSize("benchDecodersScene.glges");
+
+    //load the scene and decode every object
+    size_t sum = 0;
+    double time = 1e9;
+    for (int r = 0; r < GLGE_BENCH_DECODER_RUNS; r++)
+    {
+        double start = glgeTestTime();
+        Scene scene("benchDecodersScene");
+        scene.load();
+        std::vector<NamedObject*> objs = scene.getAllObjects();
+        for (NamedObject* obj : objs)
+        {
+            GLGEFuzzObject* o = obj->getObject<GLGEFuzzObject>();
+            sum += o->ints.size();
+            delete o;
+        }
+        time = std::min(time, glgeTestTime() - start);
+        for (NamedObject* obj : objs) { delete obj; }
+    }
+    glgeBenchPrint(name, bytes, time);
+    std::remove("benchDecodersScene.glges");
+    return sum;
+}
+
+int main()
+{
+    size_t sum = 0;
+    printf("[GLGE BENCH] fastest of %d runs\n", GLGE_BENCH_DECODER_RUNS);
+
+    //read a stream of mixed values with DataView
+    {
+        Data dat;
+        for (int i = 0; i < 1000000; i++)
+        {
+            dat.writeInt(i);
+            dat.writeFloat(i * 0.5f);
+            dat.writeVarInt(i & 0x3FFF);
+            dat.writeString("obj");
+        }
+        double time = 1e9;
+        for (int r = 0; r < GLGE_BENCH_DECODER_RUNS; r++)
+        {
+            double start = glgeTestTime();
+            DataView view(dat.getReadPointer(), dat.getLen());
+            for (int i = 0; i < 1000000; i++)
+            {
+                sum += view.readInt();
+                sum += (size_t)view.readFloat();
+                sum += view.readVarInt();
+                sum += view.readString().size();
+            }
+            time = std::min(time, glgeTestTime() - start);
+        }
+        glgeBenchPrint("DataView mixed values", dat.getLen(), time);
+    }
+
+    //decode a mesh with about one million vertices
+    {
+        std::vector<Vertex> vertices(1024 * 1024, Vertex(1, 2, 3, 0.5f, 0.5f));
+        std::vector<unsigned int> indices(3 * 1024 * 1024);
+        for (size_t i = 0; i < indices.size(); i++) { indices[i] = (unsigned int)(i / 3); }
+        Data dat;
+        glgeEncodeMesh(&dat, vertices, indices);
+        double time = 1e9;
+        for (int r = 0; r < GLGE_BENCH_DECODER_RUNS; r++)
+        {
+            double start = glgeTestTime();
+            DataView view(dat.getReadPointer(), dat.getLen());
+            std::vector<Vertex> outVertices;
+            std::vector<unsigned int> outIndices;
+            glgeDecodeMesh(view, outVertices, outIndices);
+            sum += outIndices.size();
+            time = std::min(time, glgeTestTime() - start);
+        }
+        glgeBenchPrint("glgeDecodeMesh", dat.getLen(), time);
+    }
+
+    //load scenes with every compression mode
+    sum += glgeBenchScene(GLGE_COMPRESSION_NONE, "Scene load, uncompressed");
+    sum += glgeBenchScene(GLGE_COMPRESSION_FAST, "Scene load, fast compression");
+    sum += glgeBenchScene(GLGE_COMPRESSION_HIGH, "Scene load, high compression");
+
+    //read an atlas file with a lot of images
+    {
+        const std::string path = "benchDecodersAtlas.glgea";
+        {
+            GLGEAtlasFile atlas;
+            atlas.open(path, 'w');
+            atlas.size = vec2(4096, 4096);
+            for (int i = 0; i < GLGE_BENCH_DECODER_IMAGES; i++) { atlas.addImage("textures/image" + std::to_string(i) + ".png", vec2(i % 4096, i / 4096), vec2(16, 16)); }
+            atlas.write();
+            atlas.close();
+        }
+        double time = 1e9;
+        for (int r = 0; r < GLGE_BENCH_DECODER_RUNS; r++)
+        {
+            double start = glgeTestTime();
+            GLGEAtlasFile atlas;
+            atlas.open(path, 'r');
+            atlas.read();
+            atlas.close();
+            sum += atlas.images.size();
+            time = std::min(time, glgeTestTime() - start);
+        }
+        glgeBenchPrint("GLGEAtlasFile::read", glgeBenchFileSize(path), time);
+        std::remove(path.c_str());
+    }
+
+    printf("[GLGE BENCH] checksum %zu\n", sum);
+    return 0;
+}
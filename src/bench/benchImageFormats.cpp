@@ -0,0 +1,122 @@
+/**
+ * @file benchImageFormats.cpp
+ * @author DM8AT
+ * @brief compare the encode and decode speed and the file size of QOI and PNG images
+ * @version 0.1
+ * @date 2024-03-26
+ * 
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license. 
+ * 
+ */
+
+//include the test helpers
+#include "../tests/glgeTest.hpp"
+//include the vectors used by the image functions
+#include "../GLGE/CML/CML.h"
+//include the images
+#include "../GLGE/GLGEIndependend/glgeImage.h"
+//include the needed standard librarys
+#include <vector>
+#include <cstring>
+
+/**
+ * @brief the width and height of the test image
+ */
+#define GLGE_BENCH_IMAGE_SIZE 1024
+/**
+ * @brief how often every image is stored and loaded
+ */
+#define GLGE_BENCH_IMAGE_RUNS 10
+
+/**
+ * @brief get the size of a file
+ */
+static long glgeBenchFileSize(const char* file)
+{
+    FILE* f = fopen(file, "rb");
+    if (!f) { return -1; }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+/**
+ * @brief store and load the image in one format and print the results
+ * 
+ * @param name the name of the format
+ * @param file the file to write
+ * @param format the GLGE_IMG_TYPE_* format
+ * @param pixels the RGBA pixels of the image
+ * @param bottomUp true : the rows are handed to the writer from the bottom to the top, this uses GLGE's own writers | false : the rows are stored from the top
+ * @return bool true if the loaded image equals the stored one
+ */
+static bool glgeBenchFormat(const char* name, const char* file, unsigned int format, std::vector<uint8_t>& pixels, bool bottomUp = false)
+{
+    //flip the rows if the image is stored bottom up
+    std::vector<uint8_t> stored = pixels;
+    size_t stride = GLGE_BENCH_IMAGE_SIZE * 4;
+    if (bottomUp)
+    {
+        for (int y = 0; y < GLGE_BENCH_IMAGE_SIZE; y++) { memcpy(stored.data() + y * stride, pixels.data() + (GLGE_BENCH_IMAGE_SIZE - 1 - y) * stride, stride); }
+    }
+    //store the image multiple times
+    double start = glgeTestTime();
+    for (int i = 0; i < GLGE_BENCH_IMAGE_RUNS; i++) { glgeStoreImage(file, ivec2(GLGE_BENCH_IMAGE_SIZE, GLGE_BENCH_IMAGE_SIZE), stored.data(), format, bottomUp); }
+    double encodeTime = (glgeTestTime() - start) / GLGE_BENCH_IMAGE_RUNS;
+    //load the image multiple times
+    bool same = true;
+    start = glgeTestTime();
+    for (int i = 0; i < GLGE_BENCH_IMAGE_RUNS; i++)
+    {
+        int x = 0, y = 0, comp = 0;
+        uint8_t* data = glgeLoadImage(file, &x, &y, &comp, 4);
+        same = same && data && (x == GLGE_BENCH_IMAGE_SIZE) && (y == GLGE_BENCH_IMAGE_SIZE) && (memcmp(data, pixels.data(), pixels.size()) == 0);
+        if (data) { glgeImageFree(data); }
+    }
+    double decodeTime = (glgeTestTime() - start) / GLGE_BENCH_IMAGE_RUNS;
+    //print the results, the speed is measured in uncompressed pixel data
+    double mb = pixels.size() / (1024.0 * 1024.0);
+    long size = glgeBenchFileSize(file);
+    printf("[GLGE BENCH] %-14s : %8ld bytes (%5.1f%% of raw), encode %7.1f MB/s, decode %7.1f MB/s%s\n", name, size, 100.0 * size / pixels.size(), 
+           mb / encodeTime, mb / decodeTime, same ? "" : ", ROUND TRIP FAILED");
+    remove(file);
+    return same;
+}
+
+int main()
+{
+    //create an image with smooth gradients, flat areas and noise like a typical texture
+    std::vector<uint8_t> pixels(GLGE_BENCH_IMAGE_SIZE * GLGE_BENCH_IMAGE_SIZE * 4);
+    uint32_t seed = 1;
+    for (int y = 0; y < GLGE_BENCH_IMAGE_SIZE; y++)
+    {
+        for (int x = 0; x < GLGE_BENCH_IMAGE_SIZE; x++)
+        {
+            uint8_t* p = pixels.data() + ((size_t)y * GLGE_BENCH_IMAGE_SIZE + x) * 4;
+            seed = seed * 1664525u + 1013904223u;
+            uint8_t noise = (uint8_t)((seed >> 24) & 0x07);
+            //the left half is a gradient with some noise, the right half has flat tiles
+            if (x < GLGE_BENCH_IMAGE_SIZE / 2)
+            {
+                p[0] = (uint8_t)(x / 2 + noise);
+                p[1] = (uint8_t)(y / 4 + noise);
+                p[2] = (uint8_t)(128 + noise);
+            }
+            else
+            {
+                uint8_t tile = (uint8_t)(((x / 64) ^ (y / 64)) * 37);
+                p[0] = tile;
+                p[1] = (uint8_t)(255 - tile);
+                p[2] = (uint8_t)(tile / 2);
+            }
+            p[3] = (y < GLGE_BENCH_IMAGE_SIZE / 8) ? (uint8_t)(x / 4) : 255;
+        }
+    }
+    printf("[GLGE BENCH] %dx%d RGBA image, %d runs\n", GLGE_BENCH_IMAGE_SIZE, GLGE_BENCH_IMAGE_SIZE, GLGE_BENCH_IMAGE_RUNS);
+    //compare the formats
+    bool ok = glgeBenchFormat("PNG", "benchImage.png", GLGE_IMG_TYPE_PNG, pixels);
+    ok = glgeBenchFormat("PNG bottom up", "benchImage.png", GLGE_IMG_TYPE_PNG, pixels, true) && ok;
+    ok = glgeBenchFormat("QOI", "benchImage.qoi", GLGE_IMG_TYPE_QOI, pixels) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file benchTextureLoad.cpp
+ * @author DM8AT
+ * @brief compare the time the main thread is blocked by loading many PNG textures synchronously and asynchronously
+ * @version 0.1
+ * @date 2024-03-26
+ * 
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license. 
+ * 
+ */
+
+//check if glew is allready included
+#ifndef _GLGE_GLEW_
+//say that glew is now included
+#define _GLGE_GLEW_
+//include glew
+#include <GL/glew.h>
+//close the if for glew
+#endif
+
+//include GLGE
+#include "../GLGE/GLGEALL.h"
+//include the index of the current window
+#include "../GLGE/GLGEOpenGL/openglGLGEVars.hpp"
+//include the needed standard librarys
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <sys/stat.h>
+
+/**
+ * @brief the amount of PNG files to load
+ */
+#define GLGE_BENCH_TEXTURE_COUNT 500
+/**
+ * @brief the width and height of a single texture
+ */
+#define GLGE_BENCH_TEXTURE_SIZE 256
+
+/**
+ * @brief get the current time in milliseconds
+ */
+static double glgeBenchTime()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief write the PNG files that are loaded by the benchmark
+ * 
+ * @return std::vector<std::string> the paths of the files
+ */
+static std::vector<std::string> glgeBenchWriteTextures()
+{
+    //create the directory for the files
+    mkdir("benchTextures", 0755);
+    //store the paths
+    std::vector<std::string> files;
+    //store the pixels of one image
+    std::vector<uint8_t> pixels(GLGE_BENCH_TEXTURE_SIZE * GLGE_BENCH_TEXTURE_SIZE * 4);
+    //store a simple random number generator, so the images don't compress to nothing
+    uint32_t seed = 1;
+    for (int i = 0; i < GLGE_BENCH_TEXTURE_COUNT; i++)
+    {
+        //fill the image with a gradient and some noise
+        for (size_t p = 0; p < pixels.size(); p += 4)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            size_t x = (p / 4) % GLGE_BENCH_TEXTURE_SIZE;
+            size_t y = (p / 4) / GLGE_BENCH_TEXTURE_SIZE;
+            pixels[p + 0] = (uint8_t)(x + i);
+            pixels[p + 1] = (uint8_t)(y * 2);
+            pixels[p + 2] = (uint8_t)((seed >> 24) & 0x1F);
+            pixels[p + 3] = 255;
+        }
+        //store the image
+        files.push_back("benchTextures/texture" + std::to_string(i) + ".png");
+        glgeStoreImage(files.back().c_str(), ivec2(GLGE_BENCH_TEXTURE_SIZE, GLGE_BENCH_TEXTURE_SIZE), pixels.data(), GLGE_IMG_TYPE_PNG);
+    }
+    //return the paths
+    return files;
+}
+
+int main()
+{
+    //initalise GLGE and create a small window for the OpenGL context
+    glgeInit();
+    Window* win = new Window("GLGE texture load benchmark", vec2(256, 256));
+    win->start();
+    win->makeCurrent();
+    int windowIndex = glgeCurrentWindowIndex;
+
+    //write the files, they are in the file system cache afterwards
+    std::vector<std::string> files = glgeBenchWriteTextures();
+    //store the textures
+    std::vector<Texture*> textures;
+    textures.reserve(files.size());
+
+    //load all textures synchronously, the main thread is blocked the whole time
+    double start = glgeBenchTime();
+    for (size_t i = 0; i < files.size(); i++) { textures.push_back(new Texture(files[i].c_str())); }
+    glFinish();
+    double syncTime = glgeBenchTime() - start;
+    //delete the textures
+    for (size_t i = 0; i < textures.size(); i++) { delete textures[i]; }
+    textures.clear();
+
+    //start loading all textures asynchronously
+    start = glgeBenchTime();
+    for (size_t i = 0; i < files.size(); i++) { textures.push_back(new Texture(files[i].c_str(), GLGE_TEXTURE_LOAD_ASYNC)); }
+    double asyncStartTime = glgeBenchTime() - start;
+    //upload the textures like the main loop does, once per frame
+    double longestFrame = 0;
+    double uploadTime = 0;
+    int frames = 0;
+    while (glgeGetLoadingTextureCount() > 0)
+    {
+        //upload the next parts
+        double frameStart = glgeBenchTime();
+        glgeUploadLoadedTextures(windowIndex);
+        glFinish();
+        double frameTime = glgeBenchTime() - frameStart;
+        //store the statistics
+        uploadTime += frameTime;
+        longestFrame = (frameTime > longestFrame) ? frameTime : longestFrame;
+        frames++;
+    }
+    double asyncTime = glgeBenchTime() - start;
+    //check that all textures loaded
+    int failed = 0;
+    for (size_t i = 0; i < textures.size(); i++) { failed += textures[i]->isResident() ? 0 : 1; }
+    //delete the textures
+    for (size_t i = 0; i < textures.size(); i++) { delete textures[i]; }
+
+    //print the results
+    printf("[GLGE BENCH] %d PNG textures of %dx%d pixels\n", GLGE_BENCH_TEXTURE_COUNT, GLGE_BENCH_TEXTURE_SIZE, GLGE_BENCH_TEXTURE_SIZE);
+    printf("[GLGE BENCH] synchronous  : main thread blocked for %.1f ms\n", syncTime);
+    printf("[GLGE BENCH] asynchronous : all resident after %.1f ms, main thread blocked for %.1f ms (%.1f ms starting the loads, %.1f ms uploading)\n", 
+           asyncTime, asyncStartTime + uploadTime, asyncStartTime, uploadTime);
+    printf("[GLGE BENCH] asynchronous : %d frames, longest frame %.2f ms with a budget of %.2f ms, %d textures failed\n", 
+           frames, longestFrame, glgeGetTextureUploadBudget(), failed);
+    //the benchmark failed if a texture is missing
+    return (failed == 0) ? 0 : 1;
+}
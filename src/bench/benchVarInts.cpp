@@ -0,0 +1,96 @@
+/**
+ * @file benchVarInts.cpp
+ * @author DM8AT
+ * @brief measure the speed of varint arrays, build it with GLGE_DATA_NO_SIMD to measure the scalar code
+ * @version 0.1
+ * @date 2024-03-26
+ * 
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license. 
+ * 
+ */
+
+//include the test helpers
+#include "../tests/glgeTest.hpp"
+//include the data class
+#include "../GLGE/GLGEIndependend/GLGEData.h"
+
+/**
+ * @brief the amount of integers in every array
+ */
+#define GLGE_BENCH_VARINT_COUNT (4*1024*1024)
+/**
+ * @brief how often every array is written and read
+ */
+#define GLGE_BENCH_VARINT_RUNS 5
+
+/**
+ * @brief write and read an array of varints and print the speed
+ * 
+ * @param name the name of the array
+ * @param values the integers
+ * @param delta say if the differences are stored
+ * @return bool true if the integers read back unchanged
+ */
+static bool glgeBenchVarInts(const char* name, const std::vector<unsigned int>& values, bool delta)
+{
+    std::vector<unsigned int> read(values.size());
+    double writeTime = 0, readTime = 0;
+    size_t bytes = 0;
+    bool same = true;
+    for (int r = 0; r < GLGE_BENCH_VARINT_RUNS; r++)
+    {
+        //write the integers
+        Data dat;
+        double start = glgeTestTime();
+        dat.writeVarInts(values.data(), values.size(), delta);
+        writeTime += glgeTestTime() - start;
+        bytes = dat.getLen();
+        //read the integers
+        start = glgeTestTime();
+        same = dat.readVarInts(read.data(), read.size(), delta) && same;
+        readTime += glgeTestTime() - start;
+    }
+    same = same && (read == values);
+    //print the speed in decoded integers
+    double ints = values.size() * (double)GLGE_BENCH_VARINT_RUNS / 1e6;
+    printf("[GLGE BENCH] %-24s : %5.2f bytes per int, write %7.1f M ints/s, read %7.1f M ints/s%s\n", name, (double)bytes / values.size(), 
+           ints / writeTime, ints / readTime, same ? "" : ", VALUES CHANGED");
+    return same;
+}
+
+int main()
+{
+    //say wich code is measured
+#if !defined(GLGE_DATA_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    printf("[GLGE BENCH] varints with SSE2, %d integers, %d runs\n", GLGE_BENCH_VARINT_COUNT, GLGE_BENCH_VARINT_RUNS);
+#else
+    printf("[GLGE BENCH] varints without SIMD, %d integers, %d runs\n", GLGE_BENCH_VARINT_COUNT, GLGE_BENCH_VARINT_RUNS);
+#endif
+    std::vector<unsigned int> values(GLGE_BENCH_VARINT_COUNT);
+    uint64_t seed = 1;
+    bool ok = true;
+
+    //integers that fit into a single byte
+    for (size_t i = 0; i < values.size(); i++) { seed = seed * 6364136223846793005ull + 1; values[i] = (unsigned int)(seed >> 57); }
+    ok = glgeBenchVarInts("1 byte", values, false) && ok;
+    //integers that need two bytes
+    for (size_t i = 0; i < values.size(); i++) { seed = seed * 6364136223846793005ull + 1; values[i] = 128 + (unsigned int)((seed >> 40) % 16000); }
+    ok = glgeBenchVarInts("2 bytes", values, false) && ok;
+    //integers with a random length of 1 or 2 bytes
+    for (size_t i = 0; i < values.size(); i++) { seed = seed * 6364136223846793005ull + 1; values[i] = ((seed >> 60) < 10) ? (unsigned int)((seed >> 33) % 128) : 128 + (unsigned int)((seed >> 33) % 16000); }
+    ok = glgeBenchVarInts("1 or 2 bytes", values, false) && ok;
+    //integers with a random length of 1 to 5 bytes
+    for (size_t i = 0; i < values.size(); i++) { seed = seed * 6364136223846793005ull + 1; values[i] = (unsigned int)(seed >> 32) >> (7 * ((seed >> 20) % 5)); }
+    ok = glgeBenchVarInts("1 to 5 bytes", values, false) && ok;
+    //the index buffer of a grid of quads, stored as differences like meshes
+    const unsigned int width = 1024;
+    for (size_t i = 0; i + 6 <= values.size(); i += 6)
+    {
+        unsigned int q = (unsigned int)(i / 6);
+        unsigned int v = (q / (width - 1)) * width + (q % (width - 1));
+        unsigned int quad[6] = {v, v + 1, v + width, v + 1, v + width + 1, v + width};
+        for (int k = 0; k < 6; k++) { values[i + k] = quad[k]; }
+    }
+    ok = glgeBenchVarInts("grid indices, delta", values, true) && ok;
+    return ok ? 0 : 1;
+}
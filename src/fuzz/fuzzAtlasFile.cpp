@@ -0,0 +1,49 @@
+/**
+ * @file fuzzAtlasFile.cpp
+ * @author DM8AT
+ * @brief libFuzzer target for GLGEAtlasFile::read, the input is the content of an atlas file
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers, they define the error variables
+#include "../tests/glgeTest.hpp"
+//include the atlas files
+#include "../GLGE/glgeAtlasFile.hpp"
+//include the needed standard librarys
+#include <stdint.h>
+#include <stddef.h>
+#include <cstdio>
+
+/**
+ * @brief the path the input is written to, the file is created in the working directory
+ */
+#define GLGE_FUZZ_ATLAS_PATH "glgeFuzzAtlas.glgea"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    //invalid data is expected, so don't print the errors
+    glgeErrorOutput = false;
+    //the atlas file can only be read from a file
+    FILE* f = fopen(GLGE_FUZZ_ATLAS_PATH, "wb");
+    if (!f) { return 0; }
+    if (size) { fwrite(data, 1, size, f); }
+    fclose(f);
+
+    //read the atlas file
+    GLGEAtlasFile atlas;
+    if (atlas.open(GLGE_FUZZ_ATLAS_PATH, 'r'))
+    {
+        atlas.read();
+        atlas.close();
+    }
+    //look up an image by its name
+    if (!atlas.images.empty()) { atlas.find(atlas.images.back().name); }
+
+    //remove the file
+    std::remove(GLGE_FUZZ_ATLAS_PATH);
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file fuzzDataView.cpp
+ * @author DM8AT
+ * @brief libFuzzer target for the read functions of DataView and the mesh decoder
+ *
+ * The first byte of the input is the length of a program, the following bytes are the program and the remaining bytes are
+ * the data that is read. Every byte of the program selects a read function.
+ *
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers, they define the error variables
+#include "../tests/glgeTest.hpp"
+//include the data class
+#include "../GLGE/GLGEIndependend/GLGEData.h"
+//include the mesh decoder
+#include "../GLGE/GLGEIndependend/glge3DcoreDefClasses.h"
+//include the needed standard librarys
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief the amount of read functions a program byte can select
+ */
+#define GLGE_FUZZ_DATA_OPERATIONS 30
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    //invalid data is expected, so don't print the errors
+    glgeErrorOutput = false;
+    if (size == 0) { return 0; }
+    //split the input into the program and the data
+    size_t programSize = std::min<size_t>(data[0], size - 1);
+    const uint8_t* program = data + 1;
+    DataView dat(data + 1 + programSize, size - 1 - programSize);
+
+    //run the program
+    for (size_t i = 0; i < programSize; i++)
+    {
+        switch (program[i] % GLGE_FUZZ_DATA_OPERATIONS)
+        {
+        case 0: dat.readBool(); break;
+        case 1: dat.readByte(); break;
+        case 2: dat.readUByte(); break;
+        case 3: dat.readShort(); break;
+        case 4: dat.readUShort(); break;
+        case 5: dat.readInt(); break;
+        case 6: dat.readUInt(); break;
+        case 7: dat.readLong(); break;
+        case 8: dat.readULong(); break;
+        case 9: dat.readFloat(); break;
+        case 10: dat.readDouble(); break;
+        case 11: dat.readString(); break;
+        case 12: dat.readVarInt(); break;
+        case 13: dat.readVarLong(); break;
+        case 14: dat.readVec2(); break;
+        case 15: dat.readVec3(); break;
+        case 16: dat.readVec4(); break;
+        case 17: dat.readMat2(); break;
+        case 18: dat.readMat3(); break;
+        case 19: dat.readMat4(); break;
+        case 20: dat.readQuaternion(); break;
+        case 21:
+        {
+            //read a block of bytes with a size from the data
+            uint8_t* bytes = dat.readBytes(dat.readUByte());
+            delete[] bytes;
+            break;
+        }
+        case 22:
+        {
+            //read a big endian array into existing memory
+            uint16_t values[255];
+            dat.readArray(values, dat.readUByte());
+            break;
+        }
+        case 23:
+        {
+            //read a little endian array into existing memory
+            uint32_t values[255];
+            dat.readLittleEndianArray(values, dat.readUByte());
+            break;
+        }
+        case 24: dat.readArray<double>(); break;
+        case 25: dat.readVarIntArray(false); break;
+        case 26: dat.readVarIntArray(true); break;
+        case 27:
+        {
+            //read varints into existing memory, the highest bit of the count selects the delta encoding
+            unsigned int values[128];
+            uint8_t count = dat.readUByte();
+            dat.readVarInts(values, count & 0x7F, count & 0x80);
+            break;
+        }
+        case 28: dat.skip(dat.readUByte()); break;
+        case 29:
+        {
+            //decode a mesh of an encoded object
+            std::vector<Vertex> vertices;
+            std::vector<unsigned int> indices;
+            glgeDecodeMesh(dat, vertices, indices);
+            break;
+        }
+        default: break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file fuzzScene.cpp
+ * @author DM8AT
+ * @brief libFuzzer target for the scene file loader, the table of contents, the change log and the compressed objects
+ *
+ * The first 4 bytes of the input are the size of the scene file as little endian integer, the scene file follows and the
+ * remaining bytes are the change log. The change log is only written if it isn't empty.
+ *
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers, they define the error variables
+#include "../tests/glgeTest.hpp"
+//include the scenes
+#include "../GLGE/GLGEIndependend/GLGEScene.hpp"
+//include the object type of the corpus
+#include "glgeFuzz.hpp"
+//include the needed standard librarys
+#include <stdint.h>
+#include <stddef.h>
+#include <cstdio>
+
+/**
+ * @brief the name of the scene the input is written to, the scene file is created in the working directory
+ */
+#define GLGE_FUZZ_SCENE_NAME "glgeFuzzScene"
+
+/**
+ * @brief write bytes to a file
+ *
+ * @param path the path to the file
+ * @param data the bytes to write
+ * @param size the amount of bytes
+ */
+static void glgeFuzzWriteFile(const std::string& path, const uint8_t* data, size_t size)
+{
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) { return; }
+    if (size) { fwrite(data, 1, size, f); }
+    fclose(f);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    //invalid data is expected, so don't print the errors
+    glgeErrorOutput = false;
+    if (size < sizeof(uint32_t)) { return 0; }
+    //split the input into the scene file and the change log
+    uint32_t sceneSize = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    size_t remain = size - sizeof(uint32_t);
+    if (sceneSize > remain) { sceneSize = (uint32_t)remain; }
+    const std::string path = std::string(GLGE_FUZZ_SCENE_NAME) + ".glges";
+    const std::string changesPath = path + GLGE_SCENE_CHANGES_ENDING;
+    glgeFuzzWriteFile(path, data + sizeof(uint32_t), sceneSize);
+    std::remove(changesPath.c_str());
+    if (remain > sceneSize) { glgeFuzzWriteFile(changesPath, data + sizeof(uint32_t) + sceneSize, remain - sceneSize); }
+
+    {
+        //load the scene, this reads the table of contents and replays the change log
+        Scene scene(GLGE_FUZZ_SCENE_NAME);
+        scene.load();
+        //access every object by its name, this looks the name up in the table of contents
+        std::vector<std::string> names = scene.getObjectNames();
+        for (const std::string& name : names) { scene.has(name); }
+        if (!names.empty()) { scene.get(names[0]); }
+        //create all objects, compressed objects are decompressed
+        std::vector<NamedObject*> objs = scene.getAllObjects();
+        for (NamedObject* obj : objs)
+        {
+            if (!obj) { continue; }
+            //read the type and the data of the object
+            size_t bytes = 0;
+            obj->getBytes(&bytes);
+            obj->isDirty();
+            //decode the objects of the corpus
+            if (obj->getTypeName() == typeid(GLGEFuzzObject).name()) { delete obj->getObject<GLGEFuzzObject>(); }
+        }
+        //the objects belong to the caller
+        for (NamedObject* obj : objs) { delete obj; }
+    }
+
+    //remove the files
+    std::remove(path.c_str());
+    std::remove(changesPath.c_str());
+    return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file glgeFuzz.hpp
+ * @author DM8AT
+ * @brief the object type that is stored in the scene files of the fuzz corpus and decoded by the scene fuzz target
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+#ifndef _GLGE_FUZZ_H_
+#define _GLGE_FUZZ_H_
+
+//include the data class
+#include "../GLGE/GLGEIndependend/GLGEData.h"
+//include the needed standard librarys
+#include <vector>
+#include <string>
+
+/**
+ * @brief a small object with a name, integers and floats
+ */
+class GLGEFuzzObject
+{
+public:
+    /**
+     * @brief store the name of the object
+     */
+    std::string name;
+    /**
+     * @brief store some integers, they are stored as varints
+     */
+    std::vector<unsigned int> ints;
+    /**
+     * @brief store some floats
+     */
+    std::vector<float> floats;
+
+    /**
+     * @brief encode the object
+     *
+     * @return Data* the encoded data
+     */
+    Data* encode()
+    {
+        Data* dat = new Data();
+        dat->writeString(this->name);
+        dat->writeVarIntArray(this->ints, true);
+        dat->writeArray(this->floats);
+        return dat;
+    }
+
+    /**
+     * @brief decode the object
+     *
+     * @param dat the data to decode from
+     */
+    void decode(DataView dat)
+    {
+        this->name = dat.readString();
+        this->ints = dat.readVarIntArray(true);
+        this->floats = dat.readArray<float>();
+    }
+};
+
+#endif
@@ -0,0 +1,304 @@
+/**
+ * @file glgeFuzzCorpus.cpp
+ * @author DM8AT
+ * @brief create the seed corpus of valid inputs for the fuzz targets
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers, they define the error variables
+#include "../tests/glgeTest.hpp"
+//include the scenes
+#include "../GLGE/GLGEIndependend/GLGEScene.hpp"
+//include the compression modes
+#include "../GLGE/GLGEIndependend/glgeCompression.h"
+//include the mesh encoding
+#include "../GLGE/GLGEIndependend/glge3DcoreDefClasses.h"
+//include the atlas files
+#include "../GLGE/glgeAtlasFile.hpp"
+//include the object type of the corpus
+#include "glgeFuzz.hpp"
+//include the needed standard librarys
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <cstdio>
+
+/**
+ * @brief the amount of read functions of the DataView fuzz target
+ */
+#define GLGE_FUZZ_DATA_OPERATIONS 30
+
+/**
+ * @brief read a whole file
+ *
+ * @param path the path to the file
+ * @return std::vector<uint8_t> the bytes of the file, empty if the file doesn't exist
+ */
+static std::vector<uint8_t> glgeFuzzReadFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief write bytes to a file
+ *
+ * @param path the path to the file
+ * @param data the bytes to write
+ */
+static void glgeFuzzWriteFile(const std::string& path, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write((const char*)data.data(), data.size());
+}
+
+/**
+ * @brief write the data that a read function of the DataView fuzz target reads
+ *
+ * @param dat the data to write to
+ * @param operation the read function
+ */
+static void glgeFuzzWriteOperation(Data& dat, int operation)
+{
+    switch (operation)
+    {
+    case 0: dat.writeBool(true); break;
+    case 1: dat.writeByte(-5); break;
+    case 2: dat.writeUByte(200); break;
+    case 3: dat.writeShort(-1234); break;
+    case 4: dat.writeUShort(0x0A0D); break;
+    case 5: dat.writeInt(-123456); break;
+    case 6: dat.writeUInt(0x80000A0D); break;
+    case 7: dat.writeLong(-1234567890123l); break;
+    case 8: dat.writeULong(0x0102030405060708ul); break;
+    case 9: dat.writeFloat(3.5f); break;
+    case 10: dat.writeDouble(-0.125); break;
+    case 11: dat.writeString("GLGE scene object"); break;
+    case 12: dat.writeVarInt(-300); break;
+    case 13: dat.writeVarLong(1l << 40); break;
+    case 14: dat.writeVec2(vec2(1, 2)); break;
+    case 15: dat.writeVec3(vec3(1, 2, 3)); break;
+    case 16: dat.writeVec4(vec4(1, 2, 3, 4)); break;
+    case 17: dat.writeMat2(mat2()); break;
+    case 18: dat.writeMat3(mat3()); break;
+    case 19: dat.writeMat4(mat4()); break;
+    case 20: dat.writeQuaternion(Quaternion(1, 0, 0, 0)); break;
+    case 21:
+    {
+        uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+        dat.writeUByte(sizeof(bytes));
+        dat.writeBytes(bytes, sizeof(bytes));
+        break;
+    }
+    case 22:
+    {
+        uint16_t values[] = {1, 0x0A0D, 0xFFFF, 300};
+        dat.writeUByte(4);
+        dat.writeArray(values, 4);
+        break;
+    }
+    case 23:
+    {
+        uint32_t values[] = {1, 0x0A0D, 0xFFFFFFFF, 300, 70000};
+        dat.writeUByte(5);
+        dat.writeLittleEndianArray(values, 5);
+        break;
+    }
+    case 24: dat.writeArray(std::vector<double>{1.0, -2.5, 1e300}); break;
+    case 25: dat.writeVarIntArray(std::vector<unsigned int>{1, 200, 70000, 0xFFFFFFFF}, false); break;
+    case 26: dat.writeVarIntArray(std::vector<unsigned int>{10, 11, 12, 100, 5, 5, 6}, true); break;
+    case 27:
+    {
+        //17 integers, so the SIMD path for blocks of 16 bytes is used
+        std::vector<unsigned int> values;
+        for (unsigned int i = 0; i < 17; i++) { values.push_back(i * i * 37); }
+        dat.writeUByte((uint8_t)values.size());
+        dat.writeVarInts(values.data(), values.size());
+        break;
+    }
+    case 28:
+    {
+        dat.writeUByte(3);
+        uint8_t skipped[] = {9, 9, 9};
+        dat.writeBytes(skipped, sizeof(skipped));
+        break;
+    }
+    case 29:
+    {
+        //a quad with 4 vertices and 6 indices
+        std::vector<Vertex> vertices = {Vertex(0, 0, 0, 0, 0), Vertex(1, 0, 0, 1, 0), Vertex(1, 1, 0, 1, 1), Vertex(0, 1, 0, 0, 1)};
+        std::vector<unsigned int> indices = {0, 1, 2, 0, 2, 3};
+        glgeEncodeMesh(&dat, vertices, indices);
+        break;
+    }
+    default: break;
+    }
+}
+
+/**
+ * @brief create an input of the DataView fuzz target
+ *
+ * @param program the read functions to call
+ * @return std::vector<uint8_t> the input
+ */
+static std::vector<uint8_t> glgeFuzzDataInput(const std::vector<uint8_t>& program)
+{
+    Data dat;
+    for (uint8_t operation : program) { glgeFuzzWriteOperation(dat, operation); }
+    std::vector<uint8_t> input;
+    input.push_back((uint8_t)program.size());
+    input.insert(input.end(), program.begin(), program.end());
+    input.insert(input.end(), dat.getReadPointer(), dat.getReadPointer() + dat.getLen());
+    return input;
+}
+
+/**
+ * @brief create a scene file and optionally a change log and pack them into an input of the scene fuzz target
+ *
+ * @param mode the compression mode of the scene
+ * @param objects the amount of objects
+ * @param changes true : store changes in the change log | false : only write the scene file
+ * @return std::vector<uint8_t> the input
+ */
+static std::vector<uint8_t> glgeFuzzSceneInput(uint8_t mode, int objects, bool changes)
+{
+    const std::string name = "glgeFuzzCorpusScene";
+    const std::string path = name + ".glges";
+    const std::string changesPath = path + GLGE_SCENE_CHANGES_ENDING;
+    std::remove(path.c_str());
+    std::remove(changesPath.c_str());
+    //create the objects, the threshold is small so the small objects are compressed
+    {
+        Scene scene(name.c_str());
+        scene.setCompression(mode, 32);
+        for (int i = 0; i < objects; i++)
+        {
+            GLGEFuzzObject obj;
+            obj.name = "object " + std::to_string(i);
+            for (unsigned int j = 0; j < 24; j++) { obj.ints.push_back(j * 3 + i); obj.floats.push_back(j * 0.5f); }
+            scene.set<GLGEFuzzObject>(&obj, "obj" + std::to_string(i));
+        }
+        scene.safeFile();
+    }
+    //store a change, a new object and a removal in the change log
+    if (changes)
+    {
+        Scene scene(name.c_str());
+        scene.setCompression(mode, 32);
+        scene.load();
+        GLGEFuzzObject obj;
+        obj.name = "changed";
+        for (unsigned int j = 0; j < 24; j++) { obj.ints.push_back(j * 7); obj.floats.push_back(j * 0.25f); }
+        scene.set<GLGEFuzzObject>(&obj, "obj0");
+        scene.set<GLGEFuzzObject>(&obj, "added");
+        if (objects > 1) { scene.remove("obj1"); }
+        scene.safeChanges();
+    }
+    //pack the files
+    std::vector<uint8_t> file = glgeFuzzReadFile(path);
+    std::vector<uint8_t> log = glgeFuzzReadFile(changesPath);
+    std::vector<uint8_t> input = {(uint8_t)file.size(), (uint8_t)(file.size() >> 8), (uint8_t)(file.size() >> 16), (uint8_t)(file.size() >> 24)};
+    input.insert(input.end(), file.begin(), file.end());
+    input.insert(input.end(), log.begin(), log.end());
+    std::remove(path.c_str());
+    std::remove(changesPath.c_str());
+    return input;
+}
+
+/**
+ * @brief create a scene file like the writer of version 1 and pack it into an input of the scene fuzz target
+ *
+ * @param objects the amount of objects
+ * @return std::vector<uint8_t> the input
+ */
+static std::vector<uint8_t> glgeFuzzSceneInputV1(int objects)
+{
+    std::vector<uint8_t> file = {'G','L','G','E','S','c','e','n','e','0','0','1'};
+    for (int i = 0; i < objects; i++)
+    {
+        GLGEFuzzObject obj;
+        obj.name = "object " + std::to_string(i);
+        for (unsigned int j = 0; j < 24; j++) { obj.ints.push_back(j * 3 + i); obj.floats.push_back(j * 0.5f); }
+        NamedObject named;
+        named.set<GLGEFuzzObject>(&obj, "obj" + std::to_string(i));
+        size_t size = 0;
+        const uint8_t* data = named.getBytes(&size);
+        //the length also counts the name and its length, so the old writer copied that many bytes past the object
+        uint8_t nLen = (uint8_t)named.name.size();
+        uint32_t len = (uint32_t)(size + nLen + sizeof(nLen));
+        file.insert(file.end(), (uint8_t*)&len, (uint8_t*)&len + sizeof(len));
+        file.push_back(nLen);
+        file.insert(file.end(), named.name.begin(), named.name.end());
+        file.insert(file.end(), data, data + size);
+        file.insert(file.end(), (size_t)nLen + 1, 0);
+    }
+    //pack the file without a change log
+    std::vector<uint8_t> input = {(uint8_t)file.size(), (uint8_t)(file.size() >> 8), (uint8_t)(file.size() >> 16), (uint8_t)(file.size() >> 24)};
+    input.insert(input.end(), file.begin(), file.end());
+    return input;
+}
+
+/**
+ * @brief create an atlas file
+ *
+ * @param images the amount of images
+ * @return std::vector<uint8_t> the content of the atlas file
+ */
+static std::vector<uint8_t> glgeFuzzAtlasInput(int images)
+{
+    const std::string path = "glgeFuzzCorpusAtlas.glgea";
+    {
+        GLGEAtlasFile atlas;
+        atlas.open(path, 'w');
+        atlas.size = vec2(1024, 266);
+        //the positions contain bytes that look like line breaks and bytes with the highest bit
+        for (int i = 0; i < images; i++) { atlas.addImage("textures/image" + std::to_string(i) + ".png", vec2(10 + i * 128, 266), vec2(128, 10)); }
+        atlas.write();
+        atlas.close();
+    }
+    std::vector<uint8_t> input = glgeFuzzReadFile(path);
+    std::remove(path.c_str());
+    return input;
+}
+
+int main(int argc, char** argv)
+{
+    //get the directory of the corpus
+    std::string dir = (argc > 1) ? argv[1] : "src/fuzz/corpus";
+    std::filesystem::create_directories(dir + "/DataView");
+    std::filesystem::create_directories(dir + "/Scene");
+    std::filesystem::create_directories(dir + "/AtlasFile");
+
+    //one input for every read function and one that calls all of them
+    std::vector<uint8_t> all;
+    for (int i = 0; i < GLGE_FUZZ_DATA_OPERATIONS; i++)
+    {
+        glgeFuzzWriteFile(dir + "/DataView/op" + std::to_string(i), glgeFuzzDataInput({(uint8_t)i}));
+        all.push_back((uint8_t)i);
+    }
+    glgeFuzzWriteFile(dir + "/DataView/all", glgeFuzzDataInput(all));
+
+    //scene files with every compression mode, with and without a change log
+    glgeFuzzWriteFile(dir + "/Scene/empty", glgeFuzzSceneInput(GLGE_COMPRESSION_NONE, 0, false));
+    glgeFuzzWriteFile(dir + "/Scene/none", glgeFuzzSceneInput(GLGE_COMPRESSION_NONE, 4, false));
+    glgeFuzzWriteFile(dir + "/Scene/fast", glgeFuzzSceneInput(GLGE_COMPRESSION_FAST, 4, false));
+    glgeFuzzWriteFile(dir + "/Scene/high", glgeFuzzSceneInput(GLGE_COMPRESSION_HIGH, 4, false));
+    glgeFuzzWriteFile(dir + "/Scene/noneChanges", glgeFuzzSceneInput(GLGE_COMPRESSION_NONE, 4, true));
+    glgeFuzzWriteFile(dir + "/Scene/fastChanges", glgeFuzzSceneInput(GLGE_COMPRESSION_FAST, 4, true));
+    //a scene file of version 1
+    glgeFuzzWriteFile(dir + "/Scene/v1", glgeFuzzSceneInputV1(4));
+
+    //atlas files with no, one and a few images
+    glgeFuzzWriteFile(dir + "/AtlasFile/empty", glgeFuzzAtlasInput(0));
+    glgeFuzzWriteFile(dir + "/AtlasFile/single", glgeFuzzAtlasInput(1));
+    glgeFuzzWriteFile(dir + "/AtlasFile/images", glgeFuzzAtlasInput(5));
+
+    printf("[GLGE FUZZ] wrote the corpus to %s\n", dir.c_str());
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file glgeFuzzMain.cpp
+ * @author DM8AT
+ * @brief run a fuzz target on files and directories without libFuzzer, so the corpus can be replayed with any compiler
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the needed standard librarys
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+
+/**
+ * @brief the fuzz target, it is defined by the linked target
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+/**
+ * @brief run the fuzz target on a file
+ *
+ * @param path the path to the file
+ */
+static void glgeFuzzRunFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+}
+
+int main(int argc, char** argv)
+{
+    //count the inputs
+    size_t runs = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        //run all files of a directory in a fixed order
+        if (std::filesystem::is_directory(argv[i]))
+        {
+            std::vector<std::string> files;
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(argv[i]))
+            {
+                if (entry.is_regular_file()) { files.push_back(entry.path().string()); }
+            }
+            std::sort(files.begin(), files.end());
+            for (const std::string& f : files) { glgeFuzzRunFile(f); runs++; }
+        }
+        else { glgeFuzzRunFile(argv[i]); runs++; }
+    }
+    //print the amount of inputs
+    printf("[GLGE FUZZ] %s: ran %zu inputs\n", argc > 0 ? argv[0] : "", runs);
+    return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file glgeTest.hpp
+ * @author DM8AT
+ * @brief small helpers for the tests, benchmarks and fuzz targets that only link the graphic library independend parts of GLGE
+ * @version 0.1
+ * @date 2024-03-26
+ * 
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license. 
+ * 
+ */
+
+#ifndef _GLGE_TEST_H_
+#define _GLGE_TEST_H_
+
+//include the needed standard librarys
+#include <stdio.h>
+#include <chrono>
+
+/**
+ * @brief say if errors should be printed, normaly defined in glgeVars.cpp, wich is not linked without SDL
+ */
+bool glgeErrorOutput = true;
+/**
+ * @brief say if errors should close the program, normaly defined in glgeVars.cpp
+ */
+bool glgeExitOnError = false;
+/**
+ * @brief say if warnings should be printed, normaly defined in glgeVars.cpp
+ */
+bool glgeWarningOutput = true;
+
+/**
+ * @brief store the amount of checks that failed
+ */
+static int glgeTestFailures = 0;
+
+/**
+ * @brief check a condition and print the location if it is false
+ */
+#define GLGE_TEST_CHECK(cond, msg) if (!(cond)) { printf("[GLGE TEST FAILED] %s:%d %s\n", __FILE__, __LINE__, msg); glgeTestFailures++; }
+
+/**
+ * @brief get the current time in seconds
+ * 
+ * @return double the time in seconds
+ */
+static inline double glgeTestTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief print the result of a test
+ * 
+ * @param name the name of the test
+ * @return int the exit code for the test, 0 if all checks passed
+ */
+static inline int glgeTestResult(const char* name)
+{
+    //print the result
+    if (glgeTestFailures) { printf("[GLGE TEST] %s: %d checks failed\n", name, glgeTestFailures); }
+    else { printf("[GLGE TEST] %s: passed\n", name); }
+    //return the exit code
+    return (glgeTestFailures == 0) ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * @file testBlockCompression.cpp
+ * @author DM8AT
+ * @brief test that every BCn format decodes close to the source image, that opaque images stay opaque and that BC5 keeps normal maps
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "glgeTest.hpp"
+//include the block compression
+#include "../GLGE/GLGEIndependend/glgeBlockCompression.h"
+//include the needed standard librarys
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * @brief the width and height of the test images, the width is not a multiple of 4 so partial blocks are tested
+ */
+#define GLGE_TEST_BC_SIZE 66
+
+/**
+ * @brief create a smooth RGBA image with a bit of noise
+ *
+ * @param size the width and height of the image
+ * @param opaque true : every alpha is 255 | false : the alpha is a gradient
+ * @return std::vector<uint8_t> the pixels of the image
+ */
+static std::vector<uint8_t> glgeTestCreateImage(int size, bool opaque)
+{
+    std::vector<uint8_t> rgba((size_t)size * size * 4);
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            uint8_t* p = rgba.data() + ((size_t)y * size + x) * 4;
+            int noise = (x * 7 + y * 13) % 9 - 4;
+            p[0] = (uint8_t)std::min(255, std::max(0, x * 255 / size + noise));
+            p[1] = (uint8_t)std::min(255, std::max(0, y * 255 / size - noise));
+            p[2] = (uint8_t)(128 + 100 * std::sin((x + y) * 0.1));
+            p[3] = opaque ? 255 : (uint8_t)((x + y) * 255 / (2 * size));
+        }
+    }
+    return rgba;
+}
+
+/**
+ * @brief create a normal map of a bumpy surface, the normal is stored as 128 + 127 * n
+ *
+ * @param size the width and height of the image
+ * @return std::vector<uint8_t> the pixels of the image
+ */
+static std::vector<uint8_t> glgeTestCreateNormals(int size)
+{
+    std::vector<uint8_t> rgba((size_t)size * size * 4);
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            //the derivatives of a sine height field
+            float nx = -0.5f * std::cos(x * 0.2f), ny = -0.5f * std::cos(y * 0.3f);
+            float len = std::sqrt(nx*nx + ny*ny + 1.f);
+            uint8_t* p = rgba.data() + ((size_t)y * size + x) * 4;
+            p[0] = (uint8_t)std::lround(128.f + 127.f * nx / len);
+            p[1] = (uint8_t)std::lround(128.f + 127.f * ny / len);
+            p[2] = (uint8_t)std::lround(128.f + 127.f / len);
+            p[3] = 255;
+        }
+    }
+    return rgba;
+}
+
+/**
+ * @brief compress and decompress an image
+ *
+ * @param rgba the image to compress
+ * @param size the width and height of the image
+ * @param format the block compression format
+ * @param preset the quality preset
+ * @return std::vector<uint8_t> the decoded image
+ */
+static std::vector<uint8_t> glgeTestRoundTrip(const std::vector<uint8_t>& rgba, int size, unsigned int format, unsigned int preset)
+{
+    std::vector<uint8_t> blocks = glgeCompressBlocks(rgba.data(), size, size, format, preset);
+    GLGE_TEST_CHECK(blocks.size() == glgeGetCompressedSize(format, size, size), "the compressed size is wrong")
+    std::vector<uint8_t> decoded(rgba.size());
+    glgeDecompressBlocks(blocks.data(), size, size, format, decoded.data());
+    return decoded;
+}
+
+/**
+ * @brief check if every alpha of an image is 255
+ */
+static bool glgeTestIsOpaque(const std::vector<uint8_t>& rgba)
+{
+    for (size_t i = 3; i < rgba.size(); i += 4) { if (rgba[i] != 255) { return false; } }
+    return true;
+}
+
+int main()
+{
+    const int size = GLGE_TEST_BC_SIZE;
+    std::vector<uint8_t> image = glgeTestCreateImage(size, false);
+    std::vector<uint8_t> opaque = glgeTestCreateImage(size, true);
+
+    //every format and preset must reach a minimum quality, the higher presets must not be worse than the fast one
+    const unsigned int formats[] = {GLGE_BC1, GLGE_BC3, GLGE_BC4, GLGE_BC5, GLGE_BC7};
+    const float minPSNR[] = {30.f, 30.f, 40.f, 40.f, 33.f};
+    for (int f = 0; f < 5; f++)
+    {
+        float fast = 0;
+        for (unsigned int preset = GLGE_BC_PRESET_FAST; preset <= GLGE_BC_PRESET_HIGH; preset++)
+        {
+            //BC1 only stores one bit of alpha, so it is tested with the opaque image
+            const std::vector<uint8_t>& src = (formats[f] == GLGE_BC1) ? opaque : image;
+            std::vector<uint8_t> decoded = glgeTestRoundTrip(src, size, formats[f], preset);
+            float psnr = glgeCalculatePSNR(src.data(), decoded.data(), size, size, formats[f]);
+            printf("[GLGE TEST] %s preset %u: %.2f dB\n", glgeGetBlockCompressionName(formats[f]), preset, psnr);
+            std::string msg = std::string(glgeGetBlockCompressionName(formats[f])) + " is below the minimum PSNR";
+            GLGE_TEST_CHECK(psnr >= minPSNR[f], msg.c_str())
+            if (preset == GLGE_BC_PRESET_FAST) { fast = psnr; }
+            msg = std::string(glgeGetBlockCompressionName(formats[f])) + " is worse with a higher preset";
+            GLGE_TEST_CHECK(psnr >= fast - 0.05f, msg.c_str())
+        }
+    }
+
+    //opaque images must decode with an alpha of exactly 255 in every format that stores alpha
+    const unsigned int alphaFormats[] = {GLGE_BC1, GLGE_BC3, GLGE_BC7};
+    for (unsigned int format : alphaFormats)
+    {
+        for (unsigned int preset = GLGE_BC_PRESET_FAST; preset <= GLGE_BC_PRESET_HIGH; preset++)
+        {
+            std::string msg = std::string(glgeGetBlockCompressionName(format)) + " doesn't keep an opaque image opaque";
+            GLGE_TEST_CHECK(glgeTestIsOpaque(glgeTestRoundTrip(opaque, size, format, preset)), msg.c_str())
+        }
+    }
+    //a uniform opaque block is the simplest case of the shared p-bit
+    {
+        std::vector<uint8_t> flat(4 * 4 * 4);
+        for (size_t i = 0; i < flat.size(); i += 4) { flat[i] = 200; flat[i+1] = 100; flat[i+2] = 51; flat[i+3] = 255; }
+        GLGE_TEST_CHECK(glgeTestIsOpaque(glgeTestRoundTrip(flat, 4, GLGE_BC7, GLGE_BC_PRESET_NORMAL)), "a flat opaque BC7 block isn't opaque")
+    }
+
+    //BC5 stores the x and y of a normal map, the rebuilt z must stay close to the source normal
+    {
+        std::vector<uint8_t> normals = glgeTestCreateNormals(size);
+        std::vector<uint8_t> decoded = glgeTestRoundTrip(normals, size, GLGE_BC5, GLGE_BC_PRESET_NORMAL);
+        float psnr = glgeCalculatePSNR(normals.data(), decoded.data(), size, size, GLGE_BC5);
+        printf("[GLGE TEST] BC5 normal map: %.2f dB\n", psnr);
+        GLGE_TEST_CHECK(psnr >= 40.f, "the BC5 normal map is below the minimum PSNR")
+        //the largest angle between the source and the decoded normal, z is rebuilt like the default shader does
+        double maxAngle = 0;
+        for (size_t i = 0; i < normals.size(); i += 4)
+        {
+            double sx = (normals[i] - 128) / 127.0, sy = (normals[i+1] - 128) / 127.0;
+            double dx = (decoded[i] - 128) / 127.0, dy = (decoded[i+1] - 128) / 127.0;
+            double sz = std::sqrt(std::max(0.0, 1.0 - sx*sx - sy*sy)), dz = std::sqrt(std::max(0.0, 1.0 - dx*dx - dy*dy));
+            double dot = (sx*dx + sy*dy + sz*dz) / (std::sqrt(sx*sx + sy*sy + sz*sz) * std::sqrt(dx*dx + dy*dy + dz*dz));
+            maxAngle = std::max(maxAngle, std::acos(std::min(1.0, dot)) * 180.0 / M_PI);
+        }
+        printf("[GLGE TEST] BC5 normal map: largest error %.2f degrees\n", maxAngle);
+        GLGE_TEST_CHECK(maxAngle < 2.0, "a BC5 normal is off by more than 2 degrees")
+        //the blue chanel is not stored and reads as 0
+        GLGE_TEST_CHECK(decoded[2] == 0 && decoded[3] == 255, "BC5 doesn't decode blue as 0 and alpha as 1")
+    }
+
+    //the whole pipeline with mip levels reports the PSNR of the first level
+    {
+        CompressedImage compressed = glgeCompressImage(image.data(), size, size, GLGE_BC7, GLGE_BC_PRESET_NORMAL, true);
+        GLGE_TEST_CHECK(compressed.levels.size() == 7, "the mip chain of a 66x66 image doesn't have 7 levels")
+        GLGE_TEST_CHECK(compressed.psnr >= 35.f, "glgeCompressImage reports a low PSNR")
+    }
+
+    return glgeTestResult("testBlockCompression");
+}
@@ -0,0 +1,140 @@
+/**
+ * @file testDataArrays.cpp
+ * @author DM8AT
+ * @brief test that arrays of every element size written with Data read back unchanged and in the same byte order as single values
+ * @version 0.1
+ * @date 2024-03-26
+ * 
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license. 
+ * 
+ */
+
+//include the test helpers
+#include "glgeTest.hpp"
+//include the data class
+#include "../GLGE/GLGEIndependend/GLGEData.h"
+//include the needed standard librarys
+#include <memory>
+
+/**
+ * @brief write an array as big endian and as little endian and read both back
+ * 
+ * @tparam T the type of the elements
+ * @param values the values to write
+ * @param count the amount of values
+ */
+template<typename T> static void glgeTestArray(const T* values, size_t count)
+{
+    //write the array in both byte orders
+    Data dat;
+    dat.writeArray(values, count);
+    dat.writeLittleEndianArray(values, count);
+    //check the size
+    GLGE_TEST_CHECK(dat.getLen() == 2 * count * sizeof(T), "an array has the wrong size")
+    //read both arrays back
+    //std::vector<bool> has no data pointer, so plain arrays are used
+    std::unique_ptr<T[]> big(new T[count + 1]()), little(new T[count + 1]());
+    GLGE_TEST_CHECK(dat.readArray(big.get(), count), "a big endian array could not be read")
+    GLGE_TEST_CHECK(dat.readLittleEndianArray(little.get(), count), "a little endian array could not be read")
+    //nothing is left, so another read must fail without printing the error
+    glgeErrorOutput = false;
+    GLGE_TEST_CHECK(!dat.readArray(big.get(), 1), "a read past the end succeeded")
+    glgeErrorOutput = true;
+    //compare the values
+    GLGE_TEST_CHECK(std::memcmp(big.get(), values, count * sizeof(T)) == 0, "a big endian array changed")
+    GLGE_TEST_CHECK(std::memcmp(little.get(), values, count * sizeof(T)) == 0, "a little endian array changed")
+}
+
+/**
+ * @brief write a vector with the length prefix and read it back
+ * 
+ * @tparam T the type of the elements
+ * @param values the values to write
+ */
+template<typename T> static void glgeTestVector(const std::vector<T>& values)
+{
+    //write and read the vector
+    Data dat;
+    dat.writeArray(values);
+    std::vector<T> read = dat.readArray<T>();
+    GLGE_TEST_CHECK(read == values, "a vector changed")
+    GLGE_TEST_CHECK(dat.getLen() == 0, "a vector left bytes behind")
+}
+
+/**
+ * @brief create a vector with values that use every byte of the type
+ */
+template<typename T> static std::vector<T> glgeTestValues(size_t count)
+{
+    std::vector<T> values(count);
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < count; i++)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t bits = seed ^ (seed >> 29);
+        std::memcpy(&values[i], &bits, sizeof(T));
+    }
+    return values;
+}
+
+int main()
+{
+    //1 byte elements, they are copied without swapping
+    std::vector<int8_t> i8 = glgeTestValues<int8_t>(1001);
+    std::vector<uint8_t> u8 = glgeTestValues<uint8_t>(1001);
+    std::vector<char> c8 = glgeTestValues<char>(1001);
+    bool b8[7] = {true, false, false, true, true, false, true};
+    glgeTestArray(i8.data(), i8.size());
+    glgeTestArray(u8.data(), u8.size());
+    glgeTestArray(c8.data(), c8.size());
+    glgeTestArray(b8, 7);
+    glgeTestVector(i8);
+    glgeTestVector(u8);
+    glgeTestVector(c8);
+    //2 byte elements
+    std::vector<int16_t> i16 = glgeTestValues<int16_t>(1001);
+    std::vector<uint16_t> u16 = glgeTestValues<uint16_t>(1001);
+    glgeTestArray(i16.data(), i16.size());
+    glgeTestArray(u16.data(), u16.size());
+    glgeTestVector(u16);
+    //4 byte elements
+    std::vector<int32_t> i32 = glgeTestValues<int32_t>(1001);
+    std::vector<uint32_t> u32 = glgeTestValues<uint32_t>(1001);
+    std::vector<float> f32 = {0.f, -0.f, 1.5f, -3.25e7f, 1e-38f, 3.4e38f};
+    glgeTestArray(i32.data(), i32.size());
+    glgeTestArray(u32.data(), u32.size());
+    glgeTestArray(f32.data(), f32.size());
+    glgeTestVector(f32);
+    //8 byte elements
+    std::vector<int64_t> i64 = glgeTestValues<int64_t>(1001);
+    std::vector<uint64_t> u64 = glgeTestValues<uint64_t>(1001);
+    std::vector<double> f64 = {0.0, -1.0, 1e300, -2.5e-300};
+    glgeTestArray(i64.data(), i64.size());
+    glgeTestArray(u64.data(), u64.size());
+    glgeTestArray(f64.data(), f64.size());
+    glgeTestVector(i64);
+    //empty arrays
+    glgeTestArray(u8.data(), 0);
+    glgeTestVector(std::vector<double>());
+
+    //arrays must use the same big endian layout as the single value writers
+    Data single, array;
+    short s[3] = {0x0102, -2, 0x7F00};
+    int in[3] = {0x01020304, -5, 0x7FFFFFFF};
+    long l[2] = {0x0102030405060708l, -9};
+    float f[2] = {1.25f, -7.5f};
+    for (int i = 0; i < 3; i++) { single.writeShort(s[i]); }
+    for (int i = 0; i < 3; i++) { single.writeInt(in[i]); }
+    for (int i = 0; i < 2; i++) { single.writeLong(l[i]); }
+    for (int i = 0; i < 2; i++) { single.writeFloat(f[i]); }
+    array.writeArray(s, 3);
+    array.writeArray(in, 3);
+    array.writeArray(l, 2);
+    array.writeArray(f, 2);
+    GLGE_TEST_CHECK((single.getLen() == array.getLen()) && (std::memcmp(single.getReadPointer(), array.getReadPointer(), single.getLen()) == 0), "arrays and single values use different byte orders")
+    //the first short must be stored with the high byte first
+    GLGE_TEST_CHECK((array.getReadPointer()[0] == 0x01) && (array.getReadPointer()[1] == 0x02), "arrays are not stored as big endian")
+
+    //print the result
+    return glgeTestResult("data arrays");
+}
@@ -0,0 +1,112 @@
+/**
+ * @file testImageCache.cpp
+ * @author DM8AT
+ * @brief test that the image cache is used for unchanged sources, is not used for changed sources and deletes the least recently used images
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "glgeTest.hpp"
+//include the vectors used by the image functions
+#include "../GLGE/CML/CML.h"
+//include the images and the cache
+#include "../GLGE/GLGEIndependend/glgeImage.h"
+#include "../GLGE/GLGEIndependend/glgeImageCache.h"
+//include the needed standard librarys
+#include <vector>
+#include <string>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#include <filesystem>
+
+/**
+ * @brief the directory of the cache
+ */
+#define GLGE_TEST_CACHE_DIR "testImageCacheDir"
+/**
+ * @brief the width and height of the images, every decoded image takes 16 KB in the cache
+ */
+#define GLGE_TEST_CACHE_IMAGE 64
+
+/**
+ * @brief store a source image, the image is a PPM so images with different pixels have the same file size
+ *
+ * @param file the file to store the image in
+ * @param seed the value the pixels are created from
+ */
+static void glgeTestStoreSource(const char* file, uint8_t seed)
+{
+    std::vector<uint8_t> rgba(GLGE_TEST_CACHE_IMAGE * GLGE_TEST_CACHE_IMAGE * 4);
+    for (size_t i = 0; i < rgba.size(); i++) { rgba[i] = ((i & 3) == 3) ? 255 : (uint8_t)(i * 7 + seed); }
+    glgeStoreImage(file, ivec2(GLGE_TEST_CACHE_IMAGE, GLGE_TEST_CACHE_IMAGE), rgba.data(), GLGE_IMG_TYPE_PPM);
+}
+
+/**
+ * @brief load an image and check if it came from the cache
+ *
+ * @param file the file to load
+ * @param first the first red value the image must have
+ * @return true : the pixels were mapped from the cache | false : the source was decoded
+ */
+static bool glgeTestLoad(const char* file, uint8_t first)
+{
+    int x = 0, y = 0, comp = 0;
+    uint8_t* data = glgeLoadImage(file, &x, &y, &comp, 4);
+    GLGE_TEST_CHECK(data && (x == GLGE_TEST_CACHE_IMAGE) && (y == GLGE_TEST_CACHE_IMAGE) && (comp == 3), "the image can't be loaded")
+    if (!data) { return false; }
+    GLGE_TEST_CHECK(data[0] == first, "the loaded image has the wrong pixels")
+    //the cache maps its files, decoded images are not known to it
+    bool hit = glgeFreeCachedImage(data);
+    if (!hit) { glgeImageFree(data); }
+    //give every cache file its own time of last use
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return hit;
+}
+
+int main()
+{
+    std::filesystem::remove_all(GLGE_TEST_CACHE_DIR);
+    //the cache fits two images, but not three
+    glgeSetImageCache(GLGE_TEST_CACHE_DIR, 40 * 1024);
+    GLGE_TEST_CHECK(glgeIsImageCacheActive(), "the image cache is not active")
+
+    //the first load decodes the source, the second uses the cache
+    glgeTestStoreSource("testImageCacheA.ppm", 1);
+    GLGE_TEST_CHECK(!glgeTestLoad("testImageCacheA.ppm", 1), "the first load of an image is a cache hit")
+    GLGE_TEST_CHECK(glgeTestLoad("testImageCacheA.ppm", 1), "the second load of an image is a cache miss")
+
+    //a source with new content, but the same size and modification time, is decoded again
+    {
+        std::filesystem::file_time_type time = std::filesystem::last_write_time("testImageCacheA.ppm");
+        glgeTestStoreSource("testImageCacheA.ppm", 2);
+        std::filesystem::last_write_time("testImageCacheA.ppm", time);
+        GLGE_TEST_CHECK(!glgeTestLoad("testImageCacheA.ppm", 2), "a changed source with the same size and time is a cache hit")
+        GLGE_TEST_CHECK(glgeTestLoad("testImageCacheA.ppm", 2), "the changed source is not cached again")
+    }
+
+    //a third image evicts the least recently used one
+    glgeTestStoreSource("testImageCacheB.ppm", 3);
+    glgeTestStoreSource("testImageCacheC.ppm", 4);
+    GLGE_TEST_CHECK(!glgeTestLoad("testImageCacheB.ppm", 3), "the first load of the second image is a cache hit")
+    GLGE_TEST_CHECK(!glgeTestLoad("testImageCacheC.ppm", 4), "the first load of the third image is a cache hit")
+    GLGE_TEST_CHECK(glgeTestLoad("testImageCacheB.ppm", 3), "a recently used image was evicted")
+    GLGE_TEST_CHECK(glgeTestLoad("testImageCacheC.ppm", 4), "a recently used image was evicted")
+    GLGE_TEST_CHECK(!glgeTestLoad("testImageCacheA.ppm", 2), "the least recently used image was not evicted")
+
+    //a cleared cache has no hits
+    glgeClearImageCache();
+    GLGE_TEST_CHECK(!glgeTestLoad("testImageCacheC.ppm", 4), "a cleared cache is used")
+
+    //remove the files
+    glgeSetImageCache(NULL);
+    std::filesystem::remove_all(GLGE_TEST_CACHE_DIR);
+    std::remove("testImageCacheA.ppm");
+    std::remove("testImageCacheB.ppm");
+    std::remove("testImageCacheC.ppm");
+    return glgeTestResult("image cache");
+}
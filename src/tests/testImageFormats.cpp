@@ -0,0 +1,164 @@
+/**
+ * @file testImageFormats.cpp
+ * @author DM8AT
+ * @brief test that images written as PPM, QOI and PNG load back unchanged, with rows stored from the top, from the bottom and as floats
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "glgeTest.hpp"
+//include the vectors used by the image functions
+#include "../GLGE/CML/CML.h"
+//include the images
+#include "../GLGE/GLGEIndependend/glgeImage.h"
+//include the needed standard librarys
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdio>
+
+/**
+ * @brief create an RGBA image with noise, flat areas and a translucent band
+ *
+ * @param width the width of the image
+ * @param height the height of the image
+ * @return std::vector<uint8_t> the pixels of the image
+ */
+static std::vector<uint8_t> glgeTestCreateImage(int width, int height)
+{
+    std::vector<uint8_t> rgba((size_t)width * height * 4);
+    uint32_t seed = 7;
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            uint8_t* p = rgba.data() + ((size_t)y * width + x) * 4;
+            seed = seed * 1664525u + 1013904223u;
+            //the left half is noise, so the PNG is larger than one IDAT chunk, the right half repeats
+            if (x < width / 2)
+            {
+                p[0] = (uint8_t)(seed >> 24);
+                p[1] = (uint8_t)(seed >> 16);
+                p[2] = (uint8_t)(x + y);
+            }
+            else
+            {
+                p[0] = (uint8_t)((x / 16) * 40);
+                p[1] = (uint8_t)((y / 16) * 40);
+                p[2] = 200;
+            }
+            p[3] = (y < height / 4) ? (uint8_t)(x * 3) : 255;
+        }
+    }
+    return rgba;
+}
+
+/**
+ * @brief store an image, load it again and compare the pixels
+ *
+ * @param file the file to write, the ending selects the format
+ * @param pixels the pixels in the order they are passed to the writer
+ * @param expected the pixels the loaded image must have, from the top row down
+ * @param width the width of the image
+ * @param height the height of the image
+ * @param bottomUp say if the first row of the pixels is the bottom row
+ * @param chanels the amount of chanels the format stores, PPM has no alpha
+ */
+static void glgeTestRoundTrip(const char* file, std::vector<uint8_t>& pixels, const std::vector<uint8_t>& expected, int width, int height, bool bottomUp, int chanels)
+{
+    glgeStoreImage(file, ivec2(width, height), pixels.data(), GLGE_IMG_TYPE_ENDING, bottomUp);
+    int x = 0, y = 0, comp = 0;
+    uint8_t* data = glgeLoadImage(file, &x, &y, &comp, 4);
+    std::string msg = std::string(file) + (bottomUp ? " (bottom up)" : " (top down)");
+    GLGE_TEST_CHECK(data != NULL, (msg + " can't be loaded").c_str())
+    if (!data) { return; }
+    GLGE_TEST_CHECK((x == width) && (y == height) && (comp == chanels), (msg + " has the wrong size").c_str())
+    //compare the stored chanels, formats without alpha load as opaque
+    bool same = (x == width) && (y == height);
+    for (size_t i = 0; same && (i < expected.size()); i++)
+    {
+        uint8_t want = (((i & 3) == 3) && (chanels == 3)) ? 255 : expected[i];
+        same = (data[i] == want);
+    }
+    GLGE_TEST_CHECK(same, (msg + " doesn't load the stored pixels").c_str())
+    glgeImageFree(data);
+    std::remove(file);
+}
+
+int main()
+{
+    //the width is odd, so the rows are not aligned
+    const int width = 301, height = 173;
+    std::vector<uint8_t> image = glgeTestCreateImage(width, height);
+    //the same image with the bottom row first
+    size_t stride = (size_t)width * 4;
+    std::vector<uint8_t> flipped(image.size());
+    for (int y = 0; y < height; y++) { std::memcpy(flipped.data() + y * stride, image.data() + (height - 1 - y) * stride, stride); }
+
+    //write every format from the top and from the bottom, the bottom up writers are GLGE's own row readers
+    const char* files[] = {"testImageFormats.ppm", "testImageFormats.qoi", "testImageFormats.png"};
+    const int chanels[] = {3, 4, 4};
+    for (int f = 0; f < 3; f++)
+    {
+        glgeTestRoundTrip(files[f], image, image, width, height, false, chanels[f]);
+        glgeTestRoundTrip(files[f], flipped, image, width, height, true, chanels[f]);
+    }
+
+    //a flat image is compressed to long matches and runs
+    {
+        std::vector<uint8_t> flat((size_t)64 * 64 * 4, 77);
+        glgeTestRoundTrip("testImageFormats.png", flat, flat, 64, 64, true, 4);
+        glgeTestRoundTrip("testImageFormats.qoi", flat, flat, 64, 64, true, 4);
+    }
+    //a single pixel is smaller than a match
+    {
+        std::vector<uint8_t> pixel = {1, 2, 3, 4};
+        glgeTestRoundTrip("testImageFormats.png", pixel, pixel, 1, 1, true, 4);
+        glgeTestRoundTrip("testImageFormats.qoi", pixel, pixel, 1, 1, true, 4);
+    }
+
+    //float images are stored from the bottom row and converted row by row
+    {
+        std::vector<vec4> floats((size_t)width * height);
+        for (int y = 0; y < height; y++)
+        {
+            const uint8_t* row = image.data() + (height - 1 - y) * stride;
+            for (int x = 0; x < width; x++)
+            {
+                floats[(size_t)y * width + x] = vec4(row[x*4] / 255.f, row[x*4 + 1] / 255.f, row[x*4 + 2] / 255.f, row[x*4 + 3] / 255.f);
+            }
+        }
+        for (int f = 0; f < 3; f++)
+        {
+            glgeStoreImage(files[f], ivec2(width, height), floats.data(), GLGE_IMG_TYPE_ENDING, false);
+            int x = 0, y = 0, comp = 0;
+            uint8_t* data = glgeLoadImage(files[f], &x, &y, &comp, 4);
+            bool same = data && (x == width) && (y == height);
+            for (size_t i = 0; same && (i < image.size()); i++) { same = (data[i] == ((((i & 3) == 3) && (chanels[f] == 3)) ? 255 : image[i])); }
+            GLGE_TEST_CHECK(same, (std::string(files[f]) + " doesn't load the stored float pixels").c_str())
+            if (data) { glgeImageFree(data); }
+            std::remove(files[f]);
+        }
+    }
+
+    //the chanels of the file are optional, also for QOI files loaded as floats
+    {
+        std::vector<uint8_t> pixels = {0, 255, 128, 255, 255, 0, 0, 64};
+        glgeStoreImage("testImageFormats.qoi", ivec2(2, 1), pixels.data(), GLGE_IMG_TYPE_QOI);
+        int x = 0, y = 0;
+        uint8_t* bytes = glgeLoadImage("testImageFormats.qoi", &x, &y, NULL);
+        GLGE_TEST_CHECK(bytes && (x == 2) && (y == 1) && (bytes[7] == 64), "a QOI file can't be loaded without the chanels")
+        if (bytes) { glgeImageFree(bytes); }
+        float* floats = glgeLoadImageHDR("testImageFormats.qoi", &x, &y, NULL);
+        //the colors are linear, the alpha is not converted
+        GLGE_TEST_CHECK(floats && (x == 2) && (y == 1) && (floats[1] == 1.f) && (floats[4] == 1.f) && (floats[7] == 64 / 255.f), "a QOI file can't be loaded as floats without the chanels")
+        if (floats) { glgeImageFree(floats); }
+        std::remove("testImageFormats.qoi");
+    }
+
+    return glgeTestResult("image formats");
+}
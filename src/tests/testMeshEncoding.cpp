@@ -0,0 +1,205 @@
+/**
+ * @file testMeshEncoding.cpp
+ * @author DM8AT
+ * @brief test that meshes encoded with glgeEncodeMesh decode to the same vertices and indices and compare the speed to the old encoding
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "glgeTest.hpp"
+//include the mesh encoding
+#include "../GLGE/GLGEIndependend/glge3DcoreDefClasses.h"
+//include the needed standard librarys
+#include <climits>
+#include <cstring>
+
+/**
+ * @brief the width and height of the grid mesh, the mesh has about one million vertices
+ */
+#define GLGE_TEST_MESH_SIZE 1024
+
+/**
+ * @brief create a grid mesh
+ *
+ * @param vertices the vector to store the vertices in
+ * @param indices the vector to store the indices in
+ * @param size the width and height of the grid in vertices
+ */
+static void glgeTestCreateGrid(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, unsigned int size)
+{
+    vertices.clear();
+    indices.clear();
+    vertices.reserve(size * size);
+    indices.reserve((size - 1) * (size - 1) * 6);
+    for (unsigned int y = 0; y < size; y++)
+    {
+        for (unsigned int x = 0; x < size; x++)
+        {
+            Vertex v = Vertex(x * 0.5f, (float)((x * 7 + y * 13) % 17), y * 0.5f, vec4(x / (float)size, y / (float)size, 0.5f, 1.f), 0.f, 1.f, 0.f);
+            v.texCoord = vec2(x / (float)size, y / (float)size);
+            vertices.push_back(v);
+        }
+    }
+    for (unsigned int y = 0; y + 1 < size; y++)
+    {
+        for (unsigned int x = 0; x + 1 < size; x++)
+        {
+            unsigned int i = y * size + x;
+            unsigned int quad[6] = {i, i + 1, i + size, i + 1, i + size + 1, i + size};
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+}
+
+/**
+ * @brief encode a mesh like version 1 of the object encoding, every value is written on its own
+ *
+ * @param dat the data to write to
+ * @param vertices the vertices of the mesh
+ * @param indices the indices of the mesh
+ */
+static void glgeTestEncodeVersion1(Data* dat, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    dat->writeLong(vertices.size());
+    for (const Vertex& v : vertices)
+    {
+        dat->writeVec3(v.pos);
+        dat->writeVec4(v.color);
+        dat->writeVec2(v.texCoord);
+        dat->writeVec3(v.normal);
+    }
+    dat->writeLong(indices.size());
+    for (unsigned int i : indices) { dat->writeUInt(i); }
+}
+
+/**
+ * @brief check if two lists of vertices are bitwise equal
+ */
+static bool glgeTestSameVertices(const std::vector<Vertex>& a, const std::vector<Vertex>& b)
+{
+    return (a.size() == b.size()) && (a.empty() || (std::memcmp(a.data(), b.data(), a.size() * sizeof(Vertex)) == 0));
+}
+
+/**
+ * @brief check that a mesh decodes to the input and the data is fully read
+ *
+ * @param dat the encoded mesh
+ * @param vertices the expected vertices
+ * @param indices the expected indices
+ * @param msg the message to print if the check fails
+ */
+static void glgeTestDecode(Data& dat, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const char* msg)
+{
+    DataView view(dat.getReadPointer(), dat.getLen());
+    std::vector<Vertex> outVertices;
+    std::vector<unsigned int> outIndices;
+    GLGE_TEST_CHECK(glgeDecodeMesh(view, outVertices, outIndices), msg)
+    GLGE_TEST_CHECK(glgeTestSameVertices(outVertices, vertices), msg)
+    GLGE_TEST_CHECK(outIndices == indices, msg)
+    GLGE_TEST_CHECK(view.getLen() == 0, msg)
+}
+
+/**
+ * @brief check that invalid data is rejected
+ *
+ * @param dat the invalid data
+ * @param msg the message to print if the check fails
+ */
+static void glgeTestReject(Data& dat, const char* msg)
+{
+    glgeErrorOutput = false;
+    DataView view(dat.getReadPointer(), dat.getLen());
+    std::vector<Vertex> outVertices;
+    std::vector<unsigned int> outIndices;
+    GLGE_TEST_CHECK(!glgeDecodeMesh(view, outVertices, outIndices), msg)
+    glgeErrorOutput = true;
+}
+
+int main()
+{
+    //create a mesh with about one million vertices
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    glgeTestCreateGrid(vertices, indices, GLGE_TEST_MESH_SIZE);
+    double mb = (vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int)) / (1024.0 * 1024.0);
+
+    //round trip with the newest encoding and measure the speed
+    Data current;
+    double start = glgeTestTime();
+    glgeEncodeMesh(&current, vertices, indices);
+    double encodeTime = glgeTestTime() - start;
+    start = glgeTestTime();
+    {
+        DataView view(current.getReadPointer(), current.getLen());
+        std::vector<Vertex> outVertices;
+        std::vector<unsigned int> outIndices;
+        glgeDecodeMesh(view, outVertices, outIndices);
+    }
+    double decodeTime = glgeTestTime() - start;
+    glgeTestDecode(current, vertices, indices, "the mesh changed in the round trip");
+
+    //round trip with the old encoding, old scene files must still load
+    Data old;
+    start = glgeTestTime();
+    glgeTestEncodeVersion1(&old, vertices, indices);
+    double oldEncodeTime = glgeTestTime() - start;
+    start = glgeTestTime();
+    {
+        DataView view(old.getReadPointer(), old.getLen());
+        std::vector<Vertex> outVertices;
+        std::vector<unsigned int> outIndices;
+        glgeDecodeMesh(view, outVertices, outIndices);
+    }
+    double oldDecodeTime = glgeTestTime() - start;
+    glgeTestDecode(old, vertices, indices, "the mesh of version 1 changed in the round trip");
+    printf("[GLGE TEST] %zu vertices, %zu indices: version %d encode %7.1f MB/s, decode %7.1f MB/s | version 1 encode %7.1f MB/s, decode %7.1f MB/s\n",
+           vertices.size(), indices.size(), GLGE_OBJECT_ENCODING_VERSION, mb / encodeTime, mb / decodeTime, mb / oldEncodeTime, mb / oldDecodeTime);
+
+    //an empty mesh
+    {
+        std::vector<Vertex> noVertices;
+        std::vector<unsigned int> noIndices;
+        Data empty;
+        glgeEncodeMesh(&empty, noVertices, noIndices);
+        glgeTestDecode(empty, noVertices, noIndices, "the empty mesh changed in the round trip");
+    }
+
+    //a newer version is rejected
+    {
+        Data newer;
+        glgeEncodeMesh(&newer, vertices, indices);
+        long version = -(GLGE_OBJECT_ENCODING_VERSION + 1);
+        Data header;
+        header.writeLong(version);
+        std::memcpy(newer.getData(), header.getData(), header.getLen());
+        glgeTestReject(newer, "a newer encoding was accepted");
+    }
+    //the smallest long can't be negated and must be rejected as a newer version
+    {
+        Data smallest;
+        smallest.writeLong(LONG_MIN);
+        for (int i = 0; i < 64; i++) { smallest.writeUByte(0); }
+        glgeTestReject(smallest, "the smallest long was accepted as a version");
+    }
+    //truncated data is rejected
+    {
+        std::vector<Vertex> smallVertices;
+        std::vector<unsigned int> smallIndices;
+        glgeTestCreateGrid(smallVertices, smallIndices, 4);
+        Data full;
+        glgeEncodeMesh(&full, smallVertices, smallIndices);
+        for (size_t cut = sizeof(long); cut < full.getLen(); cut += 5)
+        {
+            Data truncated;
+            truncated.writeBytes((uint8_t*)full.getData(), cut);
+            glgeTestReject(truncated, "truncated mesh data was accepted");
+        }
+    }
+
+    //return the result
+    return glgeTestResult("mesh encoding");
+}
@@ -0,0 +1,205 @@
+/**
+ * @file testSceneChanges.cpp
+ * @author DM8AT
+ * @brief check that only the changed objects of a loaded scene are written to the change log, also if the objects were compressed
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "../tests/glgeTest.hpp"
+//include the scenes
+#include "../GLGE/GLGEIndependend/GLGEScene.hpp"
+//include the compression modes
+#include "../GLGE/GLGEIndependend/glgeCompression.h"
+//include the needed standard librarys
+#include <vector>
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+/**
+ * @brief the amount of objects in the test scene
+ */
+#define GLGE_TEST_SCENE_OBJECTS 20
+/**
+ * @brief the amount of values of every object, large enough to be compressed
+ */
+#define GLGE_TEST_SCENE_VALUES 2048
+/**
+ * @brief the size of the header of a change log entry
+ */
+#define GLGE_TEST_CHANGE_HEADER_SIZE 16
+/**
+ * @brief the size of the magic bytes at the start of the change log
+ */
+#define GLGE_TEST_CHANGE_MAGIC_SIZE 12
+
+/**
+ * @brief a simple object that stores a list of values
+ */
+class TestValues
+{
+public:
+    /**
+     * @brief store the values
+     */
+    std::vector<int> values;
+
+    /**
+     * @brief encode the values
+     *
+     * @return Data* the encoded data
+     */
+    Data* encode()
+    {
+        Data* dat = new Data();
+        dat->writeULong(this->values.size());
+        dat->writeArray(this->values.data(), this->values.size());
+        return dat;
+    }
+
+    /**
+     * @brief decode the values
+     *
+     * @param dat the data to decode from
+     */
+    void decode(DataView dat)
+    {
+        this->values.resize(dat.readULong());
+        dat.readArray(this->values.data(), this->values.size());
+    }
+};
+
+/**
+ * @brief read a whole file
+ *
+ * @param path the path to the file
+ * @return std::vector<uint8_t> the bytes of the file, empty if the file doesn't exist
+ */
+static std::vector<uint8_t> glgeTestReadFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief create the values of an object
+ *
+ * @param obj the index of the object
+ * @param edit true : create the edited values | false : create the stored values
+ * @return TestValues* the new values
+ */
+static TestValues* glgeTestCreateValues(int obj, bool edit)
+{
+    TestValues* v = new TestValues();
+    v->values.resize(GLGE_TEST_SCENE_VALUES);
+    for (size_t i = 0; i < v->values.size(); i++) { v->values[i] = (int)(i % 64) + obj * 1000 + (edit ? 7 : 0); }
+    return v;
+}
+
+int main()
+{
+    const std::string path = "testSceneChanges.glges";
+    const std::string changesPath = path + GLGE_SCENE_CHANGES_ENDING;
+    std::remove(path.c_str());
+    std::remove(changesPath.c_str());
+
+    //store a scene with compressed objects
+    {
+        Scene scene("testSceneChanges");
+        scene.setCompression(GLGE_COMPRESSION_FAST, 64);
+        for (int i = 0; i < GLGE_TEST_SCENE_OBJECTS; i++)
+        {
+            TestValues* v = glgeTestCreateValues(i, false);
+            scene.set<TestValues>(v, "obj" + std::to_string(i));
+            delete v;
+        }
+        scene.safeFile();
+    }
+    std::vector<uint8_t> base = glgeTestReadFile(path);
+    GLGE_TEST_CHECK(!base.empty(), "the scene file was not written")
+    //the objects have to be compressed, else the test doesn't cover the decompressed objects
+    GLGE_TEST_CHECK(base.size() < GLGE_TEST_SCENE_OBJECTS * GLGE_TEST_SCENE_VALUES * sizeof(int) / 2, "the objects were not compressed")
+
+    //load the scene, read every object and store the changes without editing anything
+    {
+        Scene scene("testSceneChanges");
+        scene.setCompression(GLGE_COMPRESSION_FAST, 64);
+        scene.load();
+        std::vector<NamedObject*> objs = scene.getAllObjects();
+        GLGE_TEST_CHECK(objs.size() == GLGE_TEST_SCENE_OBJECTS, "not all objects were loaded")
+        for (NamedObject* obj : objs)
+        {
+            GLGE_TEST_CHECK(obj && !obj->isDirty(), "a loaded object is dirty")
+        }
+        scene.safeChanges();
+    }
+    GLGE_TEST_CHECK(glgeTestReadFile(changesPath).empty(), "unchanged objects were written to the change log")
+    GLGE_TEST_CHECK(glgeTestReadFile(path) == base, "the scene file was rewritten without changes")
+
+    //load the scene again, read every object and edit one of them
+    {
+        Scene scene("testSceneChanges");
+        scene.setCompression(GLGE_COMPRESSION_FAST, 64);
+        scene.load();
+        std::vector<NamedObject*> objs = scene.getAllObjects();
+        for (NamedObject* obj : objs)
+        {
+            TestValues* v = obj->getObject<TestValues>();
+            delete v;
+        }
+        TestValues* edited = glgeTestCreateValues(5, true);
+        scene.set<TestValues>(edited, "obj5");
+        delete edited;
+        scene.safeChanges();
+    }
+    //the scene file must be unchanged and the change log must contain exactly one entry
+    GLGE_TEST_CHECK(glgeTestReadFile(path) == base, "the scene file was rewritten for a single change")
+    std::vector<uint8_t> changes = glgeTestReadFile(changesPath);
+    size_t entries = 0;
+    std::string entryName;
+    size_t pos = GLGE_TEST_CHANGE_MAGIC_SIZE;
+    while (pos + GLGE_TEST_CHANGE_HEADER_SIZE <= changes.size())
+    {
+        uint16_t nameLength = 0;
+        uint64_t length = 0;
+        std::memcpy(&nameLength, changes.data() + pos + 2, sizeof(nameLength));
+        std::memcpy(&length, changes.data() + pos + 8, sizeof(length));
+        pos += GLGE_TEST_CHANGE_HEADER_SIZE;
+        if (pos + nameLength > changes.size()) { break; }
+        entryName = std::string((const char*)changes.data() + pos, nameLength);
+        pos += nameLength + length;
+        entries++;
+    }
+    GLGE_TEST_CHECK(changes.size() > GLGE_TEST_CHANGE_MAGIC_SIZE, "the change was not written to the change log")
+    GLGE_TEST_CHECK(pos == changes.size(), "the change log has an invalid size")
+    GLGE_TEST_CHECK(entries == 1, "the change log contains more than the edited object")
+    GLGE_TEST_CHECK(entryName == "obj5", "the change log contains the wrong object")
+
+    //load the scene with the change log and check all values
+    {
+        Scene scene("testSceneChanges");
+        scene.load();
+        for (int i = 0; i < GLGE_TEST_SCENE_OBJECTS; i++)
+        {
+            NamedObject* obj = scene.get("obj" + std::to_string(i));
+            GLGE_TEST_CHECK(obj != NULL, "an object is missing after the changes were loaded")
+            if (!obj) { continue; }
+            TestValues* v = obj->getObject<TestValues>();
+            TestValues* expected = glgeTestCreateValues(i, i == 5);
+            GLGE_TEST_CHECK(v->values == expected->values, "an object has the wrong values after the changes were loaded")
+            delete v;
+            delete expected;
+        }
+    }
+
+    //remove the scene files
+    std::remove(path.c_str());
+    std::remove(changesPath.c_str());
+    return glgeTestResult("scene changes");
+}
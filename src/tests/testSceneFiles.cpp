@@ -0,0 +1,354 @@
+/**
+ * @file testSceneFiles.cpp
+ * @author DM8AT
+ * @brief check that scene files of version 1 still load, that objects are found by name when names are missing or share a hash and that damaged objects and failed loads in the background are reported on the calling thread
+ * @version 0.1
+ * @date 2024-03-26
+ *
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license.
+ *
+ */
+
+//include the test helpers
+#include "../tests/glgeTest.hpp"
+//include the scenes
+#include "../GLGE/GLGEIndependend/GLGEScene.hpp"
+//include the compression modes
+#include "../GLGE/GLGEIndependend/glgeCompression.h"
+//include the needed standard librarys
+#include <vector>
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
+
+/**
+ * @brief the size of the header of a scene file of version 2
+ */
+#define GLGE_TEST_SCENE_HEADER_SIZE 32
+/**
+ * @brief the amount of compressed objects, together they are large enough to be decompressed on multiple threads
+ */
+#define GLGE_TEST_SCENE_LARGE_OBJECTS 16
+/**
+ * @brief the amount of values of every compressed object
+ */
+#define GLGE_TEST_SCENE_LARGE_VALUES (64*1024)
+
+/**
+ * @brief a simple object that stores a list of values
+ */
+class TestValues
+{
+public:
+    /**
+     * @brief store the values
+     */
+    std::vector<int> values;
+
+    /**
+     * @brief encode the values
+     *
+     * @return Data* the encoded data
+     */
+    Data* encode()
+    {
+        Data* dat = new Data();
+        dat->writeULong(this->values.size());
+        dat->writeArray(this->values.data(), this->values.size());
+        return dat;
+    }
+
+    /**
+     * @brief decode the values
+     *
+     * @param dat the data to decode from
+     */
+    void decode(DataView dat)
+    {
+        this->values.resize(dat.readULong());
+        dat.readArray(this->values.data(), this->values.size());
+    }
+};
+
+/**
+ * @brief read a whole file
+ *
+ * @param path the path to the file
+ * @return std::vector<uint8_t> the bytes of the file, empty if the file doesn't exist
+ */
+static std::vector<uint8_t> glgeTestReadFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief write bytes to a file
+ *
+ * @param path the path to the file
+ * @param data the bytes to write
+ */
+static void glgeTestWriteFile(const std::string& path, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write((const char*)data.data(), data.size());
+}
+
+/**
+ * @brief create the values of an object
+ *
+ * @param obj the index of the object
+ * @return TestValues the values
+ */
+static TestValues glgeTestCreateValues(int obj)
+{
+    TestValues v;
+    v.values.resize(100 + obj * 10);
+    for (size_t i = 0; i < v.values.size(); i++) { v.values[i] = (int)i * 3 + obj * 1000; }
+    return v;
+}
+
+/**
+ * @brief create the values of a compressed object, half of them are noise so the compressed data stays large
+ *
+ * @param obj the index of the object
+ * @return TestValues the values
+ */
+static TestValues glgeTestCreateLargeValues(int obj)
+{
+    TestValues v;
+    v.values.resize(GLGE_TEST_SCENE_LARGE_VALUES);
+    uint32_t seed = (uint32_t)obj + 1;
+    for (size_t i = 0; i < v.values.size(); i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        v.values[i] = (i & 1) ? (int)seed : obj;
+    }
+    return v;
+}
+
+/**
+ * @brief check that an object of a scene exists and decodes to the values of an index
+ *
+ * @param scene the scene to read from
+ * @param name the name of the object
+ * @param obj the index the values were created from
+ * @return true : the object is correct | false : the object is missing or wrong
+ */
+static bool glgeTestCheckObject(Scene& scene, const std::string& name, int obj)
+{
+    NamedObject* named = scene.get(name);
+    if (!named) { return false; }
+    TestValues* v = named->getObject<TestValues>();
+    bool same = (v->values == glgeTestCreateValues(obj).values);
+    delete v;
+    return same;
+}
+
+int main()
+{
+    const std::string path = "testSceneFiles.glges";
+    const std::string changesPath = path + GLGE_SCENE_CHANGES_ENDING;
+    std::remove(path.c_str());
+    std::remove(changesPath.c_str());
+    const char* names[] = {"alpha", "beta", "a longer name of an object"};
+
+    //write a file like the writer of version 1, the length of a record also counts the name and its length, so the writer copied that many bytes past the object
+    {
+        std::vector<uint8_t> file = {'G','L','G','E','S','c','e','n','e','0','0','1'};
+        std::vector<std::vector<uint8_t>> objects;
+        for (int i = 0; i < 3; i++)
+        {
+            TestValues v = glgeTestCreateValues(i);
+            NamedObject obj;
+            obj.set<TestValues>(&v, names[i]);
+            size_t size = 0;
+            const uint8_t* data = obj.getBytes(&size);
+            objects.push_back(std::vector<uint8_t>(data, data + size));
+            //write the record
+            uint8_t nLen = (uint8_t)std::strlen(names[i]);
+            uint32_t len = (uint32_t)(size + nLen + sizeof(nLen));
+            file.insert(file.end(), (uint8_t*)&len, (uint8_t*)&len + sizeof(len));
+            file.push_back(nLen);
+            file.insert(file.end(), names[i], names[i] + nLen);
+            file.insert(file.end(), data, data + size);
+            //the bytes behind the object were whatever followed it in memory
+            file.insert(file.end(), (size_t)nLen + 1, 0xCD);
+        }
+        glgeTestWriteFile(path, file);
+
+        //load the old file, the objects must not contain the bytes behind them
+        Scene scene("testSceneFiles");
+        scene.load();
+        GLGE_TEST_CHECK(scene.getObjectNames().size() == 3, "a scene file of version 1 doesn't load all objects")
+        for (int i = 0; i < 3; i++)
+        {
+            GLGE_TEST_CHECK(glgeTestCheckObject(scene, names[i], i), "an object of a scene file of version 1 doesn't decode")
+            NamedObject* obj = scene.get(names[i]);
+            size_t size = 0;
+            const uint8_t* data = obj ? obj->getBytes(&size) : NULL;
+            GLGE_TEST_CHECK(data && (size == objects[i].size()) && (std::memcmp(data, objects[i].data(), size) == 0), "an object of a scene file of version 1 contains the bytes behind it")
+        }
+        //store the scene in the current version
+        scene.safeFile();
+    }
+    //the rewritten file loads with the same objects
+    {
+        std::vector<uint8_t> file = glgeTestReadFile(path);
+        GLGE_TEST_CHECK((file.size() > 12) && (std::memcmp(file.data() + 9, "002", 3) == 0), "a scene file of version 1 isn't rewritten in version 2")
+        Scene scene("testSceneFiles");
+        scene.load();
+        GLGE_TEST_CHECK(scene.getObjectNames().size() == 3, "a rewritten scene file of version 1 doesn't contain all objects")
+        for (int i = 0; i < 3; i++) { GLGE_TEST_CHECK(glgeTestCheckObject(scene, names[i], i), "an object of a rewritten scene file of version 1 doesn't decode") }
+    }
+
+    //missing names are not found and don't create objects
+    {
+        Scene scene("testSceneFiles");
+        scene.load();
+        GLGE_TEST_CHECK(!scene.has("gamma") && !scene.has("") && !scene.has("alph") && !scene.has("alphaa"), "a missing name is found in the scene file")
+        GLGE_TEST_CHECK(!scene.get("gamma") && !scene.get(""), "a missing name creates an object")
+        GLGE_TEST_CHECK(scene.getObjectNames().size() == 3, "looking up a missing name adds an object")
+        //a removed object is missing too, also before it is created
+        scene.remove("beta");
+        GLGE_TEST_CHECK(!scene.has("beta") && !scene.get("beta"), "a removed object is found in the scene file")
+        GLGE_TEST_CHECK(scene.has("alpha"), "an object isn't found after another one was removed")
+    }
+
+    //give the record of another name the same hash, the lookup must compare the names of every record with that hash
+    for (int first = 0; first < 2; first++)
+    {
+        //store only two objects, so the table of contents can be rewritten in any order
+        std::remove(path.c_str());
+        {
+            Scene scene("testSceneFiles");
+            for (int i = 0; i < 2; i++)
+            {
+                TestValues v = glgeTestCreateValues(i);
+                scene.set<TestValues>(&v, names[i]);
+            }
+            scene.safeFile();
+        }
+        std::vector<uint8_t> file = glgeTestReadFile(path);
+        uint64_t count = 0, namesOffset = 0;
+        std::memcpy(&count, file.data() + 16, sizeof(count));
+        std::memcpy(&namesOffset, file.data() + 24, sizeof(namesOffset));
+        GLGE_TEST_CHECK(count == 2, "the scene file doesn't store two records")
+        if (count != 2) { break; }
+        SceneRecord records[2];
+        std::memcpy(records, file.data() + GLGE_TEST_SCENE_HEADER_SIZE, sizeof(records));
+        //find the record of the name that is looked up
+        int beta = (std::string((const char*)file.data() + namesOffset + records[1].nameOffset, records[1].nameLength) == "beta") ? 1 : 0;
+        SceneRecord colliding[2] = {records[1 - beta], records[beta]};
+        colliding[0].nameHash = colliding[1].nameHash;
+        //the record with the wrong name comes first or second
+        if (first) { std::swap(colliding[0], colliding[1]); }
+        std::memcpy(file.data() + GLGE_TEST_SCENE_HEADER_SIZE, colliding, sizeof(colliding));
+        glgeTestWriteFile(path, file);
+
+        //check the lookup before the objects are created
+        Scene scene("testSceneFiles");
+        scene.load();
+        GLGE_TEST_CHECK(scene.has("beta"), "a name isn't found if another record has the same hash")
+        GLGE_TEST_CHECK(glgeTestCheckObject(scene, "beta", 1), "a name finds the record of another name with the same hash")
+        GLGE_TEST_CHECK(!scene.has("gamma") && !scene.get("gamma"), "a missing name is found next to records with the same hash")
+        //the other record is stored under the hash of beta, so it can't be found by its own name
+        GLGE_TEST_CHECK(!scene.get("alpha"), "a record is found by a name with a different hash")
+    }
+
+    //damage one compressed object, the error must reach the calling thread after all objects were decompressed
+    {
+        std::remove(path.c_str());
+        {
+            Scene scene("testSceneFiles");
+            scene.setCompression(GLGE_COMPRESSION_FAST, 64);
+            for (int i = 0; i < GLGE_TEST_SCENE_LARGE_OBJECTS; i++)
+            {
+                TestValues v = glgeTestCreateLargeValues(i);
+                scene.set<TestValues>(&v, "obj" + std::to_string(i));
+            }
+            scene.safeFile();
+        }
+        //make the uncompressed size of obj3 one byte too small, so the data doesn't fit
+        std::vector<uint8_t> file = glgeTestReadFile(path);
+        uint64_t count = 0, namesOffset = 0;
+        std::memcpy(&count, file.data() + 16, sizeof(count));
+        std::memcpy(&namesOffset, file.data() + 24, sizeof(namesOffset));
+        bool damaged = false;
+        for (uint64_t i = 0; i < count; i++)
+        {
+            SceneRecord record;
+            std::memcpy(&record, file.data() + GLGE_TEST_SCENE_HEADER_SIZE + i*sizeof(SceneRecord), sizeof(record));
+            if (std::string((const char*)file.data() + namesOffset + record.nameOffset, record.nameLength) != "obj3") { continue; }
+            if (!(record.flags & GLGE_SCENE_FLAG_COMPRESSED)) { break; }
+            uint64_t rawSize = 0;
+            std::memcpy(&rawSize, file.data() + record.offset, sizeof(rawSize));
+            rawSize--;
+            std::memcpy(file.data() + record.offset, &rawSize, sizeof(rawSize));
+            damaged = true;
+        }
+        GLGE_TEST_CHECK(damaged, "the large object isn't compressed")
+        glgeTestWriteFile(path, file);
+
+        //the error is thrown on the calling thread and not inside of a worker thread
+        Scene scene("testSceneFiles");
+        scene.load();
+        bool thrown = false;
+        glgeExitOnError = true;
+        try { scene.getAllObjects(); }
+        catch (const std::runtime_error&) { thrown = true; }
+        glgeExitOnError = false;
+        GLGE_TEST_CHECK(thrown, "a damaged compressed object doesn't throw an error")
+        //the other objects were created before the error was raised
+        for (int i = 0; i < GLGE_TEST_SCENE_LARGE_OBJECTS; i++)
+        {
+            if (i == 3) { continue; }
+            NamedObject* obj = scene.get("obj" + std::to_string(i));
+            TestValues* v = obj ? obj->getObject<TestValues>() : NULL;
+            GLGE_TEST_CHECK(v && (v->values == glgeTestCreateLargeValues(i).values), "an object is lost because another object is damaged")
+            delete v;
+        }
+        //without exiting on errors the damaged object is missing
+        GLGE_TEST_CHECK(!scene.get("obj3"), "a damaged compressed object is created")
+    }
+
+    //a load in the background that fails leaves the scene unchanged, the file still contains the damaged object
+    {
+        Scene scene("testSceneFiles");
+        TestValues kept = glgeTestCreateValues(5);
+        scene.set<TestValues>(&kept, "kept");
+        //the error of the damaged object is thrown on the thread that finishes the load
+        bool thrown = false;
+        glgeExitOnError = true;
+        scene.loadAsync();
+        try { scene.finishLoad(true); }
+        catch (const std::runtime_error&) { thrown = true; }
+        glgeExitOnError = false;
+        GLGE_TEST_CHECK(thrown, "the error of a load in the background isn't thrown by finishLoad")
+        GLGE_TEST_CHECK(!scene.isLoading(), "a failed load in the background is still running")
+        GLGE_TEST_CHECK(glgeTestCheckObject(scene, "kept", 5) && !scene.has("obj0"), "a failed load in the background changed the scene")
+
+        //a missing file is reported by the progress and by finishLoad
+        Scene missing("testSceneFilesMissing");
+        missing.set<TestValues>(&kept, "kept");
+        missing.loadAsync();
+        for (int i = 0; (i < 1000) && (missing.getLoadProgress() >= 0.f); i++) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); }
+        GLGE_TEST_CHECK(missing.getLoadProgress() == -1.f, "the progress of a failed load isn't -1")
+        GLGE_TEST_CHECK(!missing.finishLoad(true) && !missing.isLoading(), "finishLoad applies a failed load")
+        GLGE_TEST_CHECK(glgeTestCheckObject(missing, "kept", 5), "a failed load in the background removed the objects of the scene")
+
+        //without exiting on errors the damaged object is skipped and the rest of the file is applied
+        scene.loadAsync();
+        GLGE_TEST_CHECK(scene.finishLoad(true), "a load in the background with a damaged object isn't applied")
+        GLGE_TEST_CHECK(scene.has("obj0") && !scene.get("obj3") && !scene.has("kept"), "a load in the background doesn't replace the objects of the scene")
+    }
+
+    //remove the files
+    std::remove(path.c_str());
+    std::remove(changesPath.c_str());
+    return glgeTestResult("scene files");
+}
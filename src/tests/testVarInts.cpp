@@ -0,0 +1,157 @@
+/**
+ * @file testVarInts.cpp
+ * @author DM8AT
+ * @brief test that the SSE2 decode of varint arrays returns the same integers as the scalar decode
+ * @version 0.1
+ * @date 2024-03-26
+ * 
+ * @copyright Copyright DM8AT 2024. All rights reserved. This project is released under the MIT license. 
+ * 
+ */
+
+//include the test helpers
+#include "glgeTest.hpp"
+//include the data class
+#include "../GLGE/GLGEIndependend/GLGEData.h"
+
+/**
+ * @brief decode varints one by one like DataView::readVarInt, but without the sign
+ * 
+ * @param in the bytes
+ * @param size the amount of bytes
+ * @param values the integers to write to
+ * @param count the amount of integers
+ * @return size_t the amount of read bytes, 0 if the data is invalid
+ */
+static size_t glgeTestDecodeScalar(const uint8_t* in, size_t size, uint32_t* values, size_t count)
+{
+    size_t p = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t value = 0;
+        for (int position = 0; ; position += 7)
+        {
+            if ((position >= 35) || (p >= size)) { return 0; }
+            value |= (uint32_t)(in[p] & 0x7F) << position;
+            if ((in[p++] & 0x80) == 0) { break; }
+        }
+        values[i] = value;
+    }
+    return p;
+}
+
+/**
+ * @brief decode bytes with the batched decoder, with single calls and with the reference and check that all agree
+ * 
+ * @param bytes the encoded varints
+ * @param count the amount of varints to decode
+ * @param msg the message to print if the decoders disagree
+ */
+static void glgeTestCompare(const std::vector<uint8_t>& bytes, size_t count, const char* msg)
+{
+    //decode with the reference
+    std::vector<uint32_t> expected(count + 1, 0xDEADBEEF);
+    size_t expectedSize = glgeTestDecodeScalar(bytes.data(), bytes.size(), expected.data(), count);
+    bool expectValid = (expectedSize != 0) || (count == 0);
+    //decode all at once, this uses the SSE2 path for blocks of 16 bytes
+    glgeErrorOutput = false;
+    DataView batch(bytes.data(), bytes.size());
+    std::vector<unsigned int> batched(count + 1, 0xDEADBEEF);
+    bool batchValid = batch.readVarInts(batched.data(), count);
+    //decode one at a time, a single integer never uses the SSE2 path
+    DataView single(bytes.data(), bytes.size());
+    std::vector<unsigned int> singles(count + 1, 0xDEADBEEF);
+    bool singleValid = true;
+    for (size_t i = 0; (i < count) && singleValid; i++) { singleValid = single.readVarInts(&singles[i], 1); }
+    glgeErrorOutput = true;
+    //compare the results
+    GLGE_TEST_CHECK(batchValid == expectValid, msg)
+    GLGE_TEST_CHECK(singleValid == expectValid, msg)
+    if (!expectValid) { return; }
+    GLGE_TEST_CHECK(std::memcmp(batched.data(), expected.data(), count * sizeof(uint32_t)) == 0, msg)
+    GLGE_TEST_CHECK(std::memcmp(singles.data(), expected.data(), count * sizeof(uint32_t)) == 0, msg)
+    GLGE_TEST_CHECK(batch.getLen() == bytes.size() - expectedSize, msg)
+    GLGE_TEST_CHECK(single.getLen() == bytes.size() - expectedSize, msg)
+    //nothing is written past the requested integers
+    GLGE_TEST_CHECK(batched[count] == 0xDEADBEEF, msg)
+}
+
+/**
+ * @brief encode integers with Data::writeVarInts
+ */
+static std::vector<uint8_t> glgeTestEncode(const std::vector<unsigned int>& values)
+{
+    Data dat;
+    dat.writeVarInts(values.data(), values.size());
+    return std::vector<uint8_t>(dat.getReadPointer(), dat.getReadPointer() + dat.getLen());
+}
+
+int main()
+{
+    //the smallest and largest integer of every length from 1 to 5 bytes
+    const unsigned int limits[] = {0u, 127u, 128u, 16383u, 16384u, 2097151u, 2097152u, 268435455u, 268435456u, 0xFFFFFFFFu};
+
+    //every length at every offset of a 16 byte load, the padding moves the varint across the end of the block
+    for (int len = 0; len < 10; len++)
+    {
+        for (int pad = 0; pad < 20; pad++)
+        {
+            std::vector<unsigned int> values(pad, 1u);
+            values.push_back(limits[len]);
+            values.insert(values.end(), 40, 5u);
+            std::vector<uint8_t> bytes = glgeTestEncode(values);
+            glgeTestCompare(bytes, values.size(), "a varint at the end of a block was decoded differently");
+            //the encoded bytes must read back as the written integers
+            DataView view(bytes.data(), bytes.size());
+            std::vector<unsigned int> read(values.size());
+            GLGE_TEST_CHECK(view.readVarInts(read.data(), read.size()) && (read == values), "varints changed in a round trip")
+        }
+    }
+
+    //random mixes of all lengths, every second run only uses varints with 1 or 2 bytes like mesh indices
+    uint64_t seed = 12345;
+    for (int run = 0; run < 2000; run++)
+    {
+        size_t count = (size_t)(run % 97);
+        std::vector<unsigned int> values(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            int bits = (int)((seed >> 59) % ((run & 1) ? 15 : 33));
+            values[i] = (unsigned int)(seed >> 20) & (bits ? (0xFFFFFFFFu >> (32 - bits)) : 0u);
+        }
+        std::vector<uint8_t> bytes = glgeTestEncode(values);
+        glgeTestCompare(bytes, count, "a random varint array was decoded differently");
+        //decode fewer integers than stored
+        if (count) { glgeTestCompare(bytes, count / 2, "a part of a varint array was decoded differently"); }
+        //cut the data off at every length of the last block
+        for (size_t cut = 1; (cut < 20) && (cut <= bytes.size()); cut++)
+        {
+            std::vector<uint8_t> part(bytes.begin(), bytes.end() - cut);
+            glgeTestCompare(part, count, "a cut off varint array was decoded differently");
+        }
+    }
+
+    //invalid data, a varint with 6 bytes at every offset of a block
+    for (int pad = 0; pad < 20; pad++)
+    {
+        std::vector<uint8_t> bytes(pad, 0x01);
+        bytes.insert(bytes.end(), {0x80, 0x80, 0x80, 0x80, 0x80, 0x01});
+        bytes.insert(bytes.end(), 20, 0x02);
+        glgeTestCompare(bytes, pad + 21, "a varint with 6 bytes was decoded differently");
+    }
+    //16 bytes with the continue bit can't be valid
+    glgeTestCompare(std::vector<uint8_t>(40, 0x80), 20, "a block without an end was decoded differently");
+    //longer encodings than needed are valid
+    std::vector<uint8_t> padded;
+    for (int i = 0; i < 20; i++) { padded.insert(padded.end(), {0x81, 0x80, 0x00}); }
+    glgeTestCompare(padded, 20, "padded varints were decoded differently");
+    //a fifth byte with more than 4 bits keeps only the low bits like the scalar decode
+    std::vector<uint8_t> wide(20, 0x03);
+    wide.insert(wide.end(), {0xFF, 0xFF, 0xFF, 0xFF, 0x7F});
+    wide.insert(wide.end(), 20, 0x04);
+    glgeTestCompare(wide, 41, "a fifth byte with too many bits was decoded differently");
+
+    //print the result
+    return glgeTestResult("varints");
+}